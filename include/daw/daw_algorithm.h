@@ -12,19 +12,27 @@
 #include "daw_do_n.h"
 #include "daw_enable_if.h"
 #include "daw_exception.h"
+#include "daw_is_constant_evaluated.h"
 #include "daw_move.h"
+#include "daw_simd_support.h"
 #include "daw_swap.h"
 #include "daw_traits.h"
 #include "daw_view.h"
 #include "impl/daw_math_impl.h"
 
 #include <algorithm>
+#include <array>
 #include <ciso646>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -227,6 +235,563 @@ namespace daw {
 } // namespace daw
 
 namespace daw::algorithm {
+	/// Execution policy tags for the reduce, map_reduce, transform and
+	/// accumulate overloads.  The parallel policies need
+	/// parallel/daw_parallel_algorithm.h
+	namespace execution {
+		/// Run on the calling thread
+		struct sequenced_policy {
+			explicit sequenced_policy( ) = default;
+		};
+
+		/// Run on the calling thread, elements may be interleaved so the loops
+		/// vectorize.  Arguments must not alias
+		struct unsequenced_policy {
+			explicit unsequenced_policy( ) = default;
+		};
+
+		/// Run over several threads
+		struct parallel_policy {
+			explicit parallel_policy( ) = default;
+		};
+
+		/// Run over several threads with vectorizable loops in each
+		struct parallel_unsequenced_policy {
+			explicit parallel_unsequenced_policy( ) = default;
+		};
+
+		inline constexpr sequenced_policy seq{ };
+		inline constexpr unsequenced_policy unseq{ };
+		inline constexpr parallel_policy par{ };
+		inline constexpr parallel_unsequenced_policy par_unseq{ };
+
+		template<typename T>
+		inline constexpr bool is_execution_policy_v =
+		  std::is_same_v<T, sequenced_policy> or
+		  std::is_same_v<T, unsequenced_policy> or
+		  std::is_same_v<T, parallel_policy> or
+		  std::is_same_v<T, parallel_unsequenced_policy>;
+	} // namespace execution
+
+	namespace algorithm_details {
+		/// Elements per step of the portable block kernels, one 256 bit lane
+		/// group the compiler can map to whatever vector width is enabled
+		template<typename T>
+		inline constexpr std::ptrdiff_t simd_lane_count =
+		  static_cast<std::ptrdiff_t>( 32U / sizeof( T ) );
+
+		/// Elements per chunk of the block kernels.  The min/max kernels track
+		/// the winning chunk and search only it for the position
+		inline constexpr std::ptrdiff_t simd_chunk_size = 256;
+
+		template<typename T>
+		inline constexpr bool is_simd_value_v =
+		  std::is_arithmetic_v<T> and not std::is_same_v<T, bool>;
+
+		/// Pointers and std::vector iterators over arithmetic values, the
+		/// ranges the block kernels can read through a pointer
+		template<typename Iterator>
+		using iterator_value_detect =
+		  typename std::iterator_traits<Iterator>::value_type;
+
+		template<typename Iterator>
+		constexpr bool is_contiguous_arithmetic_iterator( ) {
+			if constexpr( std::is_pointer_v<Iterator> ) {
+				return is_simd_value_v<
+				  std::remove_cv_t<std::remove_pointer_t<Iterator>>>;
+			} else if constexpr( not daw::is_detected_v<iterator_value_detect,
+			                                            Iterator> ) {
+				return false;
+			} else {
+				using value_t = typename std::iterator_traits<Iterator>::value_type;
+				if constexpr( is_simd_value_v<value_t> ) {
+					return std::is_same_v<Iterator,
+					                      typename std::vector<value_t>::iterator> or
+					       std::is_same_v<
+					         Iterator, typename std::vector<value_t>::const_iterator>;
+				} else {
+					return false;
+				}
+			}
+		}
+
+		template<typename Iterator>
+		inline constexpr bool is_contiguous_arithmetic_iterator_v =
+		  is_contiguous_arithmetic_iterator<Iterator>( );
+
+		template<typename T>
+		constexpr bool simd_is_nan( T value ) {
+			if constexpr( std::is_floating_point_v<T> ) {
+				return value != value;
+			} else {
+				(void)value;
+				return false;
+			}
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		template<typename T>
+		inline constexpr bool sse2_has_eq_v =
+		  ( std::is_integral_v<T> and sizeof( T ) <= 8 ) or
+		  std::is_same_v<T, float> or std::is_same_v<T, double>;
+
+		// Ordering 64 bit integers needs SSE4.2
+		template<typename T>
+		inline constexpr bool sse2_has_lt_v =
+		  ( std::is_integral_v<T> and sizeof( T ) <= 4 ) or
+		  std::is_same_v<T, float> or std::is_same_v<T, double>;
+
+		/// The compares below give a lane of all ones for true, so
+		/// _mm_movemask_epi8 has sizeof( T ) bits per element for any T
+		template<typename T>
+		__m128i sse2_load( T const *ptr ) {
+			return _mm_loadu_si128( reinterpret_cast<__m128i const *>( ptr ) );
+		}
+
+		template<typename T>
+		__m128i sse2_set1( T value ) {
+			if constexpr( std::is_same_v<T, float> ) {
+				return _mm_castps_si128( _mm_set1_ps( value ) );
+			} else if constexpr( std::is_same_v<T, double> ) {
+				return _mm_castpd_si128( _mm_set1_pd( value ) );
+			} else if constexpr( sizeof( T ) == 1 ) {
+				return _mm_set1_epi8( static_cast<char>( value ) );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_set1_epi16( static_cast<short>( value ) );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_set1_epi32( static_cast<int>( value ) );
+			} else {
+				return _mm_set1_epi64x( static_cast<long long>( value ) );
+			}
+		}
+
+		template<typename T>
+		__m128i sse2_eq( __m128i a, __m128i b ) {
+			if constexpr( std::is_same_v<T, float> ) {
+				return _mm_castps_si128(
+				  _mm_cmpeq_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) );
+			} else if constexpr( std::is_same_v<T, double> ) {
+				return _mm_castpd_si128(
+				  _mm_cmpeq_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) );
+			} else if constexpr( sizeof( T ) == 1 ) {
+				return _mm_cmpeq_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_cmpeq_epi16( a, b );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_cmpeq_epi32( a, b );
+			} else {
+				// Both 32 bit halves equal
+				__m128i const eq = _mm_cmpeq_epi32( a, b );
+				return _mm_and_si128(
+				  eq, _mm_shuffle_epi32( eq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			}
+		}
+
+		/// a < b.  Unsigned lanes are compared as signed with the top bit flipped
+		template<typename T>
+		__m128i sse2_lt( __m128i a, __m128i b ) {
+			if constexpr( std::is_same_v<T, float> ) {
+				return _mm_castps_si128(
+				  _mm_cmplt_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) );
+			} else if constexpr( std::is_same_v<T, double> ) {
+				return _mm_castpd_si128(
+				  _mm_cmplt_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) );
+			} else {
+				if constexpr( std::is_unsigned_v<T> ) {
+					__m128i const bias = sse2_set1(
+					  static_cast<T>( std::uint64_t{ 1 } << ( 8U * sizeof( T ) - 1U ) ) );
+					a = _mm_xor_si128( a, bias );
+					b = _mm_xor_si128( b, bias );
+				}
+				if constexpr( sizeof( T ) == 1 ) {
+					return _mm_cmplt_epi8( a, b );
+				} else if constexpr( sizeof( T ) == 2 ) {
+					return _mm_cmplt_epi16( a, b );
+				} else {
+					return _mm_cmplt_epi32( a, b );
+				}
+			}
+		}
+
+		/// a <= b, false when either is NaN like the scalar compare
+		template<typename T>
+		__m128i sse2_le( __m128i a, __m128i b ) {
+			if constexpr( std::is_same_v<T, float> ) {
+				return _mm_castps_si128(
+				  _mm_cmple_ps( _mm_castsi128_ps( a ), _mm_castsi128_ps( b ) ) );
+			} else if constexpr( std::is_same_v<T, double> ) {
+				return _mm_castpd_si128(
+				  _mm_cmple_pd( _mm_castsi128_pd( a ), _mm_castsi128_pd( b ) ) );
+			} else {
+				return _mm_xor_si128( sse2_lt<T>( b, a ), _mm_cmpeq_epi32( a, a ) );
+			}
+		}
+
+		template<typename T>
+		__m128i sse2_is_nan( __m128i x ) {
+			if constexpr( std::is_same_v<T, float> ) {
+				__m128 const f = _mm_castsi128_ps( x );
+				return _mm_castps_si128( _mm_cmpunord_ps( f, f ) );
+			} else if constexpr( std::is_same_v<T, double> ) {
+				__m128d const d = _mm_castsi128_pd( x );
+				return _mm_castpd_si128( _mm_cmpunord_pd( d, d ) );
+			} else {
+				(void)x;
+				return _mm_setzero_si128( );
+			}
+		}
+
+		inline __m128i sse2_select( __m128i mask, __m128i a, __m128i b ) {
+			return _mm_or_si128( _mm_and_si128( mask, a ),
+			                     _mm_andnot_si128( mask, b ) );
+		}
+
+		/// Match lanes are all ones, so subtracting them counts up by one
+		template<typename T>
+		__m128i sse2_count_lanes( __m128i acc, __m128i mask ) {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_sub_epi8( acc, mask );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_sub_epi16( acc, mask );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_sub_epi32( acc, mask );
+			} else {
+				return _mm_sub_epi64( acc, mask );
+			}
+		}
+
+		/// Position of the lowest set bit of a non-zero movemask
+		inline std::ptrdiff_t sse2_lowest_bit( unsigned mask ) {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			return static_cast<std::ptrdiff_t>( __builtin_ctz( mask ) );
+#else
+			std::ptrdiff_t result = 0;
+			while( ( mask & 1U ) == 0 ) {
+				mask >>= 1U;
+				++result;
+			}
+			return result;
+#endif
+		}
+#else
+		template<typename T>
+		inline constexpr bool sse2_has_eq_v = false;
+
+		template<typename T>
+		inline constexpr bool sse2_has_lt_v = false;
+#endif
+
+		/// The predicates the block kernels accept.  With SSE2 each also gives a
+		/// matcher that maps 16 bytes of values to a lane mask
+		template<typename T>
+		struct simd_equal_value {
+			static constexpr bool has_sse2 = sse2_has_eq_v<T>;
+			T value;
+
+			constexpr bool operator( )( T x ) const {
+				return x == value;
+			}
+#if defined( DAW_HAS_SSE2 )
+			auto sse2_matcher( ) const {
+				return [v = sse2_set1( value )]( __m128i x ) {
+					return sse2_eq<T>( x, v );
+				};
+			}
+#endif
+		};
+
+		template<typename T>
+		struct simd_less_value {
+			static constexpr bool has_sse2 = sse2_has_lt_v<T>;
+			T value;
+
+			constexpr bool operator( )( T x ) const {
+				return x < value;
+			}
+#if defined( DAW_HAS_SSE2 )
+			auto sse2_matcher( ) const {
+				return [v = sse2_set1( value )]( __m128i x ) {
+					return sse2_lt<T>( x, v );
+				};
+			}
+#endif
+		};
+
+		template<typename T>
+		struct simd_in_range_value {
+			static constexpr bool has_sse2 = sse2_has_lt_v<T>;
+			T lower;
+			T upper;
+
+			constexpr bool operator( )( T x ) const {
+				return ( lower <= x ) & ( x <= upper );
+			}
+#if defined( DAW_HAS_SSE2 )
+			auto sse2_matcher( ) const {
+				return [lo = sse2_set1( lower ), hi = sse2_set1( upper )]( __m128i x ) {
+					return _mm_and_si128( sse2_le<T>( lo, x ), sse2_le<T>( x, hi ) );
+				};
+			}
+#endif
+		};
+
+#if defined( DAW_HAS_SSE2 )
+		template<typename T, typename Predicate>
+		std::ptrdiff_t sse2_find_if( T const *ptr, std::ptrdiff_t size,
+		                             Predicate const &pred ) {
+			constexpr auto step = static_cast<std::ptrdiff_t>( 16U / sizeof( T ) );
+			auto const match = pred.sse2_matcher( );
+			std::ptrdiff_t pos = 0;
+			// Test four vectors at a time, then find the one holding the match
+			for( ; size - pos >= 4 * step; pos += 4 * step ) {
+				__m128i const m0 = match( sse2_load( ptr + pos ) );
+				__m128i const m1 = match( sse2_load( ptr + pos + step ) );
+				__m128i const m2 = match( sse2_load( ptr + pos + 2 * step ) );
+				__m128i const m3 = match( sse2_load( ptr + pos + 3 * step ) );
+				__m128i const any =
+				  _mm_or_si128( _mm_or_si128( m0, m1 ), _mm_or_si128( m2, m3 ) );
+				if( _mm_movemask_epi8( any ) != 0 ) {
+					break;
+				}
+			}
+			for( ; size - pos >= step; pos += step ) {
+				auto const mask = static_cast<unsigned>(
+				  _mm_movemask_epi8( match( sse2_load( ptr + pos ) ) ) );
+				if( mask != 0 ) {
+					return pos + sse2_lowest_bit( mask ) /
+					               static_cast<std::ptrdiff_t>( sizeof( T ) );
+				}
+			}
+			for( ; pos < size; ++pos ) {
+				if( pred( ptr[pos] ) ) {
+					return pos;
+				}
+			}
+			return size;
+		}
+
+		template<typename T, typename Predicate>
+		std::size_t sse2_count_if( T const *ptr, std::ptrdiff_t size,
+		                           Predicate const &pred ) {
+			constexpr auto step = static_cast<std::ptrdiff_t>( 16U / sizeof( T ) );
+			// Lane counters are summed before a byte lane can wrap
+			constexpr std::ptrdiff_t max_blocks = sizeof( T ) == 1 ? 255 : 4096;
+			using lane_t = std::conditional_t<
+			  sizeof( T ) == 1, std::uint8_t,
+			  std::conditional_t<
+			    sizeof( T ) == 2, std::uint16_t,
+			    std::conditional_t<sizeof( T ) == 4, std::uint32_t, std::uint64_t>>>;
+			auto const match = pred.sse2_matcher( );
+			std::size_t result = 0;
+			std::ptrdiff_t pos = 0;
+			while( size - pos >= step ) {
+				auto const blocks = std::min( ( size - pos ) / step, max_blocks );
+				__m128i acc = _mm_setzero_si128( );
+				for( std::ptrdiff_t b = 0; b < blocks; ++b, pos += step ) {
+					acc = sse2_count_lanes<T>( acc, match( sse2_load( ptr + pos ) ) );
+				}
+				lane_t lanes[step];
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( lanes ), acc );
+				for( auto lane : lanes ) {
+					result += static_cast<std::size_t>( lane );
+				}
+			}
+			for( ; pos < size; ++pos ) {
+				result += static_cast<std::size_t>( pred( ptr[pos] ) );
+			}
+			return result;
+		}
+#endif
+
+		/// Offset of the first element satisfying pred, or size.  Each chunk is
+		/// tested with a branch free or-reduction before it is searched
+		template<typename T, typename Predicate>
+		std::ptrdiff_t simd_find_if( T const *ptr, std::ptrdiff_t size,
+		                             Predicate pred ) {
+#if defined( DAW_HAS_SSE2 )
+			if constexpr( Predicate::has_sse2 ) {
+				return sse2_find_if( ptr, size, pred );
+			}
+#endif
+			std::ptrdiff_t pos = 0;
+			for( ; size - pos >= simd_chunk_size; pos += simd_chunk_size ) {
+				unsigned found = 0;
+				for( std::ptrdiff_t n = 0; n < simd_chunk_size; ++n ) {
+					found |= static_cast<unsigned>( pred( ptr[pos + n] ) );
+				}
+				if( found != 0 ) {
+					break;
+				}
+			}
+			for( ; pos < size; ++pos ) {
+				if( pred( ptr[pos] ) ) {
+					return pos;
+				}
+			}
+			return size;
+		}
+
+		template<typename T, typename Predicate>
+		std::size_t simd_count_if( T const *ptr, std::ptrdiff_t size,
+		                           Predicate pred ) {
+#if defined( DAW_HAS_SSE2 )
+			if constexpr( Predicate::has_sse2 ) {
+				return sse2_count_if( ptr, size, pred );
+			}
+#endif
+			std::size_t result = 0;
+			std::ptrdiff_t pos = 0;
+			for( ; size - pos >= simd_chunk_size; pos += simd_chunk_size ) {
+				std::uint32_t count = 0;
+				for( std::ptrdiff_t n = 0; n < simd_chunk_size; ++n ) {
+					count += static_cast<std::uint32_t>( pred( ptr[pos + n] ) );
+				}
+				result += count;
+			}
+			for( T const *it = ptr + pos; it != ptr + size; ++it ) {
+				result += static_cast<std::size_t>( pred( *it ) );
+			}
+			return result;
+		}
+
+		struct simd_extreme_result {
+			std::ptrdiff_t min_index;
+			std::ptrdiff_t max_index;
+			bool has_nan;
+		};
+
+		/// Minimum and maximum under operator< of the simd_chunk_size values at
+		/// ptr, reduced over independent lanes.  Returns non-zero if any is NaN
+		template<typename T>
+		unsigned simd_chunk_extreme( T const *ptr, T &chunk_min, T &chunk_max ) {
+			constexpr std::ptrdiff_t lanes = simd_lane_count<T>;
+#if defined( DAW_HAS_SSE2 )
+			if constexpr( sse2_has_lt_v<T> ) {
+				constexpr auto step = static_cast<std::ptrdiff_t>( 16U / sizeof( T ) );
+				// Two accumulators each so the compares of one step overlap
+				__m128i vmin0 = sse2_load( ptr );
+				__m128i vmax0 = vmin0;
+				__m128i vmin1 = sse2_load( ptr + step );
+				__m128i vmax1 = vmin1;
+				__m128i nan =
+				  _mm_or_si128( sse2_is_nan<T>( vmin0 ), sse2_is_nan<T>( vmin1 ) );
+				for( std::ptrdiff_t n = 2 * step; n < simd_chunk_size; n += 2 * step ) {
+					__m128i const x0 = sse2_load( ptr + n );
+					__m128i const x1 = sse2_load( ptr + n + step );
+					vmin0 = sse2_select( sse2_lt<T>( x0, vmin0 ), x0, vmin0 );
+					vmax0 = sse2_select( sse2_lt<T>( vmax0, x0 ), x0, vmax0 );
+					vmin1 = sse2_select( sse2_lt<T>( x1, vmin1 ), x1, vmin1 );
+					vmax1 = sse2_select( sse2_lt<T>( vmax1, x1 ), x1, vmax1 );
+					nan = _mm_or_si128(
+					  nan, _mm_or_si128( sse2_is_nan<T>( x0 ), sse2_is_nan<T>( x1 ) ) );
+				}
+				vmin0 = sse2_select( sse2_lt<T>( vmin1, vmin0 ), vmin1, vmin0 );
+				vmax0 = sse2_select( sse2_lt<T>( vmax0, vmax1 ), vmax1, vmax0 );
+				T lane_min[step];
+				T lane_max[step];
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( lane_min ), vmin0 );
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( lane_max ), vmax0 );
+				chunk_min = lane_min[0];
+				chunk_max = lane_max[0];
+				for( std::ptrdiff_t j = 1; j < step; ++j ) {
+					chunk_min = lane_min[j] < chunk_min ? lane_min[j] : chunk_min;
+					chunk_max = chunk_max < lane_max[j] ? lane_max[j] : chunk_max;
+				}
+				return static_cast<unsigned>( _mm_movemask_epi8( nan ) );
+			}
+#endif
+			T lane_min[lanes];
+			T lane_max[lanes];
+			unsigned lane_nan[lanes];
+			for( std::ptrdiff_t j = 0; j < lanes; ++j ) {
+				lane_min[j] = ptr[0];
+				lane_max[j] = ptr[0];
+				lane_nan[j] = 0;
+			}
+			for( std::ptrdiff_t n = 0; n < simd_chunk_size; n += lanes ) {
+				for( std::ptrdiff_t j = 0; j < lanes; ++j ) {
+					T const x = ptr[n + j];
+					lane_min[j] = x < lane_min[j] ? x : lane_min[j];
+					lane_max[j] = lane_max[j] < x ? x : lane_max[j];
+					lane_nan[j] |= static_cast<unsigned>( simd_is_nan( x ) );
+				}
+			}
+			unsigned nan = 0;
+			for( std::ptrdiff_t j = 0; j < lanes; ++j ) {
+				chunk_min = lane_min[j] < chunk_min ? lane_min[j] : chunk_min;
+				chunk_max = chunk_max < lane_max[j] ? lane_max[j] : chunk_max;
+				nan |= lane_nan[j];
+			}
+			return nan;
+		}
+
+		/// Positions of the first minimum and of the first, or with LastMax the
+		/// last, maximum of a non-empty range under operator<.  Each chunk is
+		/// reduced over independent lanes, only the chunk holding the winner is
+		/// searched for its position.  A NaN anywhere sets has_nan, as the
+		/// generic algorithms give NaN order dependent meaning
+		template<bool LastMax, typename T>
+		simd_extreme_result simd_extreme( T const *ptr, std::ptrdiff_t size ) {
+			T run_min = ptr[0];
+			T run_max = ptr[0];
+			std::ptrdiff_t min_chunk = -1;
+			std::ptrdiff_t max_chunk = -1;
+			for( std::ptrdiff_t pos = 0; pos < size; pos += simd_chunk_size ) {
+				T chunk_min = ptr[pos];
+				T chunk_max = ptr[pos];
+				unsigned nan = 0;
+				if( size - pos >= simd_chunk_size ) {
+					nan = simd_chunk_extreme( ptr + pos, chunk_min, chunk_max );
+				} else {
+					for( std::ptrdiff_t n = pos; n < size; ++n ) {
+						T const x = ptr[n];
+						chunk_min = x < chunk_min ? x : chunk_min;
+						chunk_max = chunk_max < x ? x : chunk_max;
+						nan |= static_cast<unsigned>( simd_is_nan( x ) );
+					}
+				}
+				if( nan != 0 ) {
+					return simd_extreme_result{ 0, 0, true };
+				}
+				if( chunk_min < run_min ) {
+					run_min = chunk_min;
+					min_chunk = pos;
+				}
+				if( LastMax ? not( chunk_max < run_max ) : run_max < chunk_max ) {
+					run_max = chunk_max;
+					max_chunk = pos;
+				}
+			}
+			simd_extreme_result result{ 0, 0, false };
+			if( min_chunk >= 0 ) {
+				result.min_index = min_chunk;
+				while( not( ptr[result.min_index] == run_min ) ) {
+					++result.min_index;
+				}
+			}
+			if( max_chunk >= 0 ) {
+				if constexpr( LastMax ) {
+					result.max_index =
+					  std::min( max_chunk + simd_chunk_size, size ) - 1;
+					while( not( ptr[result.max_index] == run_max ) ) {
+						--result.max_index;
+					}
+				} else {
+					result.max_index = max_chunk;
+					while( not( ptr[result.max_index] == run_max ) ) {
+						++result.max_index;
+					}
+				}
+			}
+			return result;
+		}
+
+		template<typename Compare, typename T>
+		inline constexpr bool is_simd_less_v =
+		  std::is_same_v<Compare, std::less<>> or
+		  std::is_same_v<Compare, std::less<T>>;
+	} // namespace algorithm_details
+
 	template<typename Lhs>
 	constexpr auto const &min_item( Lhs const &lhs ) noexcept {
 		return lhs;
@@ -287,9 +852,27 @@ namespace daw::algorithm {
 		return first;
 	}
 
+	/// @brief Find the first element equal to value.  Contiguous arithmetic
+	/// ranges searched for a value of the same type use a block kernel at
+	/// runtime
 	template<class InputIterator, class T>
 	constexpr InputIterator find( InputIterator first, InputIterator last,
 	                              T const &value ) {
+#if defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if constexpr( algorithm_details::is_contiguous_arithmetic_iterator_v<
+		                InputIterator> ) {
+			using value_t =
+			  typename std::iterator_traits<InputIterator>::value_type;
+			if constexpr( std::is_same_v<value_t, T> ) {
+				if( not DAW_IS_CONSTANT_EVALUATED( ) and first != last ) {
+					using pred_t = algorithm_details::simd_equal_value<value_t>;
+					return first + algorithm_details::simd_find_if(
+					                 std::addressof( *first ), last - first,
+					                 pred_t{ value } );
+				}
+			}
+		}
+#endif
 		for( ; first != last; ++first ) {
 			if( *first == value ) {
 				return first;
@@ -818,6 +1401,14 @@ namespace daw::algorithm {
 			constexpr bool operator( )( T &&value ) const {
 				return m_lower <= value and std::forward<T>( value ) <= m_upper;
 			}
+
+			constexpr std::remove_reference_t<Lower> const &lower( ) const {
+				return m_lower;
+			}
+
+			constexpr std::remove_reference_t<Upper> const &upper( ) const {
+				return m_upper;
+			}
 		}; // in_range
 
 		template<typename Value>
@@ -834,6 +1425,10 @@ namespace daw::algorithm {
 			constexpr bool operator( )( T &&value ) const {
 				return std::forward<T>( value ) == m_value;
 			}
+
+			constexpr std::remove_reference_t<Value> const &value( ) const {
+				return m_value;
+			}
 		}; // equal_to
 
 		template<typename Value>
@@ -850,6 +1445,10 @@ namespace daw::algorithm {
 			constexpr bool operator( )( T &&value ) const {
 				return std::forward<T>( value ) < m_value;
 			}
+
+			constexpr std::remove_reference_t<Value> const &value( ) const {
+				return m_value;
+			}
 		}; // less_than
 
 		template<typename Value>
@@ -1500,33 +2099,311 @@ namespace daw::algorithm {
 		return first;
 	}
 
+	namespace algorithm_details {
+		// Ranges at or below this size are finished with an insertion sort
+		inline constexpr std::ptrdiff_t select_insertion_limit = 16;
+		// Ranges above this size choose their pivot with Floyd-Rivest sampling
+		inline constexpr std::ptrdiff_t select_sample_limit = 600;
+
+		constexpr std::ptrdiff_t select_log2( std::ptrdiff_t n ) noexcept {
+			std::ptrdiff_t result = 0;
+			while( n > 1 ) {
+				n /= 2;
+				++result;
+			}
+			return result;
+		}
+
+		constexpr std::uint64_t select_isqrt( std::uint64_t n ) noexcept {
+			if( n < 2 ) {
+				return n;
+			}
+			std::uint64_t x = n;
+			std::uint64_t y = x / 2 + 1;
+			while( y < x ) {
+				x = y;
+				y = ( x + n / x ) / 2;
+			}
+			return x;
+		}
+
+		constexpr std::uint64_t select_icbrt( std::uint64_t n ) noexcept {
+			std::uint64_t lo = 0;
+			std::uint64_t hi = n < ( 1ULL << 21U ) ? n : ( 1ULL << 21U );
+			while( lo < hi ) {
+				std::uint64_t const mid = ( lo + hi + 1 ) / 2;
+				if( mid * mid * mid <= n ) {
+					lo = mid;
+				} else {
+					hi = mid - 1;
+				}
+			}
+			return lo;
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void select_insertion_sort( RandomIterator first,
+		                                      RandomIterator last,
+		                                      Compare &comp ) {
+			if( not( first != last ) ) {
+				return;
+			}
+			for( auto it = daw::next( first ); it != last; ++it ) {
+				for( auto j = it; j != first and comp( *j, *daw::prev( j ) ); --j ) {
+					daw::iter_swap( j, daw::prev( j ) );
+				}
+			}
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr RandomIterator median_of_3( RandomIterator a, RandomIterator b,
+		                                      RandomIterator c, Compare &comp ) {
+			if( comp( *a, *b ) ) {
+				if( comp( *b, *c ) ) {
+					return b;
+				}
+				return comp( *a, *c ) ? c : a;
+			}
+			if( comp( *a, *c ) ) {
+				return a;
+			}
+			return comp( *b, *c ) ? c : b;
+		}
+
+		/// Partition [first, last) around *pivot and return the pivot's final
+		/// position.  Elements equal to the pivot stop both scans so runs of
+		/// duplicates split evenly
+		template<typename RandomIterator, typename Compare>
+		constexpr RandomIterator select_partition( RandomIterator first,
+		                                           RandomIterator last,
+		                                           RandomIterator pivot,
+		                                           Compare &comp ) {
+			daw::iter_swap( first, pivot );
+			auto i = daw::next( first );
+			auto j = daw::prev( last );
+			while( true ) {
+				while( i <= j and comp( *i, *first ) ) {
+					++i;
+				}
+				while( i <= j and comp( *first, *j ) ) {
+					--j;
+				}
+				if( i >= j ) {
+					break;
+				}
+				daw::iter_swap( i, j );
+				++i;
+				--j;
+			}
+			daw::iter_swap( first, j );
+			return j;
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void select_impl( RandomIterator first, RandomIterator nth,
+		                            RandomIterator last, Compare &comp,
+		                            std::ptrdiff_t budget );
+
+		/// Median of medians of groups of five.  Only used once the pivot budget
+		/// is exhausted, it guarantees a linear bound on adversarial input
+		template<typename RandomIterator, typename Compare>
+		constexpr RandomIterator median_of_medians( RandomIterator first,
+		                                            RandomIterator last,
+		                                            Compare &comp ) {
+			auto const groups = ( last - first ) / 5;
+			for( std::ptrdiff_t g = 0; g < groups; ++g ) {
+				auto const group = first + g * 5;
+				select_insertion_sort( group, group + 5, comp );
+				daw::iter_swap( first + g, group + 2 );
+			}
+			auto const mid = first + groups / 2;
+			select_impl( first, mid, first + groups, comp,
+			             2 * select_log2( groups ) );
+			return mid;
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void select_impl( RandomIterator first, RandomIterator nth,
+		                            RandomIterator last, Compare &comp,
+		                            std::ptrdiff_t budget ) {
+			while( last - first > select_insertion_limit ) {
+				std::ptrdiff_t const n = last - first;
+				RandomIterator pivot = first;
+				if( budget <= 0 ) {
+					pivot = median_of_medians( first, last, comp );
+				} else if( n > select_sample_limit ) {
+					--budget;
+					// Floyd-Rivest: recursively select nth within a window around it
+					// sized ~n^(2/3) so that *nth becomes a pivot very close to the
+					// final value
+					std::ptrdiff_t const k = nth - first;
+					auto const un = static_cast<std::uint64_t>( n );
+					auto const cr = select_icbrt( un );
+					auto const sample = static_cast<std::ptrdiff_t>( cr * cr / 2 );
+					std::ptrdiff_t const z = ( select_log2( n ) * 11 ) / 16;
+					auto const var = static_cast<double>( z ) *
+					                 static_cast<double>( sample ) *
+					                 static_cast<double>( n - sample ) /
+					                 static_cast<double>( n );
+					auto sd = static_cast<std::ptrdiff_t>(
+					  select_isqrt( static_cast<std::uint64_t>( var ) ) / 2 );
+					if( k + 1 < n / 2 ) {
+						sd = -sd;
+					}
+					std::ptrdiff_t lo = k - ( k + 1 ) * sample / n + sd;
+					std::ptrdiff_t hi = k + ( n - k - 1 ) * sample / n + sd;
+					lo = lo < 0 ? 0 : ( lo > k ? k : lo );
+					hi = hi >= n ? n - 1 : ( hi < k ? k : hi );
+					select_impl( first + lo, nth, first + hi + 1, comp, budget );
+					pivot = nth;
+				} else {
+					--budget;
+					pivot =
+					  median_of_3( first, first + n / 2, daw::prev( last ), comp );
+				}
+				auto const mid = select_partition( first, last, pivot, comp );
+				if( mid == nth ) {
+					return;
+				}
+				if( nth < mid ) {
+					last = mid;
+				} else {
+					first = daw::next( mid );
+				}
+			}
+			select_insertion_sort( first, last, comp );
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void sift_down( RandomIterator first, std::ptrdiff_t len,
+		                          std::ptrdiff_t idx, Compare &comp ) {
+			while( true ) {
+				std::ptrdiff_t child = 2 * idx + 1;
+				if( child >= len ) {
+					return;
+				}
+				if( child + 1 < len and comp( first[child], first[child + 1] ) ) {
+					++child;
+				}
+				if( not comp( first[idx], first[child] ) ) {
+					return;
+				}
+				daw::iter_swap( first + idx, first + child );
+				idx = child;
+			}
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void make_heap( RandomIterator first, std::ptrdiff_t len,
+		                          Compare &comp ) {
+			for( std::ptrdiff_t idx = len / 2; idx-- > 0; ) {
+				sift_down( first, len, idx, comp );
+			}
+		}
+
+		template<typename RandomIterator, typename Compare>
+		constexpr void sort_heap( RandomIterator first, std::ptrdiff_t len,
+		                          Compare &comp ) {
+			while( len > 1 ) {
+				--len;
+				daw::iter_swap( first, first + len );
+				sift_down( first, len, 0, comp );
+			}
+		}
+	} // namespace algorithm_details
+
+	/// @brief Rearranges [first, last) so that *nth is the element that would
+	/// be there if the range was sorted, everything before it is not greater
+	/// and everything after it is not less.  Introselect with Floyd-Rivest
+	/// pivot sampling for large ranges and a median of medians fallback so
+	/// that the worst case stays linear
+	/// @param first first item in range
+	/// @param nth position to select for
+	/// @param last end of range
+	/// @param comp comparision function object
 	template<typename RandomIterator, typename Compare = std::less<>>
-	constexpr void nth_element(
-	  RandomIterator first, RandomIterator nth, RandomIterator const last,
-	  Compare comp = Compare{ } ) noexcept( noexcept( comp( *first, *nth ) )
-	                                          &&noexcept( daw::cswap( *first,
-	                                                                  *nth ) ) ) {
+	constexpr void nth_element( RandomIterator first, RandomIterator nth,
+	                            RandomIterator const last,
+	                            Compare comp = Compare{ } ) {
 
 		traits::is_random_access_iterator_test<RandomIterator>( );
 		traits::is_inout_iterator_test<RandomIterator>( );
 
 		traits::is_compare_test<Compare, decltype( *first ), decltype( *nth )>( );
 
-		if( not( first != last ) ) {
+		if( not( first != last ) or not( nth != last ) ) {
 			return;
 		}
-		while( first != nth ) {
-			auto min_idx = first;
-			auto j = daw::next( first );
-			while( j != last ) {
-				if( daw::invoke( comp, *j, *min_idx ) ) {
-					min_idx = j;
-					daw::cswap( *first, *min_idx );
-				}
-				++j;
+		algorithm_details::select_impl(
+		  first, nth, last, comp,
+		  2 * algorithm_details::select_log2( last - first ) );
+	}
+
+	/// @brief Rearranges [first, last) so that [first, middle) holds the
+	/// smallest middle - first elements in sorted order.  Selection followed by
+	/// a heap sort of the prefix, O(n + k log k)
+	/// @param first first item in range
+	/// @param middle end of the sorted prefix
+	/// @param last end of range
+	/// @param comp comparision function object
+	template<typename RandomIterator, typename Compare = std::less<>>
+	constexpr void partial_sort( RandomIterator first, RandomIterator middle,
+	                             RandomIterator const last,
+	                             Compare comp = Compare{ } ) {
+
+		traits::is_random_access_iterator_test<RandomIterator>( );
+		traits::is_inout_iterator_test<RandomIterator>( );
+
+		if( not( first != middle ) ) {
+			return;
+		}
+		if( middle != last ) {
+			daw::algorithm::nth_element( first, middle, last, comp );
+		}
+		auto const len = middle - first;
+		algorithm_details::make_heap( first, len, comp );
+		algorithm_details::sort_heap( first, len, comp );
+	}
+
+	/// @brief Copies the smallest min( last - first, d_last - d_first )
+	/// elements of [first, last) into [d_first, d_last) in sorted order.  The
+	/// input is read once, keeping the current best in a bounded max heap
+	/// @param first first item in input range
+	/// @param last end of input range
+	/// @param d_first first item in output range
+	/// @param d_last end of output range
+	/// @param comp comparision function object
+	/// @return end of the written output
+	template<typename InputIterator, typename LastType, typename RandomIterator,
+	         typename Compare = std::less<>>
+	constexpr RandomIterator
+	partial_sort_copy( InputIterator first, LastType const last,
+	                   RandomIterator d_first, RandomIterator const d_last,
+	                   Compare comp = Compare{ } ) {
+
+		traits::is_input_iterator_test<InputIterator>( );
+		traits::is_random_access_iterator_test<RandomIterator>( );
+
+		auto d_end = d_first;
+		while( first != last and d_end != d_last ) {
+			*d_end = *first;
+			++d_end;
+			++first;
+		}
+		auto const len = d_end - d_first;
+		if( len == 0 ) {
+			return d_first;
+		}
+		algorithm_details::make_heap( d_first, len, comp );
+		while( first != last ) {
+			if( comp( *first, *d_first ) ) {
+				*d_first = *first;
+				algorithm_details::sift_down( d_first, len, 0, comp );
 			}
 			++first;
 		}
+		algorithm_details::sort_heap( d_first, len, comp );
+		return d_end;
 	}
 
 	/// @brief Examines the range [first, last) and finds the largest range
@@ -1662,7 +2539,9 @@ namespace daw::algorithm {
 	}
 
 	template<typename T, typename RandomIterator, typename RandomIteratorLast,
-	         typename BinaryOperation>
+	         typename BinaryOperation,
+	         daw::enable_when_t<not execution::is_execution_policy_v<
+	           daw::remove_cvref_t<RandomIterator>>> = nullptr>
 	constexpr T reduce(
 	  RandomIterator first, RandomIteratorLast last, T init,
 	  BinaryOperation
@@ -1799,7 +2678,8 @@ namespace daw::algorithm {
 	template<typename InputIterator, typename LastType, typename T,
 	         typename BinaryOperation = std::plus<>,
 	         daw::enable_when_t<
-	           not daw::traits::is_container_like_v<InputIterator>> = nullptr>
+	           not daw::traits::is_container_like_v<InputIterator> and
+	           not execution::is_execution_policy_v<InputIterator>> = nullptr>
 	constexpr T accumulate(
 	  InputIterator first, LastType last, T init,
 	  BinaryOperation binary_op =
@@ -1821,21 +2701,305 @@ static_assert(
 		return daw::move( init );
 	}
 
-	template<class ForwardIterator, typename Compare = std::less<>>
-	constexpr ForwardIterator max_element( ForwardIterator first,
-	                                       ForwardIterator last,
-	                                       Compare &&comp = Compare{ } ) {
-		if( first == last ) {
-			return last;
-		}
-		auto largest = first;
-		++first;
-		while( first != last ) {
-			if( daw::invoke( comp, *largest, *first ) ) {
-				largest = first;
+	namespace algorithm_details {
+		/// Elements per block for the execution policy overloads.  Blocks, not
+		/// threads, are the unit of work so results do not depend on the number
+		/// of threads
+		inline constexpr std::ptrdiff_t policy_block_size = 1 << 14;
+
+		/// Independent accumulators per block for the unsequenced policies
+		inline constexpr std::ptrdiff_t policy_lane_count = 8;
+
+		template<typename Policy>
+		inline constexpr bool is_unsequenced_policy_v =
+		  std::is_same_v<Policy, execution::unsequenced_policy> or
+		  std::is_same_v<Policy, execution::parallel_unsequenced_policy>;
+
+		/// Calls func( block ) for every block in [0, block_count).  The
+		/// parallel policies are specialized in parallel/daw_parallel_algorithm.h
+		template<typename Policy>
+		struct block_executor;
+
+		struct serial_block_executor {
+			template<typename Func>
+			static void run( std::size_t block_count, Func &func ) {
+				for( std::size_t block = 0; block < block_count; ++block ) {
+					func( block );
+				}
 			}
-			++first;
-		}
+		};
+
+		template<>
+		struct block_executor<execution::sequenced_policy>
+		  : serial_block_executor {};
+
+		template<>
+		struct block_executor<execution::unsequenced_policy>
+		  : serial_block_executor {};
+
+		/// Pairwise combine values[0, count) in place, always in the same order
+		template<typename T, typename Reduce>
+		T tree_combine( T *values, std::size_t count, Reduce &reduce ) {
+			while( count > 1 ) {
+				std::size_t const half = count / 2;
+				for( std::size_t n = 0; n < half; ++n ) {
+					values[n] = daw::invoke( reduce, daw::move( values[2 * n] ),
+					                         daw::move( values[2 * n + 1] ) );
+				}
+				if( count % 2 != 0 ) {
+					values[half] = daw::move( values[count - 1] );
+				}
+				count -= half;
+			}
+			return daw::move( values[0] );
+		}
+
+		/// Reduce get( first ) ... get( last - 1 ), a non-empty range.  With
+		/// Lanes, arithmetic values are split into policy_lane_count contiguous
+		/// runs with one accumulator each, which breaks the dependency chain so
+		/// the loop vectorizes.  The runs are combined in order, so reduce only
+		/// needs to be associative
+		template<bool Lanes, typename T, typename Get, typename Reduce>
+		T reduce_block( std::ptrdiff_t first, std::ptrdiff_t last, Get &get,
+		                Reduce &reduce ) {
+			constexpr std::ptrdiff_t lanes = policy_lane_count;
+			if constexpr( Lanes and std::is_arithmetic_v<T> ) {
+				if( last - first >= 2 * lanes ) {
+					std::ptrdiff_t const run = ( last - first ) / lanes;
+					T acc[lanes];
+					for( std::ptrdiff_t j = 0; j < lanes; ++j ) {
+						acc[j] = static_cast<T>( get( first + j * run ) );
+					}
+					for( std::ptrdiff_t idx = 1; idx < run; ++idx ) {
+						for( std::ptrdiff_t j = 0; j < lanes; ++j ) {
+							acc[j] =
+							  daw::invoke( reduce, acc[j], get( first + j * run + idx ) );
+						}
+					}
+					// The remainder follows the last run
+					for( std::ptrdiff_t idx = first + lanes * run; idx < last; ++idx ) {
+						acc[lanes - 1] = daw::invoke( reduce, acc[lanes - 1], get( idx ) );
+					}
+					return tree_combine( acc, static_cast<std::size_t>( lanes ),
+					                     reduce );
+				}
+			}
+			T result = static_cast<T>( get( first ) );
+			for( ++first; first < last; ++first ) {
+				result = daw::invoke( reduce, daw::move( result ), get( first ) );
+			}
+			return result;
+		}
+
+		/// Reduce each fixed size block, then combine the block results in a
+		/// fixed tree and finally with init.  The grouping only depends on size
+		/// and whether the policy is unsequenced, so floating point results are
+		/// the same from run to run and for any thread count
+		template<typename Policy, typename T, typename Get, typename Reduce>
+		T blocked_reduce( std::ptrdiff_t size, T init, Get get, Reduce &reduce ) {
+			if( size <= 0 ) {
+				return init;
+			}
+			auto const block_count = static_cast<std::size_t>(
+			  ( size + policy_block_size - 1 ) / policy_block_size );
+			std::vector<T> partials( block_count, init );
+			auto reduce_one = [&]( std::size_t block ) {
+				auto const first =
+				  static_cast<std::ptrdiff_t>( block ) * policy_block_size;
+				auto const last = std::min( first + policy_block_size, size );
+				partials[block] =
+				  reduce_block<is_unsequenced_policy_v<Policy>, T>( first, last, get,
+				                                                    reduce );
+			};
+			block_executor<Policy>::run( block_count, reduce_one );
+			return daw::invoke(
+			  reduce, daw::move( init ),
+			  tree_combine( partials.data( ), block_count, reduce ) );
+		}
+
+		/// Call func( first, last ) for each block of [0, size)
+		template<typename Policy, typename Func>
+		void blocked_for_each( std::ptrdiff_t size, Func func ) {
+			if( size <= 0 ) {
+				return;
+			}
+			auto const block_count = static_cast<std::size_t>(
+			  ( size + policy_block_size - 1 ) / policy_block_size );
+			auto run_one = [&]( std::size_t block ) {
+				auto const first =
+				  static_cast<std::ptrdiff_t>( block ) * policy_block_size;
+				func( first, std::min( first + policy_block_size, size ) );
+			};
+			block_executor<Policy>::run( block_count, run_one );
+		}
+
+		template<typename ExecutionPolicy>
+		using policy_enable_t = std::enable_if_t<
+		  execution::is_execution_policy_v<daw::remove_cvref_t<ExecutionPolicy>>,
+		  std::nullptr_t>;
+	} // namespace algorithm_details
+
+	/// @brief Reduce [first, last) with binary_op using an execution policy.
+	/// binary_op must be associative, the grouping is a fixed tree of blocks
+	/// so the result is reproducible for a given policy and size
+	/// @param policy one of execution::seq, unseq, par or par_unseq
+	/// @param first start of range
+	/// @param last end of range
+	/// @param init initial value, combined once with the reduced range
+	/// @param binary_op associative reduction
+	/// @return init combined with the reduction of the range
+	template<typename ExecutionPolicy, typename RandomIterator, typename T,
+	         typename BinaryOperation = std::plus<>,
+	         algorithm_details::policy_enable_t<ExecutionPolicy> = nullptr>
+	T reduce( ExecutionPolicy &&, RandomIterator first, RandomIterator last,
+	          T init, BinaryOperation binary_op = BinaryOperation{ } ) {
+		traits::is_random_access_iterator_test<RandomIterator>( );
+		using policy_t = daw::remove_cvref_t<ExecutionPolicy>;
+		return algorithm_details::blocked_reduce<policy_t>(
+		  last - first, daw::move( init ),
+		  [first]( std::ptrdiff_t idx ) -> decltype( auto ) {
+			  return first[idx];
+		  },
+		  binary_op );
+	}
+
+	/// @brief Map each pair of [first1, last1) and [first2, ...) with map_func
+	/// and reduce the results with reduce_func using an execution policy.
+	/// reduce_func must be associative
+	template<typename ExecutionPolicy, typename RandomIterator1,
+	         typename RandomIterator2, typename T, typename ReduceFunction,
+	         typename MapFunction,
+	         algorithm_details::policy_enable_t<ExecutionPolicy> = nullptr>
+	T map_reduce( ExecutionPolicy &&, RandomIterator1 first1,
+	              RandomIterator1 last1, RandomIterator2 first2, T init,
+	              ReduceFunction reduce_func, MapFunction map_func ) {
+		traits::is_random_access_iterator_test<RandomIterator1>( );
+		traits::is_random_access_iterator_test<RandomIterator2>( );
+		using policy_t = daw::remove_cvref_t<ExecutionPolicy>;
+		return algorithm_details::blocked_reduce<policy_t>(
+		  last1 - first1, daw::move( init ),
+		  [&]( std::ptrdiff_t idx ) {
+			  return daw::invoke( map_func, first1[idx], first2[idx] );
+		  },
+		  reduce_func );
+	}
+
+	/// @brief Accumulate with an execution policy.  Unlike the serial
+	/// accumulate the order is not a left fold, binary_op must be associative
+	template<typename ExecutionPolicy, typename RandomIterator, typename T,
+	         typename BinaryOperation = std::plus<>,
+	         algorithm_details::policy_enable_t<ExecutionPolicy> = nullptr>
+	T accumulate( ExecutionPolicy &&policy, RandomIterator first,
+	              RandomIterator last, T init,
+	              BinaryOperation binary_op = BinaryOperation{ } ) {
+		return daw::algorithm::reduce( policy, first, last, daw::move( init ),
+		                               binary_op );
+	}
+
+	/// @brief Transform [first, last) to [first_out, ...) with an execution
+	/// policy.  The ranges must not overlap
+	/// @return end of output range
+	template<typename ExecutionPolicy, typename RandomIterator,
+	         typename RandomOutputIterator, typename UnaryOperation,
+	         algorithm_details::policy_enable_t<ExecutionPolicy> = nullptr>
+	RandomOutputIterator transform( ExecutionPolicy &&, RandomIterator first,
+	                                RandomIterator last,
+	                                RandomOutputIterator first_out,
+	                                UnaryOperation unary_op ) {
+		traits::is_random_access_iterator_test<RandomIterator>( );
+		traits::is_random_access_iterator_test<RandomOutputIterator>( );
+		using policy_t = daw::remove_cvref_t<ExecutionPolicy>;
+		auto const size = last - first;
+		algorithm_details::blocked_for_each<policy_t>(
+		  size, [&]( std::ptrdiff_t block_first, std::ptrdiff_t block_last ) {
+			  auto const in = first + block_first;
+			  auto const out = first_out + block_first;
+			  std::ptrdiff_t const count = block_last - block_first;
+			  for( std::ptrdiff_t n = 0; n < count; ++n ) {
+				  out[n] = daw::invoke( unary_op, in[n] );
+			  }
+		  } );
+		return first_out + size;
+	}
+
+	namespace algorithm_details {
+		/// Run the block min/max kernel when ForwardIterator is contiguous
+		/// arithmetic, Compare is std::less and this is not a constant
+		/// evaluation.  Returns false when the generic loop must run instead
+		template<bool LastMax, typename ForwardIterator, typename Compare>
+		constexpr bool try_simd_extreme( ForwardIterator first,
+		                                 ForwardIterator last,
+		                                 simd_extreme_result &result ) {
+#if defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+			if constexpr( is_contiguous_arithmetic_iterator_v<ForwardIterator> ) {
+				using value_t =
+				  typename std::iterator_traits<ForwardIterator>::value_type;
+				if constexpr( is_simd_less_v<Compare, value_t> ) {
+					if( DAW_IS_CONSTANT_EVALUATED( ) ) {
+						return false;
+					}
+					result =
+					  simd_extreme<LastMax>( std::addressof( *first ), last - first );
+					return not result.has_nan;
+				}
+			}
+#endif
+			(void)first;
+			(void)last;
+			(void)result;
+			return false;
+		}
+	} // namespace algorithm_details
+
+	/// @brief Find the first smallest element.  Contiguous arithmetic ranges
+	/// with std::less use a block kernel at runtime
+	template<class ForwardIterator, typename Compare = std::less<>>
+	constexpr ForwardIterator min_element( ForwardIterator first,
+	                                       ForwardIterator last,
+	                                       Compare &&comp = Compare{ } ) {
+		if( first == last ) {
+			return last;
+		}
+		algorithm_details::simd_extreme_result simd_result{ };
+		if( algorithm_details::try_simd_extreme<false, ForwardIterator,
+		                                        daw::remove_cvref_t<Compare>>(
+		      first, last, simd_result ) ) {
+			return first + simd_result.min_index;
+		}
+		auto smallest = first;
+		++first;
+		while( first != last ) {
+			if( daw::invoke( comp, *first, *smallest ) ) {
+				smallest = first;
+			}
+			++first;
+		}
+		return smallest;
+	}
+
+	/// @brief Find the first largest element.  Contiguous arithmetic ranges
+	/// with std::less use a block kernel at runtime
+	template<class ForwardIterator, typename Compare = std::less<>>
+	constexpr ForwardIterator max_element( ForwardIterator first,
+	                                       ForwardIterator last,
+	                                       Compare &&comp = Compare{ } ) {
+		if( first == last ) {
+			return last;
+		}
+		algorithm_details::simd_extreme_result simd_result{ };
+		if( algorithm_details::try_simd_extreme<false, ForwardIterator,
+		                                        daw::remove_cvref_t<Compare>>(
+		      first, last, simd_result ) ) {
+			return first + simd_result.max_index;
+		}
+		auto largest = first;
+		++first;
+		while( first != last ) {
+			if( daw::invoke( comp, *largest, *first ) ) {
+				largest = first;
+			}
+			++first;
+		}
 		return largest;
 	}
 
@@ -1878,6 +3042,15 @@ static_assert(
 		if( not( first != last ) ) {
 			return result;
 		}
+		if constexpr( std::is_same_v<ForwardIterator, LastType> ) {
+			algorithm_details::simd_extreme_result simd_result{ };
+			if( algorithm_details::try_simd_extreme<true, ForwardIterator, Compare>(
+			      first, last, simd_result ) ) {
+				result.min_element = first + simd_result.min_index;
+				result.max_element = first + simd_result.max_index;
+				return result;
+			}
+		}
 		++first;
 		if( not( first != last ) ) {
 			return result;
@@ -1944,6 +3117,529 @@ static_assert(
 		return d_first;
 	}
 
+	namespace algorithm_details {
+		template<typename OutputIterator>
+		struct set_output_sink {
+			OutputIterator out;
+
+			template<typename T>
+			constexpr void operator( )( T &&value ) {
+				*out = std::forward<T>( value );
+				++out;
+			}
+		};
+
+		struct set_count_sink {
+			std::size_t count = 0;
+
+			template<typename T>
+			constexpr void operator( )( T const & ) noexcept {
+				++count;
+			}
+		};
+
+		template<typename InputIterator1, typename LastType1,
+		         typename InputIterator2, typename LastType2, typename Sink,
+		         typename Compare>
+		constexpr void set_union_impl( InputIterator1 first1, LastType1 last1,
+		                               InputIterator2 first2, LastType2 last2,
+		                               Sink &sink, Compare &comp ) {
+			while( first1 != last1 and first2 != last2 ) {
+				if( daw::invoke( comp, *first1, *first2 ) ) {
+					sink( *first1 );
+					++first1;
+				} else if( daw::invoke( comp, *first2, *first1 ) ) {
+					sink( *first2 );
+					++first2;
+				} else {
+					sink( *first1 );
+					++first1;
+					++first2;
+				}
+			}
+			for( ; first1 != last1; ++first1 ) {
+				sink( *first1 );
+			}
+			for( ; first2 != last2; ++first2 ) {
+				sink( *first2 );
+			}
+		}
+
+		template<typename InputIterator1, typename LastType1,
+		         typename InputIterator2, typename LastType2, typename Sink,
+		         typename Compare>
+		constexpr void set_difference_impl( InputIterator1 first1,
+		                                    LastType1 last1,
+		                                    InputIterator2 first2,
+		                                    LastType2 last2, Sink &sink,
+		                                    Compare &comp ) {
+			while( first1 != last1 and first2 != last2 ) {
+				if( daw::invoke( comp, *first1, *first2 ) ) {
+					sink( *first1 );
+					++first1;
+				} else {
+					if( not daw::invoke( comp, *first2, *first1 ) ) {
+						++first1;
+					}
+					++first2;
+				}
+			}
+			for( ; first1 != last1; ++first1 ) {
+				sink( *first1 );
+			}
+		}
+
+		/// Exponential then binary search for the first position in
+		/// [first, last) not less than value
+		template<typename RandomIterator, typename T, typename Compare>
+		constexpr RandomIterator gallop_lower_bound( RandomIterator first,
+		                                             RandomIterator last,
+		                                             T const &value,
+		                                             Compare &comp ) {
+			std::ptrdiff_t const size = last - first;
+			std::ptrdiff_t step = 1;
+			std::ptrdiff_t lo = 0;
+			while( step < size and daw::invoke( comp, first[step], value ) ) {
+				lo = step;
+				step *= 2;
+			}
+			std::ptrdiff_t hi = step < size ? step + 1 : size;
+			while( lo < hi ) {
+				std::ptrdiff_t const mid = lo + ( hi - lo ) / 2;
+				if( daw::invoke( comp, first[mid], value ) ) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return first + lo;
+		}
+
+		template<typename RandomIterator1, typename RandomIterator2,
+		         typename Sink, typename Compare>
+		constexpr void set_intersection_gallop_impl( RandomIterator1 first1,
+		                                             RandomIterator1 last1,
+		                                             RandomIterator2 first2,
+		                                             RandomIterator2 last2,
+		                                             Sink &sink,
+		                                             Compare &comp ) {
+			while( first1 != last1 and first2 != last2 ) {
+				first2 = gallop_lower_bound( first2, last2, *first1, comp );
+				if( first2 == last2 ) {
+					return;
+				}
+				if( not daw::invoke( comp, *first1, *first2 ) ) {
+					sink( *first1 );
+					++first2;
+				}
+				++first1;
+			}
+		}
+
+		template<typename InputIterator1, typename LastType1,
+		         typename InputIterator2, typename LastType2, typename Sink,
+		         typename Compare>
+		constexpr void set_intersection_merge_impl( InputIterator1 first1,
+		                                            LastType1 last1,
+		                                            InputIterator2 first2,
+		                                            LastType2 last2, Sink &sink,
+		                                            Compare &comp ) {
+			while( first1 != last1 and first2 != last2 ) {
+				if( daw::invoke( comp, *first1, *first2 ) ) {
+					++first1;
+				} else {
+					if( not daw::invoke( comp, *first2, *first1 ) ) {
+						sink( *first1 );
+						++first1;
+					}
+					++first2;
+				}
+			}
+		}
+
+		template<typename T>
+		inline constexpr bool is_block_set_value_v =
+		  std::is_same_v<T, std::uint32_t> or std::is_same_v<T, std::uint64_t>;
+
+		/// Elements per block of the all pairs intersection, 256 bits
+		template<typename T>
+		inline constexpr std::ptrdiff_t set_block_size =
+		  static_cast<std::ptrdiff_t>( 32U / sizeof( T ) );
+
+#if defined( DAW_HAS_SSE2 )
+		/// Any equal pair between two blocks.  Each vector of the first block
+		/// is compared with every rotation of each vector of the second
+		template<typename T>
+		bool sse2_set_block_has_match( T const *first1, T const *first2 ) {
+			__m128i const a0 = sse2_load( first1 );
+			__m128i const a1 = sse2_load( first1 + 16U / sizeof( T ) );
+			__m128i found = _mm_setzero_si128( );
+			auto const compare = [&]( __m128i b ) {
+				found = _mm_or_si128(
+				  found, _mm_or_si128( sse2_eq<T>( a0, b ), sse2_eq<T>( a1, b ) ) );
+			};
+			for( std::ptrdiff_t half = 0; half < 2; ++half ) {
+				__m128i const b = sse2_load(
+				  first2 + half * static_cast<std::ptrdiff_t>( 16U / sizeof( T ) ) );
+				compare( b );
+				if constexpr( sizeof( T ) == 4 ) {
+					compare( _mm_shuffle_epi32( b, _MM_SHUFFLE( 0, 3, 2, 1 ) ) );
+					compare( _mm_shuffle_epi32( b, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+					compare( _mm_shuffle_epi32( b, _MM_SHUFFLE( 2, 1, 0, 3 ) ) );
+				} else {
+					compare( _mm_shuffle_epi32( b, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+				}
+			}
+			return _mm_movemask_epi8( found ) != 0;
+		}
+#endif
+
+		template<typename T>
+		constexpr bool set_block_has_match( T const *first1, T const *first2 ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+			if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+				return sse2_set_block_has_match( first1, first2 );
+			}
+#endif
+			constexpr std::ptrdiff_t block = set_block_size<T>;
+			unsigned found = 0;
+			for( std::ptrdiff_t i = 0; i < block; ++i ) {
+				for( std::ptrdiff_t j = 0; j < block; ++j ) {
+					found |= static_cast<unsigned>( first1[i] == first2[j] );
+				}
+			}
+			return found != 0;
+		}
+
+		/// Compare a block of each list all against all, so the inner loop is
+		/// a broadcast and a vector compare instead of a branch per element.
+		/// Blocks with no equal pair are skipped whole, the one with the smaller
+		/// maximum advances.  Blocks with a match are merged one element at a
+		/// time, so duplicates give min( count1, count2 ) copies like the other
+		/// kernels
+		template<typename T, typename Sink>
+		constexpr void set_intersection_block_impl( T const *first1,
+		                                            T const *last1,
+		                                            T const *first2,
+		                                            T const *last2,
+		                                            Sink &sink ) {
+			constexpr std::ptrdiff_t block = set_block_size<T>;
+			auto comp = std::less<>{ };
+			while( last1 - first1 >= block and last2 - first2 >= block ) {
+				bool const found = set_block_has_match( first1, first2 );
+				T const max1 = first1[block - 1];
+				T const max2 = first2[block - 1];
+				if( found ) {
+					// Merge until one of the blocks is used up
+					T const *const end1 = first1 + block;
+					T const *const end2 = first2 + block;
+					while( first1 != end1 and first2 != end2 ) {
+						if( *first1 < *first2 ) {
+							++first1;
+						} else {
+							if( not( *first2 < *first1 ) ) {
+								sink( *first1 );
+								++first1;
+							}
+							++first2;
+						}
+					}
+					continue;
+				}
+				// With no equal pair, every value in the block with the smaller
+				// maximum is below the rest of the other list.  A tie would be a
+				// match, so only one block advances
+				if( max1 < max2 ) {
+					first1 += block;
+				} else {
+					first2 += block;
+				}
+			}
+			set_intersection_merge_impl( first1, last1, first2, last2, sink,
+			                             comp );
+		}
+
+		/// Lists this many times larger than the other are galloped through
+		inline constexpr std::ptrdiff_t set_gallop_ratio = 32;
+
+		template<typename Iterator>
+		using set_value_t =
+		  daw::remove_cvref_t<decltype( *std::declval<Iterator>( ) )>;
+
+		template<typename Iterator1, typename Iterator2, typename Compare>
+		inline constexpr bool use_set_block_kernel_v =
+		  std::is_pointer_v<Iterator1> and std::is_pointer_v<Iterator2> and
+		  std::is_same_v<set_value_t<Iterator1>, set_value_t<Iterator2>> and
+		  is_block_set_value_v<set_value_t<Iterator1>> and
+		  ( std::is_same_v<Compare, std::less<>> or
+		    std::is_same_v<Compare, std::less<set_value_t<Iterator1>>> );
+
+		template<typename RandomIterator1, typename RandomIterator2,
+		         typename Sink, typename Compare>
+		constexpr void set_intersection_adaptive_impl( RandomIterator1 first1,
+		                                               RandomIterator1 last1,
+		                                               RandomIterator2 first2,
+		                                               RandomIterator2 last2,
+		                                               Sink &sink,
+		                                               Compare &comp ) {
+			auto const size1 = last1 - first1;
+			auto const size2 = last2 - first2;
+			if( size1 * set_gallop_ratio <= size2 ) {
+				set_intersection_gallop_impl( first1, last1, first2, last2, sink,
+				                              comp );
+			} else if( size2 * set_gallop_ratio <= size1 ) {
+				set_intersection_gallop_impl( first2, last2, first1, last1, sink,
+				                              comp );
+			} else if constexpr( use_set_block_kernel_v<RandomIterator1,
+			                                            RandomIterator2,
+			                                            Compare> ) {
+				set_intersection_block_impl( first1, last1, first2, last2, sink );
+			} else {
+				set_intersection_merge_impl( first1, last1, first2, last2, sink,
+				                             comp );
+			}
+		}
+
+		template<typename Lists>
+		constexpr auto list_size( Lists const &lists, std::size_t idx ) {
+			return std::end( lists[idx] ) - std::begin( lists[idx] );
+		}
+
+		/// Intersect many lists by walking the smallest and galloping through
+		/// the others, smallest first so most candidates are rejected early.
+		/// Each list keeps a cursor so the total work is bounded by the smallest
+		/// list times the log of the gaps
+		template<typename Lists, typename Sink, typename Compare>
+		void set_intersection_k_impl( Lists const &lists, Sink &sink,
+		                              Compare &comp ) {
+			using iterator_t = decltype( std::begin( lists[0] ) );
+			std::size_t const count = std::size( lists );
+			if( count == 0 ) {
+				return;
+			}
+			std::vector<std::size_t> order( count );
+			for( std::size_t n = 0; n < count; ++n ) {
+				order[n] = n;
+			}
+			std::sort( order.begin( ), order.end( ),
+			           [&]( std::size_t lhs, std::size_t rhs ) {
+				           return list_size( lists, lhs ) < list_size( lists, rhs );
+			           } );
+			std::vector<iterator_t> cursors( count );
+			for( std::size_t n = 0; n < count; ++n ) {
+				cursors[n] = std::begin( lists[order[n]] );
+			}
+			auto const &smallest = lists[order[0]];
+			for( auto it = std::begin( smallest ); it != std::end( smallest );
+			     ++it ) {
+				bool in_all = true;
+				for( std::size_t n = 1; n < count; ++n ) {
+					auto const last = std::end( lists[order[n]] );
+					cursors[n] = gallop_lower_bound( cursors[n], last, *it, comp );
+					if( cursors[n] == last ) {
+						return;
+					}
+					if( daw::invoke( comp, *it, *cursors[n] ) ) {
+						in_all = false;
+						break;
+					}
+				}
+				if( in_all ) {
+					sink( *it );
+					// Each match uses up one copy in every list, so duplicates give
+					// the smallest count
+					for( std::size_t n = 1; n < count; ++n ) {
+						++cursors[n];
+					}
+				}
+			}
+		}
+
+		/// k-way union with a binary heap of list cursors keyed on their
+		/// current value, equal values from several lists are emitted once
+		template<typename Lists, typename Sink, typename Compare>
+		void set_union_k_impl( Lists const &lists, Sink &sink, Compare &comp ) {
+			using iterator_t = decltype( std::begin( lists[0] ) );
+			struct cursor_t {
+				iterator_t first;
+				iterator_t last;
+			};
+			std::vector<cursor_t> heap{ };
+			heap.reserve( std::size( lists ) );
+			for( auto const &list : lists ) {
+				if( std::begin( list ) != std::end( list ) ) {
+					heap.push_back( cursor_t{ std::begin( list ), std::end( list ) } );
+				}
+			}
+			auto const heap_comp = [&]( cursor_t const &lhs, cursor_t const &rhs ) {
+				return daw::invoke( comp, *rhs.first, *lhs.first );
+			};
+			std::make_heap( heap.begin( ), heap.end( ), heap_comp );
+			bool has_last = false;
+			iterator_t last_emitted{ };
+			while( not heap.empty( ) ) {
+				std::pop_heap( heap.begin( ), heap.end( ), heap_comp );
+				auto &top = heap.back( );
+				if( not has_last or
+				    daw::invoke( comp, *last_emitted, *top.first ) ) {
+					sink( *top.first );
+					last_emitted = top.first;
+					has_last = true;
+				}
+				++top.first;
+				if( top.first == top.last ) {
+					heap.pop_back( );
+				} else {
+					std::push_heap( heap.begin( ), heap.end( ), heap_comp );
+				}
+			}
+		}
+	} // namespace algorithm_details
+
+	/// @brief Copy the elements of sorted range 1 or sorted range 2 to d_first,
+	/// elements in both once
+	template<typename InputIterator1, typename LastType1, typename InputIterator2,
+	         typename LastType2, typename OutputIterator,
+	         typename Compare = std::less<>>
+	constexpr OutputIterator
+	set_union( InputIterator1 first1, LastType1 last1, InputIterator2 first2,
+	           LastType2 last2, OutputIterator d_first,
+	           Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_union_impl( first1, last1, first2, last2, sink,
+		                                   comp );
+		return sink.out;
+	}
+
+	/// @brief Count of the union of two sorted ranges without writing it
+	template<typename InputIterator1, typename LastType1, typename InputIterator2,
+	         typename LastType2, typename Compare = std::less<>>
+	constexpr std::size_t set_union_count( InputIterator1 first1, LastType1 last1,
+	                                       InputIterator2 first2, LastType2 last2,
+	                                       Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_count_sink{ };
+		algorithm_details::set_union_impl( first1, last1, first2, last2, sink,
+		                                   comp );
+		return sink.count;
+	}
+
+	/// @brief Copy the elements of sorted range 1 not found in sorted range 2
+	/// to d_first
+	template<typename InputIterator1, typename LastType1, typename InputIterator2,
+	         typename LastType2, typename OutputIterator,
+	         typename Compare = std::less<>>
+	constexpr OutputIterator
+	set_difference( InputIterator1 first1, LastType1 last1, InputIterator2 first2,
+	                LastType2 last2, OutputIterator d_first,
+	                Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_difference_impl( first1, last1, first2, last2, sink,
+		                                        comp );
+		return sink.out;
+	}
+
+	/// @brief Count of the difference of two sorted ranges without writing it
+	template<typename InputIterator1, typename LastType1, typename InputIterator2,
+	         typename LastType2, typename Compare = std::less<>>
+	constexpr std::size_t
+	set_difference_count( InputIterator1 first1, LastType1 last1,
+	                      InputIterator2 first2, LastType2 last2,
+	                      Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_count_sink{ };
+		algorithm_details::set_difference_impl( first1, last1, first2, last2, sink,
+		                                        comp );
+		return sink.count;
+	}
+
+	/// @brief Intersection of two sorted random access ranges, walking the
+	/// first and galloping (exponential search) through the second.  Best when
+	/// the first range is much smaller, O(m log(n/m))
+	template<typename RandomIterator1, typename RandomIterator2,
+	         typename OutputIterator, typename Compare = std::less<>>
+	constexpr OutputIterator
+	set_intersection_galloping( RandomIterator1 first1, RandomIterator1 last1,
+	                            RandomIterator2 first2, RandomIterator2 last2,
+	                            OutputIterator d_first,
+	                            Compare comp = Compare{ } ) {
+		traits::is_random_access_iterator_test<RandomIterator2>( );
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_intersection_gallop_impl( first1, last1, first2,
+		                                                 last2, sink, comp );
+		return sink.out;
+	}
+
+	/// @brief Intersection of two sorted random access ranges choosing the
+	/// kernel by shape: galloping when one is 32x or more larger, an all pairs
+	/// block compare for contiguous uint32_t/uint64_t, and a merge otherwise
+	template<typename RandomIterator1, typename RandomIterator2,
+	         typename OutputIterator, typename Compare = std::less<>>
+	constexpr OutputIterator
+	set_intersection_adaptive( RandomIterator1 first1, RandomIterator1 last1,
+	                           RandomIterator2 first2, RandomIterator2 last2,
+	                           OutputIterator d_first,
+	                           Compare comp = Compare{ } ) {
+		traits::is_random_access_iterator_test<RandomIterator1>( );
+		traits::is_random_access_iterator_test<RandomIterator2>( );
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_intersection_adaptive_impl( first1, last1, first2,
+		                                                   last2, sink, comp );
+		return sink.out;
+	}
+
+	/// @brief Size of the intersection of two sorted random access ranges,
+	/// using the same kernels as set_intersection_adaptive without any writes
+	template<typename RandomIterator1, typename RandomIterator2,
+	         typename Compare = std::less<>>
+	constexpr std::size_t
+	set_intersection_count( RandomIterator1 first1, RandomIterator1 last1,
+	                        RandomIterator2 first2, RandomIterator2 last2,
+	                        Compare comp = Compare{ } ) {
+		traits::is_random_access_iterator_test<RandomIterator1>( );
+		traits::is_random_access_iterator_test<RandomIterator2>( );
+		auto sink = algorithm_details::set_count_sink{ };
+		algorithm_details::set_intersection_adaptive_impl( first1, last1, first2,
+		                                                   last2, sink, comp );
+		return sink.count;
+	}
+
+	/// @brief Intersection of every sorted list in lists, a random access
+	/// container of random access ranges
+	template<typename Lists, typename OutputIterator,
+	         typename Compare = std::less<>>
+	OutputIterator set_intersection_k( Lists const &lists, OutputIterator d_first,
+	                                   Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_intersection_k_impl( lists, sink, comp );
+		return sink.out;
+	}
+
+	template<typename Lists, typename Compare = std::less<>>
+	std::size_t set_intersection_k_count( Lists const &lists,
+	                                      Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_count_sink{ };
+		algorithm_details::set_intersection_k_impl( lists, sink, comp );
+		return sink.count;
+	}
+
+	/// @brief Union of every sorted list in lists, values found in several
+	/// lists are written once
+	template<typename Lists, typename OutputIterator,
+	         typename Compare = std::less<>>
+	OutputIterator set_union_k( Lists const &lists, OutputIterator d_first,
+	                            Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_output_sink<OutputIterator>{ d_first };
+		algorithm_details::set_union_k_impl( lists, sink, comp );
+		return sink.out;
+	}
+
+	template<typename Lists, typename Compare = std::less<>>
+	std::size_t set_union_k_count( Lists const &lists,
+	                               Compare comp = Compare{ } ) {
+		auto sink = algorithm_details::set_count_sink{ };
+		algorithm_details::set_union_k_impl( lists, sink, comp );
+		return sink.count;
+	}
+
 	template<typename Iterator, typename EndIterator, typename T>
 	constexpr void iota( Iterator first, EndIterator last, T start_value ) {
 		while( first != last ) {
@@ -2101,6 +3797,281 @@ static_assert(
 		}
 	}
 
+	/// @brief Number of k element combinations of n items
+	/// @throws std::overflow_error when the count does not fit in size_t
+	constexpr std::size_t binomial( std::size_t n, std::size_t k ) {
+		if( k > n ) {
+			return 0;
+		}
+		if( k > n - k ) {
+			k = n - k;
+		}
+		std::size_t result = 1;
+		for( std::size_t i = 0; i < k; ++i ) {
+			// result * ( n - i ) is always divisible by i + 1
+			std::size_t const factor = n - i;
+			std::size_t const divisor = i + 1;
+			std::size_t const g = std::gcd( result, divisor );
+			std::size_t const reduced = result / g;
+			daw::exception::precondition_check<std::overflow_error>(
+			  reduced <= std::numeric_limits<std::size_t>::max( ) /
+			               ( factor / ( divisor / g ) ) );
+			result = reduced * ( factor / ( divisor / g ) );
+		}
+		return result;
+	}
+
+	/// @brief The row major index space of an N dimensional product.  Flat
+	/// index i decodes directly to its coordinates, so the space can be cut
+	/// into independent chunks
+	template<std::size_t N>
+	class product_index_space {
+		static_assert( N > 0, "A product needs at least one dimension" );
+		std::array<std::size_t, N> m_extents;
+		std::size_t m_size = 1;
+
+	public:
+		using value_type = std::array<std::size_t, N>;
+
+		/// @throws std::overflow_error when the product of the extents does not
+		/// fit in size_t
+		explicit constexpr product_index_space(
+		  std::array<std::size_t, N> const &extents )
+		  : m_extents( extents ) {
+			for( auto e : m_extents ) {
+				if( e == 0 ) {
+					m_size = 0;
+					return;
+				}
+			}
+			for( auto e : m_extents ) {
+				daw::exception::precondition_check<std::overflow_error>(
+				  m_size <= std::numeric_limits<std::size_t>::max( ) / e );
+				m_size *= e;
+			}
+		}
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] constexpr std::array<std::size_t, N> const &
+		extents( ) const noexcept {
+			return m_extents;
+		}
+
+		/// Coordinates of flat index, the last dimension varies fastest
+		[[nodiscard]] constexpr value_type decode( std::size_t index ) const {
+			value_type result{ };
+			for( std::size_t d = N; d-- > 0; ) {
+				result[d] = index % m_extents[d];
+				index /= m_extents[d];
+			}
+			return result;
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		encode( value_type const &coordinates ) const {
+			std::size_t result = 0;
+			for( std::size_t d = 0; d < N; ++d ) {
+				result = result * m_extents[d] + coordinates[d];
+			}
+			return result;
+		}
+
+		/// Step to the coordinates of the next flat index.  Returns false after
+		/// the last one, wrapping to all zeros
+		constexpr bool next( value_type &coordinates ) const {
+			for( std::size_t d = N; d-- > 0; ) {
+				if( ++coordinates[d] < m_extents[d] ) {
+					return true;
+				}
+				coordinates[d] = 0;
+			}
+			return false;
+		}
+	};
+
+	/// @brief The k element combinations of [0, n) in lexicographic order,
+	/// each a strictly increasing list of k indices.  Index i decodes directly
+	/// through the combinatorial number system
+	class combination_index_space {
+		std::size_t m_n;
+		std::size_t m_k;
+		std::size_t m_size;
+
+	public:
+		/// @throws std::overflow_error when binomial( n, k ) does not fit in
+		/// size_t
+		constexpr combination_index_space( std::size_t n, std::size_t k )
+		  : m_n( n )
+		  , m_k( k )
+		  , m_size( binomial( n, k ) ) {}
+
+		[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] constexpr std::size_t n( ) const noexcept {
+			return m_n;
+		}
+
+		[[nodiscard]] constexpr std::size_t k( ) const noexcept {
+			return m_k;
+		}
+
+		/// Write the k indices of combination index to out[0, k)
+		template<typename RandomIterator>
+		constexpr void decode( std::size_t index, RandomIterator out ) const {
+			std::size_t candidate = 0;
+			for( std::size_t pos = 0; pos < m_k; ++pos ) {
+				while( true ) {
+					std::size_t const count =
+					  binomial( m_n - candidate - 1, m_k - pos - 1 );
+					if( index < count ) {
+						break;
+					}
+					index -= count;
+					++candidate;
+				}
+				out[static_cast<std::ptrdiff_t>( pos )] = candidate;
+				++candidate;
+			}
+		}
+
+		/// Step indices[0, k) to the next combination.  Returns false after
+		/// the last one
+		template<typename RandomIterator>
+		constexpr bool next( RandomIterator indices ) const {
+			for( std::size_t pos = m_k; pos-- > 0; ) {
+				auto const at = static_cast<std::ptrdiff_t>( pos );
+				if( indices[at] < m_n - m_k + pos ) {
+					++indices[at];
+					for( std::size_t p = pos + 1; p < m_k; ++p ) {
+						indices[static_cast<std::ptrdiff_t>( p )] =
+						  indices[static_cast<std::ptrdiff_t>( p - 1 )] + 1;
+					}
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	namespace algorithm_details {
+		/// Call func, treating a void result as true so callbacks may return
+		/// false to stop early
+		template<typename Function, typename... Args>
+		constexpr bool invoke_continue( Function &func, Args &&... args ) {
+			if constexpr( std::is_same_v<bool, std::invoke_result_t<Function &,
+			                                                        Args...>> ) {
+				return daw::invoke( func, std::forward<Args>( args )... );
+			} else {
+				daw::invoke( func, std::forward<Args>( args )... );
+				return true;
+			}
+		}
+	} // namespace algorithm_details
+
+	/// @brief Call func( coordinates ) for flat indices [first, last) of space.
+	/// func may return false to stop
+	/// @return false if func stopped the enumeration
+	template<std::size_t N, typename Function>
+	constexpr bool for_each_product_index( product_index_space<N> const &space,
+	                                       std::size_t first, std::size_t last,
+	                                       Function func ) {
+		if( last > space.size( ) ) {
+			last = space.size( );
+		}
+		if( first >= last ) {
+			return true;
+		}
+		auto coordinates = space.decode( first );
+		for( ; first < last; ++first ) {
+			auto const &current = coordinates;
+			if( not algorithm_details::invoke_continue( func, current ) ) {
+				return false;
+			}
+			(void)space.next( coordinates );
+		}
+		return true;
+	}
+
+	template<std::size_t N, typename Function>
+	constexpr bool for_each_product_index( product_index_space<N> const &space,
+	                                       Function func ) {
+		return daw::algorithm::for_each_product_index( space, 0, space.size( ),
+		                                               daw::move( func ) );
+	}
+
+	/// @brief Call func( indices ) for combinations [first, last) of space,
+	/// indices being a view of k size_t's.  func may return false to stop
+	/// @return false if func stopped the enumeration
+	template<typename Function>
+	bool for_each_combination_index( combination_index_space const &space,
+	                                 std::size_t first, std::size_t last,
+	                                 Function func ) {
+		if( last > space.size( ) ) {
+			last = space.size( );
+		}
+		if( first >= last ) {
+			return true;
+		}
+		std::vector<std::size_t> indices( space.k( ) );
+		space.decode( first, indices.data( ) );
+		auto const current = daw::view<std::size_t const *>(
+		  indices.data( ), indices.data( ) + indices.size( ) );
+		for( ; first < last; ++first ) {
+			if( not algorithm_details::invoke_continue( func, current ) ) {
+				return false;
+			}
+			(void)space.next( indices.data( ) );
+		}
+		return true;
+	}
+
+	template<typename Function>
+	bool for_each_combination_index( combination_index_space const &space,
+	                                 Function func ) {
+		return daw::algorithm::for_each_combination_index(
+		  space, 0, space.size( ), daw::move( func ) );
+	}
+
+	namespace algorithm_details {
+		template<typename... Containers>
+		constexpr auto make_product_space( Containers const &... containers ) {
+			return product_index_space<sizeof...( Containers )>(
+			  std::array<std::size_t, sizeof...( Containers )>{
+			    static_cast<std::size_t>( std::size( containers ) )... } );
+		}
+
+		template<typename Function, typename Tuple, std::size_t... Is>
+		constexpr bool
+		invoke_product( Function &func, Tuple const &containers,
+		                std::array<std::size_t, sizeof...( Is )> const &at,
+		                std::index_sequence<Is...> ) {
+			return invoke_continue(
+			  func, std::get<Is>( containers )[static_cast<std::ptrdiff_t>(
+			          at[Is] )]... );
+		}
+	} // namespace algorithm_details
+
+	/// @brief Call func( c0[i0], c1[i1], ... ) for every element of the
+	/// cartesian product of random access containers, the last varying
+	/// fastest.  func may return false to stop
+	/// @return false if func stopped the enumeration
+	template<typename Function, typename... Containers>
+	constexpr bool cartesian_product_for_each( Function func,
+	                                           Containers const &... cs ) {
+		auto const space = algorithm_details::make_product_space( cs... );
+		auto const refs = std::forward_as_tuple( cs... );
+		return daw::algorithm::for_each_product_index(
+		  space, [&]( auto const &at ) {
+			  return algorithm_details::invoke_product(
+			    func, refs, at, std::index_sequence_for<Containers...>{ } );
+		  } );
+	}
+
 	template<typename InputIterator, typename OutputIterator,
 	         typename BinaryOperator = std::plus<>>
 	constexpr OutputIterator
@@ -2256,8 +4227,48 @@ static_assert(
 		return result;
 	}
 
+	namespace algorithm_details {
+		template<typename Predicate, typename T>
+		struct simd_predicate {
+			static constexpr bool value = false;
+		};
+
+		template<typename Value, typename T>
+		struct simd_predicate<equal_to<Value>, T> {
+			static constexpr bool value =
+			  std::is_same_v<daw::remove_cvref_t<Value>, T>;
+
+			static auto make( equal_to<Value> const &pred ) {
+				return simd_equal_value<T>{ pred.value( ) };
+			}
+		};
+
+		template<typename Value, typename T>
+		struct simd_predicate<less_than<Value>, T> {
+			static constexpr bool value =
+			  std::is_same_v<daw::remove_cvref_t<Value>, T>;
+
+			static auto make( less_than<Value> const &pred ) {
+				return simd_less_value<T>{ pred.value( ) };
+			}
+		};
+
+		template<typename Lower, typename Upper, typename T>
+		struct simd_predicate<in_range<Lower, Upper>, T> {
+			static constexpr bool value =
+			  std::is_same_v<daw::remove_cvref_t<Lower>, T> and
+			  std::is_same_v<daw::remove_cvref_t<Upper>, T>;
+
+			static auto make( in_range<Lower, Upper> const &pred ) {
+				return simd_in_range_value<T>{ pred.lower( ), pred.upper( ) };
+			}
+		};
+	} // namespace algorithm_details
+
 	/***
-	 * Count the number of times the predicate returns true
+	 * Count the number of times the predicate returns true.  Contiguous
+	 * arithmetic ranges with an equal_to, less_than or in_range predicate of
+	 * the same type use a block kernel at runtime
 	 * @param first beginning of range
 	 * @param last end of range
 	 * @param pred unary predicate
@@ -2267,6 +4278,21 @@ static_assert(
 	         typename Predicate>
 	constexpr ResultType count_if( Iterator first, Last last, Predicate pred ) {
 		static_assert( std::is_integral_v<ResultType> );
+#if defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if constexpr( std::is_same_v<Iterator, Last> and
+		              algorithm_details::is_contiguous_arithmetic_iterator_v<
+		                Iterator> ) {
+			using simd_pred_t = algorithm_details::simd_predicate<
+			  Predicate, typename std::iterator_traits<Iterator>::value_type>;
+			if constexpr( simd_pred_t::value ) {
+				if( not DAW_IS_CONSTANT_EVALUATED( ) and first != last ) {
+					return static_cast<ResultType>( algorithm_details::simd_count_if(
+					  std::addressof( *first ), last - first,
+					  simd_pred_t::make( pred ) ) );
+				}
+			}
+		}
+#endif
 		ResultType result = 0;
 		while( first != last ) {
 			if( pred( *first ) ) {
@@ -10,6 +10,8 @@
 #pragma once
 
 #include <ciso646>
+#include <climits>
+#include <limits>
 
 #if defined( DAW_JSON_NO_INT128 )
 #if defined( DAW_HAS_INT128 )
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "daw_exception.h"
 #include "daw_traits.h"
 #include "daw_utility.h"
 
@@ -96,4 +97,62 @@ namespace daw {
 		return i & result;
 	}
 
+	/// @brief true if value is a non-zero power of two
+	template<typename Unsigned>
+	constexpr bool is_power_of_two( Unsigned value ) noexcept {
+		static_assert( std::is_unsigned_v<Unsigned>,
+		               "Only unsigned types are supported" );
+		return value != 0 and ( value & ( value - 1U ) ) == 0;
+	}
+
+	/// @brief floor( log2( value ) ), value must be non-zero
+	template<typename Unsigned>
+	constexpr size_t bit_log2( Unsigned value ) noexcept {
+		static_assert( std::is_unsigned_v<Unsigned>,
+		               "Only unsigned types are supported" );
+		size_t result = 0;
+		while( value > 1U ) {
+			value >>= 1U;
+			++result;
+		}
+		return result;
+	}
+
+	/// @brief smallest power of two that is >= value.  bit_ceil( 0 ) is 1.
+	/// The result must fit in Unsigned
+	template<typename Unsigned>
+	constexpr Unsigned bit_ceil( Unsigned value ) {
+		static_assert( std::is_unsigned_v<Unsigned>,
+		               "Only unsigned types are supported" );
+		if( value <= 1U ) {
+			return 1U;
+		}
+		size_t const shift = bit_log2( static_cast<Unsigned>( value - 1U ) ) + 1U;
+		daw::exception::precondition_check(
+		  shift < static_cast<size_t>( std::numeric_limits<Unsigned>::digits ),
+		  "bit_ceil result does not fit in the type" );
+		return static_cast<Unsigned>( Unsigned{ 1U } << shift );
+	}
+
+	/// @brief number of zero bits below the lowest set bit, value must be
+	/// non-zero
+	template<typename Unsigned>
+	constexpr size_t countr_zero( Unsigned value ) noexcept {
+		static_assert( std::is_unsigned_v<Unsigned>,
+		               "Only unsigned types are supported" );
+#if defined( __GNUC__ ) or defined( __clang__ )
+		if constexpr( sizeof( Unsigned ) <= sizeof( unsigned ) ) {
+			return static_cast<size_t>( __builtin_ctz( value ) );
+		} else {
+			return static_cast<size_t>( __builtin_ctzll( value ) );
+		}
+#else
+		size_t result = 0;
+		while( ( value & 1U ) == 0 ) {
+			value >>= 1U;
+			++result;
+		}
+		return result;
+#endif
+	}
 } // namespace daw
@@ -10,8 +10,10 @@
 
 #include "daw_bit_queues.h"
 #include "daw_exception.h"
+#include "daw_likely.h"
 
 #include <ciso646>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <stdexcept>
@@ -192,4 +194,257 @@ namespace daw {
 		return bit_stream<InputIteratorF, InputIteratorL, BitQueueLSB>{ first,
 		                                                                last };
 	}
+
+	namespace bit_stream_impl {
+		template<typename Byte>
+		constexpr uint64_t byte_at( Byte const *ptr, size_t n ) noexcept {
+			return static_cast<uint64_t>( static_cast<uint8_t>( ptr[n] ) );
+		}
+
+		template<typename Byte>
+		constexpr uint64_t load_be64( Byte const *ptr ) noexcept {
+			// Compilers fold this into a single unaligned load and a byte swap
+			return ( byte_at( ptr, 0 ) << 56U ) | ( byte_at( ptr, 1 ) << 48U ) |
+			       ( byte_at( ptr, 2 ) << 40U ) | ( byte_at( ptr, 3 ) << 32U ) |
+			       ( byte_at( ptr, 4 ) << 24U ) | ( byte_at( ptr, 5 ) << 16U ) |
+			       ( byte_at( ptr, 6 ) << 8U ) | byte_at( ptr, 7 );
+		}
+
+		template<typename Byte>
+		constexpr void store_be64( Byte *ptr, uint64_t value ) noexcept {
+			ptr[0] = static_cast<Byte>( value >> 56U );
+			ptr[1] = static_cast<Byte>( value >> 48U );
+			ptr[2] = static_cast<Byte>( value >> 40U );
+			ptr[3] = static_cast<Byte>( value >> 32U );
+			ptr[4] = static_cast<Byte>( value >> 24U );
+			ptr[5] = static_cast<Byte>( value >> 16U );
+			ptr[6] = static_cast<Byte>( value >> 8U );
+			ptr[7] = static_cast<Byte>( value );
+		}
+	} // namespace bit_stream_impl
+
+	/// A bit reader over a contiguous byte buffer, most significant bit first.
+	/// refill( ) loads the next 8 bytes at the current byte with one unaligned
+	/// load, leaving at least 57 bits available to peek_bits/consume_bits.
+	/// There are no per call bounds checks; reads past the end return zero bits
+	/// and overrun( ) reports it so a decoder can check once at the end
+	template<typename Byte>
+	struct bit_reader {
+		static_assert( sizeof( Byte ) == 1 and std::is_integral_v<Byte>,
+		               "Byte must be a single byte integral type" );
+		using value_type = uint64_t;
+		static constexpr size_t max_peek_bits = 57U;
+
+	private:
+		Byte const *m_first;
+		Byte const *m_ptr;
+		Byte const *m_last;
+		uint64_t m_bits = 0;
+		size_t m_bit_pos = 0;
+
+		constexpr uint64_t load_tail( ) const noexcept {
+			uint64_t result = 0;
+			auto const remaining = static_cast<size_t>( m_last - m_ptr );
+			for( size_t n = 0; n < 8U; ++n ) {
+				result <<= 8U;
+				if( n < remaining ) {
+					result |= static_cast<uint8_t>( m_ptr[n] );
+				}
+			}
+			return result;
+		}
+
+	public:
+		constexpr bit_reader( Byte const *first, Byte const *last ) noexcept
+		  : m_first( first )
+		  , m_ptr( first )
+		  , m_last( last ) {
+			refill( );
+		}
+
+		constexpr bit_reader( Byte const *first, size_t size ) noexcept
+		  : bit_reader( first, first + size ) {}
+
+		/// @brief Make at least max_peek_bits available
+		constexpr void refill( ) noexcept {
+			auto const available = static_cast<size_t>( m_last - m_ptr );
+			auto const whole_bytes = m_bit_pos >> 3U;
+			if( DAW_LIKELY( available >= whole_bytes + 8U ) ) {
+				m_ptr += whole_bytes;
+				m_bit_pos &= 7U;
+				m_bits = bit_stream_impl::load_be64( m_ptr ) << m_bit_pos;
+				return;
+			}
+			// Near the end m_ptr stops at m_last and bits consumed past it stay
+			// in m_bit_pos
+			auto const advance = whole_bytes < available ? whole_bytes : available;
+			m_ptr += advance;
+			m_bit_pos -= advance * 8U;
+			m_bits = m_ptr != m_last ? load_tail( ) << m_bit_pos : 0U;
+		}
+
+		/// @brief Look at the next num_bits without consuming them.  Requires
+		/// num_bits <= max_peek_bits and no more than that consumed since the
+		/// last refill
+		constexpr uint64_t peek_bits( size_t num_bits ) const noexcept {
+			// Two shifts so that num_bits == 0 is well defined
+			return ( m_bits >> 1U ) >> ( 63U - num_bits );
+		}
+
+		constexpr void consume_bits( size_t num_bits ) noexcept {
+			m_bits <<= num_bits;
+			m_bit_pos += num_bits;
+		}
+
+		/// @brief Branchless refill, peek and consume of up to 57 bits
+		constexpr uint64_t pop_bits( size_t num_bits ) noexcept {
+			refill( );
+			auto const result = peek_bits( num_bits );
+			consume_bits( num_bits );
+			return result;
+		}
+
+		/// @brief Pop up to 64 bits into a T
+		template<typename T = uint64_t>
+		constexpr T pop_value( size_t num_bits = sizeof( T ) * 8U ) noexcept {
+			if( num_bits <= max_peek_bits ) {
+				return static_cast<T>( pop_bits( num_bits ) );
+			}
+			auto const high = pop_bits( num_bits - 32U );
+			return static_cast<T>( ( high << 32U ) | pop_bits( 32U ) );
+		}
+
+		constexpr void skip_bits( size_t num_bits ) noexcept {
+			m_bit_pos += num_bits;
+			refill( );
+		}
+
+		constexpr void align_to_byte( ) noexcept {
+			skip_bits( ( 8U - ( m_bit_pos & 7U ) ) & 7U );
+		}
+
+		constexpr size_t bits_consumed( ) const noexcept {
+			return static_cast<size_t>( m_ptr - m_first ) * 8U + m_bit_pos;
+		}
+
+		constexpr size_t size_bits( ) const noexcept {
+			return static_cast<size_t>( m_last - m_first ) * 8U;
+		}
+
+		constexpr size_t bits_remaining( ) const noexcept {
+			auto const consumed = bits_consumed( );
+			return consumed < size_bits( ) ? size_bits( ) - consumed : 0U;
+		}
+
+		constexpr bool valid( ) const noexcept {
+			return bits_consumed( ) < size_bits( );
+		}
+
+		explicit constexpr operator bool( ) const noexcept {
+			return valid( );
+		}
+
+		/// @brief True if more bits were consumed than the buffer holds
+		constexpr bool overrun( ) const noexcept {
+			return bits_consumed( ) > size_bits( );
+		}
+	}; // bit_reader
+
+	template<typename Byte>
+	bit_reader( Byte const *, Byte const * ) -> bit_reader<Byte>;
+
+	template<typename Byte>
+	bit_reader( Byte const *, size_t ) -> bit_reader<Byte>;
+
+	/// A bit writer into a contiguous byte buffer, most significant bit first,
+	/// producing the layout bit_reader consumes.  Bits are accumulated in a
+	/// 64 bit register and written out a word at a time when the buffer has at
+	/// least 8 bytes left
+	template<typename Byte>
+	struct bit_writer {
+		static_assert( sizeof( Byte ) == 1 and std::is_integral_v<Byte>,
+		               "Byte must be a single byte integral type" );
+		static constexpr size_t max_push_bits = 56U;
+
+	private:
+		Byte *m_first;
+		Byte *m_ptr;
+		Byte *m_last;
+		uint64_t m_bits = 0;
+		size_t m_count = 0;
+
+		constexpr void flush_bytes( ) {
+			auto const byte_count = m_count >> 3U;
+			// Left align the pending bits; two shifts keep m_count == 0 defined
+			auto const word = ( m_bits << 1U ) << ( 63U - m_count );
+			if( m_last - m_ptr >= 8 ) {
+				bit_stream_impl::store_be64( m_ptr, word );
+			} else {
+				daw::exception::precondition_check<std::out_of_range>(
+				  static_cast<size_t>( m_last - m_ptr ) >= byte_count,
+				  "Attempt to write past end of buffer" );
+				for( size_t n = 0; n < byte_count; ++n ) {
+					m_ptr[n] = static_cast<Byte>( word >> ( 56U - n * 8U ) );
+				}
+			}
+			m_ptr += byte_count;
+			m_count &= 7U;
+		}
+
+	public:
+		constexpr bit_writer( Byte *first, Byte *last ) noexcept
+		  : m_first( first )
+		  , m_ptr( first )
+		  , m_last( last ) {}
+
+		constexpr bit_writer( Byte *first, size_t size ) noexcept
+		  : bit_writer( first, first + size ) {}
+
+		/// @brief Append the low num_bits of value, num_bits <= max_push_bits
+		constexpr void push_bits( uint64_t value, size_t num_bits ) {
+			daw::exception::precondition_check<std::invalid_argument>(
+			  num_bits <= max_push_bits, "push_bits is limited to 56 bits" );
+			auto const mask = ( uint64_t{ 1 } << num_bits ) - 1U;
+			m_bits = ( m_bits << num_bits ) | ( value & mask );
+			m_count += num_bits;
+			flush_bytes( );
+		}
+
+		/// @brief Append the low num_bits of value, num_bits <= 64
+		template<typename T>
+		constexpr void push_value( T value, size_t num_bits = sizeof( T ) * 8U ) {
+			auto const v = static_cast<uint64_t>( value );
+			if( num_bits <= max_push_bits ) {
+				push_bits( v, num_bits );
+			} else {
+				push_bits( v >> 32U, num_bits - 32U );
+				push_bits( v, 32U );
+			}
+		}
+
+		/// @brief Pad the current byte with zero bits
+		constexpr void align_to_byte( ) {
+			push_bits( 0U, ( 8U - m_count ) & 7U );
+		}
+
+		/// @brief Write out any partial byte and return the bytes used
+		constexpr size_t finish( ) {
+			align_to_byte( );
+			return size_bytes( );
+		}
+
+		constexpr size_t size_bytes( ) const noexcept {
+			return static_cast<size_t>( m_ptr - m_first );
+		}
+
+		constexpr size_t size_bits( ) const noexcept {
+			return size_bytes( ) * 8U + m_count;
+		}
+	}; // bit_writer
+
+	template<typename Byte>
+	bit_writer( Byte *, Byte * ) -> bit_writer<Byte>;
+
+	template<typename Byte>
+	bit_writer( Byte *, size_t ) -> bit_writer<Byte>;
 } // namespace daw
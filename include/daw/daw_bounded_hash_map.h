@@ -12,8 +12,11 @@
 #include "daw_algorithm.h"
 #include "daw_optional.h"
 #include "daw_traits.h"
+#include "impl/daw_flat_hash_impl.h"
 
+#include <array>
 #include <ciso646>
+#include <cstddef>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -424,7 +427,7 @@ namespace daw {
 			if( !item ) {
 				return { };
 			}
-			return item.kv.value;
+			return daw::optional<mapped_type const &>( item.kv.value );
 		}
 
 		constexpr size_type count( Key const &key ) const {
@@ -530,4 +533,180 @@ namespace daw {
 	make_bounded_hash_map( std::pair<Key, Value> const ( &items )[N] ) {
 		return bounded_hash_map<Key, Value, N, Hash>( items );
 	}
+
+	namespace flat_hash_details {
+		struct map_key_of {
+			template<typename Key, typename Value>
+			static constexpr Key const &get( key_value_t<Key, Value> const &kv ) {
+				return kv.key;
+			}
+		};
+	} // namespace flat_hash_details
+
+	/// A bounded_hash_map that keeps a separate tag byte per slot, probed a
+	/// group at a time, with a power of two slot count and Robin Hood
+	/// displacement to bound the probe length.  Like bounded_hash_map it can
+	/// be built and queried at compile time.
+	template<typename Key, typename Value, size_t N,
+	         typename Hash = std::hash<Key>,
+	         typename KeyEqual = std::equal_to<Key>>
+	struct bounded_flat_hash_map {
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using value_type = key_value_t<Key, Value>;
+		using reference = value_type &;
+		using const_reference = value_type const &;
+		using pointer = value_type *;
+		using const_pointer = value_type const *;
+
+	private:
+		using table_t =
+		  flat_hash_details::robin_hood_table<value_type, N,
+		                                      flat_hash_details::map_key_of,
+		                                      Hash, KeyEqual>;
+		table_t m_table{ };
+
+	public:
+		using iterator = typename table_t::iterator;
+		using const_iterator = typename table_t::const_iterator;
+
+		constexpr bounded_flat_hash_map( ) = default;
+
+		template<size_type ItemCount>
+		constexpr bounded_flat_hash_map(
+		  std::pair<Key, Value> const ( &init_values )[ItemCount] ) {
+
+			static_assert( ItemCount <= N );
+			for( auto const &kv : init_values ) {
+				insert( kv.first, kv.second );
+			}
+		}
+
+		template<typename Iterator>
+		constexpr bounded_flat_hash_map( Iterator first, Iterator last ) {
+			for( ; first != last; ++first ) {
+				insert( *first );
+			}
+		}
+
+		/// Insert or replace the value for key
+		template<typename K, typename V,
+		         std::enable_if_t<
+		           daw::all_true_v<std::is_same_v<Key, daw::remove_cvref_t<K>>,
+		                           std::is_same_v<Value, daw::remove_cvref_t<V>>>,
+		           std::nullptr_t> = nullptr>
+		constexpr void insert( K &&key, V &&value ) {
+			auto const index = m_table.find_index( key );
+			if( index != table_t::npos ) {
+				m_table.slot( index ).value = std::forward<V>( value );
+				return;
+			}
+			(void)m_table.insert(
+			  value_type( std::forward<K>( key ), std::forward<V>( value ) ) );
+		}
+
+		constexpr void insert( std::pair<Key const, Value> const &item ) {
+			insert( item.first, item.second );
+		}
+
+		constexpr bool exists( Key const &key ) const {
+			return m_table.find_index( key ) != table_t::npos;
+		}
+
+		template<typename K>
+		constexpr mapped_type &operator[]( K &&key ) {
+			static_assert( std::is_convertible_v<std::remove_reference_t<K>, Key>,
+			               "Incompatable key passed" );
+			auto index = m_table.find_index( key );
+			if( index == table_t::npos ) {
+				index =
+				  m_table.insert( value_type( std::forward<K>( key ), Value{ } ) )
+				    .first;
+			}
+			return m_table.slot( index ).value;
+		}
+
+		constexpr mapped_type const &operator[]( Key const &key ) const {
+			auto const index = m_table.find_index( key );
+			daw::exception::precondition_check( index != table_t::npos );
+			return m_table.slot( index ).value;
+		}
+
+		constexpr daw::optional<mapped_type const &>
+		try_get( Key const &key ) const {
+			auto const index = m_table.find_index( key );
+			if( index == table_t::npos ) {
+				return { };
+			}
+			return daw::optional<mapped_type const &>( m_table.slot( index ).value );
+		}
+
+		constexpr size_type count( Key const &key ) const {
+			return exists( key ) ? 1U : 0U;
+		}
+
+		static constexpr size_type capacity( ) {
+			return N;
+		}
+
+		constexpr size_type size( ) const {
+			return m_table.size( );
+		}
+
+		constexpr bool empty( ) const {
+			return m_table.size( ) == 0;
+		}
+
+		/// The longest distance an element has been placed from its home slot
+		constexpr size_type max_probe_length( ) const {
+			return m_table.max_probe_length( );
+		}
+
+		constexpr iterator begin( ) {
+			return m_table.make_iterator( 0 );
+		}
+
+		constexpr const_iterator begin( ) const {
+			return m_table.make_iterator( 0 );
+		}
+
+		constexpr const_iterator cbegin( ) const {
+			return m_table.make_iterator( 0 );
+		}
+
+		constexpr iterator end( ) {
+			return m_table.make_iterator( table_t::npos );
+		}
+
+		constexpr const_iterator end( ) const {
+			return m_table.make_iterator( table_t::npos );
+		}
+
+		constexpr const_iterator cend( ) const {
+			return m_table.make_iterator( table_t::npos );
+		}
+
+		constexpr iterator find( Key const &key ) {
+			return m_table.make_iterator( m_table.find_index( key ) );
+		}
+
+		constexpr const_iterator find( Key const &key ) const {
+			return m_table.make_iterator( m_table.find_index( key ) );
+		}
+
+		constexpr void erase( Key const &key ) {
+			(void)m_table.erase( key );
+		}
+	};
+
+	template<typename Key, typename Value, typename Hash = std::hash<Key>,
+	         size_t N>
+	constexpr auto
+	make_bounded_flat_hash_map( std::pair<Key, Value> const ( &items )[N] ) {
+		return bounded_flat_hash_map<Key, Value, N, Hash>( items );
+	}
 } // namespace daw
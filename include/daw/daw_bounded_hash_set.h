@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw_algorithm.h"
+#include "impl/daw_flat_hash_impl.h"
 
 #include <ciso646>
 #include <functional>
@@ -462,4 +463,112 @@ namespace daw {
 		}
 		return result;
 	}
+
+	namespace flat_hash_details {
+		struct set_key_of {
+			template<typename Key>
+			static constexpr Key const &get( Key const &key ) {
+				return key;
+			}
+		};
+	} // namespace flat_hash_details
+
+	/// A bounded_hash_set_t that keeps a separate tag byte per slot, probed a
+	/// group at a time, with a power of two slot count and Robin Hood
+	/// displacement to bound the probe length.  Like bounded_hash_set_t it
+	/// can be built and queried at compile time.
+	template<typename Key, size_t Capacity, typename Hash = std::hash<Key>,
+	         typename KeyEqual = std::equal_to<Key>>
+	struct bounded_flat_hash_set {
+		using key_type = Key;
+		using value_type = Key;
+		using size_type = size_t;
+		using difference_type = ptrdiff_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using reference = value_type &;
+		using const_reference = value_type const &;
+		using pointer = value_type *;
+		using const_pointer = value_type const *;
+
+	private:
+		using table_t =
+		  flat_hash_details::robin_hood_table<Key, Capacity,
+		                                      flat_hash_details::set_key_of,
+		                                      Hash, KeyEqual>;
+		table_t m_table{ };
+
+	public:
+		using iterator = typename table_t::const_iterator;
+		using const_iterator = typename table_t::const_iterator;
+
+		constexpr bounded_flat_hash_set( ) = default;
+
+		constexpr iterator insert( Key const &key ) {
+			return m_table.make_iterator( m_table.insert( Key( key ) ).first );
+		}
+
+		constexpr iterator insert( Key &&key ) {
+			return m_table.make_iterator( m_table.insert( std::move( key ) ).first );
+		}
+
+		/// Returns the number of elements removed
+		constexpr size_type erase( Key const &key ) {
+			return m_table.erase( key ) ? 1U : 0U;
+		}
+
+		constexpr bool exists( Key const &key ) const {
+			return m_table.find_index( key ) != table_t::npos;
+		}
+
+		constexpr size_type count( Key const &key ) const {
+			return exists( key ) ? 1U : 0U;
+		}
+
+		static constexpr size_type capacity( ) {
+			return Capacity;
+		}
+
+		constexpr size_type size( ) const {
+			return m_table.size( );
+		}
+
+		constexpr bool empty( ) const {
+			return m_table.size( ) == 0;
+		}
+
+		/// The longest distance an element has been placed from its home slot
+		constexpr size_type max_probe_length( ) const {
+			return m_table.max_probe_length( );
+		}
+
+		constexpr const_iterator begin( ) const {
+			return m_table.make_iterator( 0 );
+		}
+
+		constexpr const_iterator cbegin( ) const {
+			return m_table.make_iterator( 0 );
+		}
+
+		constexpr const_iterator end( ) const {
+			return m_table.make_iterator( table_t::npos );
+		}
+
+		constexpr const_iterator cend( ) const {
+			return m_table.make_iterator( table_t::npos );
+		}
+
+		constexpr const_iterator find( Key const &key ) const {
+			return m_table.make_iterator( m_table.find_index( key ) );
+		}
+	};
+
+	template<typename Key, typename Hash = std::hash<Key>, size_t N>
+	constexpr auto make_bounded_flat_hash_set( Key const ( &items )[N] ) {
+		auto result = bounded_flat_hash_set<Key, N, Hash>{ };
+		for( auto const &item : items ) {
+			result.insert( item );
+		}
+		return result;
+	}
 } // namespace daw
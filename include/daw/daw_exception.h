@@ -8,8 +8,13 @@
 
 #pragma once
 
+#include "daw_likely.h"
+#include "daw_unreachable.h"
+
 #include <algorithm>
 #include <ciso646>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
 #include <iterator>
 #include <type_traits>
@@ -28,6 +33,42 @@
 
 #endif
 
+// How much of the contract checking is kept.  Only checks that abort, e.g.
+// precondition_check<Terminator> and dbg_precondition_check, are affected.
+// Checks that throw a typed exception report bad input and are always kept.
+//   DAW_CHECK_LEVEL_OFF    - never checked, the condition is assumed
+//   DAW_CHECK_LEVEL_DEBUG  - checked unless NDEBUG is defined
+//   DAW_CHECK_LEVEL_ALWAYS - always checked, the default
+#define DAW_CHECK_LEVEL_OFF 0
+#define DAW_CHECK_LEVEL_DEBUG 1
+#define DAW_CHECK_LEVEL_ALWAYS 2
+
+#ifndef DAW_CHECK_LEVEL
+#define DAW_CHECK_LEVEL DAW_CHECK_LEVEL_ALWAYS
+#endif
+
+#if DAW_CHECK_LEVEL == DAW_CHECK_LEVEL_ALWAYS or                              \
+  ( DAW_CHECK_LEVEL == DAW_CHECK_LEVEL_DEBUG and not defined( NDEBUG ) )
+#define DAW_CONTRACT_CHECKS true
+#else
+#define DAW_CONTRACT_CHECKS false
+#endif
+
+#if defined( DAW_CHECK_COUNTERS )
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#endif
+
+#if defined( __GNUC__ ) or defined( __clang__ ) or                            \
+  ( defined( _MSC_VER ) and _MSC_VER >= 1926 )
+#define DAW_CHECK_SITE_FILE __builtin_FILE( )
+#define DAW_CHECK_SITE_LINE __builtin_LINE( )
+#else
+#define DAW_CHECK_SITE_FILE nullptr
+#define DAW_CHECK_SITE_LINE 0
+#endif
+
 namespace daw::exception {
 	struct basic_exception {
 		template<typename Arg>
@@ -102,6 +143,160 @@ namespace daw::exception {
 #endif
 	}
 
+	struct Terminator {};
+
+	/// Are the aborting contract checks evaluated, see DAW_CHECK_LEVEL
+	inline constexpr bool contract_checks_v = DAW_CONTRACT_CHECKS;
+
+	/// The source location of a check.  file is null when the compiler cannot
+	/// report it
+	struct check_site {
+		char const *file;
+		std::uint_least32_t line;
+	};
+
+	/// The condition of a check and where the check is.  The site comes from
+	/// the default arguments, so it is the caller of the check function even
+	/// when the failure path is not inlined
+	struct check_condition {
+		bool value;
+		check_site site;
+
+		template<typename Bool,
+		         std::enable_if_t<std::is_constructible<bool, Bool>::value,
+		                          std::nullptr_t> = nullptr>
+		constexpr check_condition(
+		  Bool &&condition, char const *file = DAW_CHECK_SITE_FILE,
+		  std::uint_least32_t line = DAW_CHECK_SITE_LINE ) noexcept
+		  : value( static_cast<bool>( std::forward<Bool>( condition ) ) )
+		  , site{ file, line } {}
+	};
+
+#if defined( DAW_CHECK_COUNTERS )
+	/// A check site and how many times it has failed
+	struct check_site_count {
+		check_site site;
+		std::uint64_t count;
+	};
+
+	namespace exception_details {
+		/// state is 0 while empty, 1 while site is being written and 2 after
+		struct check_site_slot {
+			std::atomic<int> state;
+			check_site site;
+			std::atomic<std::uint64_t> count;
+		};
+
+		inline constexpr std::size_t check_site_table_size = 256;
+		inline check_site_slot check_site_table[check_site_table_size]{ };
+		/// Failures at sites that did not fit in the table
+		inline std::atomic<std::uint64_t> check_site_overflow{ };
+
+		/// The same header can give a site a different file pointer in each
+		/// translation unit, so the names are compared
+		inline bool same_site( check_site lhs, check_site rhs ) noexcept {
+			if( lhs.line != rhs.line ) {
+				return false;
+			}
+			if( lhs.file == nullptr or rhs.file == nullptr ) {
+				return lhs.file == rhs.file;
+			}
+			return lhs.file == rhs.file or std::strcmp( lhs.file, rhs.file ) == 0;
+		}
+
+		inline void record_check_failure( check_site site ) noexcept {
+			auto const hash = static_cast<std::size_t>( site.line ) * 2654435761U;
+			for( std::size_t n = 0; n < check_site_table_size; ++n ) {
+				auto &slot =
+				  check_site_table[( hash + n ) % check_site_table_size];
+				int state = slot.state.load( std::memory_order_acquire );
+				if( state == 0 and
+				    slot.state.compare_exchange_strong( state, 1,
+				                                        std::memory_order_acq_rel ) ) {
+					slot.site = site;
+					slot.state.store( 2, std::memory_order_release );
+					slot.count.fetch_add( 1, std::memory_order_relaxed );
+					return;
+				}
+				while( state == 1 ) {
+					state = slot.state.load( std::memory_order_acquire );
+				}
+				if( same_site( slot.site, site ) ) {
+					slot.count.fetch_add( 1, std::memory_order_relaxed );
+					return;
+				}
+			}
+			check_site_overflow.fetch_add( 1, std::memory_order_relaxed );
+		}
+	} // namespace exception_details
+
+	/// Call func( check_site_count ) for each site that has failed a check
+	template<typename Function>
+	void for_each_check_failure( Function &&func ) {
+		for( auto const &slot : exception_details::check_site_table ) {
+			if( slot.state.load( std::memory_order_acquire ) == 2 ) {
+				func( check_site_count{
+				  slot.site, slot.count.load( std::memory_order_relaxed ) } );
+			}
+		}
+	}
+
+	/// The total number of failed checks since the program started
+	inline std::uint64_t check_failure_count( ) noexcept {
+		std::uint64_t result =
+		  exception_details::check_site_overflow.load( std::memory_order_relaxed );
+		for( auto const &slot : exception_details::check_site_table ) {
+			result += slot.count.load( std::memory_order_relaxed );
+		}
+		return result;
+	}
+
+#define DAW_RECORD_CHECK_FAILURE( site )                                       \
+	daw::exception::exception_details::record_check_failure( site )
+#else
+#define DAW_RECORD_CHECK_FAILURE( site ) static_cast<void>( site )
+#endif
+
+	namespace exception_details {
+		/// The throw machinery of a failed check lives here, out of line, so
+		/// that the inlined check is only a compare and a rarely taken call
+		template<typename ExceptionType, typename... Args>
+		DAW_ATTRIBUTE_COLD [[noreturn]] void cold_throw_impl( check_site site,
+		                                                      Args... args ) {
+			DAW_RECORD_CHECK_FAILURE( site );
+			daw_throw<ExceptionType>( std::forward<Args>( args )... );
+		}
+
+		/// String literals are passed as pointers so that every message length
+		/// does not get its own copy of the throw code
+		template<typename Arg>
+		using cold_arg_t =
+		  std::conditional_t<std::is_array<std::remove_reference_t<Arg>>::value,
+		                     std::decay_t<Arg>, Arg &&>;
+
+		template<typename ExceptionType, typename... Args>
+		[[noreturn]] inline void cold_throw( check_site site, Args &&... args ) {
+			cold_throw_impl<ExceptionType, cold_arg_t<Args>...>(
+			  site, std::forward<Args>( args )... );
+		}
+
+		DAW_ATTRIBUTE_COLD [[noreturn]] inline void
+		cold_abort( check_site site ) noexcept {
+			DAW_RECORD_CHECK_FAILURE( site );
+			std::abort( );
+		}
+
+		template<typename ExceptionType, typename... Args>
+		[[noreturn]] inline void check_failed( check_site site,
+		                                       Args &&... args ) {
+			if constexpr( std::is_same<Terminator, ExceptionType>::value ) {
+				cold_abort( site );
+			} else {
+				cold_throw<ExceptionType>( site, std::forward<Args>( args )... );
+			}
+		}
+	} // namespace exception_details
+
 #ifndef NODEBUGTHROW
 	template<typename ExceptionType = DefaultException, typename... Args>
 	[[noreturn]] constexpr void debug_throw( Args &&... args ) {
@@ -268,45 +463,47 @@ namespace daw::exception {
 		return true;
 	}
 
-	struct Terminator {};
-
-	template<typename ExceptionType = Terminator, typename Bool, typename... Args>
-	constexpr void precondition_check( Bool &&condition, Args &&... args ) {
-		if( !static_cast<bool>( condition ) ) {
-			if constexpr( std::is_same<Terminator, ExceptionType>::value ) {
-				std::abort( );
-			} else {
-				daw_throw<ExceptionType>( std::forward<Args>( args )... );
-			}
+	template<typename ExceptionType = Terminator, typename... Args>
+	constexpr void precondition_check( check_condition condition,
+	                                   Args &&... args ) {
+		if constexpr( std::is_same<Terminator, ExceptionType>::value and
+		              not contract_checks_v ) {
+			DAW_ASSUME( condition.value );
+		} else if( DAW_UNLIKELY( not condition.value ) ) {
+			exception_details::check_failed<ExceptionType>(
+			  condition.site, std::forward<Args>( args )... );
 		}
 	}
 
-	template<typename ExceptionType = Terminator, typename Bool, typename... Args>
-	constexpr void postcondition_check( Bool &&condition, Args &&... args ) {
-		if( !static_cast<bool>( condition ) ) {
-			if constexpr( std::is_same<Terminator, ExceptionType>::value ) {
-				std::abort( );
-			} else {
-				daw_throw<ExceptionType>( std::forward<Args>( args )... );
-			}
+	template<typename ExceptionType = Terminator, typename... Args>
+	constexpr void postcondition_check( check_condition condition,
+	                                    Args &&... args ) {
+		if constexpr( std::is_same<Terminator, ExceptionType>::value and
+		              not contract_checks_v ) {
+			DAW_ASSUME( condition.value );
+		} else if( DAW_UNLIKELY( not condition.value ) ) {
+			exception_details::check_failed<ExceptionType>(
+			  condition.site, std::forward<Args>( args )... );
 		}
 	}
 #ifndef NODEBUGTHROW
-	template<typename Exception = AssertException, typename Bool,
-	         typename... Args>
-	constexpr void dbg_precondition_check( Bool &&condition, Args &&... ) {
-
-		//			static_assert( std::is_convertible<Bool, bool>::value );
-		if( not static_cast<bool>( condition ) ) {
-			std::abort( );
+	template<typename Exception = AssertException, typename... Args>
+	constexpr void dbg_precondition_check( check_condition condition,
+	                                       Args &&... ) {
+		if constexpr( not contract_checks_v ) {
+			DAW_ASSUME( condition.value );
+		} else if( DAW_UNLIKELY( not condition.value ) ) {
+			exception_details::cold_abort( condition.site );
 		}
 	}
 
-	template<typename Bool, typename... Args>
-	constexpr void dbg_postcondition_check( Bool &&condition, Args &&... ) {
-		static_assert( std::is_convertible<Bool, bool>::value );
-		if( not static_cast<bool>( condition ) ) {
-			std::abort( );
+	template<typename... Args>
+	constexpr void dbg_postcondition_check( check_condition condition,
+	                                        Args &&... ) {
+		if constexpr( not contract_checks_v ) {
+			DAW_ASSUME( condition.value );
+		} else if( DAW_UNLIKELY( not condition.value ) ) {
+			exception_details::cold_abort( condition.site );
 		}
 	}
 #else
@@ -328,11 +525,11 @@ namespace daw::exception {
 		return std::forward<ValueType>( value );
 	}
 
-	template<typename ExceptionType = AssertException, typename Bool,
-	         typename... Args>
-	constexpr void daw_throw_on_false( Bool &&test, Args &&... args ) {
-		if( !static_cast<bool>( std::forward<Bool>( test ) ) ) {
-			daw_throw<ExceptionType>( std::forward<Args>( args )... );
+	template<typename ExceptionType = AssertException, typename... Args>
+	constexpr void daw_throw_on_false( check_condition test, Args &&... args ) {
+		if( DAW_UNLIKELY( not test.value ) ) {
+			exception_details::cold_throw<ExceptionType>(
+			  test.site, std::forward<Args>( args )... );
 		}
 	}
 
@@ -344,17 +541,10 @@ namespace daw::exception {
 		}
 	}
 
-	template<typename ExceptionType = DefaultException, typename Bool>
-	constexpr void daw_throw_on_false( Bool &&test ) {
-		if( !static_cast<bool>( std::forward<Bool>( test ) ) ) {
-			daw_throw<ExceptionType>( );
-		}
-	}
-
-	template<typename ExceptionType = DefaultException, typename Bool>
-	constexpr void daw_throw_on_true( Bool const &test ) {
-		if( static_cast<bool>( test ) ) {
-			daw_throw<ExceptionType>( );
+	template<typename ExceptionType = DefaultException>
+	constexpr void daw_throw_on_false( check_condition test ) {
+		if( DAW_UNLIKELY( not test.value ) ) {
+			exception_details::cold_throw<ExceptionType>( test.site );
 		}
 	}
 
@@ -423,20 +613,21 @@ namespace daw::exception {
 		return false;
 	}
 
-	template<typename ExceptionType = DefaultException, typename Bool>
-	constexpr void daw_throw_on_true( Bool &&test ) {
-		if( static_cast<bool>( std::forward<Bool>( test ) ) ) {
-			daw_throw<ExceptionType>( );
+	template<typename ExceptionType = DefaultException>
+	constexpr void daw_throw_on_true( check_condition test ) {
+		if( DAW_UNLIKELY( test.value ) ) {
+			exception_details::cold_throw<ExceptionType>( test.site );
 		}
 	}
 
 	template<
-	  typename ExceptionType = AssertException, typename Bool, typename... Args,
+	  typename ExceptionType = AssertException, typename... Args,
 	  typename std::enable_if<( sizeof...( Args ) > 0 ), std::nullptr_t>::type =
 	    nullptr>
-	constexpr void daw_throw_on_true( Bool &&test, Args &&... args ) {
-		if( static_cast<bool>( std::forward<Bool>( test ) ) ) {
-			daw_throw<ExceptionType>( std::forward<Args>( args )... );
+	constexpr void daw_throw_on_true( check_condition test, Args &&... args ) {
+		if( DAW_UNLIKELY( test.value ) ) {
+			exception_details::cold_throw<ExceptionType>(
+			  test.site, std::forward<Args>( args )... );
 		}
 	}
 
@@ -10,6 +10,7 @@
 
 #include "cpp_17.h"
 #include "daw_exception.h"
+#include "daw_likely.h"
 #include "daw_move.h"
 #include "daw_overload.h"
 #include "daw_traits.h"
@@ -19,10 +20,13 @@
 #include <ciso646>
 #include <cstddef>
 #include <exception>
+#include <memory>
+#include <new>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -417,6 +421,715 @@ namespace daw {
 	expected_t<Result> expected_from_exception( std::exception_ptr ptr ) {
 		return expected_t<Result>( ptr );
 	}
+
+	/// Tag selecting the error alternative of expected
+	struct unexpect_t {
+		explicit unexpect_t( ) = default;
+	};
+	inline constexpr unexpect_t unexpect{ };
+
+	/// @brief Wraps an error so it can be implicitly converted to an expected
+	template<typename E>
+	class unexpected {
+		static_assert( not std::is_reference_v<E> and not std::is_void_v<E> );
+		E m_error;
+
+	public:
+		template<typename Err = E,
+		         std::enable_if_t<
+		           not std::is_same_v<daw::remove_cvref_t<Err>, unexpected> and
+		             not std::is_same_v<daw::remove_cvref_t<Err>,
+		                                std::in_place_t> and
+		             std::is_constructible_v<E, Err>,
+		           std::nullptr_t> = nullptr>
+		constexpr explicit unexpected( Err &&error )
+		  : m_error( std::forward<Err>( error ) ) {}
+
+		template<typename... Args>
+		constexpr explicit unexpected( std::in_place_t, Args &&... args )
+		  : m_error( std::forward<Args>( args )... ) {}
+
+		constexpr E &error( ) & noexcept {
+			return m_error;
+		}
+
+		constexpr E const &error( ) const & noexcept {
+			return m_error;
+		}
+
+		constexpr E &&error( ) && noexcept {
+			return std::move( m_error );
+		}
+
+		template<typename G>
+		friend constexpr bool operator==( unexpected const &lhs,
+		                                  unexpected<G> const &rhs ) {
+			return lhs.error( ) == rhs.error( );
+		}
+
+		template<typename G>
+		friend constexpr bool operator!=( unexpected const &lhs,
+		                                  unexpected<G> const &rhs ) {
+			return not( lhs.error( ) == rhs.error( ) );
+		}
+	};
+
+	template<typename E>
+	unexpected( E ) -> unexpected<E>;
+
+	/// Thrown by expected::value( ) when there is an error instead
+	template<typename E>
+	class bad_expected_access : public std::exception {
+		E m_error;
+
+	public:
+		explicit bad_expected_access( E error )
+		  : m_error( daw::move( error ) ) {}
+
+		char const *what( ) const noexcept override {
+			return "bad expected access";
+		}
+
+		E const &error( ) const & noexcept {
+			return m_error;
+		}
+
+		E &error( ) & noexcept {
+			return m_error;
+		}
+	};
+
+	template<typename T, typename E>
+	class expected;
+
+	namespace expected_details {
+		/// Stored in place of T when T is void
+		struct void_value {
+			friend constexpr bool operator==( void_value, void_value ) noexcept {
+				return true;
+			}
+		};
+
+		template<typename T>
+		using stored_t = std::conditional_t<std::is_void_v<T>, void_value, T>;
+
+		struct no_init_t {};
+
+		template<typename T>
+		struct is_expected : std::false_type {};
+
+		template<typename T, typename E>
+		struct is_expected<expected<T, E>> : std::true_type {};
+
+		template<typename T>
+		inline constexpr bool is_expected_v =
+		  is_expected<daw::remove_cvref_t<T>>::value;
+
+		template<typename T>
+		struct is_unexpected : std::false_type {};
+
+		template<typename E>
+		struct is_unexpected<unexpected<E>> : std::true_type {};
+
+		template<typename T>
+		inline constexpr bool is_unexpected_v =
+		  is_unexpected<daw::remove_cvref_t<T>>::value;
+
+		/// The value and error share storage, there is no heap allocation and no
+		/// reference count.  m_empty only exists so the copy constructors of
+		/// non-trivial types can start from a constexpr friendly state
+		template<typename T, typename E,
+		         bool = std::is_trivially_destructible_v<T> and
+		                std::is_trivially_destructible_v<E>>
+		struct expected_storage {
+			union {
+				char m_empty;
+				T m_value;
+				E m_error;
+			};
+			bool m_has_value;
+
+			constexpr explicit expected_storage( no_init_t ) noexcept
+			  : m_empty( )
+			  , m_has_value( false ) {}
+
+			template<typename... Args>
+			constexpr explicit expected_storage( std::in_place_t, Args &&... args )
+			  : m_value( std::forward<Args>( args )... )
+			  , m_has_value( true ) {}
+
+			template<typename... Args>
+			constexpr explicit expected_storage( unexpect_t, Args &&... args )
+			  : m_error( std::forward<Args>( args )... )
+			  , m_has_value( false ) {}
+
+			void destroy( ) noexcept {}
+		};
+
+		template<typename T, typename E>
+		struct expected_storage<T, E, false> {
+			union {
+				char m_empty;
+				T m_value;
+				E m_error;
+			};
+			bool m_has_value;
+
+			constexpr explicit expected_storage( no_init_t ) noexcept
+			  : m_empty( )
+			  , m_has_value( false ) {}
+
+			template<typename... Args>
+			constexpr explicit expected_storage( std::in_place_t, Args &&... args )
+			  : m_value( std::forward<Args>( args )... )
+			  , m_has_value( true ) {}
+
+			template<typename... Args>
+			constexpr explicit expected_storage( unexpect_t, Args &&... args )
+			  : m_error( std::forward<Args>( args )... )
+			  , m_has_value( false ) {}
+
+			void destroy( ) noexcept {
+				if( m_has_value ) {
+					m_value.~T( );
+				} else {
+					m_error.~E( );
+				}
+			}
+
+			~expected_storage( ) {
+				destroy( );
+			}
+		};
+
+		/// Destroy old and construct current from args.  If that can throw, old
+		/// is restored so the expected is never left without a value or error
+		template<typename Current, typename Old, typename... Args>
+		void reinit( Current &current, Old &old, Args &&... args ) {
+			if constexpr( std::is_nothrow_constructible_v<Current, Args...> ) {
+				old.~Old( );
+				::new( static_cast<void *>( std::addressof( current ) ) )
+				  Current( std::forward<Args>( args )... );
+			} else if constexpr( std::is_nothrow_move_constructible_v<Current> ) {
+				Current tmp( std::forward<Args>( args )... );
+				old.~Old( );
+				::new( static_cast<void *>( std::addressof( current ) ) )
+				  Current( std::move( tmp ) );
+			} else {
+				static_assert( std::is_nothrow_move_constructible_v<Old>,
+				               "Either the value or error must be nothrow move "
+				               "constructible to assign" );
+				Old tmp( std::move( old ) );
+				old.~Old( );
+#ifdef DAW_USE_EXCEPTIONS
+				try {
+#endif
+					::new( static_cast<void *>( std::addressof( current ) ) )
+					  Current( std::forward<Args>( args )... );
+#ifdef DAW_USE_EXCEPTIONS
+				} catch( ... ) {
+					::new( static_cast<void *>( std::addressof( old ) ) )
+					  Old( std::move( tmp ) );
+					throw;
+				}
+#endif
+			}
+		}
+
+		/// Copy and move for a T or E that is not trivially copyable
+		template<typename T, typename E>
+		struct expected_ops : expected_storage<T, E> {
+			using base_t = expected_storage<T, E>;
+			using base_t::base_t;
+
+			expected_ops( expected_ops const &other )
+			  : base_t( no_init_t{ } ) {
+				if( other.m_has_value ) {
+					::new( static_cast<void *>( std::addressof( this->m_value ) ) )
+					  T( other.m_value );
+				} else {
+					::new( static_cast<void *>( std::addressof( this->m_error ) ) )
+					  E( other.m_error );
+				}
+				this->m_has_value = other.m_has_value;
+			}
+
+			expected_ops( expected_ops &&other ) noexcept(
+			  std::is_nothrow_move_constructible_v<T>
+			    and std::is_nothrow_move_constructible_v<E> )
+			  : base_t( no_init_t{ } ) {
+				if( other.m_has_value ) {
+					::new( static_cast<void *>( std::addressof( this->m_value ) ) )
+					  T( std::move( other.m_value ) );
+				} else {
+					::new( static_cast<void *>( std::addressof( this->m_error ) ) )
+					  E( std::move( other.m_error ) );
+				}
+				this->m_has_value = other.m_has_value;
+			}
+
+			expected_ops &operator=( expected_ops const &rhs ) {
+				if( this->m_has_value and rhs.m_has_value ) {
+					this->m_value = rhs.m_value;
+				} else if( this->m_has_value ) {
+					reinit( this->m_error, this->m_value, rhs.m_error );
+					this->m_has_value = false;
+				} else if( rhs.m_has_value ) {
+					reinit( this->m_value, this->m_error, rhs.m_value );
+					this->m_has_value = true;
+				} else {
+					this->m_error = rhs.m_error;
+				}
+				return *this;
+			}
+
+			expected_ops &operator=( expected_ops &&rhs ) noexcept(
+			  std::is_nothrow_move_constructible_v<T>
+			    and std::is_nothrow_move_assignable_v<T>
+			      and std::is_nothrow_move_constructible_v<E>
+			        and std::is_nothrow_move_assignable_v<E> ) {
+				if( this->m_has_value and rhs.m_has_value ) {
+					this->m_value = std::move( rhs.m_value );
+				} else if( this->m_has_value ) {
+					reinit( this->m_error, this->m_value, std::move( rhs.m_error ) );
+					this->m_has_value = false;
+				} else if( rhs.m_has_value ) {
+					reinit( this->m_value, this->m_error, std::move( rhs.m_value ) );
+					this->m_has_value = true;
+				} else {
+					this->m_error = std::move( rhs.m_error );
+				}
+				return *this;
+			}
+
+			~expected_ops( ) = default;
+		};
+
+		/// When T and E are trivially copyable the union's defaulted copy/move
+		/// operations are used and expected stays trivially copyable
+		template<typename T, typename E>
+		using expected_storage_t =
+		  std::conditional_t<std::is_trivially_copyable_v<T> and
+		                       std::is_trivially_copyable_v<E>,
+		                     expected_storage<T, E>, expected_ops<T, E>>;
+
+		template<typename T, typename E, typename U>
+		inline constexpr bool is_value_constructor_v =
+		  not std::is_void_v<T> and
+		  not std::is_same_v<daw::remove_cvref_t<U>, std::in_place_t> and
+		  not std::is_same_v<daw::remove_cvref_t<U>, unexpect_t> and
+		  not is_expected_v<U> and not is_unexpected_v<U> and
+		  std::is_constructible_v<stored_t<T>, U>;
+	} // namespace expected_details
+
+	/// @brief Holds either a T or an error E, in the style of std::expected.
+	/// Nothing is allocated and no exception machinery is involved in creating
+	/// or propagating an error, and when T and E are trivially copyable so is
+	/// expected, so it is passed around in registers.  T may be void.
+	/// and_then/transform/or_else/transform_error chain operations that only
+	/// run on the success or error path
+	template<typename T, typename E>
+	class expected
+	  : private traits_details::delete_copy_constructor_if<
+	      not( std::is_copy_constructible_v<expected_details::stored_t<T>> and
+	           std::is_copy_constructible_v<E> )>,
+	    private traits_details::delete_move_constructor_if<
+	      not( std::is_move_constructible_v<expected_details::stored_t<T>> and
+	           std::is_move_constructible_v<E> )>,
+	    private traits_details::delete_copy_assignment_if<
+	      not( std::is_copy_assignable_v<expected_details::stored_t<T>> and
+	           std::is_copy_assignable_v<E> )>,
+	    private traits_details::delete_move_assignment_if<
+	      not( std::is_move_assignable_v<expected_details::stored_t<T>> and
+	           std::is_move_assignable_v<E> )> {
+
+		static_assert( not std::is_reference_v<T> and not std::is_reference_v<E> );
+		static_assert( not std::is_void_v<E> );
+
+		using stored_type = expected_details::stored_t<T>;
+		using storage_t = expected_details::expected_storage_t<stored_type, E>;
+
+		// A member rather than a base, and with no base of its own when T and E
+		// are trivially copyable.  GCC only returns a small expected in
+		// registers, without a partial store and reload, when the union is not
+		// built by a base class constructor
+		storage_t m_storage;
+
+		template<typename, typename>
+		friend class expected;
+
+	public:
+		using value_type = T;
+		using error_type = E;
+		using unexpected_type = unexpected<E>;
+		using reference = std::add_lvalue_reference_t<T>;
+		using const_reference = std::add_lvalue_reference_t<
+		  std::conditional_t<std::is_void_v<T>, void, T const>>;
+		using rvalue_reference = std::add_rvalue_reference_t<T>;
+
+		template<typename U>
+		using rebind = expected<U, E>;
+
+		/// A value initialized T
+		template<typename U = stored_type,
+		         std::enable_if_t<std::is_default_constructible_v<U>,
+		                          std::nullptr_t> = nullptr>
+		constexpr expected( )
+		  : m_storage( std::in_place ) {}
+
+		template<typename U = stored_type,
+		         std::enable_if_t<
+		           expected_details::is_value_constructor_v<T, E, U>,
+		           std::nullptr_t> = nullptr>
+		constexpr expected( U &&value )
+		  : m_storage( std::in_place, std::forward<U>( value ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<std::is_constructible_v<E, G const &>,
+		                          std::nullptr_t> = nullptr>
+		constexpr expected( unexpected<G> const &error )
+		  : m_storage( unexpect, error.error( ) ) {}
+
+		template<
+		  typename G,
+		  std::enable_if_t<std::is_constructible_v<E, G>, std::nullptr_t> = nullptr>
+		constexpr expected( unexpected<G> &&error )
+		  : m_storage( unexpect, std::move( error ).error( ) ) {}
+
+		template<typename... Args>
+		constexpr explicit expected( std::in_place_t, Args &&... args )
+		  : m_storage( std::in_place, std::forward<Args>( args )... ) {}
+
+		template<typename... Args>
+		constexpr explicit expected( unexpect_t, Args &&... args )
+		  : m_storage( unexpect, std::forward<Args>( args )... ) {}
+
+		constexpr bool has_value( ) const noexcept {
+			return m_storage.m_has_value;
+		}
+
+		constexpr explicit operator bool( ) const noexcept {
+			return m_storage.m_has_value;
+		}
+
+		/// The value, throws bad_expected_access<E> when holding an error
+		constexpr reference value( ) & {
+			check_value( );
+			if constexpr( not std::is_void_v<T> ) {
+				return m_storage.m_value;
+			}
+		}
+
+		constexpr const_reference value( ) const & {
+			check_value( );
+			if constexpr( not std::is_void_v<T> ) {
+				return m_storage.m_value;
+			}
+		}
+
+		constexpr rvalue_reference value( ) && {
+			check_value( );
+			if constexpr( not std::is_void_v<T> ) {
+				return std::move( m_storage.m_value );
+			}
+		}
+
+		/// The error, has_value( ) must be false
+		constexpr E &error( ) & noexcept {
+			return m_storage.m_error;
+		}
+
+		constexpr E const &error( ) const & noexcept {
+			return m_storage.m_error;
+		}
+
+		constexpr E &&error( ) && noexcept {
+			return std::move( m_storage.m_error );
+		}
+
+		/// Unchecked access to the value, has_value( ) must be true
+		template<typename U = T,
+		         std::enable_if_t<not std::is_void_v<U>, std::nullptr_t> = nullptr>
+		constexpr U &operator*( ) & noexcept {
+			return m_storage.m_value;
+		}
+
+		template<typename U = T,
+		         std::enable_if_t<not std::is_void_v<U>, std::nullptr_t> = nullptr>
+		constexpr U const &operator*( ) const & noexcept {
+			return m_storage.m_value;
+		}
+
+		template<typename U = T,
+		         std::enable_if_t<not std::is_void_v<U>, std::nullptr_t> = nullptr>
+		constexpr U &&operator*( ) && noexcept {
+			return std::move( m_storage.m_value );
+		}
+
+		template<typename U = T,
+		         std::enable_if_t<not std::is_void_v<U>, std::nullptr_t> = nullptr>
+		constexpr U *operator->( ) noexcept {
+			return std::addressof( m_storage.m_value );
+		}
+
+		template<typename U = T,
+		         std::enable_if_t<not std::is_void_v<U>, std::nullptr_t> = nullptr>
+		constexpr U const *operator->( ) const noexcept {
+			return std::addressof( m_storage.m_value );
+		}
+
+		template<typename U>
+		constexpr stored_type value_or( U &&default_value ) const & {
+			static_assert( not std::is_void_v<T> );
+			if( DAW_LIKELY( has_value( ) ) ) {
+				return m_storage.m_value;
+			}
+			return static_cast<stored_type>( std::forward<U>( default_value ) );
+		}
+
+		template<typename U>
+		constexpr stored_type value_or( U &&default_value ) && {
+			static_assert( not std::is_void_v<T> );
+			if( DAW_LIKELY( has_value( ) ) ) {
+				return std::move( m_storage.m_value );
+			}
+			return static_cast<stored_type>( std::forward<U>( default_value ) );
+		}
+
+		/// Replace the contents with a T constructed from args.  If that
+		/// throws, the previous value or error is kept
+		template<typename... Args>
+		stored_type &emplace( Args &&... args ) {
+			if( has_value( ) ) {
+				expected_details::reinit( m_storage.m_value, m_storage.m_value,
+				                          std::forward<Args>( args )... );
+			} else {
+				expected_details::reinit( m_storage.m_value, m_storage.m_error,
+				                          std::forward<Args>( args )... );
+			}
+			m_storage.m_has_value = true;
+			return m_storage.m_value;
+		}
+
+		/// func( value ) -> expected<U, E>, only called when there is a value
+		template<typename Function>
+		constexpr auto and_then( Function &&func ) & {
+			return and_then_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto and_then( Function &&func ) const & {
+			return and_then_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto and_then( Function &&func ) && {
+			return and_then_impl( std::move( *this ),
+			                      std::forward<Function>( func ) );
+		}
+
+		/// func( value ) -> U, giving expected<U, E>
+		template<typename Function>
+		constexpr auto transform( Function &&func ) & {
+			return transform_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto transform( Function &&func ) const & {
+			return transform_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto transform( Function &&func ) && {
+			return transform_impl( std::move( *this ),
+			                       std::forward<Function>( func ) );
+		}
+
+		/// func( error ) -> expected<T, G>, only called when there is an error
+		template<typename Function>
+		constexpr auto or_else( Function &&func ) & {
+			return or_else_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto or_else( Function &&func ) const & {
+			return or_else_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto or_else( Function &&func ) && {
+			return or_else_impl( std::move( *this ),
+			                     std::forward<Function>( func ) );
+		}
+
+		/// func( error ) -> G, giving expected<T, G>
+		template<typename Function>
+		constexpr auto transform_error( Function &&func ) & {
+			return transform_error_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto transform_error( Function &&func ) const & {
+			return transform_error_impl( *this, std::forward<Function>( func ) );
+		}
+
+		template<typename Function>
+		constexpr auto transform_error( Function &&func ) && {
+			return transform_error_impl( std::move( *this ),
+			                             std::forward<Function>( func ) );
+		}
+
+		template<typename U, typename G>
+		friend constexpr bool operator==( expected const &lhs,
+		                                  expected<U, G> const &rhs ) {
+			if( lhs.has_value( ) != rhs.has_value( ) ) {
+				return false;
+			}
+			if( lhs.has_value( ) ) {
+				return lhs.m_storage.m_value == rhs.m_storage.m_value;
+			}
+			return lhs.m_storage.m_error == rhs.m_storage.m_error;
+		}
+
+		template<typename U, typename G>
+		friend constexpr bool operator!=( expected const &lhs,
+		                                  expected<U, G> const &rhs ) {
+			return not( lhs == rhs );
+		}
+
+		template<typename U,
+		         std::enable_if_t<not expected_details::is_expected_v<U> and
+		                            not expected_details::is_unexpected_v<U>,
+		                          std::nullptr_t> = nullptr>
+		friend constexpr bool operator==( expected const &lhs, U const &rhs ) {
+			return lhs.has_value( ) and lhs.m_storage.m_value == rhs;
+		}
+
+		template<typename U,
+		         std::enable_if_t<not expected_details::is_expected_v<U> and
+		                            not expected_details::is_unexpected_v<U>,
+		                          std::nullptr_t> = nullptr>
+		friend constexpr bool operator!=( expected const &lhs, U const &rhs ) {
+			return not( lhs == rhs );
+		}
+
+		template<typename G>
+		friend constexpr bool operator==( expected const &lhs,
+		                                  unexpected<G> const &rhs ) {
+			return not lhs.has_value( ) and lhs.m_storage.m_error == rhs.error( );
+		}
+
+		template<typename G>
+		friend constexpr bool operator!=( expected const &lhs,
+		                                  unexpected<G> const &rhs ) {
+			return not( lhs == rhs );
+		}
+
+	private:
+		constexpr void check_value( ) const {
+			if( DAW_UNLIKELY( not has_value( ) ) ) {
+				daw::exception::daw_throw<bad_expected_access<E>>( m_storage.m_error );
+			}
+		}
+
+		// Self is an expected with the value category and constness of *this
+		template<typename Self>
+		static constexpr decltype( auto ) value_of( Self &&self ) {
+			return ( std::forward<Self>( self ).m_storage.m_value );
+		}
+
+		template<typename Self>
+		static constexpr decltype( auto ) error_of( Self &&self ) {
+			return ( std::forward<Self>( self ).m_storage.m_error );
+		}
+
+		template<typename Self, typename Function>
+		static constexpr decltype( auto ) invoke_value( Self &&self,
+		                                                Function &&func ) {
+			if constexpr( std::is_void_v<T> ) {
+				(void)self;
+				return std::forward<Function>( func )( );
+			} else {
+				return daw::invoke( std::forward<Function>( func ),
+				                    value_of( std::forward<Self>( self ) ) );
+			}
+		}
+
+		template<typename Self, typename Function>
+		static constexpr auto and_then_impl( Self &&self, Function &&func ) {
+			using result_t = daw::remove_cvref_t<decltype( invoke_value(
+			  std::forward<Self>( self ), std::forward<Function>( func ) ) )>;
+			static_assert( expected_details::is_expected_v<result_t>,
+			               "and_then must return an expected" );
+			static_assert( std::is_same_v<typename result_t::error_type, E>,
+			               "and_then must keep the error type" );
+			if( DAW_LIKELY( self.has_value( ) ) ) {
+				return invoke_value( std::forward<Self>( self ),
+				                     std::forward<Function>( func ) );
+			}
+			return result_t( unexpect, error_of( std::forward<Self>( self ) ) );
+		}
+
+		template<typename Self, typename Function>
+		static constexpr auto transform_impl( Self &&self, Function &&func ) {
+			using value_t = std::remove_cv_t<decltype( invoke_value(
+			  std::forward<Self>( self ), std::forward<Function>( func ) ) )>;
+			using result_t = expected<value_t, E>;
+			if( DAW_LIKELY( self.has_value( ) ) ) {
+				if constexpr( std::is_void_v<value_t> ) {
+					invoke_value( std::forward<Self>( self ),
+					              std::forward<Function>( func ) );
+					return result_t( );
+				} else {
+					return result_t( std::in_place,
+					                 invoke_value( std::forward<Self>( self ),
+					                               std::forward<Function>( func ) ) );
+				}
+			}
+			return result_t( unexpect, error_of( std::forward<Self>( self ) ) );
+		}
+
+		template<typename Self, typename Function>
+		static constexpr auto or_else_impl( Self &&self, Function &&func ) {
+			using result_t = daw::remove_cvref_t<decltype( daw::invoke(
+			  std::forward<Function>( func ),
+			  error_of( std::forward<Self>( self ) ) ) )>;
+			static_assert( expected_details::is_expected_v<result_t>,
+			               "or_else must return an expected" );
+			static_assert( std::is_same_v<typename result_t::value_type, T>,
+			               "or_else must keep the value type" );
+			if( DAW_LIKELY( self.has_value( ) ) ) {
+				if constexpr( std::is_void_v<T> ) {
+					return result_t( );
+				} else {
+					return result_t( std::in_place,
+					                 value_of( std::forward<Self>( self ) ) );
+				}
+			}
+			return daw::invoke( std::forward<Function>( func ),
+			                    error_of( std::forward<Self>( self ) ) );
+		}
+
+		template<typename Self, typename Function>
+		static constexpr auto transform_error_impl( Self &&self,
+		                                            Function &&func ) {
+			using error_t = std::remove_cv_t<decltype( daw::invoke(
+			  std::forward<Function>( func ),
+			  error_of( std::forward<Self>( self ) ) ) )>;
+			using result_t = expected<T, error_t>;
+			if( DAW_LIKELY( self.has_value( ) ) ) {
+				if constexpr( std::is_void_v<T> ) {
+					return result_t( );
+				} else {
+					return result_t( std::in_place,
+					                 value_of( std::forward<Self>( self ) ) );
+				}
+			}
+			return result_t( unexpect,
+			                 daw::invoke( std::forward<Function>( func ),
+			                              error_of( std::forward<Self>( self ) ) ) );
+		}
+	};
 } // namespace daw
 
 #ifdef DAW_USE_EXCEPTIONS
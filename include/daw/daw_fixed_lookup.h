@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "daw_bit.h"
 #include "daw_bounded_array.h"
 #include "daw_exception.h"
 #include "daw_generic_hash.h"
@@ -16,6 +17,7 @@
 #include "daw_utility.h"
 
 #include <ciso646>
+#include <cstddef>
 #include <stdexcept>
 #include <type_traits>
 
@@ -39,6 +41,14 @@ namespace daw {
 			static constexpr uint32_t const a = 4093082899UL;
 			static constexpr uint32_t const b = 3367900313UL;
 		};
+
+		inline constexpr size_t fixed_lookup_bucket_bytes = 64U;
+
+		template<typename HashValue, typename Value>
+		inline constexpr size_t fixed_lookup_slots_per_bucket =
+		  fixed_lookup_bucket_bytes / ( sizeof( HashValue ) + sizeof( Value ) ) > 0
+		    ? fixed_lookup_bucket_bytes / ( sizeof( HashValue ) + sizeof( Value ) )
+		    : 1U;
 	} // namespace impl
 
 	///
@@ -192,4 +202,174 @@ namespace daw {
 		Unused( lst );
 		return result;
 	}
+
+	///
+	/// A fixed lookup table with the same interface as fixed_lookup, but the
+	/// storage is split into cache line sized buckets.  Each bucket holds the
+	/// hashes of its slots followed by their values, so a lookup that lands in
+	/// a bucket with a free slot only touches that one cache line.  The bucket
+	/// count is a power of two and buckets are selected with a mask.
+	/// Capacity is at least N and is rounded up to fill whole buckets
+	template<typename Value, size_t N, size_t HashSize = sizeof( size_t )>
+	struct bucketed_fixed_lookup {
+		static_assert( std::is_default_constructible_v<Value>,
+		               "Value must be default constructible" );
+		static_assert( N > 0, "Must supply a positive initial_size larger than 0" );
+
+		using value_t = daw::traits::root_type_t<Value>;
+		using hash_value_t = typename daw::generic_hash_t<HashSize>::hash_value_t;
+		using reference = value_t &;
+		using const_reference = value_t const &;
+
+		static constexpr size_t slots_per_bucket =
+		  impl::fixed_lookup_slots_per_bucket<hash_value_t, value_t>;
+		static constexpr size_t bucket_count =
+		  daw::bit_ceil( ( N + slots_per_bucket - 1U ) / slots_per_bucket );
+
+		static_assert(
+		  bucket_count * slots_per_bucket <=
+		    std::numeric_limits<hash_value_t>::max( ),
+		  "Cannot allocate more values than can be addressed by hash value" );
+
+	private:
+		static constexpr size_t bucket_mask = bucket_count - 1U;
+
+		struct alignas( impl::fixed_lookup_bucket_bytes ) bucket_t {
+			hash_value_t hashes[slots_per_bucket]{ };
+			value_t values[slots_per_bucket]{ };
+		};
+
+		bucket_t m_buckets[bucket_count]{ };
+
+	public:
+		static constexpr hash_value_t capacity( ) noexcept {
+			return static_cast<hash_value_t>( bucket_count * slots_per_bucket );
+		}
+
+		constexpr hash_value_t size( ) const noexcept {
+			hash_value_t count = 0;
+			for( auto const &bucket : m_buckets ) {
+				for( auto hash : bucket.hashes ) {
+					count += hash >= impl::sentinals::sentinals_size ? 1 : 0;
+				}
+			}
+			return count;
+		}
+
+	private:
+		template<typename KeyType>
+		static constexpr hash_value_t hash_fn( KeyType &&key ) noexcept {
+			auto const hash =
+			  daw::generic_hash<HashSize>( std::forward<KeyType>( key ) );
+			auto const divisor = std::numeric_limits<hash_value_t>::max( ) -
+			                     impl::sentinals::sentinals_size;
+			return ( hash % divisor ) + impl::sentinals::sentinals_size;
+		}
+
+		static constexpr size_t bucket_index( hash_value_t const hash ) noexcept {
+			// Fold the high bits in so that masking does not only see the low bits
+			constexpr auto half_bits = daw::bsizeof<hash_value_t> / 2U;
+			return static_cast<size_t>( hash ^ ( hash >> half_bits ) ) &
+			       bucket_mask;
+		}
+
+		constexpr auto lookup( hash_value_t const hash ) const noexcept {
+			struct lookup_result_t {
+				hash_value_t position;
+				bool found;
+
+				constexpr lookup_result_t( size_t pos, bool is_found ) noexcept
+				  : position{ static_cast<hash_value_t>( pos ) }
+				  , found{ is_found } {}
+
+				constexpr operator bool( ) const noexcept {
+					return found;
+				}
+			};
+
+			auto bucket = bucket_index( hash );
+			for( size_t probe = 0; probe < bucket_count; ++probe ) {
+				auto const &hashes = m_buckets[bucket].hashes;
+				for( size_t slot = 0; slot < slots_per_bucket; ++slot ) {
+					if( hashes[slot] == hash ) {
+						return lookup_result_t{ bucket * slots_per_bucket + slot, true };
+					} else if( hashes[slot] == impl::sentinals::empty ) {
+						return lookup_result_t{ bucket * slots_per_bucket + slot, false };
+					}
+				}
+				bucket = ( bucket + 1U ) & bucket_mask;
+			}
+			return lookup_result_t{ capacity( ), false };
+		}
+
+		constexpr hash_value_t &hash_at( hash_value_t position ) noexcept {
+			return m_buckets[position / slots_per_bucket]
+			  .hashes[position % slots_per_bucket];
+		}
+
+		constexpr hash_value_t insert_hash( hash_value_t const hash ) {
+			auto const is_found = lookup( hash );
+			daw::exception::daw_throw_on_true(
+			  !is_found and is_found.position == capacity( ),
+			  "Fixed hash table does not have enough space to allocate all entries" );
+			hash_at( is_found.position ) = hash;
+			return is_found.position;
+		}
+
+	public:
+		constexpr bucketed_fixed_lookup( ) noexcept(
+		  std::is_nothrow_default_constructible_v<value_t> ) = default;
+
+		template<typename Key>
+		constexpr hash_value_t find_existing( Key &&key ) const {
+			auto const hash = hash_fn( std::forward<Key>( key ) );
+			auto const is_found = lookup( hash );
+			daw::exception::daw_throw_on_false(
+			  is_found, "Attempt to access an undefined key" );
+			return is_found.position;
+		}
+
+		template<typename Key>
+		constexpr hash_value_t insert( Key &&key, Value value ) {
+			auto const position =
+			  insert_hash( hash_fn( std::forward<Key>( key ) ) );
+			get_existing( position ) = daw::move( value );
+			return position;
+		}
+
+		constexpr reference get_existing( hash_value_t position ) {
+			return m_buckets[position / slots_per_bucket]
+			  .values[position % slots_per_bucket];
+		}
+
+		constexpr const_reference get_existing( hash_value_t position ) const {
+			return m_buckets[position / slots_per_bucket]
+			  .values[position % slots_per_bucket];
+		}
+
+		template<typename Key>
+		constexpr const_reference operator[]( Key &&key ) const {
+			return get_existing( find_existing( std::forward<Key>( key ) ) );
+		}
+
+		template<typename Key>
+		constexpr reference operator[]( Key &&key ) {
+			return get_existing(
+			  insert_hash( hash_fn( std::forward<Key>( key ) ) ) );
+		}
+
+		template<typename Key>
+		constexpr bool exists( Key &&key ) const noexcept {
+			auto const hash = hash_fn( std::forward<Key>( key ) );
+			return static_cast<bool>( lookup( hash ) );
+		}
+	};
+
+	template<typename Value, size_t HashSize = sizeof( size_t ), typename... Keys>
+	constexpr auto make_bucketed_fixed_lookup( Keys &&... keys ) {
+		bucketed_fixed_lookup<Value, sizeof...( Keys ), HashSize> result{ };
+		auto const lst = { ( result[keys] = Value{ }, 0 )... };
+		Unused( lst );
+		return result;
+	}
 } // namespace daw
@@ -0,0 +1,26 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include <type_traits>
+
+// DAW_IS_CONSTANT_EVALUATED( ) is only defined when the compiler can tell,
+// check for DAW_HAS_IS_CONSTANT_EVALUATED before choosing a runtime only path
+#if defined( __cpp_lib_is_constant_evaluated )
+#define DAW_HAS_IS_CONSTANT_EVALUATED
+#define DAW_IS_CONSTANT_EVALUATED( ) std::is_constant_evaluated( )
+#elif defined( __has_builtin )
+#if __has_builtin( __builtin_is_constant_evaluated )
+#define DAW_HAS_IS_CONSTANT_EVALUATED
+#define DAW_IS_CONSTANT_EVALUATED( ) __builtin_is_constant_evaluated( )
+#endif
+#elif defined( __GNUC__ ) and not defined( __clang__ ) and __GNUC__ >= 9
+#define DAW_HAS_IS_CONSTANT_EVALUATED
+#define DAW_IS_CONSTANT_EVALUATED( ) __builtin_is_constant_evaluated( )
+#endif
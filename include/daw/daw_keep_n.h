@@ -9,12 +9,16 @@
 #pragma once
 
 #include "daw_move.h"
+#include "daw_swap.h"
 
 #include <array>
 #include <ciso646>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 namespace daw {
 	enum class keep_n_order { ascending, descending };
@@ -50,6 +54,10 @@ namespace daw {
 				}
 			}
 		};
+
+		// Candidates are tested against the current threshold this many at a
+		// time so the test compiles to a vector compare and a single branch
+		inline constexpr std::size_t keep_n_block_size = 16;
 	} // namespace keep_n_impl
 
 	template<typename T, size_t MaxItems,
@@ -140,4 +148,231 @@ namespace daw {
 			return m_values.back( );
 		}
 	};
+
+	/// @brief Keep the best MaxItems values seen, for large MaxItems.  The kept
+	/// values form a binary heap with the worst kept value at the root, so an
+	/// insert is one compare against the threshold and O(log K) when it
+	/// enters.  Ranges of arithmetic values are filtered in blocks against the
+	/// threshold first.  Instances can be merged, e.g. per thread results.
+	/// Iteration is in heap order, use sorted( ) or copy_sorted for best first
+	template<typename T, size_t MaxItems,
+	         keep_n_order Order = keep_n_order::ascending,
+	         typename Predicate = std::less<>>
+	class keep_n_heap {
+		static_assert( MaxItems > 0, "Must keep at least one item" );
+		using values_type = std::array<T, MaxItems>;
+
+	public:
+		using value_type = typename values_type::value_type;
+		using difference_type = typename values_type::difference_type;
+		using size_type = typename values_type::size_type;
+		using reference = typename values_type::reference;
+		using const_reference = typename values_type::const_reference;
+		using iterator = typename values_type::iterator;
+		using const_iterator = typename values_type::const_iterator;
+
+	private:
+		values_type m_values{ };
+		size_type m_size = 0;
+		Predicate m_pred{ };
+
+		/// lhs should be kept in preference to rhs
+		constexpr bool better( value_type const &lhs,
+		                       value_type const &rhs ) const {
+			if constexpr( Order == keep_n_order::ascending ) {
+				return m_pred( lhs, rhs );
+			} else {
+				return m_pred( rhs, lhs );
+			}
+		}
+
+		constexpr void sift_up( size_type idx ) {
+			while( idx > 0 ) {
+				size_type const parent = ( idx - 1 ) / 2;
+				if( not better( m_values[parent], m_values[idx] ) ) {
+					return;
+				}
+				daw::cswap( m_values[parent], m_values[idx] );
+				idx = parent;
+			}
+		}
+
+		constexpr void sift_down( size_type idx, size_type len ) {
+			while( true ) {
+				size_type worst = 2 * idx + 1;
+				if( worst >= len ) {
+					return;
+				}
+				if( worst + 1 < len and
+				    better( m_values[worst], m_values[worst + 1] ) ) {
+					++worst;
+				}
+				if( not better( m_values[idx], m_values[worst] ) ) {
+					return;
+				}
+				daw::cswap( m_values[idx], m_values[worst] );
+				idx = worst;
+			}
+		}
+
+		/// Inserting from m_values would read it while it changes, so build the
+		/// result in place: heap sort best first, write each value twice from
+		/// the back, then reverse to worst first which is a valid heap
+		constexpr void merge_self( ) {
+			for( size_type len = m_size; len > 1; --len ) {
+				daw::cswap( m_values[0], m_values[len - 1] );
+				sift_down( 0, len - 1 );
+			}
+			size_type const new_size =
+			  2 * m_size < MaxItems ? 2 * m_size : MaxItems;
+			for( size_type n = new_size; n-- > 0; ) {
+				m_values[n] = m_values[n / 2];
+			}
+			for( size_type lo = 0, hi = new_size; lo + 1 < hi; ++lo, --hi ) {
+				daw::cswap( m_values[lo], m_values[hi - 1] );
+			}
+			m_size = new_size;
+		}
+
+		template<typename U>
+		constexpr void insert_impl( U &&v ) {
+			if( m_size < MaxItems ) {
+				m_values[m_size] = std::forward<U>( v );
+				sift_up( m_size );
+				++m_size;
+			} else if( better( v, m_values[0] ) ) {
+				m_values[0] = std::forward<U>( v );
+				sift_down( 0, m_size );
+			}
+		}
+
+	public:
+		constexpr keep_n_heap( ) = default;
+
+		constexpr explicit keep_n_heap( Predicate const &pred )
+		  : m_pred( pred ) {}
+
+		constexpr void insert( value_type const &v ) {
+			insert_impl( v );
+		}
+
+		constexpr void insert( value_type &&v ) {
+			insert_impl( daw::move( v ) );
+		}
+
+		/// Insert every value in [first, last).  Once full, arithmetic values
+		/// from random access ranges are tested a block at a time and blocks with
+		/// nothing better than the current threshold are skipped whole
+		template<typename Iterator, typename Last>
+		constexpr void insert( Iterator first, Last last ) {
+			while( m_size < MaxItems and first != last ) {
+				insert_impl( *first );
+				++first;
+			}
+			using category_t =
+			  typename std::iterator_traits<Iterator>::iterator_category;
+			if constexpr( std::is_arithmetic_v<value_type> and
+			              std::is_base_of_v<std::random_access_iterator_tag,
+			                                category_t> and
+			              std::is_same_v<Iterator, Last> ) {
+				constexpr auto block_size =
+				  static_cast<difference_type>( keep_n_impl::keep_n_block_size );
+				while( last - first >= block_size ) {
+					value_type const threshold = m_values[0];
+					bool any_better = false;
+					for( difference_type n = 0; n < block_size; ++n ) {
+						any_better |= better( static_cast<value_type>( first[n] ),
+						                      threshold );
+					}
+					if( any_better ) {
+						for( difference_type n = 0; n < block_size; ++n ) {
+							insert_impl( first[n] );
+						}
+					}
+					first += block_size;
+				}
+			}
+			while( first != last ) {
+				insert_impl( *first );
+				++first;
+			}
+		}
+
+		/// Combine another result set into this one.  Merging with itself keeps
+		/// every value twice, the same as merging a copy
+		template<size_t OtherMax>
+		constexpr void
+		merge( keep_n_heap<T, OtherMax, Order, Predicate> const &other ) {
+			if constexpr( OtherMax == MaxItems ) {
+				if( &other == this ) {
+					merge_self( );
+					return;
+				}
+			}
+			insert( other.begin( ), other.end( ) );
+		}
+
+		constexpr void clear( ) noexcept {
+			m_size = 0;
+		}
+
+		/// The worst value still kept, candidates must beat it to enter once full
+		constexpr const_reference threshold( ) const noexcept {
+			return m_values[0];
+		}
+
+		constexpr bool full( ) const noexcept {
+			return m_size == MaxItems;
+		}
+
+		constexpr bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		constexpr size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		static constexpr size_type capacity( ) noexcept {
+			return MaxItems;
+		}
+
+		constexpr const_iterator begin( ) const noexcept {
+			return m_values.begin( );
+		}
+
+		constexpr const_iterator cbegin( ) const noexcept {
+			return m_values.cbegin( );
+		}
+
+		constexpr const_iterator end( ) const noexcept {
+			return m_values.begin( ) + static_cast<difference_type>( m_size );
+		}
+
+		constexpr const_iterator cend( ) const noexcept {
+			return end( );
+		}
+
+		/// Write the kept values best first
+		template<typename OutputIterator>
+		constexpr OutputIterator copy_sorted( OutputIterator out ) const {
+			auto tmp = *this;
+			for( size_type len = m_size; len > 1; --len ) {
+				daw::cswap( tmp.m_values[0], tmp.m_values[len - 1] );
+				tmp.sift_down( 0, len - 1 );
+			}
+			for( size_type n = 0; n < m_size; ++n ) {
+				*out = tmp.m_values[n];
+				++out;
+			}
+			return out;
+		}
+
+		std::vector<value_type> sorted( ) const {
+			std::vector<value_type> result{ };
+			result.reserve( m_size );
+			copy_sorted( std::back_inserter( result ) );
+			return result;
+		}
+	};
 } // namespace daw
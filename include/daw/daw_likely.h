@@ -0,0 +1,31 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+// Branch hints for C++17, where [[likely]]/[[unlikely]] are not available.
+// e.g. if( DAW_LIKELY( has_value( ) ) ) { ... }
+#if defined( __GNUC__ ) or defined( __clang__ )
+#define DAW_LIKELY( ... )                                                      \
+	__builtin_expect( static_cast<bool>( __VA_ARGS__ ), 1 )
+#define DAW_UNLIKELY( ... )                                                    \
+	__builtin_expect( static_cast<bool>( __VA_ARGS__ ), 0 )
+#else
+#define DAW_LIKELY( ... ) static_cast<bool>( __VA_ARGS__ )
+#define DAW_UNLIKELY( ... ) static_cast<bool>( __VA_ARGS__ )
+#endif
+
+// Marks a function as rarely called so it is placed out of line, away from
+// the hot code that calls it
+#if defined( __GNUC__ ) or defined( __clang__ )
+#define DAW_ATTRIBUTE_COLD [[gnu::cold, gnu::noinline]]
+#elif defined( _MSC_VER )
+#define DAW_ATTRIBUTE_COLD __declspec( noinline )
+#else
+#define DAW_ATTRIBUTE_COLD
+#endif
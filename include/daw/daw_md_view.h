@@ -0,0 +1,483 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_exception.h"
+
+#include <algorithm>
+#include <array>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace daw {
+	template<std::size_t N>
+	using md_extents = std::array<std::size_t, N>;
+
+	/// Edge length, in elements, of the tiles used by the tiled walks.  Two
+	/// 32x32 tiles of doubles are 16KiB and fit in L1 together
+	inline constexpr std::size_t md_default_tile = 32;
+
+	namespace md_view_details {
+		template<std::size_t N>
+		constexpr std::size_t product( md_extents<N> const &extents ) {
+			std::size_t result = 1;
+			for( std::size_t n : extents ) {
+				result *= n;
+			}
+			return result;
+		}
+
+		constexpr std::size_t next_pow2( std::size_t n ) {
+			std::size_t result = 1;
+			while( result < n ) {
+				result <<= 1U;
+			}
+			return result;
+		}
+
+		constexpr std::size_t log2_pow2( std::size_t n ) {
+			std::size_t result = 0;
+			while( n > 1 ) {
+				n >>= 1U;
+				++result;
+			}
+			return result;
+		}
+
+		/// Move the low 32 bits of n to the even bit positions
+		constexpr std::uint64_t spread_bits( std::uint64_t n ) {
+			n &= 0xFFFF'FFFFULL;
+			n = ( n | ( n << 16U ) ) & 0x0000'FFFF'0000'FFFFULL;
+			n = ( n | ( n << 8U ) ) & 0x00FF'00FF'00FF'00FFULL;
+			n = ( n | ( n << 4U ) ) & 0x0F0F'0F0F'0F0F'0F0FULL;
+			n = ( n | ( n << 2U ) ) & 0x3333'3333'3333'3333ULL;
+			n = ( n | ( n << 1U ) ) & 0x5555'5555'5555'5555ULL;
+			return n;
+		}
+
+		template<typename... Indices>
+		inline constexpr bool are_indices_v =
+		  ( std::is_integral_v<Indices> and ... );
+
+		/// Extents and strides shared by the strided layouts
+		template<std::size_t N>
+		class strided_mapping {
+		protected:
+			md_extents<N> m_extents{ };
+			md_extents<N> m_strides{ };
+
+		public:
+			static constexpr bool is_strided = true;
+
+			constexpr strided_mapping( ) = default;
+			constexpr strided_mapping( md_extents<N> const &extents,
+			                           md_extents<N> const &strides )
+			  : m_extents( extents )
+			  , m_strides( strides ) {}
+
+			constexpr md_extents<N> const &extents( ) const {
+				return m_extents;
+			}
+
+			constexpr md_extents<N> const &strides( ) const {
+				return m_strides;
+			}
+
+			constexpr std::size_t stride( std::size_t dim ) const {
+				return m_strides[dim];
+			}
+
+			constexpr std::size_t
+			operator( )( md_extents<N> const &indices ) const {
+				std::size_t result = 0;
+				for( std::size_t d = 0; d < N; ++d ) {
+					result += indices[d] * m_strides[d];
+				}
+				return result;
+			}
+
+			constexpr std::size_t required_span_size( ) const {
+				std::size_t result = 1;
+				for( std::size_t d = 0; d < N; ++d ) {
+					if( m_extents[d] == 0 ) {
+						return 0;
+					}
+					result += ( m_extents[d] - 1 ) * m_strides[d];
+				}
+				return result;
+			}
+		};
+	} // namespace md_view_details
+
+	/// Row major, the last index is contiguous
+	struct layout_right {
+		template<std::size_t N>
+		struct mapping : md_view_details::strided_mapping<N> {
+			constexpr mapping( ) = default;
+			explicit constexpr mapping( md_extents<N> const &extents )
+			  : md_view_details::strided_mapping<N>( extents,
+			                                         make_strides( extents ) ) {}
+
+		private:
+			static constexpr md_extents<N>
+			make_strides( md_extents<N> const &extents ) {
+				md_extents<N> result{ };
+				std::size_t stride = 1;
+				for( std::size_t d = N; d > 0; --d ) {
+					result[d - 1] = stride;
+					stride *= extents[d - 1];
+				}
+				return result;
+			}
+		};
+	};
+	using layout_row_major = layout_right;
+
+	/// Column major, the first index is contiguous
+	struct layout_left {
+		template<std::size_t N>
+		struct mapping : md_view_details::strided_mapping<N> {
+			constexpr mapping( ) = default;
+			explicit constexpr mapping( md_extents<N> const &extents )
+			  : md_view_details::strided_mapping<N>( extents,
+			                                         make_strides( extents ) ) {}
+
+		private:
+			static constexpr md_extents<N>
+			make_strides( md_extents<N> const &extents ) {
+				md_extents<N> result{ };
+				std::size_t stride = 1;
+				for( std::size_t d = 0; d < N; ++d ) {
+					result[d] = stride;
+					stride *= extents[d];
+				}
+				return result;
+			}
+		};
+	};
+	using layout_column_major = layout_left;
+
+	/// Caller supplied strides, e.g. a sub block of a larger matrix
+	struct layout_stride {
+		template<std::size_t N>
+		struct mapping : md_view_details::strided_mapping<N> {
+			using md_view_details::strided_mapping<N>::strided_mapping;
+		};
+	};
+
+	/// 2D tiles of TileRows x TileCols stored contiguously and row major, with
+	/// the tiles themselves in row major order.  The extents are padded up to
+	/// whole tiles, see required_span_size
+	template<std::size_t TileRows, std::size_t TileCols = TileRows>
+	struct layout_tiled {
+		static_assert( TileRows > 0 and TileCols > 0 );
+		static constexpr std::size_t tile_rows = TileRows;
+		static constexpr std::size_t tile_cols = TileCols;
+
+		template<std::size_t N>
+		class mapping {
+			static_assert( N == 2, "Tiled layouts are two dimensional" );
+			md_extents<2> m_extents{ };
+			std::size_t m_tiles_per_row = 0;
+
+		public:
+			static constexpr bool is_strided = false;
+
+			constexpr mapping( ) = default;
+			explicit constexpr mapping( md_extents<2> const &extents )
+			  : m_extents( extents )
+			  , m_tiles_per_row( ( extents[1] + TileCols - 1 ) / TileCols ) {}
+
+			constexpr md_extents<2> const &extents( ) const {
+				return m_extents;
+			}
+
+			constexpr std::size_t
+			operator( )( md_extents<2> const &indices ) const {
+				std::size_t const tile =
+				  ( indices[0] / TileRows ) * m_tiles_per_row + indices[1] / TileCols;
+				return tile * ( TileRows * TileCols ) +
+				       ( indices[0] % TileRows ) * TileCols + indices[1] % TileCols;
+			}
+
+			constexpr std::size_t required_span_size( ) const {
+				std::size_t const tile_rows_count =
+				  ( m_extents[0] + TileRows - 1 ) / TileRows;
+				return tile_rows_count * m_tiles_per_row * ( TileRows * TileCols );
+			}
+		};
+	};
+
+	/// 2D Z-order.  The row and column bits are interleaved so that every
+	/// aligned power of two square is contiguous.  Storage is sized to the
+	/// next power of two of each extent, and when they differ the extra high
+	/// bits of the longer side are placed above the interleaved bits
+	struct layout_morton {
+		static constexpr std::size_t tile_rows = 16;
+		static constexpr std::size_t tile_cols = 16;
+
+		template<std::size_t N>
+		class mapping {
+			static_assert( N == 2, "Morton layouts are two dimensional" );
+			md_extents<2> m_extents{ };
+			std::size_t m_row_bits = 0;
+			std::size_t m_col_bits = 0;
+			std::size_t m_common_bits = 0;
+
+		public:
+			static constexpr bool is_strided = false;
+
+			constexpr mapping( ) = default;
+			explicit constexpr mapping( md_extents<2> const &extents )
+			  : m_extents( extents )
+			  , m_row_bits( md_view_details::log2_pow2(
+			      md_view_details::next_pow2( extents[0] ) ) )
+			  , m_col_bits( md_view_details::log2_pow2(
+			      md_view_details::next_pow2( extents[1] ) ) )
+			  , m_common_bits( std::min( m_row_bits, m_col_bits ) ) {
+				daw::exception::precondition_check<std::length_error>(
+				  m_common_bits <= 32, "Morton extent is too large" );
+			}
+
+			constexpr md_extents<2> const &extents( ) const {
+				return m_extents;
+			}
+
+			constexpr std::size_t
+			operator( )( md_extents<2> const &indices ) const {
+				std::uint64_t const low_mask = ( 1ULL << m_common_bits ) - 1ULL;
+				std::uint64_t const row = indices[0];
+				std::uint64_t const col = indices[1];
+				std::uint64_t const low =
+				  ( md_view_details::spread_bits( row & low_mask ) << 1U ) |
+				  md_view_details::spread_bits( col & low_mask );
+				std::uint64_t const high =
+				  ( row >> m_common_bits ) | ( col >> m_common_bits );
+				return static_cast<std::size_t>( low |
+				                                 ( high << ( 2U * m_common_bits ) ) );
+			}
+
+			constexpr std::size_t required_span_size( ) const {
+				if( m_extents[0] == 0 or m_extents[1] == 0 ) {
+					return 0;
+				}
+				return std::size_t{ 1 } << ( m_row_bits + m_col_bits );
+			}
+		};
+	};
+
+	/// @brief A non-owning N dimensional view of contiguous storage.  Layout
+	/// maps an index tuple to an offset from data( )
+	template<typename T, std::size_t N, typename Layout = layout_right>
+	class md_view {
+		static_assert( N > 0 );
+
+	public:
+		using element_type = T;
+		using value_type = std::remove_cv_t<T>;
+		using pointer = T *;
+		using reference = T &;
+		using size_type = std::size_t;
+		using layout_type = Layout;
+		using mapping_type = typename Layout::template mapping<N>;
+		static constexpr std::size_t rank = N;
+
+	private:
+		pointer m_data = nullptr;
+		mapping_type m_map{ };
+
+		template<typename Container>
+		using container_data_t =
+		  decltype( std::data( std::declval<Container &>( ) ) );
+
+	public:
+		constexpr md_view( ) = default;
+
+		constexpr md_view( pointer data, md_extents<N> const &extents )
+		  : m_data( data )
+		  , m_map( extents ) {}
+
+		constexpr md_view( pointer data, mapping_type const &map )
+		  : m_data( data )
+		  , m_map( map ) {}
+
+		/// View the storage of a contiguous container, e.g. std::vector or
+		/// heap_array.  It must hold at least required_span_size( ) elements
+		template<typename Container,
+		         std::enable_if_t<
+		           std::is_convertible_v<container_data_t<Container>, pointer>,
+		           std::nullptr_t> = nullptr>
+		constexpr md_view( Container &container, md_extents<N> const &extents )
+		  : m_data( std::data( container ) )
+		  , m_map( extents ) {
+			daw::exception::precondition_check<std::out_of_range>(
+			  static_cast<std::size_t>( std::size( container ) ) >=
+			    m_map.required_span_size( ),
+			  "Container is smaller than the view" );
+		}
+
+		template<typename... Indices,
+		         std::enable_if_t<( sizeof...( Indices ) == N and
+		                            md_view_details::are_indices_v<Indices...> ),
+		                          std::nullptr_t> = nullptr>
+		constexpr reference operator( )( Indices... indices ) const {
+			return m_data[m_map(
+			  md_extents<N>{ static_cast<std::size_t>( indices )... } )];
+		}
+
+		constexpr reference operator[]( md_extents<N> const &indices ) const {
+			return m_data[m_map( indices )];
+		}
+
+		constexpr reference at( md_extents<N> const &indices ) const {
+			for( std::size_t d = 0; d < N; ++d ) {
+				daw::exception::precondition_check<std::out_of_range>(
+				  indices[d] < extent( d ), "Index out of range" );
+			}
+			return operator[]( indices );
+		}
+
+		template<typename... Indices,
+		         std::enable_if_t<( sizeof...( Indices ) == N and
+		                            md_view_details::are_indices_v<Indices...> ),
+		                          std::nullptr_t> = nullptr>
+		constexpr reference at( Indices... indices ) const {
+			return at( md_extents<N>{ static_cast<std::size_t>( indices )... } );
+		}
+
+		constexpr pointer data( ) const {
+			return m_data;
+		}
+
+		constexpr mapping_type const &mapping( ) const {
+			return m_map;
+		}
+
+		constexpr md_extents<N> const &extents( ) const {
+			return m_map.extents( );
+		}
+
+		constexpr size_type extent( std::size_t dim ) const {
+			return m_map.extents( )[dim];
+		}
+
+		/// Number of addressable elements, the product of the extents
+		constexpr size_type size( ) const {
+			return md_view_details::product( extents( ) );
+		}
+
+		constexpr bool empty( ) const {
+			return size( ) == 0;
+		}
+
+		/// Number of elements of storage the layout touches, including padding
+		constexpr size_type required_span_size( ) const {
+			return m_map.required_span_size( );
+		}
+	};
+
+	/// @brief Call func( i, j ) for every index of a rows x cols space, one
+	/// tile_rows x tile_cols tile at a time so that the data touched by a tile
+	/// stays in cache while it is visited
+	template<typename Function>
+	constexpr void md_for_each_tiled( std::size_t rows, std::size_t cols,
+	                                  Function func,
+	                                  std::size_t tile_rows = md_default_tile,
+	                                  std::size_t tile_cols = md_default_tile ) {
+		daw::exception::precondition_check<std::invalid_argument>(
+		  tile_rows > 0 and tile_cols > 0, "Tile extents must be non-zero" );
+		for( std::size_t ib = 0; ib < rows; ib += tile_rows ) {
+			std::size_t const ie = std::min( rows, ib + tile_rows );
+			for( std::size_t jb = 0; jb < cols; jb += tile_cols ) {
+				std::size_t const je = std::min( cols, jb + tile_cols );
+				for( std::size_t i = ib; i < ie; ++i ) {
+					for( std::size_t j = jb; j < je; ++j ) {
+						func( i, j );
+					}
+				}
+			}
+		}
+	}
+
+	/// @brief Call func( element ) for every element of view.  Strided layouts
+	/// are walked with the smallest stride innermost, tiled layouts one tile at
+	/// a time
+	template<typename T, std::size_t N, typename Layout, typename Function>
+	constexpr void md_for_each( md_view<T, N, Layout> const &view,
+	                            Function func ) {
+		using mapping_t = typename md_view<T, N, Layout>::mapping_type;
+		if( view.empty( ) ) {
+			return;
+		}
+		if constexpr( mapping_t::is_strided ) {
+			auto const &map = view.mapping( );
+			// order[N - 1] is the dimension with the smallest stride
+			md_extents<N> order{ };
+			for( std::size_t d = 0; d < N; ++d ) {
+				order[d] = d;
+			}
+			for( std::size_t d = 1; d < N; ++d ) {
+				for( std::size_t k = d; k > 0 and map.stride( order[k - 1] ) <
+				                                      map.stride( order[k] );
+				     --k ) {
+					std::size_t const tmp = order[k - 1];
+					order[k - 1] = order[k];
+					order[k] = tmp;
+				}
+			}
+			std::size_t const inner_extent = view.extent( order[N - 1] );
+			std::size_t const inner_stride = map.stride( order[N - 1] );
+			md_extents<N> index{ };
+			while( true ) {
+				T *ptr = view.data( ) + map( index );
+				for( std::size_t k = 0; k < inner_extent; ++k ) {
+					func( ptr[k * inner_stride] );
+				}
+				// Advance the outer dimensions, odometer style
+				std::size_t k = N - 1;
+				while( k > 0 ) {
+					std::size_t const d = order[k - 1];
+					if( ++index[d] < view.extent( d ) ) {
+						break;
+					}
+					index[d] = 0;
+					--k;
+				}
+				if( k == 0 ) {
+					return;
+				}
+			}
+		} else {
+			md_for_each_tiled(
+			  view.extent( 0 ), view.extent( 1 ),
+			  [&]( std::size_t i, std::size_t j ) { func( view( i, j ) ); },
+			  Layout::tile_rows, Layout::tile_cols );
+		}
+	}
+
+	/// @brief dst( j, i ) = src( i, j ).  Works a tile at a time so that both
+	/// the rows being read and the columns being written stay in cache, rather
+	/// than striding across all of dst for every row of src
+	template<typename T, typename U, typename LayoutSrc, typename LayoutDst>
+	constexpr void md_transpose( md_view<T, 2, LayoutSrc> const &src,
+	                             md_view<U, 2, LayoutDst> const &dst,
+	                             std::size_t tile = md_default_tile ) {
+		daw::exception::precondition_check<std::out_of_range>(
+		  dst.extent( 0 ) == src.extent( 1 ) and dst.extent( 1 ) == src.extent( 0 ),
+		  "Transpose extents do not match" );
+		md_for_each_tiled(
+		  src.extent( 0 ), src.extent( 1 ),
+		  [&]( std::size_t i, std::size_t j ) { dst( j, i ) = src( i, j ); }, tile,
+		  tile );
+	}
+} // namespace daw
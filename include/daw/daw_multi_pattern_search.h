@@ -0,0 +1,452 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_bit.h"
+#include "daw_exception.h"
+#include "daw_likely.h"
+#include "daw_simd_support.h"
+#include "daw_string_view.h"
+
+#include <algorithm>
+#include <array>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	/// A pattern found by multi_pattern_searcher.  The match is
+	/// haystack.substr( position, size )
+	struct pattern_match {
+		std::size_t pattern;
+		std::size_t position;
+		std::size_t size;
+
+		friend constexpr bool operator==( pattern_match const &lhs,
+		                                  pattern_match const &rhs ) noexcept {
+			return lhs.pattern == rhs.pattern and lhs.position == rhs.position;
+		}
+
+		friend constexpr bool operator!=( pattern_match const &lhs,
+		                                  pattern_match const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+
+		/// Ordered by position, then by pattern index
+		friend constexpr bool operator<( pattern_match const &lhs,
+		                                 pattern_match const &rhs ) noexcept {
+			return lhs.position != rhs.position ? lhs.position < rhs.position
+			                                    : lhs.pattern < rhs.pattern;
+		}
+	};
+
+	namespace multi_pattern_details {
+		inline constexpr std::uint32_t no_pattern =
+		  std::numeric_limits<std::uint32_t>::max( );
+		/// Set in a transition when the state it goes to reports a match
+		inline constexpr std::uint32_t match_flag = 0x8000'0000U;
+
+		constexpr unsigned char byte( char c ) noexcept {
+			return static_cast<unsigned char>( c );
+		}
+
+		/// Aho-Corasick automaton expanded to a DFA so each byte is one table
+		/// lookup.  Bytes that appear in no pattern share one column, which
+		/// keeps rows short for the usual alphanumeric token sets.  States are
+		/// stored as the offset of their row.
+		class aho_corasick {
+			std::array<std::uint16_t, 256> m_class{ };
+			std::size_t m_class_count = 1;
+			std::vector<std::uint32_t> m_next{ };
+			/// First pattern that ends in each state
+			std::vector<std::uint32_t> m_own{ };
+			/// The longest proper suffix state that has patterns of its own, or 0
+			std::vector<std::uint32_t> m_dict{ };
+			/// The next pattern with the same text as this one
+			std::vector<std::uint32_t> m_same{ };
+
+		public:
+			aho_corasick( ) = default;
+
+			explicit aho_corasick( std::vector<daw::string_view> const &patterns ) {
+				std::array<bool, 256> used{ };
+				for( auto p : patterns ) {
+					for( char c : p ) {
+						used[byte( c )] = true;
+					}
+				}
+				// Class 0 is every byte that is in no pattern
+				std::uint16_t next_class = 1;
+				for( std::size_t b = 0; b < 256; ++b ) {
+					if( used[b] ) {
+						m_class[b] = next_class++;
+					}
+				}
+				m_class_count = next_class;
+				std::size_t const width = m_class_count;
+
+				// The trie, with none for missing edges
+				constexpr std::uint32_t none = no_pattern;
+				std::vector<std::uint32_t> go( width, none );
+				m_own.push_back( no_pattern );
+				m_same.assign( patterns.size( ), no_pattern );
+				for( std::size_t n = 0; n < patterns.size( ); ++n ) {
+					std::size_t state = 0;
+					for( char c : patterns[n] ) {
+						std::size_t const edge = state * width + m_class[byte( c )];
+						if( go[edge] == none ) {
+							go[edge] = static_cast<std::uint32_t>( m_own.size( ) );
+							m_own.push_back( no_pattern );
+							go.resize( go.size( ) + width, none );
+						}
+						state = go[edge];
+					}
+					// Keep patterns with the same text in index order
+					auto *tail = &m_own[state];
+					while( *tail != no_pattern ) {
+						tail = &m_same[*tail];
+					}
+					*tail = static_cast<std::uint32_t>( n );
+				}
+				std::size_t const state_count = m_own.size( );
+				daw::exception::precondition_check(
+				  state_count * width < match_flag, "too many patterns" );
+
+				// Breadth first, so a state's failure state is complete before the
+				// state itself.  Missing edges become the failure state's edges.
+				std::vector<std::uint32_t> fail( state_count, 0 );
+				m_dict.assign( state_count, 0 );
+				std::vector<std::uint32_t> queue{ };
+				queue.reserve( state_count );
+				for( std::size_t c = 0; c < width; ++c ) {
+					auto &edge = go[c];
+					if( edge == none ) {
+						edge = 0;
+					} else {
+						queue.push_back( edge );
+					}
+				}
+				for( std::size_t head = 0; head < queue.size( ); ++head ) {
+					std::uint32_t const state = queue[head];
+					for( std::size_t c = 0; c < width; ++c ) {
+						auto &edge = go[state * width + c];
+						std::uint32_t const via_fail = go[fail[state] * width + c];
+						if( edge == none ) {
+							edge = via_fail;
+						} else {
+							fail[edge] = via_fail;
+							m_dict[edge] =
+							  m_own[via_fail] != no_pattern ? via_fail : m_dict[via_fail];
+							queue.push_back( edge );
+						}
+					}
+				}
+
+				m_next.resize( go.size( ) );
+				for( std::size_t n = 0; n < go.size( ); ++n ) {
+					std::uint32_t const to = go[n];
+					bool const reports = m_own[to] != no_pattern or m_dict[to] != 0;
+					m_next[n] = static_cast<std::uint32_t>( to * width ) |
+					            ( reports ? match_flag : 0U );
+				}
+			}
+
+			/// Run the automaton over [first, first + count).  For each match call
+			/// on_match( pattern, end ) with end relative to first.  Stops early
+			/// once limit, which on_match may lower, is passed
+			template<typename OnMatch>
+			void scan( char const *first, std::size_t count, std::size_t const &limit,
+			           OnMatch &&on_match ) const {
+				if( m_next.empty( ) ) {
+					return;
+				}
+				std::uint32_t row = 0;
+				for( std::size_t n = 0; n < count and n < limit; ++n ) {
+					std::uint32_t const edge = m_next[row + m_class[byte( first[n] )]];
+					row = edge & ~match_flag;
+					if( DAW_UNLIKELY( ( edge & match_flag ) != 0 ) ) {
+						auto state = static_cast<std::uint32_t>( row / m_class_count );
+						if( m_own[state] == no_pattern ) {
+							state = m_dict[state];
+						}
+						for( ; state != 0; state = m_dict[state] ) {
+							for( auto p = m_own[state]; p != no_pattern; p = m_same[p] ) {
+								on_match( p, n + 1 );
+							}
+						}
+					}
+				}
+			}
+		};
+
+#if defined( DAW_HAS_SSSE3 )
+		/// Teddy, the SIMD prefilter from Hyperscan.  Patterns go in 8 buckets.
+		/// For each of the first fingerprint bytes there are two 16 entry
+		/// tables, on the low and the high nibble, giving the buckets that have
+		/// a pattern with a byte like it there.  Two shuffles per byte position
+		/// give the candidate buckets for 16 start positions at once, and only
+		/// those are compared in full.
+		class teddy {
+			std::size_t m_fingerprint = 0;
+			std::array<std::array<std::uint8_t, 16>, 3> m_low{ };
+			std::array<std::array<std::uint8_t, 16>, 3> m_high{ };
+			std::array<std::vector<std::uint32_t>, 8> m_buckets{ };
+
+			__m128i classify( char const *ptr, std::size_t k ) const noexcept {
+				__m128i const x =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( ptr ) );
+				__m128i const nibble = _mm_set1_epi8( 0x0F );
+				__m128i const low = _mm_shuffle_epi8(
+				  _mm_loadu_si128(
+				    reinterpret_cast<__m128i const *>( m_low[k].data( ) ) ),
+				  _mm_and_si128( x, nibble ) );
+				__m128i const high = _mm_shuffle_epi8(
+				  _mm_loadu_si128(
+				    reinterpret_cast<__m128i const *>( m_high[k].data( ) ) ),
+				  _mm_and_si128( _mm_srli_epi16( x, 4 ), nibble ) );
+				return _mm_and_si128( low, high );
+			}
+
+		public:
+			static constexpr std::size_t max_patterns = 64;
+
+			teddy( ) = default;
+
+			explicit teddy( std::vector<daw::string_view> const &patterns ) {
+				std::size_t min_size = std::numeric_limits<std::size_t>::max( );
+				for( auto p : patterns ) {
+					min_size = std::min( min_size, p.size( ) );
+				}
+				m_fingerprint = std::min( min_size, std::size_t{ 3 } );
+				// Patterns with the same start share a bucket, which keeps the
+				// buckets selective
+				std::vector<std::uint32_t> order( patterns.size( ) );
+				for( std::size_t n = 0; n < order.size( ); ++n ) {
+					order[n] = static_cast<std::uint32_t>( n );
+				}
+				std::sort( order.begin( ), order.end( ),
+				           [&]( std::uint32_t lhs, std::uint32_t rhs ) {
+					           return patterns[lhs].substr( 0, m_fingerprint ) <
+					                  patterns[rhs].substr( 0, m_fingerprint );
+				           } );
+				std::size_t const per_bucket = ( order.size( ) + 7U ) / 8U;
+				for( std::size_t n = 0; n < order.size( ); ++n ) {
+					std::size_t const bucket = n / per_bucket;
+					auto const pattern = patterns[order[n]];
+					m_buckets[bucket].push_back( order[n] );
+					for( std::size_t k = 0; k < m_fingerprint; ++k ) {
+						auto const b = byte( pattern[k] );
+						auto const bit = static_cast<std::uint8_t>( 1U << bucket );
+						m_low[k][b & 0x0FU] |= bit;
+						m_high[k][b >> 4U] |= bit;
+					}
+				}
+				for( auto &bucket : m_buckets ) {
+					std::sort( bucket.begin( ), bucket.end( ) );
+				}
+			}
+
+			/// Check every start position that has a full block of input.  Calls
+			/// on_match( pattern, position ) for each match and returns where it
+			/// stopped.  pattern_at( p ) is the text of pattern p.  Stops after
+			/// the block where limit, which on_match may lower, is passed
+			template<typename PatternAt, typename OnMatch>
+			std::size_t scan( daw::string_view haystack, PatternAt pattern_at,
+			                  std::size_t const &limit,
+			                  OnMatch &&on_match ) const {
+				char const *const data = haystack.data( );
+				std::size_t const size = haystack.size( );
+				std::size_t pos = 0;
+				for( ; pos + m_fingerprint - 1 + 16 <= size and pos <= limit;
+				     pos += 16 ) {
+					__m128i candidates = classify( data + pos, 0 );
+					for( std::size_t k = 1; k < m_fingerprint; ++k ) {
+						candidates =
+						  _mm_and_si128( candidates, classify( data + pos + k, k ) );
+					}
+					auto mask =
+					  static_cast<std::uint32_t>( _mm_movemask_epi8(
+					    _mm_cmpeq_epi8( candidates, _mm_setzero_si128( ) ) ) ) ^
+					  0xFFFFU;
+					if( DAW_LIKELY( mask == 0 ) ) {
+						continue;
+					}
+					alignas( 16 ) std::uint8_t lanes[16];
+					_mm_store_si128( reinterpret_cast<__m128i *>( lanes ), candidates );
+					for( ; mask != 0; mask &= mask - 1U ) {
+						std::size_t const start = pos + daw::countr_zero( mask );
+						for( std::uint32_t buckets = lanes[start - pos]; buckets != 0;
+						     buckets &= buckets - 1U ) {
+							for( auto p : m_buckets[daw::countr_zero( buckets )] ) {
+								daw::string_view const pattern = pattern_at( p );
+								if( pattern.size( ) <= size - start and
+								    std::char_traits<char>::compare( data + start,
+								                                     pattern.data( ),
+								                                     pattern.size( ) ) == 0 ) {
+									on_match( p, start );
+								}
+							}
+						}
+					}
+				}
+				return pos;
+			}
+		};
+#endif
+	} // namespace multi_pattern_details
+
+	/// Searches for many patterns in one pass over the text.  The patterns are
+	/// compiled once into an Aho-Corasick automaton.  With SSSE3 and at most
+	/// 64 patterns, a Teddy prefilter finds candidate positions 16 bytes at a
+	/// time and the automaton only handles the tail.  The searcher keeps its
+	/// own copy of the patterns.
+	class multi_pattern_searcher {
+		/// The patterns end to end.  Pattern n is [m_ends[n - 1], m_ends[n])
+		std::string m_text{ };
+		std::vector<std::size_t> m_ends{ };
+		std::size_t m_max_size = 0;
+		multi_pattern_details::aho_corasick m_automaton{ };
+#if defined( DAW_HAS_SSSE3 )
+		std::optional<multi_pattern_details::teddy> m_teddy{ };
+#endif
+
+		template<typename ForwardIterator>
+		void build( ForwardIterator first, ForwardIterator last ) {
+			for( auto it = first; it != last; ++it ) {
+				auto const p = daw::string_view( *it );
+				daw::exception::precondition_check( not p.empty( ),
+				                                    "patterns must not be empty" );
+				m_text.append( p.data( ), p.size( ) );
+				m_ends.push_back( m_text.size( ) );
+				m_max_size = std::max( m_max_size, p.size( ) );
+			}
+			auto patterns = std::vector<daw::string_view>( );
+			for( std::size_t n = 0; n < size( ); ++n ) {
+				patterns.push_back( pattern( n ) );
+			}
+			m_automaton = multi_pattern_details::aho_corasick( patterns );
+#if defined( DAW_HAS_SSSE3 )
+			if( not patterns.empty( ) and
+			    patterns.size( ) <= multi_pattern_details::teddy::max_patterns ) {
+				m_teddy.emplace( patterns );
+			}
+#endif
+		}
+
+		/// Call on_match( pattern, position ) for each match.  limit is the
+		/// last start position still wanted, and on_match may lower it
+		template<typename OnMatch>
+		void scan( daw::string_view haystack, std::size_t &limit,
+		           OnMatch &&on_match ) const {
+			std::size_t tail = 0;
+#if defined( DAW_HAS_SSSE3 )
+			if( m_teddy ) {
+				tail = m_teddy->scan(
+				  haystack, [this]( std::size_t p ) { return pattern( p ); }, limit,
+				  on_match );
+				if( tail > limit ) {
+					return;
+				}
+			}
+#endif
+			// The automaton sees end positions, relative to the tail.  A match
+			// ending past limit + m_max_size cannot start by limit
+			constexpr auto unlimited = std::numeric_limits<std::size_t>::max( );
+			auto const end_limit_for = [&]( ) -> std::size_t {
+				if( limit == unlimited ) {
+					return unlimited;
+				}
+				return limit < tail ? 0 : limit - tail + m_max_size;
+			};
+			std::size_t end_limit = end_limit_for( );
+			m_automaton.scan( haystack.data( ) + tail, haystack.size( ) - tail,
+			                  end_limit, [&]( std::uint32_t p, std::size_t end ) {
+				                  on_match( p, tail + end - pattern( p ).size( ) );
+				                  end_limit = end_limit_for( );
+			                  } );
+		}
+
+	public:
+		multi_pattern_searcher( ) = default;
+
+		/// The patterns, each convertible to daw::string_view, must not be empty
+		template<typename ForwardIterator>
+		multi_pattern_searcher( ForwardIterator first, ForwardIterator last ) {
+			build( first, last );
+		}
+
+		multi_pattern_searcher( std::initializer_list<daw::string_view> patterns ) {
+			build( patterns.begin( ), patterns.end( ) );
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_ends.size( );
+		}
+
+		[[nodiscard]] daw::string_view pattern( std::size_t index ) const {
+			std::size_t const first = index == 0 ? 0 : m_ends[index - 1];
+			return daw::string_view( m_text.data( ) + first, m_ends[index] - first );
+		}
+
+		/// Call func( pattern_match ) for every occurrence of every pattern,
+		/// overlapping ones included.  Each match is reported once, in no
+		/// particular order
+		template<typename Function>
+		void for_each_match( daw::string_view haystack, Function &&func ) const {
+			std::size_t limit = std::numeric_limits<std::size_t>::max( );
+			scan( haystack, limit, [&]( std::uint32_t p, std::size_t position ) {
+				func( pattern_match{ p, position, pattern( p ).size( ) } );
+			} );
+		}
+
+		/// Every match, ordered by position and then by pattern index
+		[[nodiscard]] std::vector<pattern_match>
+		find_all( daw::string_view haystack ) const {
+			auto result = std::vector<pattern_match>( );
+			for_each_match( haystack, [&]( pattern_match const &m ) {
+				result.push_back( m );
+			} );
+			std::sort( result.begin( ), result.end( ) );
+			return result;
+		}
+
+		/// The match that starts first, the lowest pattern index among those
+		/// that start there
+		[[nodiscard]] std::optional<pattern_match>
+		find_first( daw::string_view haystack ) const {
+			auto result = std::optional<pattern_match>( );
+			std::size_t limit = std::numeric_limits<std::size_t>::max( );
+			scan( haystack, limit, [&]( std::uint32_t p, std::size_t position ) {
+				auto const m = pattern_match{ p, position, pattern( p ).size( ) };
+				if( not result or m < *result ) {
+					result = m;
+					limit = position;
+				}
+			} );
+			return result;
+		}
+
+		[[nodiscard]] bool contains_any( daw::string_view haystack ) const {
+			bool found = false;
+			std::size_t limit = std::numeric_limits<std::size_t>::max( );
+			scan( haystack, limit, [&]( std::uint32_t, std::size_t ) {
+				found = true;
+				limit = 0;
+			} );
+			return found;
+		}
+	};
+} // namespace daw
@@ -0,0 +1,591 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "cpp_17.h"
+#include "daw_is_constant_evaluated.h"
+#include "daw_simd_support.h"
+#include "daw_string_view.h"
+
+#include <array>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/// Character classes and scanners for ASCII text held in char buffers.
+/// Each class is a predicate on a single char and, where the target has
+/// SSE2, can also classify 16 chars at once.  The scanners use the block
+/// form at run time and the predicate in constant expressions and for the
+/// tail of a buffer.  Bytes 0x80 and above never belong to the fixed
+/// classes, so UTF-8 text can be scanned without decoding.
+namespace daw::parser {
+	namespace parser_ascii_details {
+		/// True when the unsigned value of c is in [first, first + count)
+		constexpr bool in_range( char c, unsigned char first,
+		                         unsigned char count ) noexcept {
+			return static_cast<unsigned char>( static_cast<unsigned char>( c ) -
+			                                   first ) < count;
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		inline __m128i load( char const *ptr ) noexcept {
+			return _mm_loadu_si128( reinterpret_cast<__m128i const *>( ptr ) );
+		}
+
+		inline void store( char *ptr, __m128i value ) noexcept {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( ptr ), value );
+		}
+
+		/// Lanes whose unsigned value is in [first, first + count)
+		inline __m128i in_range( __m128i x, unsigned char first,
+		                         unsigned char count ) noexcept {
+			// SSE2 only compares signed bytes.  Flipping the top bit makes the
+			// unsigned comparison of x - first against count a signed one.
+			__m128i const bias = _mm_set1_epi8( static_cast<char>( 0x80 ) );
+			__m128i const offset = _mm_xor_si128(
+			  _mm_sub_epi8( x, _mm_set1_epi8( static_cast<char>( first ) ) ), bias );
+			return _mm_cmplt_epi8(
+			  offset, _mm_set1_epi8( static_cast<char>( count ^ 0x80U ) ) );
+		}
+
+		inline __m128i lower_case_bits( __m128i x ) noexcept {
+			return _mm_or_si128( x, _mm_set1_epi8( 0x20 ) );
+		}
+#endif
+
+		template<typename Class>
+		using block_match_test =
+		  decltype( static_cast<void>( std::declval<Class const &>( ).match(
+		    std::declval<char const *>( ) ) ) );
+
+		/// Class has a match member that classifies 16 chars at once
+		template<typename Class>
+		inline constexpr bool has_block_match_v =
+		  daw::is_detected_v<block_match_test, Class>;
+
+		constexpr std::size_t lowest_bit( std::uint32_t value ) noexcept {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			return static_cast<std::size_t>( __builtin_ctz( value ) );
+#else
+			std::size_t result = 0;
+			while( ( value & 1U ) == 0 ) {
+				value >>= 1U;
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		constexpr std::size_t highest_bit( std::uint32_t value ) noexcept {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			return 31U - static_cast<std::size_t>( __builtin_clz( value ) );
+#else
+			std::size_t result = 0;
+			while( value > 1U ) {
+				value >>= 1U;
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		/// Read 8 chars as a little endian word.  Compilers turn this into a
+		/// single load at run time.
+		constexpr std::uint64_t load_word( char const *ptr,
+		                                   std::size_t count = 8 ) noexcept {
+			std::uint64_t result = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				result |= static_cast<std::uint64_t>(
+				            static_cast<unsigned char>( ptr[n] ) )
+				          << ( 8U * n );
+			}
+			return result;
+		}
+
+		/// Lower case the ASCII letters in each byte of word, leaving every other
+		/// byte as is
+		constexpr std::uint64_t lower_word( std::uint64_t word ) noexcept {
+			constexpr std::uint64_t ones = 0x0101'0101'0101'0101ULL;
+			// Adding to the low 7 bits of each byte never carries into the next
+			// byte and leaves the result of the comparison in the top bit
+			std::uint64_t const heptets = word & ( 0x7FU * ones );
+			std::uint64_t const at_least_a = heptets + ( 0x80U - 'A' ) * ones;
+			std::uint64_t const past_z = heptets + ( 0x7FU - 'Z' ) * ones;
+			std::uint64_t const is_upper =
+			  at_least_a & ~past_z & ~word & ( 0x80U * ones );
+			return word | ( is_upper >> 2U );
+		}
+
+		constexpr std::uint64_t mix_word( std::uint64_t hash,
+		                                  std::uint64_t word ) noexcept {
+			hash = ( hash ^ word ) * 0xFF51'AFD7'ED55'8CCDULL;
+			return hash ^ ( hash >> 32U );
+		}
+	} // namespace parser_ascii_details
+
+	/// ' ', '\t', '\n', '\v', '\f' and '\r'
+	struct ascii_whitespace_t {
+		constexpr bool operator( )( char c ) const noexcept {
+			return c == ' ' or parser_ascii_details::in_range( c, '\t', 5 );
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		__m128i match( char const *ptr ) const noexcept {
+			__m128i const x = parser_ascii_details::load( ptr );
+			return _mm_or_si128( _mm_cmpeq_epi8( x, _mm_set1_epi8( ' ' ) ),
+			                     parser_ascii_details::in_range( x, '\t', 5 ) );
+		}
+#endif
+	};
+
+	/// '0' through '9'
+	struct ascii_digit_t {
+		constexpr bool operator( )( char c ) const noexcept {
+			return parser_ascii_details::in_range( c, '0', 10 );
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		__m128i match( char const *ptr ) const noexcept {
+			return parser_ascii_details::in_range(
+			  parser_ascii_details::load( ptr ), '0', 10 );
+		}
+#endif
+	};
+
+	/// 'a' through 'z' and 'A' through 'Z'
+	struct ascii_alpha_t {
+		constexpr bool operator( )( char c ) const noexcept {
+			return parser_ascii_details::in_range(
+			  static_cast<char>( static_cast<unsigned char>( c ) | 0x20U ), 'a', 26 );
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		__m128i match( char const *ptr ) const noexcept {
+			return parser_ascii_details::in_range(
+			  parser_ascii_details::lower_case_bits(
+			    parser_ascii_details::load( ptr ) ),
+			  'a', 26 );
+		}
+#endif
+	};
+
+	/// ascii_alpha_t or ascii_digit_t
+	struct ascii_alnum_t {
+		constexpr bool operator( )( char c ) const noexcept {
+			return ascii_digit_t{ }( c ) or ascii_alpha_t{ }( c );
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		__m128i match( char const *ptr ) const noexcept {
+			return _mm_or_si128( ascii_digit_t{ }.match( ptr ),
+			                     ascii_alpha_t{ }.match( ptr ) );
+		}
+#endif
+	};
+
+	/// '0' through '9', 'a' through 'f' and 'A' through 'F'
+	struct ascii_hex_t {
+		constexpr bool operator( )( char c ) const noexcept {
+			return ascii_digit_t{ }( c ) or
+			       parser_ascii_details::in_range(
+			         static_cast<char>( static_cast<unsigned char>( c ) | 0x20U ),
+			         'a', 6 );
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		__m128i match( char const *ptr ) const noexcept {
+			return _mm_or_si128( ascii_digit_t{ }.match( ptr ),
+			                     parser_ascii_details::in_range(
+			                       parser_ascii_details::lower_case_bits(
+			                         parser_ascii_details::load( ptr ) ),
+			                       'a', 6 ) );
+		}
+#endif
+	};
+
+	/// Any set of byte values, e.g. the token characters of an HTTP header
+	/// name.  The 256 bits are laid out as two 16 byte tables indexed by the
+	/// low nibble, one for bytes below 0x80 and one for the rest, so that
+	/// with SSSE3 a block is classified with two table shuffles.
+	class ascii_set {
+		std::array<std::uint8_t, 32> m_table{ };
+
+		static constexpr std::size_t row( unsigned char c ) noexcept {
+			return ( c >> 7U ) * 16U + ( c & 0x0FU );
+		}
+
+		static constexpr std::uint8_t bit( unsigned char c ) noexcept {
+			return static_cast<std::uint8_t>( 1U << ( ( c >> 4U ) & 0x07U ) );
+		}
+
+	public:
+		constexpr ascii_set( ) noexcept = default;
+
+		/// The set of the chars in chars
+		explicit constexpr ascii_set( daw::string_view chars ) noexcept {
+			for( char c : chars ) {
+				insert( c );
+			}
+		}
+
+		/// The set of bytes for which pred( char ) is true, e.g.
+		/// ascii_set::from_predicate( ascii_alnum_t{ } )
+		template<typename Predicate>
+		static constexpr ascii_set from_predicate( Predicate pred ) {
+			ascii_set result{ };
+			for( unsigned n = 0; n < 256U; ++n ) {
+				if( pred( static_cast<char>( n ) ) ) {
+					result.insert( static_cast<char>( n ) );
+				}
+			}
+			return result;
+		}
+
+		constexpr ascii_set &insert( char c ) noexcept {
+			auto const u = static_cast<unsigned char>( c );
+			m_table[row( u )] |= bit( u );
+			return *this;
+		}
+
+		/// Insert every byte from first to last inclusive
+		constexpr ascii_set &insert_range( char first, char last ) noexcept {
+			for( unsigned n = static_cast<unsigned char>( first );
+			     n <= static_cast<unsigned char>( last ); ++n ) {
+				insert( static_cast<char>( n ) );
+			}
+			return *this;
+		}
+
+		constexpr ascii_set &erase( char c ) noexcept {
+			auto const u = static_cast<unsigned char>( c );
+			m_table[row( u )] &= static_cast<std::uint8_t>( ~bit( u ) );
+			return *this;
+		}
+
+		[[nodiscard]] constexpr bool contains( char c ) const noexcept {
+			auto const u = static_cast<unsigned char>( c );
+			return ( m_table[row( u )] & bit( u ) ) != 0;
+		}
+
+		constexpr bool operator( )( char c ) const noexcept {
+			return contains( c );
+		}
+
+		/// Every byte not in the set
+		constexpr ascii_set operator~( ) const noexcept {
+			ascii_set result = *this;
+			for( auto &b : result.m_table ) {
+				b = static_cast<std::uint8_t>( ~b );
+			}
+			return result;
+		}
+
+		friend constexpr ascii_set operator|( ascii_set lhs,
+		                                      ascii_set const &rhs ) noexcept {
+			for( std::size_t n = 0; n < lhs.m_table.size( ); ++n ) {
+				lhs.m_table[n] |= rhs.m_table[n];
+			}
+			return lhs;
+		}
+
+		friend constexpr ascii_set operator&( ascii_set lhs,
+		                                      ascii_set const &rhs ) noexcept {
+			for( std::size_t n = 0; n < lhs.m_table.size( ); ++n ) {
+				lhs.m_table[n] &= rhs.m_table[n];
+			}
+			return lhs;
+		}
+
+#if defined( DAW_HAS_SSSE3 )
+		__m128i match( char const *ptr ) const noexcept {
+			__m128i const x = parser_ascii_details::load( ptr );
+			__m128i const low_nibble = _mm_and_si128( x, _mm_set1_epi8( 0x0F ) );
+			__m128i const high_nibble =
+			  _mm_and_si128( _mm_srli_epi16( x, 4 ), _mm_set1_epi8( 0x07 ) );
+			__m128i const is_high = _mm_cmplt_epi8( x, _mm_setzero_si128( ) );
+			__m128i const rows = _mm_or_si128(
+			  _mm_andnot_si128(
+			    is_high,
+			    _mm_shuffle_epi8(
+			      _mm_loadu_si128(
+			        reinterpret_cast<__m128i const *>( m_table.data( ) ) ),
+			      low_nibble ) ),
+			  _mm_and_si128(
+			    is_high,
+			    _mm_shuffle_epi8(
+			      _mm_loadu_si128(
+			        reinterpret_cast<__m128i const *>( m_table.data( ) + 16 ) ),
+			      low_nibble ) ) );
+			__m128i const bits = _mm_shuffle_epi8(
+			  _mm_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0 ),
+			  high_nibble );
+			return _mm_cmpeq_epi8( _mm_and_si128( rows, bits ), bits );
+		}
+#endif
+	};
+
+	/// The first char in [first, last) for which cls( char ) is true, or last
+	template<typename Class>
+	constexpr char const *ascii_find_if( char const *first, char const *last,
+	                                     Class const &cls ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if constexpr( parser_ascii_details::has_block_match_v<Class> ) {
+			if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+				for( ; last - first >= 16; first += 16 ) {
+					auto const mask = static_cast<std::uint32_t>(
+					  _mm_movemask_epi8( cls.match( first ) ) );
+					if( mask != 0 ) {
+						return first + parser_ascii_details::lowest_bit( mask );
+					}
+				}
+			}
+		}
+#endif
+		while( first != last and not cls( *first ) ) {
+			++first;
+		}
+		return first;
+	}
+
+	/// The first char in [first, last) for which cls( char ) is false, or last
+	template<typename Class>
+	constexpr char const *ascii_find_if_not( char const *first, char const *last,
+	                                         Class const &cls ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if constexpr( parser_ascii_details::has_block_match_v<Class> ) {
+			if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+				for( ; last - first >= 16; first += 16 ) {
+					auto const mask = static_cast<std::uint32_t>(
+					                    _mm_movemask_epi8( cls.match( first ) ) ) ^
+					                  0xFFFFU;
+					if( mask != 0 ) {
+						return first + parser_ascii_details::lowest_bit( mask );
+					}
+				}
+			}
+		}
+#endif
+		while( first != last and cls( *first ) ) {
+			++first;
+		}
+		return first;
+	}
+
+	/// One past the last char in [first, last) for which cls( char ) is false,
+	/// or first when there is none
+	template<typename Class>
+	constexpr char const *ascii_rfind_if_not( char const *first,
+	                                          char const *last,
+	                                          Class const &cls ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if constexpr( parser_ascii_details::has_block_match_v<Class> ) {
+			if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+				for( ; last - first >= 16; last -= 16 ) {
+					auto const mask = static_cast<std::uint32_t>(
+					                    _mm_movemask_epi8( cls.match( last - 16 ) ) ) ^
+					                  0xFFFFU;
+					if( mask != 0 ) {
+						return last - 15 + parser_ascii_details::highest_bit( mask );
+					}
+				}
+			}
+		}
+#endif
+		while( last != first and cls( *( last - 1 ) ) ) {
+			--last;
+		}
+		return last;
+	}
+
+	/// True when every char of str is in cls, e.g. ascii_all_of( str,
+	/// ascii_digit_t{ } )
+	template<typename Class>
+	constexpr bool ascii_all_of( daw::string_view str, Class const &cls ) {
+		return ascii_find_if_not( str.data( ), str.data( ) + str.size( ), cls ) ==
+		       str.data( ) + str.size( );
+	}
+
+	/// The first char in [first, last) that is not ASCII whitespace
+	constexpr char const *ascii_skip_ws( char const *first,
+	                                     char const *last ) noexcept {
+		return ascii_find_if_not( first, last, ascii_whitespace_t{ } );
+	}
+
+	/// Like trim_left, but only ASCII whitespace is removed
+	constexpr daw::string_view ascii_trim_left( daw::string_view str ) noexcept {
+		auto const first = ascii_skip_ws( str.data( ), str.data( ) + str.size( ) );
+		return { first, static_cast<std::size_t>( str.data( ) + str.size( ) -
+		                                          first ) };
+	}
+
+	/// Like trim_right, but only ASCII whitespace is removed
+	constexpr daw::string_view ascii_trim_right( daw::string_view str ) noexcept {
+		auto const last = ascii_rfind_if_not(
+		  str.data( ), str.data( ) + str.size( ), ascii_whitespace_t{ } );
+		return { str.data( ), static_cast<std::size_t>( last - str.data( ) ) };
+	}
+
+	/// Like trim, but only ASCII whitespace is removed
+	constexpr daw::string_view ascii_trim( daw::string_view str ) noexcept {
+		return ascii_trim_right( ascii_trim_left( str ) );
+	}
+
+	constexpr char ascii_to_lower( char c ) noexcept {
+		if( parser_ascii_details::in_range( c, 'A', 26 ) ) {
+			return static_cast<char>( static_cast<unsigned char>( c ) | 0x20U );
+		}
+		return c;
+	}
+
+	constexpr char ascii_to_upper( char c ) noexcept {
+		if( parser_ascii_details::in_range( c, 'a', 26 ) ) {
+			return static_cast<char>( static_cast<unsigned char>( c ) & ~0x20U );
+		}
+		return c;
+	}
+
+	/// Write str to out with the ASCII letters lower cased.  out may be
+	/// str.data( ).  Returns the end of the output
+	constexpr char *ascii_to_lower( daw::string_view str, char *out ) noexcept {
+		char const *first = str.data( );
+		char const *const last = str.data( ) + str.size( );
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			for( ; last - first >= 16; first += 16, out += 16 ) {
+				__m128i const x = parser_ascii_details::load( first );
+				__m128i const upper = parser_ascii_details::in_range( x, 'A', 26 );
+				parser_ascii_details::store(
+				  out,
+				  _mm_or_si128( x, _mm_and_si128( upper, _mm_set1_epi8( 0x20 ) ) ) );
+			}
+		}
+#endif
+		for( ; first != last; ++first, ++out ) {
+			*out = ascii_to_lower( *first );
+		}
+		return out;
+	}
+
+	/// Write str to out with the ASCII letters upper cased.  out may be
+	/// str.data( ).  Returns the end of the output
+	constexpr char *ascii_to_upper( daw::string_view str, char *out ) noexcept {
+		char const *first = str.data( );
+		char const *const last = str.data( ) + str.size( );
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			for( ; last - first >= 16; first += 16, out += 16 ) {
+				__m128i const x = parser_ascii_details::load( first );
+				__m128i const lower = parser_ascii_details::in_range( x, 'a', 26 );
+				parser_ascii_details::store(
+				  out,
+				  _mm_xor_si128( x, _mm_and_si128( lower, _mm_set1_epi8( 0x20 ) ) ) );
+			}
+		}
+#endif
+		for( ; first != last; ++first, ++out ) {
+			*out = ascii_to_upper( *first );
+		}
+		return out;
+	}
+
+	/// Lower case the ASCII letters of [first, last) in place
+	constexpr void ascii_to_lower( char *first, char *last ) noexcept {
+		(void)ascii_to_lower(
+		  daw::string_view( first, static_cast<std::size_t>( last - first ) ),
+		  first );
+	}
+
+	/// Upper case the ASCII letters of [first, last) in place
+	constexpr void ascii_to_upper( char *first, char *last ) noexcept {
+		(void)ascii_to_upper(
+		  daw::string_view( first, static_cast<std::size_t>( last - first ) ),
+		  first );
+	}
+
+	/// Equal when the strings only differ in the case of ASCII letters
+	constexpr bool ascii_iequal( daw::string_view lhs,
+	                             daw::string_view rhs ) noexcept {
+		if( lhs.size( ) != rhs.size( ) ) {
+			return false;
+		}
+		char const *l = lhs.data( );
+		char const *r = rhs.data( );
+		char const *const last = lhs.data( ) + lhs.size( );
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			for( ; last - l >= 16; l += 16, r += 16 ) {
+				__m128i const x = parser_ascii_details::load( l );
+				__m128i const y = parser_ascii_details::load( r );
+				// Equal ignoring the 0x20 bit, and where that bit differs both
+				// are letters
+				__m128i const folded_eq =
+				  _mm_cmpeq_epi8( parser_ascii_details::lower_case_bits( x ),
+				                  parser_ascii_details::lower_case_bits( y ) );
+				__m128i const exact_eq = _mm_cmpeq_epi8( x, y );
+				__m128i const letter = parser_ascii_details::in_range(
+				  parser_ascii_details::lower_case_bits( x ), 'a', 26 );
+				__m128i const ok =
+				  _mm_or_si128( exact_eq, _mm_and_si128( folded_eq, letter ) );
+				if( _mm_movemask_epi8( ok ) != 0xFFFF ) {
+					return false;
+				}
+			}
+		}
+#endif
+		for( ; l != last; ++l, ++r ) {
+			if( ascii_to_lower( *l ) != ascii_to_lower( *r ) ) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// A hash that is the same for strings that ascii_iequal says are equal.
+	/// It consumes 8 chars per step and lower cases them with word
+	/// arithmetic, so it works the same in constant expressions
+	constexpr std::size_t ascii_ihash( daw::string_view str ) noexcept {
+		char const *first = str.data( );
+		std::size_t count = str.size( );
+		std::uint64_t hash =
+		  0x9E37'79B9'7F4A'7C15ULL ^ static_cast<std::uint64_t>( count );
+		for( ; count >= 8; first += 8, count -= 8 ) {
+			hash = parser_ascii_details::mix_word(
+			  hash, parser_ascii_details::lower_word(
+			          parser_ascii_details::load_word( first ) ) );
+		}
+		if( count > 0 ) {
+			hash = parser_ascii_details::mix_word(
+			  hash, parser_ascii_details::lower_word(
+			          parser_ascii_details::load_word( first, count ) ) );
+		}
+		hash ^= hash >> 29U;
+		hash *= 0xBF58'476D'1CE4'E5B9ULL;
+		return static_cast<std::size_t>( hash ^ ( hash >> 32U ) );
+	}
+
+	/// Hash for containers keyed on ASCII case-insensitive strings, such as
+	/// HTTP header names
+	struct ascii_case_insensitive_hash {
+		using is_transparent = void;
+
+		constexpr std::size_t operator( )( daw::string_view str ) const noexcept {
+			return ascii_ihash( str );
+		}
+	};
+
+	struct ascii_case_insensitive_equal {
+		using is_transparent = void;
+
+		constexpr bool operator( )( daw::string_view lhs,
+		                            daw::string_view rhs ) const noexcept {
+			return ascii_iequal( lhs, rhs );
+		}
+	};
+} // namespace daw::parser
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw_parser_addons.h"
+#include "daw_parser_ascii.h"
 #include "daw_parser_helper.h"
 #include "daw_string_view.h"
 #include "daw_traits.h"
@@ -10,12 +10,20 @@
 
 #include "daw_exception.h"
 #include "daw_fnv1a_hash.h"
+#include "daw_likely.h"
+#include "daw_random_engines.h"
 #include "daw_swap.h"
 #include "daw_traits.h"
 #include "daw_utility.h"
 
+#include <algorithm>
 #include <ciso646>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <random>
+#include <type_traits>
 
 namespace daw::impl {
 	static inline auto &global_rng( ) {
@@ -25,16 +33,136 @@ namespace daw::impl {
 } // namespace daw::impl
 
 namespace daw {
-	template<typename IntType>
-	inline IntType randint( IntType a, IntType b ) {
+	namespace random_impl {
+		template<typename UInt, typename Engine>
+		constexpr UInt random_bits( Engine &engine ) {
+			constexpr auto max32 = std::numeric_limits<uint32_t>::max( );
+			constexpr auto max64 = std::numeric_limits<uint64_t>::max( );
+			static_assert( Engine::min( ) == 0 and ( Engine::max( ) == max32 or
+			                                         Engine::max( ) == max64 ),
+			               "Engine must produce all bits of a 32 or 64bit integer" );
+			if constexpr( sizeof( UInt ) <= sizeof( uint32_t ) or
+			              Engine::max( ) == max64 ) {
+				return static_cast<UInt>( engine( ) );
+			} else {
+				auto const high = static_cast<uint64_t>( engine( ) );
+				return static_cast<UInt>( ( high << 32U ) |
+				                          static_cast<uint64_t>( engine( ) ) );
+			}
+		}
+
+		constexpr uint32_t mul_high( uint32_t x, uint32_t range,
+		                             uint32_t &low ) noexcept {
+			uint64_t const m = static_cast<uint64_t>( x ) * range;
+			low = static_cast<uint32_t>( m );
+			return static_cast<uint32_t>( m >> 32U );
+		}
+
+		constexpr uint64_t mul_high( uint64_t x, uint64_t range,
+		                             uint64_t &low ) noexcept {
+			auto const m = mul_u64( x, range );
+			low = m.low;
+			return m.high;
+		}
+
+		template<typename UInt, typename Engine>
+		constexpr UInt bounded_rand( Engine &engine, UInt range, UInt x ) {
+			UInt low = 0;
+			UInt result = mul_high( x, range, low );
+			if( low < range ) {
+				UInt const threshold = static_cast<UInt>( 0U - range ) % range;
+				while( low < threshold ) {
+					result = mul_high( random_bits<UInt>( engine ), range, low );
+				}
+			}
+			return result;
+		}
+
+		/// A single lane of a lane parallel engine as a UniformRandomBitGenerator
+		template<typename LaneEngine>
+		struct lane_engine {
+			using result_type = uint64_t;
+
+			LaneEngine *lanes;
+			size_t lane;
+
+			static constexpr result_type min( ) noexcept {
+				return 0;
+			}
+
+			static constexpr result_type max( ) noexcept {
+				return std::numeric_limits<result_type>::max( );
+			}
+
+			result_type operator( )( ) noexcept {
+				return ( *lanes )( lane );
+			}
+		};
+
+		template<typename IntType>
+		using rand_uint_t =
+		  std::conditional_t<( sizeof( IntType ) <= sizeof( uint32_t ) ), uint32_t,
+		                     uint64_t>;
+	} // namespace random_impl
+
+	/// @brief Generate a uniform integer in [0, range) using Lemire's nearly
+	/// divisionless method.  A division only happens on the rare path where the
+	/// product lands in the biased region.  A range of 0 means all values
+	/// @tparam UInt uint32_t or uint64_t
+	/// @param engine A UniformRandomBitGenerator producing 32 or 64 full bits
+	template<typename UInt, typename Engine>
+	constexpr UInt bounded_rand( Engine &engine, UInt range ) {
+		static_assert( std::is_same_v<UInt, uint32_t> or
+		                 std::is_same_v<UInt, uint64_t>,
+		               "Only uint32_t and uint64_t ranges are supported" );
+		auto const x = random_impl::random_bits<UInt>( engine );
+		if( range == 0 ) {
+			return x;
+		}
+		return random_impl::bounded_rand( engine, range, x );
+	}
+
+	/// @brief Generate a uniform integer in [a, b] from engine
+	template<typename IntType, typename Engine>
+	constexpr IntType randint( Engine &engine, IntType a, IntType b ) {
 		static_assert( std::is_integral_v<IntType>,
 		               "IntType must be a valid integral type" );
 		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
-		using distribution_type = std::uniform_int_distribution<IntType>;
-		using param_type = typename distribution_type::param_type;
+		using uint_t = random_impl::rand_uint_t<IntType>;
+		// A full width range wraps to 0, which bounded_rand treats as all values
+		auto const range = static_cast<uint_t>(
+		  static_cast<uint_t>( static_cast<uint_t>( b ) -
+		                       static_cast<uint_t>( a ) ) +
+		  1U );
+		auto const offset = bounded_rand<uint_t>( engine, range );
+		return static_cast<IntType>( static_cast<uint_t>( a ) + offset );
+	}
+
+	/// @brief Generate a uniform floating point value in [a, b) from engine
+	template<typename Real, typename Engine>
+	constexpr Real randreal( Engine &engine, Real a, Real b ) {
+		static_assert( std::is_floating_point_v<Real>,
+		               "Real must be a floating point type" );
+		Real result = a;
+		if constexpr( sizeof( Real ) <= sizeof( float ) ) {
+			auto const bits = random_impl::random_bits<uint32_t>( engine );
+			auto const unit = static_cast<Real>( bits >> 8U ) * 0x1.0p-24f;
+			result = a + ( b - a ) * unit;
+		} else {
+			auto const bits = random_impl::random_bits<uint64_t>( engine );
+			auto const unit = static_cast<Real>( bits >> 11U ) * 0x1.0p-53;
+			result = a + ( b - a ) * unit;
+		}
+		// Rounding can give b when unit is close to 1
+		if( DAW_UNLIKELY( not( result < b ) and a < b ) ) {
+			return std::nextafter( b, a );
+		}
+		return result;
+	}
 
-		thread_local auto d = distribution_type( );
-		return d( impl::global_rng( ), param_type( a, b ) );
+	template<typename IntType>
+	inline IntType randint( IntType a, IntType b ) {
+		return randint<IntType>( impl::global_rng( ), a, b );
 	}
 
 	template<typename IntType>
@@ -51,25 +179,126 @@ namespace daw {
 		impl::global_rng( ).seed( value );
 	}
 
-	template<typename RandomIterator>
-	inline void shuffle( RandomIterator first, RandomIterator last ) {
+	template<typename RandomIterator, typename Engine>
+	constexpr void shuffle( RandomIterator first, RandomIterator last,
+	                        Engine &engine ) {
 		using diff_t =
 		  typename std::iterator_traits<RandomIterator>::difference_type;
 
 		diff_t n = last - first;
 		for( diff_t i = n - 1; i > 0; --i ) {
-			daw::cswap( first[i], first[randint<diff_t>( 0, i )] );
+			auto const j = static_cast<diff_t>(
+			  bounded_rand<uint64_t>( engine, static_cast<uint64_t>( i ) + 1U ) );
+			daw::cswap( first[i], first[j] );
 		}
 	}
 
-	template<typename IntType, typename ForwardIterator>
-	inline void random_fill( ForwardIterator first, ForwardIterator const last,
-	                         IntType a, IntType b ) {
+	template<typename RandomIterator>
+	inline void shuffle( RandomIterator first, RandomIterator last ) {
+		daw::shuffle( first, last, impl::global_rng( ) );
+	}
+
+	template<typename IntType, typename ForwardIterator, typename Engine>
+	constexpr void random_fill( ForwardIterator first, ForwardIterator const last,
+	                            IntType a, IntType b, Engine &engine ) {
 		static_assert( std::is_integral_v<IntType>,
 		               "IntType must be a valid integral type" );
 		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
 		while( first != last ) {
-			*first++ = randint<IntType>( a, b );
+			*first++ = randint<IntType>( engine, a, b );
+		}
+	}
+
+	template<typename IntType, typename ForwardIterator>
+	inline void random_fill( ForwardIterator first, ForwardIterator const last,
+	                         IntType a, IntType b ) {
+		random_fill( first, last, a, b, impl::global_rng( ) );
+	}
+
+	/***
+	 * Fill [first, last) with uniform values in [a, b] ( [a, b) for floating
+	 * point ) using a lane parallel xoshiro256++.  Blocks of Lanes raw values
+	 * are generated together and scaled without branches so the loop
+	 * vectorizes; only blocks that hit Lemire's biased region take the
+	 * rejection path.  The lanes are seeded from engine, so the output is
+	 * reproducible for a given engine state
+	 * @tparam Lanes number of independent generator lanes
+	 * @param engine source of the lane seeds, usually a split( ) stream
+	 */
+	template<size_t Lanes = 8, typename T, typename Engine>
+	void batch_random_fill( T *first, T *const last, T a, T b, Engine &engine ) {
+		static_assert( std::is_arithmetic_v<T>, "T must be an arithmetic type" );
+		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
+		auto lanes = xoshiro256pp_lanes<Lanes>( engine );
+		// Several rounds per block amortize moving the lane state in and out
+		constexpr size_t block_size = Lanes * 8U;
+		uint64_t block[block_size];
+		using uint_t = random_impl::rand_uint_t<T>;
+		constexpr size_t per_block =
+		  block_size * sizeof( uint64_t ) / sizeof( uint_t );
+		uint_t bits[per_block];
+
+		if constexpr( std::is_floating_point_v<T> ) {
+			constexpr bool is_float = sizeof( T ) <= sizeof( float );
+			constexpr auto shift = sizeof( uint_t ) * 8U - ( is_float ? 24U : 53U );
+			constexpr T unit = is_float ? static_cast<T>( 0x1.0p-24 )
+			                            : static_cast<T>( 0x1.0p-53 );
+			T const scale = b - a;
+			// Rounding can give b, keep the result below it
+			T const top = a < b ? std::nextafter( b, a ) : b;
+			while( first != last ) {
+				lanes.generate( block );
+				std::memcpy( bits, block, sizeof( block ) );
+				auto const count =
+				  std::min( per_block, static_cast<size_t>( last - first ) );
+				for( size_t n = 0; n < count; ++n ) {
+					T const value =
+					  a + scale * ( static_cast<T>( bits[n] >> shift ) * unit );
+					first[n] = value < top ? value : top;
+				}
+				first += count;
+			}
+		} else {
+			auto const range = static_cast<uint_t>(
+			  static_cast<uint_t>( static_cast<uint_t>( b ) -
+			                       static_cast<uint_t>( a ) ) +
+			  1U );
+			auto const base = static_cast<uint_t>( a );
+			uint_t offsets[per_block];
+			while( first != last ) {
+				lanes.generate( block );
+				std::memcpy( bits, block, sizeof( block ) );
+				auto const count =
+				  std::min( per_block, static_cast<size_t>( last - first ) );
+				if( range == 0 ) {
+					for( size_t n = 0; n < count; ++n ) {
+						first[n] = static_cast<T>( bits[n] );
+					}
+				} else {
+					// Track the smallest low half; only when it is below range can a
+					// value be biased and need Lemire's rejection step
+					auto min_low = std::numeric_limits<uint_t>::max( );
+					for( size_t n = 0; n < count; ++n ) {
+						uint_t low = 0;
+						offsets[n] = random_impl::mul_high( bits[n], range, low );
+						min_low = low < min_low ? low : min_low;
+					}
+					if( min_low < range ) {
+						// Redraw from the lane that produced the value, so the output
+						// only depends on the lane seeds
+						for( size_t n = 0; n < count; ++n ) {
+							auto lane = random_impl::lane_engine<decltype( lanes )>{
+							  &lanes, ( n * sizeof( uint_t ) / sizeof( uint64_t ) ) % Lanes };
+							offsets[n] = random_impl::bounded_rand( lane, range, bits[n] );
+						}
+					}
+					for( size_t n = 0; n < count; ++n ) {
+						first[n] =
+						  static_cast<T>( static_cast<uint_t>( base + offsets[n] ) );
+					}
+				}
+				first += count;
+			}
 		}
 	}
 
@@ -0,0 +1,460 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_arith_traits.h"
+
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace daw {
+	namespace random_impl {
+		struct uint128_parts {
+			uint64_t low;
+			uint64_t high;
+		};
+
+		/// @brief Full 64x64->128bit multiplication
+		constexpr uint128_parts mul_u64( uint64_t a, uint64_t b ) noexcept {
+#if defined( DAW_HAS_INT128 )
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+			auto const result = static_cast<__uint128_t>( a ) * b;
+			return { static_cast<uint64_t>( result ),
+			         static_cast<uint64_t>( result >> 64U ) };
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+#else
+			uint64_t const a_lo = a & 0xFFFF'FFFFULL;
+			uint64_t const a_hi = a >> 32U;
+			uint64_t const b_lo = b & 0xFFFF'FFFFULL;
+			uint64_t const b_hi = b >> 32U;
+
+			uint64_t const lo_lo = a_lo * b_lo;
+			uint64_t const hi_lo = a_hi * b_lo;
+			uint64_t const lo_hi = a_lo * b_hi;
+			uint64_t const hi_hi = a_hi * b_hi;
+
+			uint64_t const cross =
+			  ( lo_lo >> 32U ) + ( hi_lo & 0xFFFF'FFFFULL ) + lo_hi;
+			return { ( cross << 32U ) | ( lo_lo & 0xFFFF'FFFFULL ),
+			         ( hi_lo >> 32U ) + ( cross >> 32U ) + hi_hi };
+#endif
+		}
+
+		constexpr uint64_t rotl( uint64_t x, unsigned k ) noexcept {
+			return ( x << k ) | ( x >> ( 64U - k ) );
+		}
+
+		/// @brief splitmix64 step, used to expand a single seed into engine state
+		constexpr uint64_t splitmix64( uint64_t &state ) noexcept {
+			uint64_t z = ( state += 0x9E37'79B9'7F4A'7C15ULL );
+			z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+			z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+			return z ^ ( z >> 31U );
+		}
+
+#if defined( __GNUC__ )
+		template<size_t Lanes>
+		struct u64_lanes;
+
+		template<>
+		struct u64_lanes<2> {
+			typedef uint64_t type __attribute__( ( vector_size( 16 ) ) );
+		};
+
+		template<>
+		struct u64_lanes<4> {
+			typedef uint64_t type __attribute__( ( vector_size( 32 ) ) );
+		};
+
+		template<>
+		struct u64_lanes<8> {
+			typedef uint64_t type __attribute__( ( vector_size( 64 ) ) );
+		};
+#else
+		template<size_t Lanes>
+		struct u64_lanes {
+			struct type {
+				uint64_t values[Lanes];
+
+				uint64_t &operator[]( size_t n ) noexcept {
+					return values[n];
+				}
+			};
+		};
+#endif
+	} // namespace random_impl
+
+	/// @brief xoshiro256++ 1.0 by Blackman and Vigna.  A fast, all purpose
+	/// 64bit generator with a period of 2^256-1.  jump( ) and long_jump( )
+	/// advance the state by 2^128 and 2^192 calls, and split( ) uses jump( ) to
+	/// hand out non-overlapping streams to parallel workers
+	class xoshiro256pp {
+		uint64_t m_state[4] = { };
+
+		template<size_t N>
+		constexpr void jump_impl( uint64_t const ( &poly )[N] ) noexcept {
+			uint64_t s0 = 0;
+			uint64_t s1 = 0;
+			uint64_t s2 = 0;
+			uint64_t s3 = 0;
+			for( uint64_t const p : poly ) {
+				for( unsigned b = 0; b < 64U; ++b ) {
+					if( p & ( 1ULL << b ) ) {
+						s0 ^= m_state[0];
+						s1 ^= m_state[1];
+						s2 ^= m_state[2];
+						s3 ^= m_state[3];
+					}
+					operator( )( );
+				}
+			}
+			m_state[0] = s0;
+			m_state[1] = s1;
+			m_state[2] = s2;
+			m_state[3] = s3;
+		}
+
+	public:
+		using result_type = uint64_t;
+		static constexpr result_type default_seed = 0x853C'49E6'748F'EA9BULL;
+
+		static constexpr result_type min( ) noexcept {
+			return std::numeric_limits<result_type>::min( );
+		}
+
+		static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		explicit constexpr xoshiro256pp(
+		  result_type seed_value = default_seed ) noexcept {
+			seed( seed_value );
+		}
+
+		/// @brief Construct from raw state.  The state must not be all zero
+		constexpr xoshiro256pp( uint64_t s0, uint64_t s1, uint64_t s2,
+		                        uint64_t s3 ) noexcept
+		  : m_state{ s0, s1, s2, s3 } {}
+
+		constexpr void seed( result_type seed_value ) noexcept {
+			for( auto &s : m_state ) {
+				s = random_impl::splitmix64( seed_value );
+			}
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			uint64_t const result =
+			  random_impl::rotl( m_state[0] + m_state[3], 23U ) + m_state[0];
+			uint64_t const t = m_state[1] << 17U;
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = random_impl::rotl( m_state[3], 45U );
+			return result;
+		}
+
+		constexpr void discard( unsigned long long count ) noexcept {
+			while( count-- > 0 ) {
+				operator( )( );
+			}
+		}
+
+		/// @brief Equivalent to 2^128 calls to operator( )
+		constexpr void jump( ) noexcept {
+			constexpr uint64_t poly[] = { 0x180E'C6D3'3CFD'0ABAULL,
+			                              0xD5A6'1266'F0C9'392CULL,
+			                              0xA958'2618'E03F'C9AAULL,
+			                              0x39AB'DC45'29B1'661CULL };
+			jump_impl( poly );
+		}
+
+		/// @brief Equivalent to 2^192 calls to operator( )
+		constexpr void long_jump( ) noexcept {
+			constexpr uint64_t poly[] = { 0x76E1'5D3E'FEFD'CBBFULL,
+			                              0xC500'4E44'1C52'2FB3ULL,
+			                              0x7771'0069'854E'E241ULL,
+			                              0x3910'9BB0'2ACB'E635ULL };
+			jump_impl( poly );
+		}
+
+		/// @brief Returns an engine at the current position and jumps this one
+		/// ahead by 2^128.  Repeated calls give each worker its own stream
+		constexpr xoshiro256pp split( ) noexcept {
+			auto result = *this;
+			jump( );
+			return result;
+		}
+
+		friend constexpr bool operator==( xoshiro256pp const &lhs,
+		                                  xoshiro256pp const &rhs ) noexcept {
+			return lhs.m_state[0] == rhs.m_state[0] and
+			       lhs.m_state[1] == rhs.m_state[1] and
+			       lhs.m_state[2] == rhs.m_state[2] and
+			       lhs.m_state[3] == rhs.m_state[3];
+		}
+
+		friend constexpr bool operator!=( xoshiro256pp const &lhs,
+		                                  xoshiro256pp const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// @brief wyrand by Wang Yi.  A Weyl sequence passed through a 128bit
+	/// multiply-fold.  The state is a counter, so discard( n ) is O(1)
+	class wyrand {
+		uint64_t m_state = 0;
+
+		static constexpr uint64_t increment = 0xA076'1D64'78BD'642FULL;
+		static constexpr uint64_t mix = 0xE703'7ED1'A0B4'28DBULL;
+
+	public:
+		using result_type = uint64_t;
+		static constexpr result_type default_seed = 0x853C'49E6'748F'EA9BULL;
+
+		static constexpr result_type min( ) noexcept {
+			return std::numeric_limits<result_type>::min( );
+		}
+
+		static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		explicit constexpr wyrand( result_type seed_value = default_seed ) noexcept
+		  : m_state( seed_value ) {}
+
+		constexpr void seed( result_type seed_value ) noexcept {
+			m_state = seed_value;
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			m_state += increment;
+			auto const m = random_impl::mul_u64( m_state, m_state ^ mix );
+			return m.low ^ m.high;
+		}
+
+		constexpr void discard( unsigned long long count ) noexcept {
+			m_state += increment * static_cast<uint64_t>( count );
+		}
+
+		/// @brief Returns an engine at the current position and moves this one
+		/// 2^48 calls ahead
+		constexpr wyrand split( ) noexcept {
+			auto result = *this;
+			discard( 1ULL << 48U );
+			return result;
+		}
+
+		friend constexpr bool operator==( wyrand const &lhs,
+		                                  wyrand const &rhs ) noexcept {
+			return lhs.m_state == rhs.m_state;
+		}
+
+		friend constexpr bool operator!=( wyrand const &lhs,
+		                                  wyrand const &rhs ) noexcept {
+			return lhs.m_state != rhs.m_state;
+		}
+	};
+
+	/// @brief PCG32 (XSH RR 64/32) by O'Neill.  Each odd increment selects one
+	/// of 2^63 independent streams and discard( n ) runs in O(log n)
+	class pcg32 {
+		uint64_t m_state = 0;
+		uint64_t m_inc = 0;
+
+		static constexpr uint64_t multiplier = 6364136223846793005ULL;
+
+		constexpr void step( ) noexcept {
+			m_state = m_state * multiplier + m_inc;
+		}
+
+		// Two draws, the first is the high word.  Named so the order does not
+		// depend on the compiler's evaluation order
+		constexpr uint64_t next_u64( ) noexcept {
+			uint64_t const hi = operator( )( );
+			uint64_t const lo = operator( )( );
+			return ( hi << 32U ) | lo;
+		}
+
+	public:
+		using result_type = uint32_t;
+		static constexpr uint64_t default_seed = 0x853C'49E6'748F'EA9BULL;
+		static constexpr uint64_t default_stream = 0xDA3E'39CB'94B9'5BDBULL;
+
+		static constexpr result_type min( ) noexcept {
+			return std::numeric_limits<result_type>::min( );
+		}
+
+		static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		explicit constexpr pcg32( uint64_t seed_value = default_seed,
+		                          uint64_t stream = default_stream ) noexcept {
+			seed( seed_value, stream );
+		}
+
+		constexpr void seed( uint64_t seed_value,
+		                     uint64_t stream = default_stream ) noexcept {
+			m_state = 0U;
+			m_inc = ( stream << 1U ) | 1U;
+			step( );
+			m_state += seed_value;
+			step( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			uint64_t const old_state = m_state;
+			step( );
+			auto const xorshifted = static_cast<uint32_t>(
+			  ( ( old_state >> 18U ) ^ old_state ) >> 27U );
+			auto const rot = static_cast<uint32_t>( old_state >> 59U );
+			return ( xorshifted >> rot ) | ( xorshifted << ( ( 0U - rot ) & 31U ) );
+		}
+
+		constexpr void discard( unsigned long long count ) noexcept {
+			uint64_t cur_mult = multiplier;
+			uint64_t cur_plus = m_inc;
+			uint64_t acc_mult = 1U;
+			uint64_t acc_plus = 0U;
+			while( count > 0 ) {
+				if( count & 1U ) {
+					acc_mult *= cur_mult;
+					acc_plus = acc_plus * cur_mult + cur_plus;
+				}
+				cur_plus = ( cur_mult + 1U ) * cur_plus;
+				cur_mult *= cur_mult;
+				count >>= 1U;
+			}
+			m_state = acc_mult * m_state + acc_plus;
+		}
+
+		/// @brief Returns an engine seeded from this one on a different stream
+		constexpr pcg32 split( ) noexcept {
+			uint64_t const new_seed = next_u64( );
+			uint64_t const new_stream = next_u64( );
+			return pcg32( new_seed, new_stream );
+		}
+
+		friend constexpr bool operator==( pcg32 const &lhs,
+		                                  pcg32 const &rhs ) noexcept {
+			return lhs.m_state == rhs.m_state and lhs.m_inc == rhs.m_inc;
+		}
+
+		friend constexpr bool operator!=( pcg32 const &lhs,
+		                                  pcg32 const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// @brief Lane parallel xoshiro256++.  Each lane is an independent
+	/// generator.  With GCC/Clang the lanes are held in a vector extension type
+	/// so each step is a handful of SIMD instructions on the target ISA,
+	/// elsewhere the lanes are stepped in a plain loop
+	template<size_t Lanes = 8>
+	class xoshiro256pp_lanes {
+		static_assert( Lanes == 2 or Lanes == 4 or Lanes == 8,
+		               "Lanes must be 2, 4, or 8" );
+		using lane_t = typename random_impl::u64_lanes<Lanes>::type;
+		lane_t m_s0{ };
+		lane_t m_s1{ };
+		lane_t m_s2{ };
+		lane_t m_s3{ };
+
+	public:
+		using result_type = uint64_t;
+		static constexpr size_t lane_count = Lanes;
+
+		/// @brief Seed each lane from successive outputs of engine
+		template<typename Engine>
+		explicit xoshiro256pp_lanes( Engine &engine ) noexcept {
+			for( size_t n = 0; n < Lanes; ++n ) {
+				auto lane = xoshiro256pp( static_cast<uint64_t>( engine( ) ) );
+				m_s0[n] = lane( );
+				m_s1[n] = lane( );
+				m_s2[n] = lane( );
+				m_s3[n] = lane( ) | 1U;
+			}
+		}
+
+		/// @brief Fill out with N / Lanes rounds of every lane
+		template<size_t N>
+		void generate( uint64_t ( &out )[N] ) noexcept {
+			static_assert( N % Lanes == 0, "N must be a multiple of Lanes" );
+			lane_t s0 = m_s0;
+			lane_t s1 = m_s1;
+			lane_t s2 = m_s2;
+			lane_t s3 = m_s3;
+#if defined( __GNUC__ )
+			for( size_t round = 0; round < N; round += Lanes ) {
+				lane_t const sum = s0 + s3;
+				lane_t const result = ( ( sum << 23U ) | ( sum >> 41U ) ) + s0;
+				std::memcpy( out + round, &result, sizeof( lane_t ) );
+				lane_t const t = s1 << 17U;
+				s2 ^= s0;
+				s3 ^= s1;
+				s1 ^= s2;
+				s0 ^= s3;
+				s2 ^= t;
+				s3 = ( s3 << 45U ) | ( s3 >> 19U );
+			}
+#else
+			for( size_t round = 0; round < N; round += Lanes ) {
+				for( size_t n = 0; n < Lanes; ++n ) {
+					auto &a0 = s0[n];
+					auto &a1 = s1[n];
+					auto &a2 = s2[n];
+					auto &a3 = s3[n];
+					out[round + n] = random_impl::rotl( a0 + a3, 23U ) + a0;
+					uint64_t const t = a1 << 17U;
+					a2 ^= a0;
+					a3 ^= a1;
+					a1 ^= a2;
+					a0 ^= a3;
+					a2 ^= t;
+					a3 = random_impl::rotl( a3, 45U );
+				}
+			}
+#endif
+			m_s0 = s0;
+			m_s1 = s1;
+			m_s2 = s2;
+			m_s3 = s3;
+		}
+
+		/// @brief Step only lane n and return its next output
+		uint64_t operator( )( size_t n ) noexcept {
+			uint64_t a0 = m_s0[n];
+			uint64_t a1 = m_s1[n];
+			uint64_t a2 = m_s2[n];
+			uint64_t a3 = m_s3[n];
+			uint64_t const result = random_impl::rotl( a0 + a3, 23U ) + a0;
+			uint64_t const t = a1 << 17U;
+			a2 ^= a0;
+			a3 ^= a1;
+			a1 ^= a2;
+			a0 ^= a3;
+			a2 ^= t;
+			m_s0[n] = a0;
+			m_s1[n] = a1;
+			m_s2[n] = a2;
+			m_s3[n] = random_impl::rotl( a3, 45U );
+			return result;
+		}
+	};
+} // namespace daw
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "daw_range_collection.h"
+#include "daw_range_lazy.h"
 #include "daw_range_reference.h"
 #include "daw_range_type.h"
 //#include "daw_range_parallel_collection.h"
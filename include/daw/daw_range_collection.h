@@ -114,11 +114,11 @@ namespace daw {
 			}
 
 			reference operator[]( size_t pos ) {
-				return m_values[pos].get( );
+				return m_values[pos];
 			}
 
 			const_reference operator[]( size_t pos ) const {
-				return m_values[pos].get( );
+				return m_values[pos];
 			}
 
 			bool operator==( CollectionRange const &other ) const {
@@ -135,12 +135,22 @@ namespace daw {
 			}
 
 			template<typename Value>
-			iterator find( Value const &value ) const {
+			iterator find( Value const &value ) {
+				return std::find( begin( ), end( ), value );
+			}
+
+			template<typename Value>
+			const_iterator find( Value const &value ) const {
 				return std::find( begin( ), end( ), value );
 			}
 
 			template<typename UnaryPredicate>
-			iterator find_if( UnaryPredicate predicate ) const {
+			iterator find_if( UnaryPredicate predicate ) {
+				return std::find_if( begin( ), end( ), predicate );
+			}
+
+			template<typename UnaryPredicate>
+			const_iterator find_if( UnaryPredicate predicate ) const {
 				return std::find_if( begin( ), end( ), predicate );
 			}
 
@@ -168,7 +178,7 @@ namespace daw {
 				return std::find_if( begin( ), end( ), pred2 ) != end( );
 			}
 
-			decltype( auto ) sort( ) const {
+			auto sort( ) const {
 				return make_range_reference( *this ).sort( );
 			}
 
@@ -188,7 +198,7 @@ namespace daw {
 				return *this;
 			}
 
-			decltype( auto ) stable_sort( ) const {
+			auto stable_sort( ) const {
 				return make_range_reference( *this ).stable_sort( );
 			}
 
@@ -198,7 +208,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) stable_sort( UnaryPredicate predicate ) const {
+			auto stable_sort( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).stable_sort( predicate );
 			}
 
@@ -208,7 +218,7 @@ namespace daw {
 				return *this;
 			}
 
-			decltype( auto ) unique( ) const {
+			auto unique( ) const {
 				return make_range_reference( *this ).unique( );
 			}
 
@@ -219,7 +229,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) unique( UnaryPredicate predicate ) const {
+			auto unique( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).unique( predicate );
 			}
 
@@ -232,7 +242,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) partition( UnaryPredicate predicate ) const {
+			auto partition( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).partition( predicate );
 			}
 
@@ -243,7 +253,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) stable_partition( UnaryPredicate predicate ) const {
+			auto stable_partition( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).stable_partition( predicate );
 			}
 
@@ -254,7 +264,7 @@ namespace daw {
 			}
 
 			template<typename UnaryOperator>
-			CollectionRange &transform( UnaryOperator oper ) const {
+			auto transform( UnaryOperator oper ) const {
 				using v_t = daw::traits::root_type_t<decltype( oper( front( ) ) )>;
 				auto result = CollectionRange<v_t>( );
 				std::transform( std::begin( m_values ), std::end( m_values ),
@@ -271,7 +281,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) erase( UnaryPredicate predicate ) const {
+			auto erase( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).erase( predicate );
 			}
 
@@ -283,7 +293,7 @@ namespace daw {
 			}
 
 			template<typename Value>
-			decltype( auto ) erase_where_equal_to( Value const &value ) const {
+			auto erase_where_equal_to( Value const &value ) const {
 				return make_range_reference( *this ).erase_where_equal_to( value );
 			}
 
@@ -294,7 +304,7 @@ namespace daw {
 			}
 
 			template<typename UnaryPredicate>
-			decltype( auto ) where( UnaryPredicate predicate ) const {
+			auto where( UnaryPredicate predicate ) const {
 				return make_range_reference( *this ).where( predicate );
 			}
 
@@ -306,15 +316,14 @@ namespace daw {
 			}
 
 			template<typename Value>
-			decltype( auto ) where_equal_to( Value const &value ) const {
+			auto where_equal_to( Value const &value ) const {
 				return make_range_reference( *this ).where_equal_to( value );
 			}
 
 			template<typename Container>
 			decltype( auto ) as( ) const {
 				Container result;
-				std::transform( begin( ), end( ), std::back_inserter( result ),
-				                []( auto const &rv ) { return rv.get( ); } );
+				std::copy( begin( ), end( ), std::back_inserter( result ) );
 				return result;
 			}
 
@@ -346,7 +355,7 @@ namespace daw {
 			}
 
 			template<typename UniformRandomNumberGenerator>
-			decltype( auto ) shuffle( UniformRandomNumberGenerator &&urng ) const {
+			auto shuffle( UniformRandomNumberGenerator &&urng ) const {
 				return make_range_reference( *this ).shuffle(
 				  std::forward<UniformRandomNumberGenerator>( urng ) );
 			}
@@ -357,7 +366,7 @@ namespace daw {
 				return shuffle( g );
 			}
 
-			decltype( auto ) shuffle( ) const {
+			auto shuffle( ) const {
 				return make_range_reference( *this ).shuffle( );
 			}
 		}; // struct CollectionRange
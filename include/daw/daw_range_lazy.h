@@ -0,0 +1,447 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_move.h"
+#include "daw_range_collection.h"
+#include "daw_range_common.h"
+#include "daw_traits.h"
+
+#include <algorithm>
+#include <ciso646>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	namespace range {
+		namespace lazy_impl {
+			/// Non owning source for lvalue containers and iterator pairs
+			template<typename Iterator, typename Last = Iterator>
+			struct view_source {
+				Iterator m_first;
+				Last m_last;
+
+				Iterator begin( ) const {
+					return m_first;
+				}
+
+				Last end( ) const {
+					return m_last;
+				}
+			};
+
+			// Every stage is called with the incoming value and a continuation
+			// for the rest of the pipeline.  Returning false stops the pass
+			template<typename UnaryOperator>
+			struct map_stage {
+				UnaryOperator m_oper;
+
+				template<typename T>
+				using result_t = std::invoke_result_t<UnaryOperator &, T>;
+
+				template<typename T, typename Next>
+				bool operator( )( T &&value, Next &&next ) {
+					return next( m_oper( std::forward<T>( value ) ) );
+				}
+			};
+
+			template<typename UnaryPredicate>
+			struct filter_stage {
+				UnaryPredicate m_pred;
+
+				template<typename T>
+				using result_t = T;
+
+				template<typename T, typename Next>
+				bool operator( )( T &&value, Next &&next ) {
+					if( not m_pred( value ) ) {
+						return true;
+					}
+					return next( std::forward<T>( value ) );
+				}
+			};
+
+			struct take_stage {
+				std::size_t m_remaining;
+
+				template<typename T>
+				using result_t = T;
+
+				template<typename T, typename Next>
+				bool operator( )( T &&value, Next &&next ) {
+					if( m_remaining == 0 ) {
+						return false;
+					}
+					--m_remaining;
+					return next( std::forward<T>( value ) ) and m_remaining > 0;
+				}
+			};
+
+			struct drop_stage {
+				std::size_t m_remaining;
+
+				template<typename T>
+				using result_t = T;
+
+				template<typename T, typename Next>
+				bool operator( )( T &&value, Next &&next ) {
+					if( m_remaining > 0 ) {
+						--m_remaining;
+						return true;
+					}
+					return next( std::forward<T>( value ) );
+				}
+			};
+
+			template<typename T, typename... Stages>
+			struct pipeline_result {
+				using type = T;
+			};
+
+			template<typename T, typename Stage, typename... Stages>
+			struct pipeline_result<T, Stage, Stages...> {
+				using type =
+				  typename pipeline_result<typename Stage::template result_t<T>,
+				                           Stages...>::type;
+			};
+
+			template<std::size_t Idx, typename StageTuple, typename Sink,
+			         typename T>
+			bool push( StageTuple &stages, Sink &sink, T &&value ) {
+				if constexpr( Idx == std::tuple_size_v<StageTuple> ) {
+					return sink( std::forward<T>( value ) );
+				} else {
+					return std::get<Idx>( stages )(
+					  std::forward<T>( value ), [&]( auto &&next_value ) {
+						  return push<Idx + 1>(
+						    stages, sink,
+						    std::forward<decltype( next_value )>( next_value ) );
+					  } );
+				}
+			}
+		} // namespace lazy_impl
+
+		/// @brief A deferred chain of map/where/take/drop stages over a source.
+		/// Nothing runs until a sink (to_vector, reduce, for_each, sort, ...) is
+		/// called, and then every stage is applied to each element in a single
+		/// pass with no intermediate containers.  Lvalue sources are referenced
+		/// and must outlive the range, rvalue sources are owned.
+		template<typename Source, typename... Stages>
+		class LazyRange {
+			Source m_source;
+			std::tuple<Stages...> m_stages;
+
+			template<typename... NewStages>
+			using with_t = LazyRange<Source, NewStages...>;
+
+			template<typename Stage>
+			auto append( Stage &&stage ) const & {
+				return with_t<Stages..., daw::remove_cvref_t<Stage>>(
+				  m_source,
+				  std::tuple_cat( m_stages,
+				                  std::make_tuple( std::forward<Stage>( stage ) ) ) );
+			}
+
+			template<typename Stage>
+			auto append( Stage &&stage ) && {
+				return with_t<Stages..., daw::remove_cvref_t<Stage>>(
+				  daw::move( m_source ),
+				  std::tuple_cat( daw::move( m_stages ),
+				                  std::make_tuple( std::forward<Stage>( stage ) ) ) );
+			}
+
+		public:
+			using is_lazy_range = std::true_type;
+			using source_reference =
+			  decltype( *std::begin( std::declval<Source const &>( ) ) );
+			using reference =
+			  typename lazy_impl::pipeline_result<source_reference,
+			                                      Stages...>::type;
+			using value_type = daw::remove_cvref_t<reference>;
+
+			LazyRange( Source source, std::tuple<Stages...> stages )
+			  : m_source( daw::move( source ) )
+			  , m_stages( daw::move( stages ) ) {}
+
+			/// Apply oper to each element
+			template<typename UnaryOperator>
+			auto map( UnaryOperator oper ) const & {
+				return append( lazy_impl::map_stage<UnaryOperator>{ oper } );
+			}
+
+			template<typename UnaryOperator>
+			auto map( UnaryOperator oper ) && {
+				return daw::move( *this ).append(
+				  lazy_impl::map_stage<UnaryOperator>{ oper } );
+			}
+
+			template<typename UnaryOperator>
+			auto transform( UnaryOperator oper ) const & {
+				return map( oper );
+			}
+
+			template<typename UnaryOperator>
+			auto transform( UnaryOperator oper ) && {
+				return daw::move( *this ).map( oper );
+			}
+
+			/// Keep the elements that satisfy pred
+			template<typename UnaryPredicate>
+			auto where( UnaryPredicate pred ) const & {
+				return append( lazy_impl::filter_stage<UnaryPredicate>{ pred } );
+			}
+
+			template<typename UnaryPredicate>
+			auto where( UnaryPredicate pred ) && {
+				return daw::move( *this ).append(
+				  lazy_impl::filter_stage<UnaryPredicate>{ pred } );
+			}
+
+			template<typename UnaryPredicate>
+			auto filter( UnaryPredicate pred ) const & {
+				return where( pred );
+			}
+
+			template<typename UnaryPredicate>
+			auto filter( UnaryPredicate pred ) && {
+				return daw::move( *this ).where( pred );
+			}
+
+			/// Stop after count elements have reached this stage
+			auto take( std::size_t count ) const & {
+				return append( lazy_impl::take_stage{ count } );
+			}
+
+			auto take( std::size_t count ) && {
+				return daw::move( *this ).append( lazy_impl::take_stage{ count } );
+			}
+
+			/// Skip the first count elements that reach this stage
+			auto drop( std::size_t count ) const & {
+				return append( lazy_impl::drop_stage{ count } );
+			}
+
+			auto drop( std::size_t count ) && {
+				return daw::move( *this ).append( lazy_impl::drop_stage{ count } );
+			}
+
+			/// Run the pipeline, passing each result to sink.  Stops early if sink
+			/// returns false
+			template<typename Sink>
+			void run( Sink &&sink ) const {
+				// Stages such as take carry per pass state
+				auto stages = m_stages;
+				auto consume = [&]( auto &&value ) {
+					using result_t =
+					  decltype( sink( std::forward<decltype( value )>( value ) ) );
+					if constexpr( std::is_same_v<bool, result_t> ) {
+						return sink( std::forward<decltype( value )>( value ) );
+					} else {
+						sink( std::forward<decltype( value )>( value ) );
+						return true;
+					}
+				};
+				auto first = std::begin( m_source );
+				auto const last = std::end( m_source );
+				for( ; first != last; ++first ) {
+					if( not lazy_impl::push<0>( stages, consume, *first ) ) {
+						return;
+					}
+				}
+			}
+
+			template<typename Function>
+			void for_each( Function func ) const {
+				run( [&]( auto &&value ) {
+					func( std::forward<decltype( value )>( value ) );
+				} );
+			}
+
+			template<typename OutputIterator>
+			OutputIterator copy_to( OutputIterator out ) const {
+				run( [&]( auto &&value ) {
+					*out = std::forward<decltype( value )>( value );
+					++out;
+				} );
+				return out;
+			}
+
+			std::vector<value_type> to_vector( ) const {
+				std::vector<value_type> result{ };
+				if constexpr( sizeof...( Stages ) == 0 ) {
+					result.reserve( static_cast<std::size_t>(
+					  std::distance( std::begin( m_source ), std::end( m_source ) ) ) );
+				}
+				run( [&]( auto &&value ) {
+					result.emplace_back( std::forward<decltype( value )>( value ) );
+				} );
+				return result;
+			}
+
+			std::vector<value_type> as_vector( ) const {
+				return to_vector( );
+			}
+
+			CollectionRange<value_type> to_collection( ) const {
+				CollectionRange<value_type> result{ };
+				run( [&]( auto &&value ) {
+					result.push_back( std::forward<decltype( value )>( value ) );
+				} );
+				return result;
+			}
+
+			template<typename U, typename BinaryOperator>
+			U reduce( U init, BinaryOperator oper ) const {
+				run( [&]( auto &&value ) {
+					init = oper( daw::move( init ),
+					             std::forward<decltype( value )>( value ) );
+				} );
+				return init;
+			}
+
+			template<typename U>
+			U reduce( U init ) const {
+				return reduce( daw::move( init ),
+				               []( auto &&lhs, auto &&rhs ) { return lhs + rhs; } );
+			}
+
+			template<typename U, typename... BinaryOperator>
+			U accumulate( U init, BinaryOperator... oper ) const {
+				return reduce( daw::move( init ), oper... );
+			}
+
+			std::size_t count( ) const {
+				std::size_t result = 0;
+				run( [&]( auto && ) { ++result; } );
+				return result;
+			}
+
+			template<typename UnaryPredicate>
+			bool any_of( UnaryPredicate pred ) const {
+				bool result = false;
+				run( [&]( auto const &value ) {
+					result = static_cast<bool>( pred( value ) );
+					return not result;
+				} );
+				return result;
+			}
+
+			template<typename Value>
+			bool contains( Value const &value ) const {
+				return any_of( [&value]( auto const &v ) { return v == value; } );
+			}
+
+			template<typename Value, typename BinaryPredicate>
+			bool contains( Value const &value, BinaryPredicate pred ) const {
+				return any_of(
+				  [&value, &pred]( auto const &v ) { return pred( value, v ); } );
+			}
+
+			template<typename Value>
+			auto where_equal_to( Value const &value ) const {
+				return where( [value]( auto const &v ) { return v == value; } );
+			}
+
+			// Reordering and erasing clauses need every element, they materialize
+			// once and continue as a CollectionRange
+			template<typename UnaryPredicate>
+			CollectionRange<value_type> erase( UnaryPredicate pred ) const {
+				auto result = to_collection( );
+				result.erase( pred );
+				return result;
+			}
+
+			template<typename Value>
+			CollectionRange<value_type>
+			erase_where_equal_to( Value const &value ) const {
+				auto result = to_collection( );
+				result.erase_where_equal_to( value );
+				return result;
+			}
+
+			template<typename... Compare>
+			CollectionRange<value_type> sort( Compare... comp ) const {
+				auto result = to_collection( );
+				result.sort( comp... );
+				return result;
+			}
+
+			template<typename... Compare>
+			CollectionRange<value_type> stable_sort( Compare... comp ) const {
+				auto result = to_collection( );
+				result.stable_sort( comp... );
+				return result;
+			}
+
+			template<typename... UnaryPredicate>
+			CollectionRange<value_type> unique( UnaryPredicate... pred ) const {
+				auto result = to_collection( );
+				result.unique( pred... );
+				return result;
+			}
+
+			template<typename UnaryPredicate>
+			CollectionRange<value_type> partition( UnaryPredicate pred ) const {
+				auto result = to_collection( );
+				result.partition( pred );
+				return result;
+			}
+
+			template<typename UnaryPredicate>
+			CollectionRange<value_type>
+			stable_partition( UnaryPredicate pred ) const {
+				auto result = to_collection( );
+				result.stable_partition( pred );
+				return result;
+			}
+
+			template<typename... UniformRandomNumberGenerator>
+			CollectionRange<value_type>
+			shuffle( UniformRandomNumberGenerator &&... urng ) const {
+				auto result = to_collection( );
+				result.shuffle(
+				  std::forward<UniformRandomNumberGenerator>( urng )... );
+				return result;
+			}
+		};
+
+		template<typename T>
+		using is_lazy_range_detect = typename T::is_lazy_range;
+
+		template<typename T>
+		inline constexpr bool is_lazy_range_v =
+		  daw::is_detected_v<is_lazy_range_detect, daw::remove_cvref_t<T>>;
+
+		/// @brief Start a lazy pipeline over a container.  Lvalues are referenced,
+		/// rvalues are moved into the pipeline
+		template<typename Container>
+		auto lazy( Container &&container ) {
+			if constexpr( std::is_lvalue_reference_v<Container> ) {
+				using iterator_t = decltype( std::begin( container ) );
+				using source_t = lazy_impl::view_source<iterator_t>;
+				return LazyRange<source_t>(
+				  source_t{ std::begin( container ), std::end( container ) }, { } );
+			} else {
+				return LazyRange<daw::remove_cvref_t<Container>>(
+				  daw::move( container ), { } );
+			}
+		}
+
+		/// @brief Start a lazy pipeline over [first, last)
+		template<typename Iterator, typename Last>
+		auto lazy( Iterator first, Last last ) {
+			using source_t = lazy_impl::view_source<Iterator, Last>;
+			return LazyRange<source_t>( source_t{ first, last }, { } );
+		}
+	} // namespace range
+} // namespace daw
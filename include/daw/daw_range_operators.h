@@ -11,6 +11,7 @@
 #include "daw_algorithm.h"
 #include "daw_move.h"
 #include "daw_range_collection.h"
+#include "daw_range_lazy.h"
 #include "daw_range_reference.h"
 #include "daw_traits.h"
 
@@ -39,12 +40,18 @@ namespace daw {
 				struct gens<0, S...> {
 					typedef seq<S...> type;
 				};
+
+				/// The eager clauses copy a plain container into a CollectionRange
+				template<typename Container>
+				auto from_source( Container const &container ) {
+					return from( container );
+				}
 			} // namespace details
 		}   // namespace operators
 	}     // namespace range
 } // namespace daw
 
-#define DAW_RANGE_GENERATE_VCLAUSE( clause_name )                              \
+#define DAW_RANGE_GENERATE_VCLAUSE( clause_name, source )                      \
 	namespace daw {                                                              \
 		namespace range {                                                          \
 			namespace operators {                                                    \
@@ -57,14 +64,25 @@ namespace daw {
 						  typename Container, typename... ClauseArgs,                      \
 						  typename std::enable_if_t<daw::all_true_v<                       \
 						    !daw::range::is_range_reference_v<Container>,                  \
-						    !daw::range::is_range_collection_v<Container>>> * = nullptr,   \
+						    !daw::range::is_range_collection_v<Container>,                 \
+						    !daw::range::is_lazy_range_v<Container>>> * = nullptr,         \
 						  typename = void>                                                 \
-						static auto clause_name##_helper( Container const &container,      \
+						static auto clause_name##_helper( Container &&container,           \
 						                                  ClauseArgs &&... clause_args ) { \
-							return from( container )                                         \
+							return source( std::forward<Container>( container ) )            \
 							  .clause_name( std::forward<ClauseArgs>( clause_args )... );    \
 						}                                                                  \
                                                                                \
+						template<                                                          \
+						  typename Container, typename... ClauseArgs,                      \
+						  typename std::enable_if_t<                                       \
+						    daw::range::is_lazy_range_v<Container>> * = nullptr>           \
+						static auto clause_name##_helper( Container &&container,           \
+						                                  ClauseArgs &&... clause_args ) { \
+							return std::forward<Container>( container ).clause_name(         \
+							  std::forward<ClauseArgs>( clause_args )... );                  \
+						}                                                                  \
+                                                                               \
 						template<                                                          \
 						  typename Container, typename... ClauseArgs,                      \
 						  typename std::enable_if_t<                                       \
@@ -79,10 +97,17 @@ namespace daw {
 						  typename Container, typename... ClauseArgs,                      \
 						  typename std::enable_if_t<                                       \
 						    daw::range::is_range_collection_v<Container>> * = nullptr>     \
-						static auto clause_name##_helper( Container const &container,      \
+						static auto clause_name##_helper( Container &&container,           \
 						                                  ClauseArgs &&... clause_args ) { \
-							return container.clause_name(                                    \
-							  std::forward<ClauseArgs>( clause_args )... );                  \
+							if constexpr( std::is_lvalue_reference_v<Container> ) {          \
+								return daw::as_const( container ).clause_name(                 \
+								  std::forward<ClauseArgs>( clause_args )... );                \
+							} else {                                                         \
+								/* A temporary is owned and updated in place */                \
+								auto result = daw::move( container );                          \
+								return result.clause_name(                                     \
+								  std::forward<ClauseArgs>( clause_args )... );                \
+							}                                                                \
 						}                                                                  \
                                                                                \
 						template<typename Container>                                       \
@@ -133,7 +158,8 @@ namespace daw {
 	template<typename Container, typename... Args,                               \
 	         typename std::enable_if_t<daw::all_true_v<                          \
 	           !daw::range::is_range_reference_v<Container>,                     \
-	           !daw::range::is_range_collection_v<Container>>> * = nullptr,      \
+	           !daw::range::is_range_collection_v<Container>,                    \
+	           !daw::range::is_lazy_range_v<Container>>> * = nullptr,            \
 	         typename = void>                                                    \
 	auto operator<<(                                                             \
 	  Container &&container,                                                     \
@@ -158,23 +184,43 @@ namespace daw {
 	  daw::range::operators::details::clause_name##_t<Args...> const             \
 	    &predicate ) {                                                           \
 		return predicate( std::forward<Container>( container ) );                  \
+	}                                                                            \
+	template<typename Container, typename... Args,                               \
+	         typename std::enable_if_t<                                          \
+	           daw::range::is_lazy_range_v<Container>> * = nullptr>              \
+	auto operator<<(                                                             \
+	  Container &&container,                                                     \
+	  daw::range::operators::details::clause_name##_t<Args...> const             \
+	    &predicate ) {                                                           \
+		return predicate( std::forward<Container>( container ) );                  \
 	}
 
-DAW_RANGE_GENERATE_VCLAUSE( accumulate )
-DAW_RANGE_GENERATE_VCLAUSE( as_vector )
-DAW_RANGE_GENERATE_VCLAUSE( erase )
-DAW_RANGE_GENERATE_VCLAUSE( erase_where_equal_to )
-DAW_RANGE_GENERATE_VCLAUSE( find )
-DAW_RANGE_GENERATE_VCLAUSE( find_if )
-DAW_RANGE_GENERATE_VCLAUSE( partition )
-DAW_RANGE_GENERATE_VCLAUSE( shuffle )
-DAW_RANGE_GENERATE_VCLAUSE( sort )
-DAW_RANGE_GENERATE_VCLAUSE( stable_partition )
-DAW_RANGE_GENERATE_VCLAUSE( stable_sort )
-DAW_RANGE_GENERATE_VCLAUSE( transform )
-DAW_RANGE_GENERATE_VCLAUSE( unique )
-DAW_RANGE_GENERATE_VCLAUSE( where )
-DAW_RANGE_GENERATE_VCLAUSE( for_each )
+DAW_RANGE_GENERATE_VCLAUSE( accumulate, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( as_vector, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( erase, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( erase_where_equal_to, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( find, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( find_if, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( partition, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( shuffle, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( sort, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( stable_partition, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( stable_sort, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( unique, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( for_each, from_source )
+// where and transform stay eager on a plain container and give a
+// CollectionRange, they only fuse when the left side is already a LazyRange
+DAW_RANGE_GENERATE_VCLAUSE( transform, from_source )
+DAW_RANGE_GENERATE_VCLAUSE( where, from_source )
+// Lazy stages, a plain container on the left starts a fused pipeline that
+// references an lvalue container and takes ownership of an rvalue one
+DAW_RANGE_GENERATE_VCLAUSE( map, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( filter, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( take, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( drop, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( reduce, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( to_vector, lazy )
+DAW_RANGE_GENERATE_VCLAUSE( count, lazy )
 
 #undef DAW_RANGE_GENERATE_VCLAUSE
 #endif //	_MSC_VER
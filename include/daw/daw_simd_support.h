@@ -0,0 +1,25 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+// DAW_HAS_SSE2 and DAW_HAS_SSSE3 are defined when the target supports them and
+// the matching intrinsic header is included.  Define DAW_NO_SIMD to use the
+// portable code everywhere.
+#if not defined( DAW_NO_SIMD )
+#if defined( __SSE2__ ) or defined( _M_X64 ) or                               \
+  ( defined( _M_IX86_FP ) and _M_IX86_FP >= 2 )
+#define DAW_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined( __SSSE3__ )
+#define DAW_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+#endif
@@ -0,0 +1,786 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_exception.h"
+#include "daw_move.h"
+#include "daw_sort_n.h"
+#include "daw_span.h"
+
+#include <algorithm>
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	namespace soa_details {
+		template<typename MemberPointer>
+		struct member_pointer_traits;
+
+		template<typename Class, typename Member>
+		struct member_pointer_traits<Member Class::*> {
+			using class_type = Class;
+			using type = Member;
+		};
+
+		template<auto Member>
+		using member_t =
+		  typename member_pointer_traits<decltype( Member )>::type;
+
+		template<auto Member>
+		using class_t =
+		  typename member_pointer_traits<decltype( Member )>::class_type;
+
+		/// Each column starts on its own cache line
+		inline constexpr std::size_t column_alignment = 64;
+
+		constexpr std::size_t align_column( std::size_t bytes ) {
+			return ( bytes + column_alignment - 1 ) / column_alignment *
+			       column_alignment;
+		}
+
+		template<auto Lhs, auto Rhs>
+		constexpr bool same_member( ) {
+			if constexpr( std::is_same_v<decltype( Lhs ), decltype( Rhs )> ) {
+				return Lhs == Rhs;
+			} else {
+				return false;
+			}
+		}
+
+		/// Position of Needle in Haystack, or sizeof...( Haystack )
+		template<auto Needle, auto... Haystack>
+		constexpr std::size_t member_index( ) {
+			std::size_t result = sizeof...( Haystack );
+			std::size_t idx = 0;
+			( ( result = ( result == sizeof...( Haystack ) and
+			               same_member<Needle, Haystack>( ) )
+			               ? idx
+			               : result,
+			    ++idx ),
+			  ... );
+			return result;
+		}
+
+		template<bool IsConst, typename Field>
+		using field_pointer_t =
+		  std::conditional_t<IsConst, Field const *, Field *>;
+
+		template<bool IsConst, typename T, auto... Members>
+		using columns_t =
+		  std::tuple<field_pointer_t<IsConst, member_t<Members>>...>;
+
+		/// @brief A row of a soa_vector.  Copies of a soa_reference refer to the
+		/// same row, and assignment writes through to the fields
+		template<bool IsConst, typename T, auto... Members>
+		class soa_reference {
+			using fields_t = columns_t<IsConst, T, Members...>;
+			using indices_t = std::index_sequence_for<decltype( Members )...>;
+			fields_t m_fields;
+
+			template<bool, typename, auto...>
+			friend class soa_reference;
+
+			template<typename Source, std::size_t... Is>
+			void copy_from( Source const &source, std::index_sequence<Is...> ) {
+				( ( *std::get<Is>( m_fields ) = source.template get<Is>( ) ), ... );
+			}
+
+			template<std::size_t... Is>
+			void assign( T const &value, std::index_sequence<Is...> ) {
+				( ( *std::get<Is>( m_fields ) = value.*Members ), ... );
+			}
+
+			template<std::size_t... Is>
+			void assign( T &&value, std::index_sequence<Is...> ) {
+				( ( *std::get<Is>( m_fields ) = daw::move( value.*Members ) ), ... );
+			}
+
+			template<std::size_t... Is>
+			T to_value( std::index_sequence<Is...> ) const {
+				T result{ };
+				( ( result.*Members = *std::get<Is>( m_fields ) ), ... );
+				return result;
+			}
+
+			template<std::size_t... Is>
+			void swap_fields( soa_reference &other, std::index_sequence<Is...> ) {
+				using std::swap;
+				( swap( *std::get<Is>( m_fields ), *std::get<Is>( other.m_fields ) ),
+				  ... );
+			}
+
+		public:
+			using value_type = T;
+
+			explicit constexpr soa_reference( fields_t fields )
+			  : m_fields( fields ) {}
+
+			template<bool B = IsConst, std::enable_if_t<B, std::nullptr_t> = nullptr>
+			constexpr soa_reference(
+			  soa_reference<false, T, Members...> const &other )
+			  : m_fields( other.m_fields ) {}
+
+			constexpr soa_reference( soa_reference const & ) = default;
+
+			template<std::size_t Index>
+			constexpr decltype( auto ) get( ) const {
+				return *std::get<Index>( m_fields );
+			}
+
+			template<auto Member,
+			         std::enable_if_t<not std::is_integral_v<decltype( Member )>,
+			                          std::nullptr_t> = nullptr>
+			constexpr decltype( auto ) get( ) const {
+				constexpr std::size_t index = member_index<Member, Members...>( );
+				static_assert( index < sizeof...( Members ),
+				               "Member is not stored in this soa_vector" );
+				return *std::get<index>( m_fields );
+			}
+
+			/// Gather the fields into a T.  T must be default constructible
+			operator T( ) const {
+				return to_value( indices_t{ } );
+			}
+
+			soa_reference &operator=( soa_reference const &rhs ) {
+				static_assert( not IsConst, "Cannot assign through a const row" );
+				copy_from( rhs, indices_t{ } );
+				return *this;
+			}
+
+			template<bool B = IsConst,
+			         std::enable_if_t<not B, std::nullptr_t> = nullptr>
+			soa_reference &
+			operator=( soa_reference<true, T, Members...> const &rhs ) {
+				copy_from( rhs, indices_t{ } );
+				return *this;
+			}
+
+			template<bool B = IsConst,
+			         std::enable_if_t<not B, std::nullptr_t> = nullptr>
+			soa_reference &operator=( T const &value ) {
+				assign( value, indices_t{ } );
+				return *this;
+			}
+
+			template<bool B = IsConst,
+			         std::enable_if_t<not B, std::nullptr_t> = nullptr>
+			soa_reference &operator=( T &&value ) {
+				assign( daw::move( value ), indices_t{ } );
+				return *this;
+			}
+
+			/// Swap the fields of two rows
+			void swap( soa_reference other ) {
+				static_assert( not IsConst, "Cannot swap const rows" );
+				swap_fields( other, indices_t{ } );
+			}
+
+			friend void swap( soa_reference lhs, soa_reference rhs ) {
+				lhs.swap( rhs );
+			}
+		};
+
+		template<bool IsConst, typename T, auto... Members>
+		class soa_iterator {
+			using fields_t = columns_t<IsConst, T, Members...>;
+			fields_t m_columns{ };
+			std::ptrdiff_t m_index = 0;
+
+			template<bool, typename, auto...>
+			friend class soa_iterator;
+
+			template<std::size_t... Is>
+			constexpr fields_t row( std::ptrdiff_t index,
+			                        std::index_sequence<Is...> ) const {
+				return fields_t{ std::get<Is>( m_columns ) + index... };
+			}
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using reference = soa_reference<IsConst, T, Members...>;
+			using pointer = void;
+
+			constexpr soa_iterator( ) = default;
+
+			constexpr soa_iterator( fields_t columns, std::ptrdiff_t index )
+			  : m_columns( columns )
+			  , m_index( index ) {}
+
+			template<bool B = IsConst, std::enable_if_t<B, std::nullptr_t> = nullptr>
+			constexpr soa_iterator( soa_iterator<false, T, Members...> const &other )
+			  : m_columns( other.m_columns )
+			  , m_index( other.m_index ) {}
+
+			constexpr std::ptrdiff_t index( ) const {
+				return m_index;
+			}
+
+			constexpr reference operator*( ) const {
+				return reference(
+				  row( m_index, std::index_sequence_for<decltype( Members )...>{ } ) );
+			}
+
+			constexpr reference operator[]( difference_type n ) const {
+				return *( *this + n );
+			}
+
+			constexpr soa_iterator &operator++( ) {
+				++m_index;
+				return *this;
+			}
+
+			constexpr soa_iterator operator++( int ) {
+				auto result = *this;
+				++m_index;
+				return result;
+			}
+
+			constexpr soa_iterator &operator--( ) {
+				--m_index;
+				return *this;
+			}
+
+			constexpr soa_iterator operator--( int ) {
+				auto result = *this;
+				--m_index;
+				return result;
+			}
+
+			constexpr soa_iterator &operator+=( difference_type n ) {
+				m_index += n;
+				return *this;
+			}
+
+			constexpr soa_iterator &operator-=( difference_type n ) {
+				m_index -= n;
+				return *this;
+			}
+
+			friend constexpr soa_iterator operator+( soa_iterator it,
+			                                         difference_type n ) {
+				it += n;
+				return it;
+			}
+
+			friend constexpr soa_iterator operator+( difference_type n,
+			                                         soa_iterator it ) {
+				it += n;
+				return it;
+			}
+
+			friend constexpr soa_iterator operator-( soa_iterator it,
+			                                         difference_type n ) {
+				it -= n;
+				return it;
+			}
+
+			friend constexpr difference_type operator-( soa_iterator const &lhs,
+			                                            soa_iterator const &rhs ) {
+				return lhs.m_index - rhs.m_index;
+			}
+
+			friend constexpr bool operator==( soa_iterator const &lhs,
+			                                  soa_iterator const &rhs ) {
+				return lhs.m_index == rhs.m_index;
+			}
+
+			friend constexpr bool operator!=( soa_iterator const &lhs,
+			                                  soa_iterator const &rhs ) {
+				return lhs.m_index != rhs.m_index;
+			}
+
+			friend constexpr bool operator<( soa_iterator const &lhs,
+			                                 soa_iterator const &rhs ) {
+				return lhs.m_index < rhs.m_index;
+			}
+
+			friend constexpr bool operator>( soa_iterator const &lhs,
+			                                 soa_iterator const &rhs ) {
+				return lhs.m_index > rhs.m_index;
+			}
+
+			friend constexpr bool operator<=( soa_iterator const &lhs,
+			                                  soa_iterator const &rhs ) {
+				return lhs.m_index <= rhs.m_index;
+			}
+
+			friend constexpr bool operator>=( soa_iterator const &lhs,
+			                                  soa_iterator const &rhs ) {
+				return lhs.m_index >= rhs.m_index;
+			}
+		};
+	} // namespace soa_details
+
+	/// @brief A struct of arrays container.  Each listed member of T is stored
+	/// in its own contiguous, cache line aligned column, so a loop over one
+	/// field only pulls that field into cache.  Rows are presented through
+	/// soa_reference proxies, which convert to T and accept assignment from T,
+	/// so the iterators work with std::sort, daw::sort and the range
+	/// algorithms.  Use soa_sort_by/soa_sort to sort with one pass over each
+	/// column instead of swapping whole rows.
+	/// e.g. soa_vector<particle, &particle::x, &particle::y, &particle::id>
+	/// @tparam T record type, must be default constructible to convert a row
+	/// back to a T
+	/// @tparam Members pointers to the data members of T to store
+	template<typename T, auto... Members>
+	class soa_vector {
+		static_assert( sizeof...( Members ) > 0 );
+		static_assert(
+		  ( std::is_same_v<T, soa_details::class_t<Members>> and ... ),
+		  "Members must be pointers to data members of T" );
+		static_assert(
+		  ( std::is_nothrow_move_constructible_v<soa_details::member_t<Members>> and
+		    ... ),
+		  "Fields must be nothrow move constructible" );
+
+		template<bool IsConst>
+		using columns_t = soa_details::columns_t<IsConst, T, Members...>;
+		using indices_t = std::index_sequence_for<decltype( Members )...>;
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = soa_details::soa_reference<false, T, Members...>;
+		using const_reference = soa_details::soa_reference<true, T, Members...>;
+		using iterator = soa_details::soa_iterator<false, T, Members...>;
+		using const_iterator = soa_details::soa_iterator<true, T, Members...>;
+
+		template<std::size_t Index>
+		using field_t = std::tuple_element_t<
+		  Index, std::tuple<soa_details::member_t<Members>...>>;
+
+		static constexpr std::size_t field_count = sizeof...( Members );
+
+	private:
+		columns_t<false> m_columns{ };
+		void *m_block = nullptr;
+		size_type m_size = 0;
+		size_type m_capacity = 0;
+
+		static constexpr std::size_t block_bytes( size_type capacity ) {
+			return ( soa_details::align_column(
+			           capacity * sizeof( soa_details::member_t<Members> ) ) +
+			         ... );
+		}
+
+		template<std::size_t... Is>
+		static columns_t<false> carve( void *block, size_type capacity,
+		                               std::index_sequence<Is...> ) {
+			auto *ptr = static_cast<unsigned char *>( block );
+			columns_t<false> result{ };
+			( ( std::get<Is>( result ) = reinterpret_cast<field_t<Is> *>( ptr ),
+			    ptr +=
+			    soa_details::align_column( capacity * sizeof( field_t<Is> ) ) ),
+			  ... );
+			return result;
+		}
+
+		template<typename Function, std::size_t... Is>
+		void each_column( Function &&func, std::index_sequence<Is...> ) {
+			( func( std::get<Is>( m_columns ),
+			        std::integral_constant<std::size_t, Is>{ } ),
+			  ... );
+		}
+
+		template<typename Function>
+		void each_column( Function &&func ) {
+			each_column( func, indices_t{ } );
+		}
+
+		void destroy_rows( size_type first, size_type last ) {
+			each_column( [&]( auto *column, auto ) {
+				std::destroy( column + first, column + last );
+			} );
+		}
+
+		void release( ) {
+			if( m_block != nullptr ) {
+				destroy_rows( 0, m_size );
+				::operator delete( m_block,
+				                   std::align_val_t{ soa_details::column_alignment } );
+			}
+			m_columns = columns_t<false>{ };
+			m_block = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+		}
+
+		void reallocate( size_type new_capacity ) {
+			void *block = ::operator new(
+			  block_bytes( new_capacity ),
+			  std::align_val_t{ soa_details::column_alignment } );
+			auto columns = carve( block, new_capacity, indices_t{ } );
+			each_column( [&]( auto *column, auto idx ) {
+				std::uninitialized_move( column, column + m_size,
+				                         std::get<decltype( idx )::value>( columns ) );
+			} );
+			size_type const size = m_size;
+			release( );
+			m_columns = columns;
+			m_block = block;
+			m_size = size;
+			m_capacity = new_capacity;
+		}
+
+		void grow_for( size_type count ) {
+			if( m_size + count > m_capacity ) {
+				reallocate( std::max( m_size + count, m_capacity * 2U ) );
+			}
+		}
+
+		/// Construct row m_size from one argument per column, undoing the
+		/// columns already built if a later one throws
+		template<typename... Args, std::size_t... Is>
+		void construct_back( std::index_sequence<Is...>, Args &&... args ) {
+			std::size_t built = 0;
+			try {
+				( ( ::new( static_cast<void *>( std::get<Is>( m_columns ) + m_size ) )
+				      field_t<Is>( std::forward<Args>( args ) ),
+				    ++built ),
+				  ... );
+			} catch( ... ) {
+				each_column( [&]( auto *column, auto idx ) {
+					if( decltype( idx )::value < built ) {
+						std::destroy_at( column + m_size );
+					}
+				} );
+				throw;
+			}
+			++m_size;
+		}
+
+		/// Copy the rows of other into the empty columns, destroying the
+		/// columns already copied and freeing the block if a later one throws
+		template<std::size_t... Is>
+		void copy_rows( soa_vector const &other, std::index_sequence<Is...> ) {
+			std::size_t built = 0;
+			try {
+				( ( std::uninitialized_copy_n( std::get<Is>( other.m_columns ),
+				                               other.m_size,
+				                               std::get<Is>( m_columns ) ),
+				    ++built ),
+				  ... );
+			} catch( ... ) {
+				each_column( [&]( auto *column, auto idx ) {
+					if( decltype( idx )::value < built ) {
+						std::destroy( column, column + other.m_size );
+					}
+				} );
+				release( );
+				throw;
+			}
+			m_size = other.m_size;
+		}
+
+		template<std::size_t... Is>
+		columns_t<true> const_columns( std::index_sequence<Is...> ) const {
+			return columns_t<true>{ std::get<Is>( m_columns )... };
+		}
+
+	public:
+		soa_vector( ) = default;
+
+		/// Create count value initialized rows
+		explicit soa_vector( size_type count ) {
+			resize( count );
+		}
+
+		soa_vector( soa_vector const &other ) {
+			if( other.m_size > 0 ) {
+				reallocate( other.m_size );
+				copy_rows( other, indices_t{ } );
+			}
+		}
+
+		soa_vector( soa_vector &&other ) noexcept
+		  : m_columns( std::exchange( other.m_columns, columns_t<false>{ } ) )
+		  , m_block( std::exchange( other.m_block, nullptr ) )
+		  , m_size( std::exchange( other.m_size, 0 ) )
+		  , m_capacity( std::exchange( other.m_capacity, 0 ) ) {}
+
+		soa_vector &operator=( soa_vector const &rhs ) {
+			if( this != &rhs ) {
+				soa_vector tmp( rhs );
+				swap( tmp );
+			}
+			return *this;
+		}
+
+		soa_vector &operator=( soa_vector &&rhs ) noexcept {
+			if( this != &rhs ) {
+				release( );
+				swap( rhs );
+			}
+			return *this;
+		}
+
+		~soa_vector( ) {
+			release( );
+		}
+
+		void swap( soa_vector &other ) noexcept {
+			std::swap( m_columns, other.m_columns );
+			std::swap( m_block, other.m_block );
+			std::swap( m_size, other.m_size );
+			std::swap( m_capacity, other.m_capacity );
+		}
+
+		size_type size( ) const {
+			return m_size;
+		}
+
+		size_type capacity( ) const {
+			return m_capacity;
+		}
+
+		bool empty( ) const {
+			return m_size == 0;
+		}
+
+		void reserve( size_type count ) {
+			if( count > m_capacity ) {
+				reallocate( count );
+			}
+		}
+
+		void clear( ) {
+			destroy_rows( 0, m_size );
+			m_size = 0;
+		}
+
+		/// Shrink to count rows or append value initialized rows
+		void resize( size_type count ) {
+			if( count <= m_size ) {
+				destroy_rows( count, m_size );
+				m_size = count;
+				return;
+			}
+			reserve( count );
+			while( m_size < count ) {
+				construct_back( indices_t{ }, soa_details::member_t<Members>{ }... );
+			}
+		}
+
+		void push_back( T const &value ) {
+			grow_for( 1 );
+			construct_back( indices_t{ }, value.*Members... );
+		}
+
+		void push_back( T &&value ) {
+			grow_for( 1 );
+			construct_back( indices_t{ }, daw::move( value.*Members )... );
+		}
+
+		/// Append a row from one argument per stored field, in Members order
+		template<typename... Args>
+		reference emplace_back( Args &&... args ) {
+			static_assert( sizeof...( Args ) == field_count,
+			               "One argument is required per field" );
+			grow_for( 1 );
+			construct_back( indices_t{ }, std::forward<Args>( args )... );
+			return back( );
+		}
+
+		void pop_back( ) {
+			daw::exception::precondition_check<std::out_of_range>(
+			  m_size > 0, "pop_back on an empty soa_vector" );
+			destroy_rows( m_size - 1, m_size );
+			--m_size;
+		}
+
+		reference operator[]( size_type index ) {
+			return begin( )[static_cast<difference_type>( index )];
+		}
+
+		const_reference operator[]( size_type index ) const {
+			return begin( )[static_cast<difference_type>( index )];
+		}
+
+		reference at( size_type index ) {
+			daw::exception::precondition_check<std::out_of_range>(
+			  index < m_size, "Index out of range" );
+			return operator[]( index );
+		}
+
+		const_reference at( size_type index ) const {
+			daw::exception::precondition_check<std::out_of_range>(
+			  index < m_size, "Index out of range" );
+			return operator[]( index );
+		}
+
+		reference front( ) {
+			return operator[]( 0 );
+		}
+
+		const_reference front( ) const {
+			return operator[]( 0 );
+		}
+
+		reference back( ) {
+			return operator[]( m_size - 1 );
+		}
+
+		const_reference back( ) const {
+			return operator[]( m_size - 1 );
+		}
+
+		/// The contiguous storage of field Index
+		template<std::size_t Index>
+		daw::span<field_t<Index>> column( ) {
+			return daw::span<field_t<Index>>( std::get<Index>( m_columns ),
+			                                  m_size );
+		}
+
+		template<std::size_t Index>
+		daw::span<field_t<Index> const> column( ) const {
+			return daw::span<field_t<Index> const>( std::get<Index>( m_columns ),
+			                                        m_size );
+		}
+
+		/// The contiguous storage of the field Member, e.g. column<&T::x>( )
+		template<auto Member,
+		         std::enable_if_t<not std::is_integral_v<decltype( Member )>,
+		                          std::nullptr_t> = nullptr>
+		decltype( auto ) column( ) {
+			constexpr std::size_t index =
+			  soa_details::member_index<Member, Members...>( );
+			static_assert( index < field_count,
+			               "Member is not stored in this soa_vector" );
+			return column<index>( );
+		}
+
+		template<auto Member,
+		         std::enable_if_t<not std::is_integral_v<decltype( Member )>,
+		                          std::nullptr_t> = nullptr>
+		decltype( auto ) column( ) const {
+			constexpr std::size_t index =
+			  soa_details::member_index<Member, Members...>( );
+			static_assert( index < field_count,
+			               "Member is not stored in this soa_vector" );
+			return column<index>( );
+		}
+
+		iterator begin( ) {
+			return iterator( m_columns, 0 );
+		}
+
+		const_iterator begin( ) const {
+			return const_iterator( const_columns( indices_t{ } ), 0 );
+		}
+
+		const_iterator cbegin( ) const {
+			return begin( );
+		}
+
+		iterator end( ) {
+			return iterator( m_columns, static_cast<difference_type>( m_size ) );
+		}
+
+		const_iterator end( ) const {
+			return const_iterator( const_columns( indices_t{ } ),
+			                       static_cast<difference_type>( m_size ) );
+		}
+
+		const_iterator cend( ) const {
+			return end( );
+		}
+
+		/// @brief Reorder the rows so that row i becomes the old row order[i].
+		/// Each column is gathered once through a scratch buffer
+		/// @param order a permutation of [0, size( ) )
+		template<typename RandomIterator>
+		void permute( RandomIterator order ) {
+			each_column( [&]( auto *column, auto ) {
+				using field_type = std::remove_pointer_t<decltype( column )>;
+				std::vector<field_type> scratch{ };
+				scratch.reserve( m_size );
+				for( size_type n = 0; n < m_size; ++n ) {
+					scratch.push_back(
+					  daw::move( column[static_cast<size_type>( order[n] )] ) );
+				}
+				std::move( scratch.begin( ), scratch.end( ), column );
+			} );
+		}
+	};
+
+	template<typename T, auto... Members>
+	void swap( soa_vector<T, Members...> &lhs,
+	           soa_vector<T, Members...> &rhs ) noexcept {
+		lhs.swap( rhs );
+	}
+
+	namespace soa_details {
+		template<typename Key, typename Compare>
+		inline constexpr bool use_radix_key_v =
+		  std::is_arithmetic_v<Key> and
+		  ( std::is_same_v<Compare, std::less<>> or
+		    std::is_same_v<Compare, std::less<Key>> );
+	} // namespace soa_details
+
+	/// @brief Stable sort of the rows by the field Member.  The keys are sorted
+	/// with their row numbers in one contiguous buffer, radix sorted when the
+	/// key is arithmetic and ordered by std::less, and then every column is
+	/// permuted once.  Only the key column is read while ordering
+	template<auto Member, typename T, auto... Members,
+	         typename Compare = std::less<>>
+	void soa_sort_by( soa_vector<T, Members...> &vec,
+	                  Compare comp = Compare{ } ) {
+		using key_t = soa_details::member_t<Member>;
+		auto const keys = vec.template column<Member>( );
+		std::vector<std::pair<key_t, std::size_t>> order{ };
+		order.reserve( vec.size( ) );
+		for( std::size_t n = 0; n < vec.size( ); ++n ) {
+			order.emplace_back( keys[n], n );
+		}
+		if constexpr( soa_details::use_radix_key_v<key_t, Compare> ) {
+			daw::radix_sort( order.begin( ), order.end( ),
+			                 []( auto const &item ) { return item.first; } );
+		} else {
+			std::stable_sort( order.begin( ), order.end( ),
+			                  [&]( auto const &lhs, auto const &rhs ) {
+				                  return comp( lhs.first, rhs.first );
+			                  } );
+		}
+		std::vector<std::size_t> rows{ };
+		rows.reserve( order.size( ) );
+		for( auto const &item : order ) {
+			rows.push_back( item.second );
+		}
+		vec.permute( rows.begin( ) );
+	}
+
+	/// @brief Stable sort of the rows with comp( const_reference,
+	/// const_reference ).  Row numbers are sorted and then every column is
+	/// permuted once, rather than swapping whole rows field by field
+	template<typename T, auto... Members, typename Compare>
+	void soa_sort( soa_vector<T, Members...> &vec, Compare comp ) {
+		std::vector<std::size_t> order( vec.size( ) );
+		std::iota( order.begin( ), order.end( ), std::size_t{ 0 } );
+		auto const &cvec = vec;
+		std::stable_sort( order.begin( ), order.end( ),
+		                  [&]( std::size_t lhs, std::size_t rhs ) {
+			                  return comp( cvec[lhs], cvec[rhs] );
+		                  } );
+		vec.permute( order.begin( ) );
+	}
+} // namespace daw
@@ -15,9 +15,17 @@
 #include "iterator/daw_reverse_iterator.h"
 
 #include <algorithm>
+#include <array>
 #include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace daw {
 	namespace sort_n_details {
@@ -498,11 +506,13 @@ namespace daw {
 			uint_fast8_t count = 0;
 			for( auto i = std::next( j ); i != last; ++i ) {
 				if( comp( *i, *j ) ) {
-					auto t = daw::move( *i );
+					// Not auto and std::move, *i may be a proxy reference
+					typename std::iterator_traits<RandomIterator>::value_type t =
+					  std::move( *i );
 					auto k = j;
 					j = i;
 					do {
-						*j = daw::move( *k );
+						*j = std::move( *k );
 						j = k;
 					} while( j != first and comp( t, *--k ) );
 					*j = daw::move( t );
@@ -525,11 +535,13 @@ namespace daw {
 			daw::sort_3( first, comp );
 			for( auto i = std::next( j ); i != last; ++i ) {
 				if( comp( *i, *j ) ) {
-					auto t = daw::move( *i );
+					// Not auto and std::move, *i may be a proxy reference
+					typename std::iterator_traits<RandomIterator>::value_type t =
+					  std::move( *i );
 					auto k = j;
 					j = i;
 					do {
-						*j = daw::move( *k );
+						*j = std::move( *k );
 						j = k;
 					} while( j != first and comp( t, *--k ) );
 					*j = daw::move( t );
@@ -786,4 +798,311 @@ namespace daw {
 		daw::sort( first_out, last_out, std::forward<Compare>( comp ) );
 		return last_out;
 	}
+
+	namespace sort_n_details {
+		/// Ranges below this many elements are not worth the radix passes
+		inline constexpr std::ptrdiff_t radix_sort_min_size = 256;
+
+		/// MSD buckets at or below this size are insertion sorted
+		inline constexpr std::ptrdiff_t msd_insertion_limit = 32;
+
+		template<std::size_t Size>
+		struct radix_uint;
+
+		template<>
+		struct radix_uint<1> {
+			using type = std::uint8_t;
+		};
+
+		template<>
+		struct radix_uint<2> {
+			using type = std::uint16_t;
+		};
+
+		template<>
+		struct radix_uint<4> {
+			using type = std::uint32_t;
+		};
+
+		template<>
+		struct radix_uint<8> {
+			using type = std::uint64_t;
+		};
+
+		template<typename Key>
+		inline constexpr bool is_numeric_radix_key_v =
+		  ( std::is_integral_v<Key> and not std::is_same_v<Key, bool> ) or
+		  ( ( std::is_same_v<Key, float> or std::is_same_v<Key, double> ) and
+		    std::numeric_limits<Key>::is_iec559 );
+
+		template<typename Key>
+		struct is_string_radix_key : std::false_type {};
+
+		template<std::size_t N>
+		struct is_string_radix_key<std::array<char, N>> : std::true_type {};
+
+		template<std::size_t N>
+		struct is_string_radix_key<std::array<unsigned char, N>>
+		  : std::true_type {};
+
+		template<typename Key>
+		inline constexpr bool is_string_radix_key_v =
+		  is_string_radix_key<Key>::value;
+
+		template<typename Key>
+		inline constexpr bool is_radix_key_v =
+		  is_numeric_radix_key_v<Key> or is_string_radix_key_v<Key>;
+
+		/// Map a numeric key to an unsigned integer with the same order.
+		/// Signed integers flip the sign bit, IEEE floats flip the sign bit when
+		/// positive and every bit when negative.  -0.0 orders before 0.0 and
+		/// NaNs go to the ends by sign
+		template<typename Key>
+		auto radix_key_bits( Key key ) {
+			using bits_t = typename radix_uint<sizeof( Key )>::type;
+			constexpr bits_t sign_bit = static_cast<bits_t>(
+			  bits_t{ 1 } << ( sizeof( bits_t ) * 8U - 1U ) );
+			if constexpr( std::is_floating_point_v<Key> ) {
+				bits_t bits;
+				std::memcpy( &bits, &key, sizeof( bits_t ) );
+				bits_t const mask =
+				  ( bits & sign_bit ) != 0 ? static_cast<bits_t>( ~bits_t{ 0 } )
+				                           : sign_bit;
+				return static_cast<bits_t>( bits ^ mask );
+			} else if constexpr( std::is_signed_v<Key> ) {
+				return static_cast<bits_t>( static_cast<bits_t>( key ) ^ sign_bit );
+			} else {
+				return static_cast<bits_t>( key );
+			}
+		}
+
+		struct radix_identity {
+			template<typename T>
+			constexpr T const &operator( )( T const &value ) const noexcept {
+				return value;
+			}
+		};
+
+		template<typename KeyExtractor, typename RandomIterator>
+		using radix_key_t = daw::remove_cvref_t<std::invoke_result_t<
+		  KeyExtractor &, decltype( *std::declval<RandomIterator>( ) )>>;
+
+		/// Orders values the same way the radix passes do
+		template<typename KeyExtractor>
+		struct radix_key_less {
+			KeyExtractor *key;
+
+			template<typename T>
+			bool operator( )( T const &lhs, T const &rhs ) const {
+				auto const &lkey = ( *key )( lhs );
+				auto const &rkey = ( *key )( rhs );
+				using key_t = daw::remove_cvref_t<decltype( lkey )>;
+				if constexpr( is_numeric_radix_key_v<key_t> ) {
+					return radix_key_bits( lkey ) < radix_key_bits( rkey );
+				} else if constexpr( is_string_radix_key_v<key_t> ) {
+					return std::memcmp( lkey.data( ), rkey.data( ), lkey.size( ) ) < 0;
+				} else {
+					return lkey < rkey;
+				}
+			}
+		};
+
+		/// LSD buckets are sized to stay in cache above this many elements, by
+		/// first splitting on the most significant byte
+		inline constexpr std::ptrdiff_t lsd_cache_limit = 1 << 16;
+
+		template<typename Bits>
+		constexpr std::size_t radix_digit( Bits bits, std::size_t d ) {
+			return static_cast<std::size_t>( ( bits >> ( d * 8U ) ) & 0xFFU );
+		}
+
+		/// Least significant digit first over the low digit_count bytes, one
+		/// byte per pass, ping-ponging between src and dst.  A single read
+		/// builds every pass's histogram and passes where all keys share the
+		/// digit are skipped.  Returns true when the result ended in dst
+		template<typename Bits, typename Src, typename Dst,
+		         typename KeyExtractor>
+		bool lsd_radix_passes( Src src, Dst dst, std::size_t size,
+		                       std::size_t digit_count, KeyExtractor &key ) {
+			std::array<std::array<std::size_t, 256>, sizeof( Bits )> counts{ };
+			for( std::size_t n = 0; n < size; ++n ) {
+				Bits const bits = radix_key_bits( key( src[n] ) );
+				for( std::size_t d = 0; d < digit_count; ++d ) {
+					++counts[d][radix_digit( bits, d )];
+				}
+			}
+			Bits const first_bits = radix_key_bits( key( src[0] ) );
+			bool in_dst = false;
+			auto const scatter = [&]( auto from, auto to, std::size_t d ) {
+				std::array<std::size_t, 256> offsets;
+				std::size_t pos = 0;
+				for( std::size_t b = 0; b < 256; ++b ) {
+					offsets[b] = pos;
+					pos += counts[d][b];
+				}
+				for( std::size_t n = 0; n < size; ++n ) {
+					auto const b = radix_digit( radix_key_bits( key( from[n] ) ), d );
+					to[offsets[b]++] = daw::move( from[n] );
+				}
+			};
+			for( std::size_t d = 0; d < digit_count; ++d ) {
+				if( counts[d][radix_digit( first_bits, d )] == size ) {
+					continue;
+				}
+				if( in_dst ) {
+					scatter( dst, src, d );
+				} else {
+					scatter( src, dst, d );
+				}
+				in_dst = not in_dst;
+			}
+			return in_dst;
+		}
+
+		/// LSD radix sort.  Large ranges are first split on the most
+		/// significant byte so each bucket's remaining passes run in cache
+		template<typename RandomIterator, typename KeyExtractor>
+		void lsd_radix_sort( RandomIterator first, RandomIterator last,
+		                     KeyExtractor &key ) {
+			using value_t = typename std::iterator_traits<RandomIterator>::value_type;
+			using bits_t =
+			  decltype( radix_key_bits( key( std::declval<value_t const &>( ) ) ) );
+			constexpr std::size_t digit_count = sizeof( bits_t );
+			auto const size = static_cast<std::size_t>( last - first );
+			std::vector<value_t> buffer( size );
+
+			if constexpr( digit_count > 1 ) {
+				if( last - first > lsd_cache_limit ) {
+					constexpr std::size_t top = digit_count - 1;
+					std::array<std::size_t, 256> counts{ };
+					for( auto it = first; it != last; ++it ) {
+						++counts[radix_digit( radix_key_bits( key( *it ) ), top )];
+					}
+					std::array<std::size_t, 257> starts;
+					std::size_t pos = 0;
+					for( std::size_t b = 0; b < 256; ++b ) {
+						starts[b] = pos;
+						pos += counts[b];
+					}
+					starts[256] = pos;
+					auto offsets = starts;
+					for( auto it = first; it != last; ++it ) {
+						auto const b = radix_digit( radix_key_bits( key( *it ) ), top );
+						buffer[offsets[b]++] = daw::move( *it );
+					}
+					for( std::size_t b = 0; b < 256; ++b ) {
+						auto const bucket_size = counts[b];
+						auto *const bucket = buffer.data( ) + starts[b];
+						auto const out =
+						  first + static_cast<std::ptrdiff_t>( starts[b] );
+						if( bucket_size == 0 ) {
+							continue;
+						}
+						if( not lsd_radix_passes<bits_t>( bucket, out, bucket_size,
+						                                  top, key ) ) {
+							std::move( bucket, bucket + bucket_size, out );
+						}
+					}
+					return;
+				}
+			}
+			if( lsd_radix_passes<bits_t>( first, buffer.data( ), size, digit_count,
+			                              key ) ) {
+				std::move( buffer.begin( ), buffer.end( ), first );
+			}
+		}
+
+		/// Most significant byte first for fixed width string keys, buckets are
+		/// stably scattered through buffer and recursed into one byte deeper
+		template<typename RandomIterator, typename KeyExtractor, typename T>
+		void msd_radix_sort( RandomIterator first, RandomIterator last,
+		                     KeyExtractor &key, T *buffer, std::size_t depth ) {
+			using key_t = radix_key_t<KeyExtractor, RandomIterator>;
+			constexpr std::size_t width = std::tuple_size_v<key_t>;
+			auto const byte_at = [&]( T const &value ) {
+				return static_cast<std::size_t>(
+				  static_cast<unsigned char>( key( value )[depth] ) );
+			};
+			while( depth < width ) {
+				auto const size = last - first;
+				if( size <= msd_insertion_limit ) {
+					std::stable_sort( first, last,
+					                  radix_key_less<KeyExtractor>{ &key } );
+					return;
+				}
+				std::array<std::size_t, 256> counts{ };
+				for( auto it = first; it != last; ++it ) {
+					++counts[byte_at( *it )];
+				}
+				if( counts[byte_at( *first )] == static_cast<std::size_t>( size ) ) {
+					++depth;
+					continue;
+				}
+				std::array<std::size_t, 256> offsets;
+				std::size_t pos = 0;
+				for( std::size_t b = 0; b < 256; ++b ) {
+					offsets[b] = pos;
+					pos += counts[b];
+				}
+				for( auto it = first; it != last; ++it ) {
+					buffer[offsets[byte_at( *it )]++] = daw::move( *it );
+				}
+				std::move( buffer, buffer + size, first );
+				if( depth + 1 < width ) {
+					auto bucket_first = first;
+					for( std::size_t b = 0; b < 256; ++b ) {
+						auto const bucket_last =
+						  bucket_first + static_cast<std::ptrdiff_t>( counts[b] );
+						if( counts[b] > 1 ) {
+							msd_radix_sort( bucket_first, bucket_last, key, buffer,
+							                depth + 1 );
+						}
+						bucket_first = bucket_last;
+					}
+				}
+				return;
+			}
+		}
+	} // namespace sort_n_details
+
+	/// @brief Stable ascending sort of [first, last) by key( value ).  Integer
+	/// and IEEE float keys use an LSD radix sort, std::array<char, N> keys an
+	/// MSD radix sort.  Small ranges, other key types and values that are not
+	/// default constructible use std::stable_sort on the same order.  Float
+	/// keys order -0.0 before 0.0, and NaNs first or last by their sign
+	/// @param first start of range
+	/// @param last end of range
+	/// @param key callable returning the key of a value
+	template<typename RandomIterator, typename KeyExtractor>
+	void radix_sort( RandomIterator first, RandomIterator last,
+	                 KeyExtractor key ) {
+		using value_t = typename std::iterator_traits<RandomIterator>::value_type;
+		using key_t = sort_n_details::radix_key_t<KeyExtractor, RandomIterator>;
+		auto const size = last - first;
+		if( size < 2 ) {
+			return;
+		}
+		if constexpr( sort_n_details::is_radix_key_v<key_t> and
+		              std::is_default_constructible_v<value_t> ) {
+			if( size >= sort_n_details::radix_sort_min_size ) {
+				if constexpr( sort_n_details::is_numeric_radix_key_v<key_t> ) {
+					sort_n_details::lsd_radix_sort( first, last, key );
+				} else {
+					std::vector<value_t> buffer( static_cast<std::size_t>( size ) );
+					sort_n_details::msd_radix_sort( first, last, key, buffer.data( ),
+					                                0 );
+				}
+				return;
+			}
+		}
+		std::stable_sort( first, last,
+		                  sort_n_details::radix_key_less<KeyExtractor>{ &key } );
+	}
+
+	/// @brief Stable ascending radix sort of integer, float or fixed width
+	/// string values
+	template<typename RandomIterator>
+	void radix_sort( RandomIterator first, RandomIterator last ) {
+		daw::radix_sort( first, last, sort_n_details::radix_identity{ } );
+	}
 } // namespace daw
@@ -16,6 +16,7 @@
 
 #include <ciso646>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <new>
@@ -333,4 +334,285 @@ namespace daw {
 			return !empty( );
 		}
 	};
+
+	namespace func_impl {
+		/// Table of operations for a type erased callable.  A null relocate or
+		/// destroy means the stored bytes can be memcpy'd or dropped as is
+		template<typename Result, typename... FuncArgs>
+		struct function_ops {
+			Result ( *invoke )( void *storage, FuncArgs &&... args );
+			void ( *relocate )( void *destination, void *source ) noexcept;
+			void ( *destroy )( void *storage ) noexcept;
+		};
+
+		template<typename Func, size_t StorageSize>
+		inline constexpr bool store_inline_v =
+		  sizeof( Func ) <= StorageSize and
+		  alignof( Func ) <= alignof( std::max_align_t ) and
+		  std::is_nothrow_move_constructible_v<Func>;
+
+		template<typename Func, size_t StorageSize>
+		struct inline_ops {
+			static Func *get( void *storage ) noexcept {
+				return std::launder( reinterpret_cast<Func *>( storage ) );
+			}
+
+			template<typename Result, typename... FuncArgs>
+			static Result invoke( void *storage, FuncArgs &&... args ) {
+				return static_cast<Result>(
+				  std::invoke( *get( storage ), std::forward<FuncArgs>( args )... ) );
+			}
+
+			static void relocate( void *destination, void *source ) noexcept {
+				Func *src = get( source );
+				new( destination ) Func( daw::move( *src ) );
+				std::destroy_at( src );
+			}
+
+			static void destroy( void *storage ) noexcept {
+				std::destroy_at( get( storage ) );
+			}
+
+			template<typename Result, typename... FuncArgs>
+			static constexpr function_ops<Result, FuncArgs...> ops = {
+			  &invoke<Result, FuncArgs...>,
+			  std::is_trivially_copyable_v<Func> ? nullptr : &relocate,
+			  std::is_trivially_destructible_v<Func> ? nullptr : &destroy };
+		};
+
+		template<typename Func>
+		struct heap_ops {
+			static Func *get( void *storage ) noexcept {
+				Func *result = nullptr;
+				std::memcpy( &result, storage, sizeof( Func * ) );
+				return result;
+			}
+
+			template<typename Result, typename... FuncArgs>
+			static Result invoke( void *storage, FuncArgs &&... args ) {
+				return static_cast<Result>(
+				  std::invoke( *get( storage ), std::forward<FuncArgs>( args )... ) );
+			}
+
+			static void destroy( void *storage ) noexcept {
+				delete get( storage );
+			}
+
+			// Only the pointer is stored, so relocation is always a memcpy
+			template<typename Result, typename... FuncArgs>
+			static constexpr function_ops<Result, FuncArgs...> ops = {
+			  &invoke<Result, FuncArgs...>, nullptr, &destroy };
+		};
+
+		template<typename Result, typename... FuncArgs>
+		struct empty_ops {
+			[[noreturn]] static Result invoke( void *, FuncArgs &&... ) {
+				daw::exception::daw_throw<std::bad_function_call>( );
+			}
+
+			static constexpr function_ops<Result, FuncArgs...> ops = {
+			  &invoke, nullptr, nullptr };
+		};
+	} // namespace func_impl
+
+	template<size_t, typename>
+	class unique_function;
+
+	///
+	/// A move only type erased callable.  Callables that fit in StorageSize
+	/// bytes and are nothrow movable are stored inline, larger ones are moved
+	/// to the heap instead of failing to compile.  Dispatch goes through a
+	/// static table of function pointers rather than a vtable, and moving a
+	/// unique_function holding a trivially copyable or heap stored callable
+	/// is a memcpy of the storage.  Calling an empty unique_function throws
+	/// std::bad_function_call without a branch on the call path
+	template<size_t StorageSize, typename Result, typename... FuncArgs>
+	class unique_function<StorageSize, Result( FuncArgs... )> {
+		static_assert( StorageSize >= sizeof( void * ),
+		               "StorageSize must be able to hold a pointer" );
+		using ops_t = func_impl::function_ops<Result, FuncArgs...>;
+
+		ops_t const *m_ops = &func_impl::empty_ops<Result, FuncArgs...>::ops;
+		alignas( std::max_align_t ) unsigned char m_storage[StorageSize];
+
+		static constexpr ops_t const *empty_ops( ) noexcept {
+			return &func_impl::empty_ops<Result, FuncArgs...>::ops;
+		}
+
+		void reset( ) noexcept {
+			if( m_ops->destroy ) {
+				m_ops->destroy( m_storage );
+			}
+			m_ops = empty_ops( );
+		}
+
+		void take( unique_function &other ) noexcept {
+			if( other.m_ops->relocate ) {
+				other.m_ops->relocate( m_storage, other.m_storage );
+			} else {
+				std::memcpy( m_storage, other.m_storage, StorageSize );
+			}
+			m_ops = std::exchange( other.m_ops, empty_ops( ) );
+		}
+
+		template<typename Func>
+		static bool is_null( Func const &f ) noexcept {
+			if constexpr( std::is_pointer_v<Func> or
+			              std::is_member_pointer_v<Func> ) {
+				return f == nullptr;
+			} else if constexpr( func_impl::has_empty_member_v<Func> ) {
+				return f.empty( );
+			} else if constexpr( func_impl::is_boolable_v<Func> and
+			                     std::is_class_v<Func> ) {
+				return not static_cast<bool>( f );
+			} else {
+				return false;
+			}
+		}
+
+		template<typename Func>
+		void store( Func &&f ) {
+			using func_t = std::decay_t<Func>;
+			if( is_null( f ) ) {
+				return;
+			}
+			if constexpr( func_impl::store_inline_v<func_t, StorageSize> ) {
+				new( m_storage ) func_t( std::forward<Func>( f ) );
+				m_ops = &func_impl::inline_ops<func_t, StorageSize>::template ops<
+				  Result, FuncArgs...>;
+			} else {
+				auto *ptr = new func_t( std::forward<Func>( f ) );
+				std::memcpy( m_storage, &ptr, sizeof( ptr ) );
+				m_ops = &func_impl::heap_ops<func_t>::template ops<Result, FuncArgs...>;
+			}
+		}
+
+	public:
+		unique_function( ) noexcept = default;
+
+		unique_function( std::nullptr_t ) noexcept {}
+
+		template<
+		  typename Func,
+		  std::enable_if_t<
+		    daw::all_true_v<
+		      not std::is_same_v<std::decay_t<Func>, unique_function>,
+		      std::is_invocable_r_v<Result, std::decay_t<Func> &, FuncArgs...>>,
+		    std::nullptr_t> = nullptr>
+		unique_function( Func &&f ) {
+			store( std::forward<Func>( f ) );
+		}
+
+		unique_function( unique_function &&other ) noexcept {
+			take( other );
+		}
+
+		unique_function &operator=( unique_function &&rhs ) noexcept {
+			if( this != &rhs ) {
+				reset( );
+				take( rhs );
+			}
+			return *this;
+		}
+
+		unique_function &operator=( std::nullptr_t ) noexcept {
+			reset( );
+			return *this;
+		}
+
+		template<
+		  typename Func,
+		  std::enable_if_t<
+		    daw::all_true_v<
+		      not std::is_same_v<std::decay_t<Func>, unique_function>,
+		      std::is_invocable_r_v<Result, std::decay_t<Func> &, FuncArgs...>>,
+		    std::nullptr_t> = nullptr>
+		unique_function &operator=( Func &&f ) {
+			reset( );
+			store( std::forward<Func>( f ) );
+			return *this;
+		}
+
+		unique_function( unique_function const & ) = delete;
+		unique_function &operator=( unique_function const & ) = delete;
+
+		~unique_function( ) {
+			reset( );
+		}
+
+		Result operator( )( FuncArgs... args ) {
+			return m_ops->invoke( m_storage, std::forward<FuncArgs>( args )... );
+		}
+
+		/// @brief Like std::function, a const call invokes the stored callable as
+		/// non-const
+		Result operator( )( FuncArgs... args ) const {
+			return m_ops->invoke( const_cast<unsigned char *>( m_storage ),
+			                      std::forward<FuncArgs>( args )... );
+		}
+
+		bool empty( ) const noexcept {
+			return m_ops == empty_ops( );
+		}
+
+		explicit operator bool( ) const noexcept {
+			return not empty( );
+		}
+
+		/// @brief True if a callable of type Func would be stored without a heap
+		/// allocation
+		template<typename Func>
+		static constexpr bool stores_inline( ) noexcept {
+			return func_impl::store_inline_v<std::decay_t<Func>, StorageSize>;
+		}
+	};
+
+	template<typename>
+	class function_ref;
+
+	///
+	/// A non-owning reference to a callable.  It is two pointers in size and
+	/// trivially copyable.  The referenced callable must outlive the
+	/// function_ref
+	template<typename Result, typename... FuncArgs>
+	class function_ref<Result( FuncArgs... )> {
+		void *m_obj;
+		Result ( *m_invoke )( void *, FuncArgs &&... );
+
+		template<typename Func>
+		static Result invoke_obj( void *obj, FuncArgs &&... args ) {
+			return static_cast<Result>( std::invoke(
+			  *static_cast<Func *>( obj ), std::forward<FuncArgs>( args )... ) );
+		}
+
+		template<typename Func>
+		static Result invoke_fp( void *obj, FuncArgs &&... args ) {
+			return static_cast<Result>( std::invoke(
+			  reinterpret_cast<Func *>( obj ), std::forward<FuncArgs>( args )... ) );
+		}
+
+	public:
+		template<
+		  typename Func,
+		  std::enable_if_t<
+		    daw::all_true_v<not std::is_same_v<daw::remove_cvref_t<Func>,
+		                                       function_ref>,
+		                    not std::is_function_v<std::remove_reference_t<Func>>,
+		                    std::is_invocable_r_v<Result, Func &, FuncArgs...>>,
+		    std::nullptr_t> = nullptr>
+		function_ref( Func &&f ) noexcept
+		  : m_obj( const_cast<void *>(
+		      static_cast<void const *>( std::addressof( f ) ) ) )
+		  , m_invoke( &invoke_obj<std::remove_reference_t<Func>> ) {}
+
+		template<typename Func, std::enable_if_t<std::is_function_v<Func>,
+		                                         std::nullptr_t> = nullptr>
+		function_ref( Func *f ) noexcept
+		  : m_obj( reinterpret_cast<void *>( f ) )
+		  , m_invoke( &invoke_fp<Func> ) {}
+
+		Result operator( )( FuncArgs... args ) const {
+			return m_invoke( m_obj, std::forward<FuncArgs>( args )... );
+		}
+	};
 } // namespace daw
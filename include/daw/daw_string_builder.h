@@ -0,0 +1,247 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_string_view.h"
+
+#include <algorithm>
+#include <array>
+#include <ciso646>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace daw {
+	/// Builds a large string as a chain of chunks instead of one buffer that
+	/// is regrown.  Appends never move what was already written.  The first
+	/// SmallSize characters live inside the builder.  The chunks can be
+	/// written out as they are, e.g. with writev, or joined into one string
+	/// when needed.
+	template<typename CharT, std::size_t SmallSize = 128 / sizeof( CharT )>
+	class basic_string_builder {
+	public:
+		using value_type = CharT;
+		using size_type = std::size_t;
+		using view_type = daw::basic_string_view<CharT>;
+
+		/// Chunks grow by doubling from first_chunk_size to max_chunk_size
+		static constexpr size_type first_chunk_size = 4096 / sizeof( CharT );
+		static constexpr size_type max_chunk_size =
+		  ( 1024 * 1024 ) / sizeof( CharT );
+		/// Views this long or longer are referenced by append_view, shorter
+		/// ones are copied
+		static constexpr size_type min_view_size = 256 / sizeof( CharT );
+
+	private:
+		struct chunk_t {
+			std::unique_ptr<CharT[]> owned{ };
+			CharT const *data = nullptr;
+			size_type size = 0;
+			/// 0 for chunks that reference memory the builder does not own
+			size_type capacity = 0;
+		};
+
+		std::array<CharT, SmallSize> m_small{ };
+		size_type m_small_size = 0;
+		std::vector<chunk_t> m_chunks{ };
+		size_type m_size = 0;
+		size_type m_next_chunk_size = first_chunk_size;
+
+		/// Start an owned chunk.  The buffer is not zero filled, everything
+		/// read from it is written first
+		chunk_t &add_chunk( size_type capacity ) {
+			auto &c = m_chunks.emplace_back( );
+#if defined( __cpp_lib_smart_ptr_for_overwrite )
+			c.owned = std::make_unique_for_overwrite<CharT[]>( capacity );
+#else
+			c.owned = std::unique_ptr<CharT[]>( new CharT[capacity] );
+#endif
+			c.data = c.owned.get( );
+			c.capacity = capacity;
+			return c;
+		}
+
+		/// Where the next characters go and how many fit there.  A chunk of at
+		/// least count characters is added when the current buffer is full
+		std::pair<CharT *, size_type> room_for( size_type count ) {
+			if( m_chunks.empty( ) ) {
+				if( m_small_size < SmallSize ) {
+					return { m_small.data( ) + m_small_size, SmallSize - m_small_size };
+				}
+			} else {
+				auto &last = m_chunks.back( );
+				if( last.size < last.capacity ) {
+					return { last.owned.get( ) + last.size, last.capacity - last.size };
+				}
+			}
+			auto const capacity = std::max( count, m_next_chunk_size );
+			m_next_chunk_size = std::min( m_next_chunk_size * 2U, max_chunk_size );
+			return { add_chunk( capacity ).owned.get( ), capacity };
+		}
+
+		/// Record that count characters were written at room_for( )
+		void commit( size_type count ) noexcept {
+			if( m_chunks.empty( ) ) {
+				m_small_size += count;
+			} else {
+				m_chunks.back( ).size += count;
+			}
+			m_size += count;
+		}
+
+	public:
+		basic_string_builder( ) = default;
+
+		/// Hint that about expected_size characters will be appended
+		explicit basic_string_builder( size_type expected_size ) {
+			reserve( expected_size );
+		}
+
+		basic_string_builder &append( view_type sv ) {
+			CharT const *first = sv.data( );
+			size_type count = sv.size( );
+			while( count > 0 ) {
+				auto const [out, room] = room_for( count );
+				auto const n = std::min( count, room );
+				std::copy_n( first, n, out );
+				commit( n );
+				first += n;
+				count -= n;
+			}
+			return *this;
+		}
+
+		basic_string_builder &append( CharT c ) {
+			*room_for( 1 ).first = c;
+			commit( 1 );
+			return *this;
+		}
+
+		basic_string_builder &append( size_type count, CharT c ) {
+			while( count > 0 ) {
+				auto const [out, room] = room_for( count );
+				auto const n = std::min( count, room );
+				std::fill_n( out, n, c );
+				commit( n );
+				count -= n;
+			}
+			return *this;
+		}
+
+		/// Append sv without copying it.  The characters must outlive the
+		/// builder and anything made from its chunks.  Short views are copied.
+		basic_string_builder &append_view( view_type sv ) {
+			if( sv.size( ) < min_view_size ) {
+				return append( sv );
+			}
+			// Later appends go to a new chunk after this one
+			auto &c = m_chunks.emplace_back( );
+			c.data = sv.data( );
+			c.size = sv.size( );
+			m_size += sv.size( );
+			return *this;
+		}
+
+		template<typename T>
+		basic_string_builder &operator+=( T const &value ) {
+			return append( value );
+		}
+
+		/// Make sure the next count characters appended go to a single chunk
+		/// without further allocation
+		void reserve( size_type count ) {
+			if( count > room_for( count ).second ) {
+				// Leave the partly used buffer and start a chunk big enough
+				add_chunk( count );
+			}
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		/// The number of pieces for_each_chunk visits.  Chunks left empty, e.g.
+		/// by reserve, are not counted
+		[[nodiscard]] size_type chunk_count( ) const noexcept {
+			auto const used = std::count_if(
+			  m_chunks.begin( ), m_chunks.end( ),
+			  []( chunk_t const &c ) { return c.size > 0; } );
+			return static_cast<size_type>( used ) + ( m_small_size > 0 ? 1U : 0U );
+		}
+
+		/// Call func( view_type ) for each piece of the string in order
+		template<typename Function>
+		void for_each_chunk( Function &&func ) const {
+			if( m_small_size > 0 ) {
+				func( view_type( m_small.data( ), m_small_size ) );
+			}
+			for( auto const &c : m_chunks ) {
+				if( c.size > 0 ) {
+					func( view_type( c.data, c.size ) );
+				}
+			}
+		}
+
+		/// The pieces of the string in order, e.g. to fill an iovec array for
+		/// writev.  They are valid until the builder is changed.
+		[[nodiscard]] std::vector<view_type> chunks( ) const {
+			auto result = std::vector<view_type>( );
+			result.reserve( chunk_count( ) );
+			for_each_chunk( [&]( view_type sv ) { result.push_back( sv ); } );
+			return result;
+		}
+
+		/// Copy the string to out, which must have room for size( ) characters
+		CharT *copy_to( CharT *out ) const {
+			for_each_chunk( [&]( view_type sv ) {
+				out = std::copy_n( sv.data( ), sv.size( ), out );
+			} );
+			return out;
+		}
+
+		/// Join the chunks into one string with a single allocation
+		template<typename Traits = std::char_traits<CharT>,
+		         typename Allocator = std::allocator<CharT>>
+		[[nodiscard]] std::basic_string<CharT, Traits, Allocator>
+		to_string( ) const {
+			auto result = std::basic_string<CharT, Traits, Allocator>( );
+			result.reserve( m_size );
+			for_each_chunk(
+			  [&]( view_type sv ) { result.append( sv.data( ), sv.size( ) ); } );
+			return result;
+		}
+
+		/// Remove the contents.  The first owned chunk is kept for reuse.
+		void clear( ) {
+			m_small_size = 0;
+			m_size = 0;
+			auto keep =
+			  std::find_if( m_chunks.begin( ), m_chunks.end( ),
+			                []( chunk_t const &c ) { return c.capacity > 0; } );
+			if( keep == m_chunks.end( ) ) {
+				m_chunks.clear( );
+			} else {
+				chunk_t reused = std::move( *keep );
+				reused.size = 0;
+				m_chunks.clear( );
+				m_chunks.push_back( std::move( reused ) );
+			}
+			m_next_chunk_size = first_chunk_size;
+		}
+	};
+
+	using string_builder = basic_string_builder<char>;
+	using wstring_builder = basic_string_builder<wchar_t>;
+} // namespace daw
@@ -0,0 +1,405 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_exception.h"
+#include "daw_likely.h"
+#include "daw_metro_hash.h"
+#include "daw_string_view.h"
+#include "daw_view.h"
+
+#include <array>
+#include <atomic>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace daw {
+	/// A 32 bit handle to a string in a string_interner.  Two handles from the
+	/// same interner are equal exactly when their strings are equal.  The
+	/// ordering is by handle value, not by the strings.
+	struct interned_string {
+		static constexpr std::uint32_t invalid_value = 0xFFFF'FFFFU;
+
+		std::uint32_t value = invalid_value;
+
+		constexpr interned_string( ) noexcept = default;
+		constexpr explicit interned_string( std::uint32_t v ) noexcept
+		  : value( v ) {}
+
+		constexpr bool is_valid( ) const noexcept {
+			return value != invalid_value;
+		}
+
+		constexpr explicit operator bool( ) const noexcept {
+			return is_valid( );
+		}
+
+		friend constexpr bool operator==( interned_string lhs,
+		                                  interned_string rhs ) noexcept {
+			return lhs.value == rhs.value;
+		}
+
+		friend constexpr bool operator!=( interned_string lhs,
+		                                  interned_string rhs ) noexcept {
+			return lhs.value != rhs.value;
+		}
+
+		friend constexpr bool operator<( interned_string lhs,
+		                                 interned_string rhs ) noexcept {
+			return lhs.value < rhs.value;
+		}
+	};
+
+	namespace string_interner_details {
+		inline constexpr std::size_t shard_bits = 4;
+		inline constexpr std::size_t shard_count = std::size_t{ 1 }
+		                                           << shard_bits;
+		inline constexpr std::size_t ordinal_bits = 32 - shard_bits;
+		/// The last ordinal is not used so that no handle is invalid_value
+		inline constexpr std::uint32_t max_ordinal =
+		  ( std::uint32_t{ 1 } << ordinal_bits ) - 2U;
+
+		/// Entries live in blocks that double in size, so a block never moves
+		/// and readers can find an entry without a lock
+		inline constexpr std::size_t first_block_bits = 10;
+		inline constexpr std::size_t block_count =
+		  ordinal_bits - first_block_bits + 1;
+
+		inline constexpr std::size_t chunk_size = 64U * 1024U;
+		inline constexpr std::uint64_t hash_seed = 0x5157'1b5d'2c2f'0f91ULL;
+
+		constexpr std::size_t highest_bit( std::uint32_t value ) noexcept {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			return 31U - static_cast<std::size_t>( __builtin_clz( value ) );
+#else
+			std::size_t result = 0;
+			while( value > 1U ) {
+				value >>= 1U;
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		struct entry {
+			char const *data;
+			std::size_t size;
+		};
+
+		/// One slice of the interner, owning the characters, the entries and
+		/// the hash index of the strings whose hash selects it
+		struct shard {
+			std::mutex m_mutex{ };
+			std::array<std::atomic<entry *>, block_count> m_blocks{ };
+			std::uint32_t m_size = 0;
+			/// Each slot is ( hash >> 32 ) << 32 | ( ordinal + 1 ), 0 is empty
+			std::vector<std::uint64_t> m_index = std::vector<std::uint64_t>( 64 );
+			std::vector<std::unique_ptr<char[]>> m_chunks{ };
+			char *m_chunk_pos = nullptr;
+			std::size_t m_chunk_left = 0;
+
+			shard( ) = default;
+			shard( shard const & ) = delete;
+			shard &operator=( shard const & ) = delete;
+
+			~shard( ) {
+				for( auto &block : m_blocks ) {
+					delete[] block.load( std::memory_order_relaxed );
+				}
+			}
+
+			static constexpr std::size_t block_of( std::uint32_t ordinal ) noexcept {
+				return highest_bit( ordinal + ( 1U << first_block_bits ) ) -
+				       first_block_bits;
+			}
+
+			static constexpr std::size_t
+			offset_in_block( std::uint32_t ordinal, std::size_t block ) noexcept {
+				return ordinal + ( 1U << first_block_bits ) -
+				       ( std::size_t{ 1 } << ( block + first_block_bits ) );
+			}
+
+			entry const &get( std::uint32_t ordinal ) const noexcept {
+				auto const block = block_of( ordinal );
+				return m_blocks[block].load(
+				  std::memory_order_acquire )[offset_in_block( ordinal, block )];
+			}
+
+			/// Look for sv in the index.  The caller holds the lock or the
+			/// interner is frozen
+			std::uint32_t find( daw::string_view sv,
+			                    std::uint64_t hash ) const noexcept {
+				std::uint64_t const fragment = hash >> 32U;
+				std::size_t const mask = m_index.size( ) - 1U;
+				for( std::size_t pos = fragment & mask;; pos = ( pos + 1U ) & mask ) {
+					std::uint64_t const slot = m_index[pos];
+					if( slot == 0 ) {
+						return interned_string::invalid_value;
+					}
+					if( ( slot >> 32U ) == fragment ) {
+						auto const ordinal = static_cast<std::uint32_t>( slot ) - 1U;
+						auto const &e = get( ordinal );
+						if( e.size == sv.size( ) and
+						    ( sv.empty( ) or
+						      std::memcmp( e.data, sv.data( ), sv.size( ) ) == 0 ) ) {
+							return ordinal;
+						}
+					}
+				}
+			}
+
+			char const *store_chars( daw::string_view sv ) {
+				// Empty entries still get a valid pointer for the views handed out
+				if( sv.empty( ) ) {
+					return "";
+				}
+				if( sv.size( ) > m_chunk_left ) {
+					auto const size = sv.size( ) > chunk_size ? sv.size( ) : chunk_size;
+					m_chunks.push_back( std::make_unique<char[]>( size ) );
+					m_chunk_pos = m_chunks.back( ).get( );
+					m_chunk_left = size;
+				}
+				char *result = m_chunk_pos;
+				std::memcpy( result, sv.data( ), sv.size( ) );
+				m_chunk_pos += sv.size( );
+				m_chunk_left -= sv.size( );
+				return result;
+			}
+
+			void insert_index( std::uint64_t fragment, std::uint32_t ordinal ) {
+				std::size_t const mask = m_index.size( ) - 1U;
+				std::size_t pos = fragment & mask;
+				while( m_index[pos] != 0 ) {
+					pos = ( pos + 1U ) & mask;
+				}
+				m_index[pos] = ( fragment << 32U ) | ( ordinal + 1U );
+			}
+
+			void grow_index( ) {
+				auto old_index = std::vector<std::uint64_t>( m_index.size( ) * 2U );
+				m_index.swap( old_index );
+				for( auto slot : old_index ) {
+					if( slot != 0 ) {
+						insert_index( slot >> 32U,
+						              static_cast<std::uint32_t>( slot ) - 1U );
+					}
+				}
+			}
+
+			/// Add sv, which is not in the index.  The caller holds the lock
+			std::uint32_t add( daw::string_view sv, std::uint64_t hash ) {
+				daw::exception::precondition_check<std::length_error>(
+				  m_size <= max_ordinal, "string_interner shard is full" );
+				std::uint32_t const ordinal = m_size;
+				auto const block = block_of( ordinal );
+				entry *entries = m_blocks[block].load( std::memory_order_relaxed );
+				if( entries == nullptr ) {
+					entries = new entry[std::size_t{ 1 }
+					                    << ( block + first_block_bits )];
+					m_blocks[block].store( entries, std::memory_order_release );
+				}
+				entries[offset_in_block( ordinal, block )] =
+				  entry{ store_chars( sv ), sv.size( ) };
+				++m_size;
+				// Keep the load factor at or below 1/2
+				if( m_size * 2U > m_index.size( ) ) {
+					grow_index( );
+				}
+				insert_index( hash >> 32U, ordinal );
+				return ordinal;
+			}
+		};
+	} // namespace string_interner_details
+
+	/// Deduplicates strings and hands out interned_string handles for them.
+	/// Strings are spread over 16 shards by hash, each with its own lock,
+	/// character arena and index.  Getting the string of a handle never
+	/// locks.  Once frozen the interner is read only and lookups do not lock
+	/// either.  The characters are not null terminated.
+	class string_interner {
+		using shard_t = string_interner_details::shard;
+
+		struct state_t {
+			std::array<shard_t, string_interner_details::shard_count> shards{ };
+			std::atomic<bool> frozen = false;
+		};
+		std::unique_ptr<state_t> m_state = std::make_unique<state_t>( );
+
+		static std::uint64_t hash( daw::string_view sv ) noexcept {
+			return daw::metro::hash64(
+			  daw::view<char const *>( sv.data( ), sv.data( ) + sv.size( ) ),
+			  string_interner_details::hash_seed );
+		}
+
+		static constexpr std::size_t shard_of( std::uint64_t hash ) noexcept {
+			return static_cast<std::size_t>(
+			  hash >> ( 64U - string_interner_details::shard_bits ) );
+		}
+
+		static constexpr interned_string make_handle( std::size_t shard,
+		                                              std::uint32_t ordinal ) {
+			if( ordinal == interned_string::invalid_value ) {
+				return interned_string( );
+			}
+			return interned_string( static_cast<std::uint32_t>(
+			  ( shard << string_interner_details::ordinal_bits ) | ordinal ) );
+		}
+
+		interned_string intern( daw::string_view sv, std::uint64_t h,
+		                        bool frozen ) {
+			auto const shard = shard_of( h );
+			auto &s = m_state->shards[shard];
+			if( frozen ) {
+				return make_handle( shard, s.find( sv, h ) );
+			}
+			auto const lck = std::lock_guard<std::mutex>( s.m_mutex );
+			auto ordinal = s.find( sv, h );
+			// freeze( ) may have finished while this thread waited on the lock
+			if( ordinal == interned_string::invalid_value and not is_frozen( ) ) {
+				ordinal = s.add( sv, h );
+			}
+			return make_handle( shard, ordinal );
+		}
+
+	public:
+		string_interner( ) = default;
+
+		/// Return the handle for sv, adding it if needed.  A frozen interner
+		/// returns an invalid handle for strings it does not have
+		interned_string intern( daw::string_view sv ) {
+			return intern( sv, hash( sv ),
+			               m_state->frozen.load( std::memory_order_acquire ) );
+		}
+
+		/// Intern every string in [first, last) and return the handles in the
+		/// same order.  The strings are grouped by shard so each shard is
+		/// locked once.
+		template<typename ForwardIterator>
+		std::vector<interned_string> intern( ForwardIterator first,
+		                                     ForwardIterator last ) {
+			auto const count =
+			  static_cast<std::size_t>( std::distance( first, last ) );
+			std::vector<interned_string> result( count );
+			bool const frozen = m_state->frozen.load( std::memory_order_acquire );
+			if( frozen ) {
+				for( std::size_t n = 0; n < count; ++n, ++first ) {
+					auto const sv = daw::string_view( *first );
+					result[n] = intern( sv, hash( sv ), true );
+				}
+				return result;
+			}
+			struct pending_t {
+				daw::string_view sv;
+				std::uint64_t hash;
+				std::size_t position;
+			};
+			std::array<std::vector<pending_t>, string_interner_details::shard_count>
+			  by_shard{ };
+			for( auto &pending : by_shard ) {
+				pending.reserve( count / by_shard.size( ) + count / 64U + 1U );
+			}
+			for( std::size_t n = 0; n < count; ++n, ++first ) {
+				auto const sv = daw::string_view( *first );
+				auto const h = hash( sv );
+				by_shard[shard_of( h )].push_back( pending_t{ sv, h, n } );
+			}
+			for( std::size_t shard = 0; shard < by_shard.size( ); ++shard ) {
+				if( by_shard[shard].empty( ) ) {
+					continue;
+				}
+				auto &s = m_state->shards[shard];
+				auto const lck = std::lock_guard<std::mutex>( s.m_mutex );
+				bool const can_add = not is_frozen( );
+				for( auto const &p : by_shard[shard] ) {
+					auto ordinal = s.find( p.sv, p.hash );
+					if( ordinal == interned_string::invalid_value and can_add ) {
+						ordinal = s.add( p.sv, p.hash );
+					}
+					result[p.position] = make_handle( shard, ordinal );
+				}
+			}
+			return result;
+		}
+
+		/// The handle of sv, or an invalid handle if it has not been interned
+		[[nodiscard]] interned_string find( daw::string_view sv ) const {
+			auto const h = hash( sv );
+			auto const shard = shard_of( h );
+			auto &s = m_state->shards[shard];
+			if( m_state->frozen.load( std::memory_order_acquire ) ) {
+				return make_handle( shard, s.find( sv, h ) );
+			}
+			auto const lck = std::lock_guard<std::mutex>( s.m_mutex );
+			return make_handle( shard, s.find( sv, h ) );
+		}
+
+		/// The string for a valid handle from this interner
+		[[nodiscard]] daw::string_view view( interned_string handle ) const {
+			daw::exception::dbg_precondition_check( handle.is_valid( ) );
+			auto const shard = static_cast<std::size_t>(
+			  handle.value >> string_interner_details::ordinal_bits );
+			auto const ordinal =
+			  handle.value & ( ( std::uint32_t{ 1 }
+			                     << string_interner_details::ordinal_bits ) -
+			                   1U );
+			auto const &e = m_state->shards[shard].get( ordinal );
+			return daw::string_view( e.data, e.size );
+		}
+
+		[[nodiscard]] daw::string_view
+		operator[]( interned_string handle ) const {
+			return view( handle );
+		}
+
+		/// Make the interner read only.  Lookups stop taking locks and intern
+		/// no longer adds strings.  It waits for intern calls that hold a shard
+		/// lock to finish.
+		void freeze( ) {
+			for( auto &s : m_state->shards ) {
+				s.m_mutex.lock( );
+			}
+			m_state->frozen.store( true, std::memory_order_release );
+			for( auto &s : m_state->shards ) {
+				s.m_mutex.unlock( );
+			}
+		}
+
+		[[nodiscard]] bool is_frozen( ) const noexcept {
+			return m_state->frozen.load( std::memory_order_acquire );
+		}
+
+		/// The number of distinct strings
+		[[nodiscard]] std::size_t size( ) const {
+			std::size_t result = 0;
+			for( auto &s : m_state->shards ) {
+				auto const lck = std::lock_guard<std::mutex>( s.m_mutex );
+				result += s.m_size;
+			}
+			return result;
+		}
+	};
+} // namespace daw
+
+namespace std {
+	template<>
+	struct hash<daw::interned_string> {
+		constexpr std::size_t
+		operator( )( daw::interned_string handle ) const noexcept {
+			return handle.value;
+		}
+	};
+} // namespace std
@@ -9,13 +9,22 @@
 #pragma once
 
 #include "daw_algorithm.h"
+#include "daw_bit.h"
+#include "daw_exception.h"
+#include "daw_is_constant_evaluated.h"
 #include "daw_move.h"
+#include "daw_simd_support.h"
 #include "daw_string_view.h"
 #include "daw_traits.h"
 #include "iterator/daw_reverse_iterator.h"
 
 #include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace daw {
 	template<typename CharT>
@@ -188,4 +197,295 @@ namespace daw {
 		return { daw::basic_string_view<CharT, Bounds, N - 1>( str ),
 		         daw::basic_string_view<CharT, Bounds, M - 1>( delemiter ) };
 	}
+
+	namespace split_details {
+		/// Call on_match( pos ) for each non overlapping occurrence of delimiter
+		/// in str at or after first, until on_match returns false.  For char the
+		/// first and last characters of the delimiter are compared 16 positions
+		/// at a time and only the candidates are compared in full.
+		template<typename CharT, typename OnMatch>
+		constexpr void find_all( daw::basic_string_view<CharT> str,
+		                         daw::basic_string_view<CharT> delimiter,
+		                         std::size_t first, OnMatch &&on_match ) {
+			std::size_t const size = delimiter.size( );
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+			if constexpr( sizeof( CharT ) == 1 ) {
+				if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+					auto const *const s = reinterpret_cast<char const *>( str.data( ) );
+					auto const *const d =
+					  reinterpret_cast<char const *>( delimiter.data( ) );
+					__m128i const front = _mm_set1_epi8( d[0] );
+					__m128i const back = _mm_set1_epi8( d[size - 1] );
+					// Matches must not overlap, so candidates before here are skipped
+					std::size_t next_allowed = first;
+					auto const load = [s]( std::size_t pos ) {
+						return _mm_loadu_si128(
+						  reinterpret_cast<__m128i const *>( s + pos ) );
+					};
+					for( ; first + size - 1 + 16 <= str.size( ); first += 16 ) {
+						__m128i const candidates =
+						  _mm_and_si128( _mm_cmpeq_epi8( load( first ), front ),
+						                 _mm_cmpeq_epi8( load( first + size - 1 ), back ) );
+						auto mask =
+						  static_cast<std::uint32_t>( _mm_movemask_epi8( candidates ) );
+						for( ; mask != 0; mask &= mask - 1U ) {
+							std::size_t const pos = first + daw::countr_zero( mask );
+							if( pos < next_allowed or
+							    std::char_traits<char>::compare( s + pos + 1, d + 1,
+							                                     size - 1 ) != 0 ) {
+								continue;
+							}
+							if( not on_match( pos ) ) {
+								return;
+							}
+							next_allowed = pos + size;
+						}
+						if( next_allowed > first + 16 ) {
+							first = next_allowed - 16;
+						}
+					}
+					if( first < next_allowed ) {
+						first = next_allowed;
+					}
+				}
+			}
+#endif
+			while( first <= str.size( ) ) {
+				std::size_t const pos = str.find( delimiter, first );
+				if( pos == daw::basic_string_view<CharT>::npos or
+				    not on_match( pos ) ) {
+					return;
+				}
+				first = pos + size;
+			}
+		}
+	} // namespace split_details
+
+	/// Splits a string at a delimiter like string_split_range, but finds every
+	/// delimiter in one pass up front and keeps where each token ends.
+	/// Iterating is then a walk over the offsets, and size( ) and operator[]
+	/// are O(1).  The string must outlive the index.
+	template<typename CharT>
+	class indexed_string_split {
+	public:
+		using value_type = daw::basic_string_view<CharT>;
+		using size_type = std::size_t;
+
+	private:
+		value_type m_str{ };
+		size_type m_delimiter_size = 0;
+		/// Where the first token starts
+		size_type m_first = 0;
+		/// Where each token ends
+		std::vector<size_type> m_ends{ };
+		bool m_is_last = true;
+
+		template<typename C, typename Function>
+		friend void for_each_split_block( daw::basic_string_view<C>,
+		                                  daw::basic_string_view<C>, std::size_t,
+		                                  Function && );
+
+		/// Index up to max_tokens tokens, the first starting at first
+		void index_from( size_type first, value_type delimiter,
+		                 size_type max_tokens ) {
+			m_first = first;
+			m_ends.clear( );
+			split_details::find_all( m_str, delimiter, first, [&]( size_type pos ) {
+				m_ends.push_back( pos );
+				return m_ends.size( ) < max_tokens;
+			} );
+			m_is_last = m_ends.size( ) < max_tokens;
+			if( m_is_last ) {
+				m_ends.push_back( m_str.size( ) );
+			}
+		}
+
+	public:
+		class const_iterator {
+			indexed_string_split const *m_split = nullptr;
+			size_type m_index = 0;
+
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = daw::basic_string_view<CharT>;
+			using reference = daw::basic_string_view<CharT>;
+			using pointer = daw::basic_string_view<CharT>;
+			using difference_type = std::ptrdiff_t;
+
+			const_iterator( ) noexcept = default;
+
+			const_iterator( indexed_string_split const *split,
+			                size_type index ) noexcept
+			  : m_split( split )
+			  , m_index( index ) {}
+
+			reference operator*( ) const noexcept {
+				return ( *m_split )[m_index];
+			}
+
+			reference operator[]( difference_type n ) const noexcept {
+				return ( *m_split )[static_cast<size_type>(
+				  static_cast<difference_type>( m_index ) + n )];
+			}
+
+			const_iterator &operator++( ) noexcept {
+				++m_index;
+				return *this;
+			}
+
+			const_iterator operator++( int ) noexcept {
+				auto result = *this;
+				++m_index;
+				return result;
+			}
+
+			const_iterator &operator--( ) noexcept {
+				--m_index;
+				return *this;
+			}
+
+			const_iterator operator--( int ) noexcept {
+				auto result = *this;
+				--m_index;
+				return result;
+			}
+
+			const_iterator &operator+=( difference_type n ) noexcept {
+				m_index = static_cast<size_type>(
+				  static_cast<difference_type>( m_index ) + n );
+				return *this;
+			}
+
+			const_iterator &operator-=( difference_type n ) noexcept {
+				return *this += -n;
+			}
+
+			friend const_iterator operator+( const_iterator it,
+			                                 difference_type n ) noexcept {
+				return it += n;
+			}
+
+			friend const_iterator operator+( difference_type n,
+			                                 const_iterator it ) noexcept {
+				return it += n;
+			}
+
+			friend const_iterator operator-( const_iterator it,
+			                                 difference_type n ) noexcept {
+				return it -= n;
+			}
+
+			friend difference_type operator-( const_iterator const &lhs,
+			                                  const_iterator const &rhs ) noexcept {
+				return static_cast<difference_type>( lhs.m_index ) -
+				       static_cast<difference_type>( rhs.m_index );
+			}
+
+			friend bool operator==( const_iterator const &lhs,
+			                        const_iterator const &rhs ) noexcept {
+				return lhs.m_index == rhs.m_index;
+			}
+
+			friend bool operator!=( const_iterator const &lhs,
+			                        const_iterator const &rhs ) noexcept {
+				return lhs.m_index != rhs.m_index;
+			}
+
+			friend bool operator<( const_iterator const &lhs,
+			                       const_iterator const &rhs ) noexcept {
+				return lhs.m_index < rhs.m_index;
+			}
+
+			friend bool operator>( const_iterator const &lhs,
+			                       const_iterator const &rhs ) noexcept {
+				return lhs.m_index > rhs.m_index;
+			}
+
+			friend bool operator<=( const_iterator const &lhs,
+			                        const_iterator const &rhs ) noexcept {
+				return lhs.m_index <= rhs.m_index;
+			}
+
+			friend bool operator>=( const_iterator const &lhs,
+			                        const_iterator const &rhs ) noexcept {
+				return lhs.m_index >= rhs.m_index;
+			}
+		};
+		using iterator = const_iterator;
+
+		indexed_string_split( ) = default;
+
+		/// Index every token of str.  delimiter must not be empty
+		indexed_string_split( value_type str, value_type delimiter )
+		  : m_str( str )
+		  , m_delimiter_size( delimiter.size( ) ) {
+			daw::exception::precondition_check( not delimiter.empty( ),
+			                                    "delimiter must not be empty" );
+			index_from( 0, delimiter, std::numeric_limits<size_type>::max( ) );
+		}
+
+		[[nodiscard]] size_type size( ) const noexcept {
+			return m_ends.size( );
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_ends.empty( );
+		}
+
+		[[nodiscard]] value_type operator[]( size_type index ) const noexcept {
+			size_type const first =
+			  index == 0 ? m_first : m_ends[index - 1] + m_delimiter_size;
+			return m_str.substr( first, m_ends[index] - first );
+		}
+
+		[[nodiscard]] const_iterator begin( ) const noexcept {
+			return { this, 0 };
+		}
+
+		[[nodiscard]] const_iterator cbegin( ) const noexcept {
+			return { this, 0 };
+		}
+
+		[[nodiscard]] const_iterator end( ) const noexcept {
+			return { this, m_ends.size( ) };
+		}
+
+		[[nodiscard]] const_iterator cend( ) const noexcept {
+			return { this, m_ends.size( ) };
+		}
+
+		/// False when this is a block from for_each_split_block and more tokens
+		/// follow it
+		[[nodiscard]] bool is_last( ) const noexcept {
+			return m_is_last;
+		}
+	};
+
+	template<typename CharT>
+	indexed_string_split( daw::basic_string_view<CharT>,
+	                      daw::basic_string_view<CharT> )
+	  -> indexed_string_split<CharT>;
+
+	/// Split str at delimiter a block of at most block_tokens tokens at a
+	/// time, calling func( indexed_string_split<CharT> const & ) for each
+	/// block.  Only one block of offsets is held at once.
+	template<typename CharT, typename Function>
+	void for_each_split_block( daw::basic_string_view<CharT> str,
+	                           daw::basic_string_view<CharT> delimiter,
+	                           std::size_t block_tokens, Function &&func ) {
+		daw::exception::precondition_check( not delimiter.empty( ),
+		                                    "delimiter must not be empty" );
+		daw::exception::precondition_check( block_tokens > 0,
+		                                    "block_tokens must not be 0" );
+		indexed_string_split<CharT> block{ };
+		block.m_str = str;
+		block.m_delimiter_size = delimiter.size( );
+		block.m_ends.reserve( block_tokens );
+		std::size_t first = 0;
+		do {
+			block.index_from( first, delimiter, block_tokens );
+			func( static_cast<indexed_string_split<CharT> const &>( block ) );
+			first = block.m_ends.back( ) + delimiter.size( );
+		} while( not block.is_last( ) );
+	}
 } // namespace daw
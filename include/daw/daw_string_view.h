@@ -199,7 +199,7 @@ namespace daw {
 		template<std::size_t N>
 		constexpr basic_string_view( CharT const ( &cstr )[N] ) noexcept
 		  : m_first( cstr )
-		  , m_last( make_last<BoundsType>( N - 1 ) ) {}
+		  , m_last( make_last<BoundsType>( cstr, N - 1 ) ) {}
 
 #ifndef NOSTRING
 		template<typename Traits, typename Allocator>
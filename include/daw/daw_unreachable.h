@@ -16,3 +16,17 @@
 #include <exception>
 #define DAW_UNREACHABLE( ) std::terminate( )
 #endif
+
+// Tell the optimizer that the condition holds.  On GCC the condition is still
+// evaluated, so it should be free of side effects
+#if defined( __clang__ )
+#define DAW_ASSUME( ... ) __builtin_assume( static_cast<bool>( __VA_ARGS__ ) )
+#elif defined( __GNUC__ )
+#define DAW_ASSUME( ... )                                                      \
+	( static_cast<bool>( __VA_ARGS__ ) ? static_cast<void>( 0 )                  \
+	                                   : __builtin_unreachable( ) )
+#elif defined( _MSC_VER )
+#define DAW_ASSUME( ... ) __assume( static_cast<bool>( __VA_ARGS__ ) )
+#else
+#define DAW_ASSUME( ... ) static_cast<void>( 0 )
+#endif
@@ -0,0 +1,584 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_is_constant_evaluated.h"
+#include "daw_simd_support.h"
+#include "daw_string_view.h"
+
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/// UTF-8 validation, counting and conversion to and from UTF-16 and UTF-32.
+/// Everything is constexpr.  At run time blocks of 16 ASCII bytes are
+/// skipped or widened at once with SSE2, and with SSSE3 mixed text is
+/// validated a block at a time as well.  Invalid means not well formed as
+/// in table 3-7 of the Unicode standard: overlong forms, surrogates, values
+/// past U+10FFFF and truncated sequences are all rejected.
+namespace daw::utf8 {
+	/// in is where reading stopped.  When ok is false it is the start of the
+	/// sequence that could not be converted.  out is one past the last unit
+	/// written.
+	template<typename InChar, typename OutChar>
+	struct transcode_result {
+		InChar const *in;
+		OutChar *out;
+		bool ok;
+
+		explicit constexpr operator bool( ) const noexcept {
+			return ok;
+		}
+	};
+
+	namespace utf8_details {
+		constexpr unsigned char byte( char c ) noexcept {
+			return static_cast<unsigned char>( c );
+		}
+
+		constexpr bool is_continuation( char c ) noexcept {
+			return ( byte( c ) & 0xC0U ) == 0x80U;
+		}
+
+		struct decoded_t {
+			char32_t code_point;
+			/// 0 when the sequence is not well formed
+			std::size_t size;
+		};
+
+		/// Decode the sequence starting at first.  first != last
+		constexpr decoded_t decode( char const *first, char const *last ) noexcept {
+			unsigned const b0 = byte( first[0] );
+			if( b0 < 0x80U ) {
+				return { static_cast<char32_t>( b0 ), 1 };
+			}
+			auto const remaining = static_cast<std::size_t>( last - first );
+			// The range of the second byte depends on the first
+			unsigned low = 0x80U;
+			unsigned high = 0xBFU;
+			std::size_t size = 0;
+			if( b0 < 0xC2U ) {
+				return { 0, 0 };
+			} else if( b0 < 0xE0U ) {
+				size = 2;
+			} else if( b0 < 0xF0U ) {
+				size = 3;
+				if( b0 == 0xE0U ) {
+					low = 0xA0U;
+				} else if( b0 == 0xEDU ) {
+					high = 0x9FU;
+				}
+			} else if( b0 < 0xF5U ) {
+				size = 4;
+				if( b0 == 0xF0U ) {
+					low = 0x90U;
+				} else if( b0 == 0xF4U ) {
+					high = 0x8FU;
+				}
+			} else {
+				return { 0, 0 };
+			}
+			if( remaining < size ) {
+				return { 0, 0 };
+			}
+			unsigned const b1 = byte( first[1] );
+			if( b1 < low or b1 > high ) {
+				return { 0, 0 };
+			}
+			auto result = static_cast<std::uint32_t>(
+			  ( b0 & ( 0x7FU >> size ) ) << 6U | ( b1 & 0x3FU ) );
+			for( std::size_t n = 2; n < size; ++n ) {
+				if( not is_continuation( first[n] ) ) {
+					return { 0, 0 };
+				}
+				result = result << 6U | ( byte( first[n] ) & 0x3FU );
+			}
+			return { static_cast<char32_t>( result ), size };
+		}
+
+		/// The first sequence in [first, last) that is not well formed, or last
+		constexpr char const *find_invalid_scalar( char const *first,
+		                                           char const *last ) noexcept {
+			while( first != last ) {
+				auto const size = decode( first, last ).size;
+				if( size == 0 ) {
+					return first;
+				}
+				first += size;
+			}
+			return first;
+		}
+
+		/// A sequence start at or before pos from which decoding sees any
+		/// sequence that crosses pos.  Only used where [begin, pos) is known to
+		/// be well formed apart from sequences that cross pos
+		constexpr char const *sequence_start( char const *begin,
+		                                      char const *pos ) noexcept {
+			char const *result = pos - ( pos - begin < 3 ? pos - begin : 3 );
+			while( result != pos and is_continuation( *result ) ) {
+				++result;
+			}
+			return result;
+		}
+
+		/// Write cp as UTF-8.  cp must be a scalar value
+		constexpr char *encode( char32_t cp, char *out ) noexcept {
+			auto const c = static_cast<std::uint32_t>( cp );
+			if( c < 0x80U ) {
+				*out++ = static_cast<char>( c );
+			} else if( c < 0x800U ) {
+				*out++ = static_cast<char>( 0xC0U | ( c >> 6U ) );
+				*out++ = static_cast<char>( 0x80U | ( c & 0x3FU ) );
+			} else if( c < 0x1'0000U ) {
+				*out++ = static_cast<char>( 0xE0U | ( c >> 12U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( c >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( c & 0x3FU ) );
+			} else {
+				*out++ = static_cast<char>( 0xF0U | ( c >> 18U ) );
+				*out++ = static_cast<char>( 0x80U | ( ( c >> 12U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( ( c >> 6U ) & 0x3FU ) );
+				*out++ = static_cast<char>( 0x80U | ( c & 0x3FU ) );
+			}
+			return out;
+		}
+
+		constexpr char16_t *encode( char32_t cp, char16_t *out ) noexcept {
+			if( cp < 0x1'0000U ) {
+				*out++ = static_cast<char16_t>( cp );
+			} else {
+				auto const c = static_cast<std::uint32_t>( cp ) - 0x1'0000U;
+				*out++ = static_cast<char16_t>( 0xD800U + ( c >> 10U ) );
+				*out++ = static_cast<char16_t>( 0xDC00U + ( c & 0x3FFU ) );
+			}
+			return out;
+		}
+
+		constexpr char32_t *encode( char32_t cp, char32_t *out ) noexcept {
+			*out++ = cp;
+			return out;
+		}
+
+		constexpr std::size_t popcount( std::uint32_t value ) noexcept {
+#if defined( __GNUC__ ) or defined( __clang__ )
+			return static_cast<std::size_t>( __builtin_popcount( value ) );
+#else
+			std::size_t result = 0;
+			for( ; value != 0; value &= value - 1U ) {
+				++result;
+			}
+			return result;
+#endif
+		}
+
+#if defined( DAW_HAS_SSE2 )
+		inline __m128i load( void const *ptr ) noexcept {
+			return _mm_loadu_si128( reinterpret_cast<__m128i const *>( ptr ) );
+		}
+
+		inline void store( void *ptr, __m128i value ) noexcept {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( ptr ), value );
+		}
+
+		inline bool is_ascii( __m128i block ) noexcept {
+			return _mm_movemask_epi8( block ) == 0;
+		}
+
+		inline bool is_zero( __m128i block ) noexcept {
+			return _mm_movemask_epi8(
+			         _mm_cmpeq_epi8( block, _mm_setzero_si128( ) ) ) == 0xFFFF;
+		}
+
+		inline char16_t *widen( __m128i ascii, char16_t *out ) noexcept {
+			__m128i const zero = _mm_setzero_si128( );
+			store( out, _mm_unpacklo_epi8( ascii, zero ) );
+			store( out + 8, _mm_unpackhi_epi8( ascii, zero ) );
+			return out + 16;
+		}
+
+		inline char32_t *widen( __m128i ascii, char32_t *out ) noexcept {
+			__m128i const zero = _mm_setzero_si128( );
+			__m128i const low = _mm_unpacklo_epi8( ascii, zero );
+			__m128i const high = _mm_unpackhi_epi8( ascii, zero );
+			store( out, _mm_unpacklo_epi16( low, zero ) );
+			store( out + 4, _mm_unpackhi_epi16( low, zero ) );
+			store( out + 8, _mm_unpacklo_epi16( high, zero ) );
+			store( out + 12, _mm_unpackhi_epi16( high, zero ) );
+			return out + 16;
+		}
+
+#if defined( DAW_HAS_SSSE3 )
+		/// Block validation after Keiser and Lemire, "Validating UTF-8 In Less
+		/// Than One Instruction Per Byte".  Three table lookups on the nibbles
+		/// of each byte and the byte before it flag every bad two byte
+		/// pattern; the rest are sequences that are too long or too short.
+		namespace lookup {
+			constexpr std::uint8_t too_short = 1U << 0U;
+			constexpr std::uint8_t too_long = 1U << 1U;
+			constexpr std::uint8_t overlong_3 = 1U << 2U;
+			constexpr std::uint8_t too_large = 1U << 3U;
+			constexpr std::uint8_t surrogate = 1U << 4U;
+			constexpr std::uint8_t overlong_2 = 1U << 5U;
+			constexpr std::uint8_t too_large_1000 = 1U << 6U;
+			constexpr std::uint8_t overlong_4 = 1U << 6U;
+			constexpr std::uint8_t two_conts = 1U << 7U;
+			constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+			inline __m128i table( std::uint8_t const ( &values )[16] ) noexcept {
+				return load( values );
+			}
+
+			inline __m128i high_nibbles( __m128i x ) noexcept {
+				return _mm_and_si128( _mm_srli_epi16( x, 4 ), _mm_set1_epi8( 0x0F ) );
+			}
+
+			/// Errors in input, given the block before it
+			inline __m128i check_block( __m128i input, __m128i prev_input ) noexcept {
+				static constexpr std::uint8_t byte_1_high[16] = {
+				  too_long,
+				  too_long,
+				  too_long,
+				  too_long,
+				  too_long,
+				  too_long,
+				  too_long,
+				  too_long,
+				  two_conts,
+				  two_conts,
+				  two_conts,
+				  two_conts,
+				  too_short | overlong_2,
+				  too_short,
+				  too_short | overlong_3 | surrogate,
+				  too_short | too_large | too_large_1000 | overlong_4 };
+				static constexpr std::uint8_t byte_1_low[16] = {
+				  carry | overlong_3 | overlong_2 | overlong_4,
+				  carry | overlong_2,
+				  carry,
+				  carry,
+				  carry | too_large,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000 | surrogate,
+				  carry | too_large | too_large_1000,
+				  carry | too_large | too_large_1000 };
+				static constexpr std::uint8_t byte_2_high[16] = {
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 |
+				    overlong_4,
+				  too_long | overlong_2 | two_conts | overlong_3 | too_large,
+				  too_long | overlong_2 | two_conts | surrogate | too_large,
+				  too_long | overlong_2 | two_conts | surrogate | too_large,
+				  too_short,
+				  too_short,
+				  too_short,
+				  too_short };
+
+				__m128i const prev1 = _mm_alignr_epi8( input, prev_input, 15 );
+				__m128i const special = _mm_and_si128(
+				  _mm_and_si128(
+				    _mm_shuffle_epi8( table( byte_1_high ), high_nibbles( prev1 ) ),
+				    _mm_shuffle_epi8( table( byte_1_low ),
+				                      _mm_and_si128( prev1, _mm_set1_epi8( 0x0F ) ) ) ),
+				  _mm_shuffle_epi8( table( byte_2_high ), high_nibbles( input ) ) );
+				// Bytes two and three after a three or four byte lead must be
+				// continuations.  Saturating subtraction leaves the top bit set
+				// only for those leads.
+				__m128i const prev2 = _mm_alignr_epi8( input, prev_input, 14 );
+				__m128i const prev3 = _mm_alignr_epi8( input, prev_input, 13 );
+				__m128i const third = _mm_subs_epu8( prev2, _mm_set1_epi8( 0x60 ) );
+				__m128i const fourth = _mm_subs_epu8( prev3, _mm_set1_epi8( 0x70 ) );
+				__m128i const must_continue =
+				  _mm_and_si128( _mm_or_si128( third, fourth ),
+				                 _mm_set1_epi8( static_cast<char>( 0x80 ) ) );
+				return _mm_xor_si128( must_continue, special );
+			}
+
+			/// Non zero when the block ends inside a sequence
+			inline __m128i is_incomplete( __m128i input ) noexcept {
+				return _mm_subs_epu8(
+				  input, _mm_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+				                        -1, static_cast<char>( 0xF0 - 1 ),
+				                        static_cast<char>( 0xE0 - 1 ),
+				                        static_cast<char>( 0xC0 - 1 ) ) );
+			}
+		} // namespace lookup
+#endif
+
+		/// find_invalid over whole blocks.  Once a block shows an error, or for
+		/// the tail, the scalar decoder finds the exact position
+		inline char const *find_invalid_blocks( char const *first,
+		                                        char const *last ) noexcept {
+			char const *const begin = first;
+#if defined( DAW_HAS_SSSE3 )
+			__m128i prev = _mm_setzero_si128( );
+			__m128i prev_incomplete = _mm_setzero_si128( );
+			for( ; last - first >= 16; first += 16 ) {
+				__m128i const input = load( first );
+				if( is_ascii( input ) ) {
+					// Only a sequence left open by the previous block can be wrong
+					if( not is_zero( prev_incomplete ) ) {
+						break;
+					}
+				} else {
+					if( not is_zero( lookup::check_block( input, prev ) ) ) {
+						break;
+					}
+					prev_incomplete = lookup::is_incomplete( input );
+				}
+				prev = input;
+			}
+			return find_invalid_scalar( sequence_start( begin, first ), last );
+#else
+			while( last - first >= 16 ) {
+				if( is_ascii( load( first ) ) ) {
+					first += 16;
+					continue;
+				}
+				// Decode up to the end of the block.  first stays on the start of
+				// a sequence
+				char const *const block_end = first + 16;
+				while( first < block_end ) {
+					auto const size = decode( first, last ).size;
+					if( size == 0 ) {
+						return first;
+					}
+					first += size;
+				}
+			}
+			(void)begin;
+			return find_invalid_scalar( first, last );
+#endif
+		}
+#endif
+
+		template<typename OutChar>
+		constexpr transcode_result<char, OutChar>
+		decode_to( char const *first, char const *last, OutChar *out ) noexcept {
+			while( first != last ) {
+				char const *stop = last;
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+				if( not DAW_IS_CONSTANT_EVALUATED( ) and last - first >= 16 ) {
+					__m128i const block = load( first );
+					if( is_ascii( block ) ) {
+						out = widen( block, out );
+						first += 16;
+						continue;
+					}
+					stop = first + 16;
+				}
+#endif
+				do {
+					auto const d = decode( first, last );
+					if( d.size == 0 ) {
+						return { first, out, false };
+					}
+					out = encode( d.code_point, out );
+					first += d.size;
+				} while( first < stop );
+			}
+			return { first, out, true };
+		}
+	} // namespace utf8_details
+
+	/// The position of the first byte of the first sequence in str that is
+	/// not well formed, or daw::string_view::npos
+	constexpr std::size_t find_invalid( daw::string_view str ) noexcept {
+		char const *const first = str.data( );
+		char const *const last = str.data( ) + str.size( );
+		char const *bad = last;
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			bad = utf8_details::find_invalid_blocks( first, last );
+		} else {
+			bad = utf8_details::find_invalid_scalar( first, last );
+		}
+#else
+		bad = utf8_details::find_invalid_scalar( first, last );
+#endif
+		if( bad == last ) {
+			return daw::string_view::npos;
+		}
+		return static_cast<std::size_t>( bad - first );
+	}
+
+	constexpr bool is_valid( daw::string_view str ) noexcept {
+		return find_invalid( str ) == daw::string_view::npos;
+	}
+
+	/// The number of code points in str, which must be valid
+	constexpr std::size_t count_code_points( daw::string_view str ) noexcept {
+		char const *first = str.data( );
+		char const *const last = str.data( ) + str.size( );
+		std::size_t result = 0;
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			// Continuation bytes are 0x80 through 0xBF, -128 through -65 signed
+			__m128i const max_continuation = _mm_set1_epi8( -65 );
+			for( ; last - first >= 16; first += 16 ) {
+				result += utf8_details::popcount( static_cast<std::uint32_t>(
+				  _mm_movemask_epi8( _mm_cmpgt_epi8( utf8_details::load( first ),
+				                                     max_continuation ) ) ) );
+			}
+		}
+#endif
+		for( ; first != last; ++first ) {
+			if( not utf8_details::is_continuation( *first ) ) {
+				++result;
+			}
+		}
+		return result;
+	}
+
+	/// The number of UTF-16 code units needed for str, which must be valid
+	constexpr std::size_t utf16_length( daw::string_view str ) noexcept {
+		std::size_t result = count_code_points( str );
+		// Four byte sequences need a surrogate pair
+		for( char c : str ) {
+			if( utf8_details::byte( c ) >= 0xF0U ) {
+				++result;
+			}
+		}
+		return result;
+	}
+
+	/// The number of UTF-8 code units needed for str, which must be valid
+	constexpr std::size_t
+	utf8_length( daw::basic_string_view<char16_t> str ) noexcept {
+		std::size_t result = 0;
+		for( char16_t c : str ) {
+			if( c < 0x80U ) {
+				result += 1;
+			} else if( c < 0x800U ) {
+				result += 2;
+			} else if( c >= 0xD800U and c < 0xDC00U ) {
+				// With the low surrogate that follows it makes 4 bytes
+				result += 4;
+			} else if( c < 0xDC00U or c > 0xDFFFU ) {
+				result += 3;
+			}
+		}
+		return result;
+	}
+
+	/// The number of UTF-8 code units needed for str, which must be valid
+	constexpr std::size_t
+	utf8_length( daw::basic_string_view<char32_t> str ) noexcept {
+		std::size_t result = 0;
+		for( char32_t c : str ) {
+			result += c < 0x80U ? 1U : c < 0x800U ? 2U : c < 0x1'0000U ? 3U : 4U;
+		}
+		return result;
+	}
+
+	/// Convert str to UTF-16.  out must have room for utf16_length( str )
+	/// units, or str.size( ) when str has not been validated
+	constexpr transcode_result<char, char16_t>
+	to_utf16( daw::string_view str, char16_t *out ) noexcept {
+		return utf8_details::decode_to( str.data( ), str.data( ) + str.size( ),
+		                                out );
+	}
+
+	/// Convert str to UTF-32.  out must have room for count_code_points( str )
+	/// units, or str.size( ) when str has not been validated
+	constexpr transcode_result<char, char32_t>
+	to_utf32( daw::string_view str, char32_t *out ) noexcept {
+		return utf8_details::decode_to( str.data( ), str.data( ) + str.size( ),
+		                                out );
+	}
+
+	/// Convert str to UTF-8.  out must have room for utf8_length( str ) bytes,
+	/// or 3 * str.size( ) when str has not been validated.  Unpaired
+	/// surrogates stop the conversion
+	constexpr transcode_result<char16_t, char>
+	from_utf16( daw::basic_string_view<char16_t> str, char *out ) noexcept {
+		char16_t const *first = str.data( );
+		char16_t const *const last = str.data( ) + str.size( );
+		while( first != last ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+			if( not DAW_IS_CONSTANT_EVALUATED( ) and last - first >= 8 ) {
+				__m128i const block = utf8_details::load( first );
+				__m128i const high_bits = _mm_and_si128(
+				  block, _mm_set1_epi16( static_cast<short>( 0xFF80 ) ) );
+				if( _mm_movemask_epi8( _mm_cmpeq_epi16(
+				      high_bits, _mm_setzero_si128( ) ) ) == 0xFFFF ) {
+					_mm_storel_epi64( reinterpret_cast<__m128i *>( out ),
+					                  _mm_packus_epi16( block, block ) );
+					first += 8;
+					out += 8;
+					continue;
+				}
+			}
+#endif
+			auto cp = static_cast<std::uint32_t>( *first );
+			std::size_t size = 1;
+			if( cp >= 0xD800U and cp <= 0xDFFFU ) {
+				if( cp >= 0xDC00U or last - first < 2 or first[1] < 0xDC00U or
+				    first[1] > 0xDFFFU ) {
+					return { first, out, false };
+				}
+				cp = 0x1'0000U + ( ( cp - 0xD800U ) << 10U ) +
+				     ( static_cast<std::uint32_t>( first[1] ) - 0xDC00U );
+				size = 2;
+			}
+			out = utf8_details::encode( static_cast<char32_t>( cp ), out );
+			first += size;
+		}
+		return { first, out, true };
+	}
+
+	/// Convert str to UTF-8.  out must have room for utf8_length( str ) bytes,
+	/// or 4 * str.size( ) when str has not been validated.  Surrogates and
+	/// values past U+10FFFF stop the conversion
+	constexpr transcode_result<char32_t, char>
+	from_utf32( daw::basic_string_view<char32_t> str, char *out ) noexcept {
+		char32_t const *first = str.data( );
+		char32_t const *const last = str.data( ) + str.size( );
+		while( first != last ) {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+			if( not DAW_IS_CONSTANT_EVALUATED( ) and last - first >= 4 ) {
+				__m128i const block = utf8_details::load( first );
+				__m128i const high_bits =
+				  _mm_and_si128( block, _mm_set1_epi32( static_cast<int>( ~0x7FU ) ) );
+				if( _mm_movemask_epi8( _mm_cmpeq_epi32(
+				      high_bits, _mm_setzero_si128( ) ) ) == 0xFFFF ) {
+					__m128i const words = _mm_packs_epi32( block, block );
+					auto const bytes =
+					  _mm_cvtsi128_si32( _mm_packus_epi16( words, words ) );
+					std::memcpy( out, &bytes, 4 );
+					first += 4;
+					out += 4;
+					continue;
+				}
+			}
+#endif
+			auto const cp = static_cast<std::uint32_t>( *first );
+			if( cp > 0x10'FFFFU or ( cp >= 0xD800U and cp <= 0xDFFFU ) ) {
+				return { first, out, false };
+			}
+			out = utf8_details::encode( *first, out );
+			++first;
+		}
+		return { first, out, true };
+	}
+} // namespace daw::utf8
@@ -114,8 +114,12 @@ namespace daw {
 					return std::forward<Visitor>( vis )(
 					  get_nt<7 + N>( std::forward<Variant>( var ) ) );
 				default:
-					return visit_nt<N + 8, R>( std::forward<Variant>( var ),
-					                           std::forward<Visitor>( vis ) );
+					if constexpr( VSz - N > 8 ) {
+						return visit_nt<N + 8, R>( std::forward<Variant>( var ),
+						                           std::forward<Visitor>( vis ) );
+					} else {
+						DAW_UNREACHABLE( );
+					}
 				}
 			} else if constexpr( VSz - N == 7 ) {
 				switch( var.index( ) ) {
@@ -222,6 +226,112 @@ namespace daw {
 			}
 			DAW_UNREACHABLE( );
 		}
+
+		// Above this many alternatives the chained switches above stop being a
+		// single jump and dispatch goes through a table of function pointers
+		// indexed by index( ) instead
+		inline constexpr std::size_t visit_table_threshold = 8;
+
+		template<std::size_t Idx, typename R, typename Variant, typename Visitor>
+		constexpr R visit_alternative( Variant &&var, Visitor &&vis ) {
+			return std::forward<Visitor>( vis )(
+			  get_nt<Idx>( std::forward<Variant>( var ) ) );
+		}
+
+		template<typename R, typename Variant, typename Visitor, typename Seq>
+		struct visit_table;
+
+		template<typename R, typename Variant, typename Visitor,
+		         std::size_t... Is>
+		struct visit_table<R, Variant, Visitor, std::index_sequence<Is...>> {
+			using func_t = R ( * )( Variant &&, Visitor && );
+			static constexpr func_t values[] = {
+			  &visit_alternative<Is, R, Variant, Visitor>... };
+		};
+
+		template<typename R, typename Variant, typename Visitor>
+		[[nodiscard]] constexpr R visit_nt_table( Variant &&var, Visitor &&vis ) {
+			using table_t =
+			  visit_table<R, Variant, Visitor,
+			              std::make_index_sequence<get_var_size_v<Variant>>>;
+			return table_t::values[var.index( )]( std::forward<Variant>( var ),
+			                                      std::forward<Visitor>( vis ) );
+		}
+
+		/// @brief Select the dispatch strategy by alternative count.  Small
+		/// variants use a single switch, which the optimizer can inline through;
+		/// larger ones use a flat table so dispatch stays O(1)
+		template<typename R, typename Variant, typename Visitor>
+		[[nodiscard]] constexpr R visit_nt_dispatch( Variant &&var,
+		                                             Visitor &&vis ) {
+			if constexpr( get_var_size_v<Variant> <= visit_table_threshold ) {
+				return visit_nt<0, R>( std::forward<Variant>( var ),
+				                       std::forward<Visitor>( vis ) );
+			} else {
+				return visit_nt_table<R>( std::forward<Variant>( var ),
+				                          std::forward<Visitor>( vis ) );
+			}
+		}
+
+		// Multi variant visitation.  The alternatives of all the variants are
+		// flattened row major into one table of size S0 * S1 * ... * Sn
+		template<std::size_t Flat, std::size_t Pos, typename... Variants>
+		constexpr std::size_t multi_alternative_index( ) {
+			constexpr std::size_t sizes[] = { get_var_size_v<Variants>... };
+			std::size_t result = Flat;
+			for( std::size_t n = sizeof...( Variants ) - 1; n > Pos; --n ) {
+				result /= sizes[n];
+			}
+			return result % sizes[Pos];
+		}
+
+		template<std::size_t Flat, typename R, std::size_t... Pos,
+		         typename Visitor, typename... Variants>
+		constexpr R visit_multi_alternative_impl( std::index_sequence<Pos...>,
+		                                          Visitor &&vis,
+		                                          Variants &&... vars ) {
+			return std::forward<Visitor>( vis )(
+			  get_nt<multi_alternative_index<Flat, Pos, Variants...>( )>(
+			    std::forward<Variants>( vars ) )... );
+		}
+
+		template<std::size_t Flat, typename R, typename Visitor,
+		         typename... Variants>
+		constexpr R visit_multi_alternative( Visitor &&vis, Variants &&... vars ) {
+			return visit_multi_alternative_impl<Flat, R>(
+			  std::index_sequence_for<Variants...>{ },
+			  std::forward<Visitor>( vis ), std::forward<Variants>( vars )... );
+		}
+
+		template<typename R, typename Visitor, typename Seq, typename... Variants>
+		struct multi_visit_table;
+
+		template<typename R, typename Visitor, std::size_t... Flats,
+		         typename... Variants>
+		struct multi_visit_table<R, Visitor, std::index_sequence<Flats...>,
+		                         Variants...> {
+			using func_t = R ( * )( Visitor &&, Variants &&... );
+			static constexpr func_t values[] = {
+			  &visit_multi_alternative<Flats, R, Visitor, Variants...>... };
+		};
+
+		template<typename... Variants>
+		inline constexpr std::size_t multi_visit_size_v =
+		  ( get_var_size_v<Variants> * ... * 1U );
+
+		template<typename R, typename Visitor, typename... Variants>
+		[[nodiscard]] constexpr R visit_nt_multi( Visitor &&vis,
+		                                          Variants &&... vars ) {
+			using table_t = multi_visit_table<
+			  R, Visitor, std::make_index_sequence<multi_visit_size_v<Variants...>>,
+			  Variants...>;
+			std::size_t flat_index = 0;
+			( (void)( flat_index =
+			            flat_index * get_var_size_v<Variants> + vars.index( ) ),
+			  ... );
+			return table_t::values[flat_index]( std::forward<Visitor>( vis ),
+			                                    std::forward<Variants>( vars )... );
+		}
 	} // namespace visit_details
 	//**********************************************
 
@@ -235,7 +345,7 @@ namespace daw {
 		  decltype( daw::visit_details::overload( std::forward<Visitors>(
 		    visitors )... )( get_nt<0>( std::forward<Variant>( var ) ) ) );
 
-		return daw::visit_details::visit_nt<0, result_t>(
+		return daw::visit_details::visit_nt_dispatch<result_t>(
 		  std::forward<Variant>( var ),
 		  daw::visit_details::overload( std::forward<Visitors>( visitors )... ) );
 	}
@@ -245,11 +355,39 @@ namespace daw {
 	template<typename Result, typename Variant, typename... Visitors>
 	[[nodiscard, maybe_unused]] constexpr Result
 	visit_nt( Variant &&var, Visitors &&... visitors ) {
-		return daw::visit_details::visit_nt<0, Result>(
+		return daw::visit_details::visit_nt_dispatch<Result>(
 		  std::forward<Variant>( var ),
 		  daw::visit_details::overload( std::forward<Visitors>( visitors )... ) );
 	}
 
+	// Multiple visitation visit.  Calls visitor with the active alternative of
+	// each variant through one flat table, so dispatch is a single indirect
+	// call regardless of the number of combinations.  Expects that all the
+	// variants are valid and not empty.  The result type is that of
+	// visitor( get_nt<0>( variants )... )
+	template<typename Visitor, typename Variant, typename... Variants>
+	[[nodiscard, maybe_unused]] constexpr decltype( auto )
+	visit_nt_multi( Visitor &&visitor, Variant &&var, Variants &&... vars ) {
+		using result_t = decltype( std::forward<Visitor>( visitor )(
+		  get_nt<0>( std::forward<Variant>( var ) ),
+		  get_nt<0>( std::forward<Variants>( vars ) )... ) );
+
+		return daw::visit_details::visit_nt_multi<result_t>(
+		  std::forward<Visitor>( visitor ), std::forward<Variant>( var ),
+		  std::forward<Variants>( vars )... );
+	}
+
+	// Multiple visitation visit with user choosable result.  Expects that all
+	// the variants are valid and not empty
+	template<typename Result, typename Visitor, typename Variant,
+	         typename... Variants>
+	[[nodiscard, maybe_unused]] constexpr Result
+	visit_nt_multi( Visitor &&visitor, Variant &&var, Variants &&... vars ) {
+		return daw::visit_details::visit_nt_multi<Result>(
+		  std::forward<Visitor>( visitor ), std::forward<Variant>( var ),
+		  std::forward<Variants>( vars )... );
+	}
+
 	template<typename Value, typename... Visitors>
 	inline constexpr bool
 	  is_visitable_v = ( std::is_invocable_v<Visitors, Value> or ... );
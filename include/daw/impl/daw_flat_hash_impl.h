@@ -0,0 +1,344 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "../daw_exception.h"
+#include "../daw_is_constant_evaluated.h"
+#include "../daw_likely.h"
+#include "../daw_simd_support.h"
+
+#include <array>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/// Open addressed Robin Hood table shared by bounded_flat_hash_map and
+/// bounded_flat_hash_set.  Slots are kept apart from a one byte tag per slot
+/// so that a probe compares a group of tags at once and only touches the
+/// slots whose tag matches.
+namespace daw::flat_hash_details {
+	/// Tags compared per step.  The tag array has this many extra bytes that
+	/// mirror the first slots so a group never has to wrap
+	inline constexpr std::size_t group_width = 16;
+	inline constexpr std::uint8_t empty_tag = 0;
+
+	/// The power of two slot count for at most N elements.  It keeps the load
+	/// factor at or below 8/9 and is never smaller than a group
+	constexpr std::size_t slot_count_for( std::size_t n ) noexcept {
+		std::size_t const min_slots = n + n / 8U + 1U;
+		std::size_t result = group_width;
+		while( result < min_slots ) {
+			result *= 2U;
+		}
+		return result;
+	}
+
+	constexpr std::size_t log2_pow2( std::size_t n ) noexcept {
+		std::size_t result = 0;
+		while( n > 1U ) {
+			n >>= 1U;
+			++result;
+		}
+		return result;
+	}
+
+	/// Fibonacci hashing spreads weak hashes, like std::hash on integers,
+	/// over the high bits used to pick the home slot
+	constexpr std::size_t mix_hash( std::size_t hash ) noexcept {
+		if constexpr( sizeof( std::size_t ) >= 8 ) {
+			return static_cast<std::size_t>( hash * 0x9E37'79B9'7F4A'7C15ULL );
+		} else {
+			return static_cast<std::size_t>( hash * 0x9E37'79B9UL );
+		}
+	}
+
+	/// The low 7 bits of the mixed hash with the high bit set, so that a used
+	/// slot is never empty_tag
+	constexpr std::uint8_t make_tag( std::size_t mixed ) noexcept {
+		return static_cast<std::uint8_t>( 0x80U | ( mixed & 0x7FU ) );
+	}
+
+	/// Bit i is set when tags[i] == tag, for each of the group_width tags
+	constexpr std::uint32_t match_group( std::uint8_t const *tags,
+	                                     std::uint8_t tag ) noexcept {
+#if defined( DAW_HAS_SSE2 ) and defined( DAW_HAS_IS_CONSTANT_EVALUATED )
+		if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+			return static_cast<std::uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( tags ) ),
+			  _mm_set1_epi8( static_cast<char>( tag ) ) ) ) );
+		}
+#endif
+		std::uint32_t result = 0;
+		for( std::size_t n = 0; n < group_width; ++n ) {
+			if( tags[n] == tag ) {
+				result |= 1U << n;
+			}
+		}
+		return result;
+	}
+
+	constexpr std::size_t count_trailing_zeros( std::uint32_t mask ) noexcept {
+		std::size_t result = 0;
+		while( ( mask & 1U ) == 0 ) {
+			mask >>= 1U;
+			++result;
+		}
+		return result;
+	}
+
+	/// A forward iterator over the used slots
+	template<typename Slot, bool IsConst>
+	struct flat_hash_iterator {
+		using difference_type = std::ptrdiff_t;
+		using value_type = Slot;
+		using pointer = std::conditional_t<IsConst, Slot const *, Slot *>;
+		using const_pointer = Slot const *;
+		using reference = std::conditional_t<IsConst, Slot const &, Slot &>;
+		using const_reference = Slot const &;
+		using iterator_category = std::forward_iterator_tag;
+
+	private:
+		std::uint8_t const *m_tags = nullptr;
+		pointer m_slots = nullptr;
+		std::size_t m_index = 0;
+		std::size_t m_slot_count = 0;
+
+		constexpr void skip_empty( ) noexcept {
+			while( m_index < m_slot_count and m_tags[m_index] == empty_tag ) {
+				++m_index;
+			}
+		}
+
+		friend struct flat_hash_iterator<Slot, not IsConst>;
+
+	public:
+		constexpr flat_hash_iterator( ) noexcept = default;
+
+		constexpr flat_hash_iterator( std::uint8_t const *tags, pointer slots,
+		                              std::size_t index,
+		                              std::size_t slot_count ) noexcept
+		  : m_tags( tags )
+		  , m_slots( slots )
+		  , m_index( index )
+		  , m_slot_count( slot_count ) {
+			skip_empty( );
+		}
+
+		template<bool B = IsConst, std::enable_if_t<B, std::nullptr_t> = nullptr>
+		constexpr flat_hash_iterator(
+		  flat_hash_iterator<Slot, false> const &other ) noexcept
+		  : m_tags( other.m_tags )
+		  , m_slots( other.m_slots )
+		  , m_index( other.m_index )
+		  , m_slot_count( other.m_slot_count ) {}
+
+		constexpr reference operator*( ) const noexcept {
+			return m_slots[m_index];
+		}
+
+		constexpr pointer operator->( ) const noexcept {
+			return m_slots + m_index;
+		}
+
+		constexpr flat_hash_iterator &operator++( ) noexcept {
+			++m_index;
+			skip_empty( );
+			return *this;
+		}
+
+		constexpr flat_hash_iterator operator++( int ) noexcept {
+			auto result = *this;
+			operator++( );
+			return result;
+		}
+
+		template<bool B>
+		constexpr bool
+		operator==( flat_hash_iterator<Slot, B> const &rhs ) const noexcept {
+			return m_index == rhs.m_index;
+		}
+
+		template<bool B>
+		constexpr bool
+		operator!=( flat_hash_iterator<Slot, B> const &rhs ) const noexcept {
+			return m_index != rhs.m_index;
+		}
+	};
+
+	/// Holds at most N elements of Slot.  KeyOf::get( slot ) returns the key
+	/// of a slot.  Probes are bounded by the longest displacement seen, which
+	/// Robin Hood insertion keeps short; erase shifts the following run back
+	/// so no tombstones are needed.
+	template<typename Slot, std::size_t N, typename KeyOf, typename Hash,
+	         typename KeyEqual>
+	struct robin_hood_table {
+		static constexpr std::size_t slot_count = slot_count_for( N );
+		static constexpr std::size_t npos = slot_count;
+
+		using dist_t = std::conditional_t<( slot_count <= 0xFFFFU ),
+		                                  std::uint16_t, std::uint32_t>;
+		using iterator = flat_hash_iterator<Slot, false>;
+		using const_iterator = flat_hash_iterator<Slot, true>;
+
+	private:
+		static constexpr std::size_t index_shift =
+		  sizeof( std::size_t ) * 8U - log2_pow2( slot_count );
+
+		std::array<std::uint8_t, slot_count + group_width> m_tags{ };
+		std::array<dist_t, slot_count> m_dist{ };
+		std::array<Slot, slot_count> m_slots{ };
+		std::size_t m_size = 0;
+		std::size_t m_max_probe = 0;
+
+		static constexpr std::size_t next( std::size_t index ) noexcept {
+			return ( index + 1U ) & ( slot_count - 1U );
+		}
+
+		constexpr void set_tag( std::size_t index, std::uint8_t tag ) noexcept {
+			m_tags[index] = tag;
+			if( index < group_width ) {
+				m_tags[slot_count + index] = tag;
+			}
+		}
+
+		static constexpr void swap_slots( Slot &lhs, Slot &rhs ) {
+			Slot tmp = std::move( lhs );
+			lhs = std::move( rhs );
+			rhs = std::move( tmp );
+		}
+
+	public:
+		template<typename K>
+		constexpr std::size_t find_index( K const &key ) const {
+			std::size_t const mixed = mix_hash( Hash{ }( key ) );
+			std::uint8_t const tag = make_tag( mixed );
+			std::size_t const home = mixed >> index_shift;
+			// Robin Hood keeps every element within m_max_probe of its home
+			for( std::size_t probe = 0; probe <= m_max_probe;
+			     probe += group_width ) {
+				std::size_t const pos = ( home + probe ) & ( slot_count - 1U );
+				std::uint32_t matches = match_group( m_tags.data( ) + pos, tag );
+				std::size_t const remaining = m_max_probe - probe + 1U;
+				if( remaining < group_width ) {
+					matches &= ( 1U << remaining ) - 1U;
+				}
+				while( matches != 0 ) {
+					std::size_t const index =
+					  ( pos + count_trailing_zeros( matches ) ) & ( slot_count - 1U );
+					if( DAW_LIKELY( KeyEqual{ }( KeyOf::get( m_slots[index] ), key ) ) ) {
+						return index;
+					}
+					matches &= matches - 1U;
+				}
+			}
+			return npos;
+		}
+
+		/// Insert slot if its key is not present.  Returns the index of the
+		/// element with that key and whether it was inserted
+		constexpr std::pair<std::size_t, bool> insert( Slot &&slot ) {
+			if( auto const found = find_index( KeyOf::get( slot ) );
+			    found != npos ) {
+				return { found, false };
+			}
+			daw::exception::precondition_check( m_size < N,
+			                                    "bounded hash table is full" );
+			std::size_t const mixed = mix_hash( Hash{ }( KeyOf::get( slot ) ) );
+			std::uint8_t tag = make_tag( mixed );
+			std::size_t index = mixed >> index_shift;
+			std::size_t dist = 0;
+			std::size_t result = npos;
+			while( m_tags[index] != empty_tag ) {
+				// Take the slot from an element that is closer to its home
+				if( m_dist[index] < dist ) {
+					if( result == npos ) {
+						result = index;
+					}
+					if( dist > m_max_probe ) {
+						m_max_probe = dist;
+					}
+					swap_slots( m_slots[index], slot );
+					std::uint8_t const old_tag = m_tags[index];
+					set_tag( index, tag );
+					tag = old_tag;
+					auto const old_dist = static_cast<std::size_t>( m_dist[index] );
+					m_dist[index] = static_cast<dist_t>( dist );
+					dist = old_dist;
+				}
+				index = next( index );
+				++dist;
+			}
+			if( result == npos ) {
+				result = index;
+			}
+			if( dist > m_max_probe ) {
+				m_max_probe = dist;
+			}
+			m_slots[index] = std::move( slot );
+			set_tag( index, tag );
+			m_dist[index] = static_cast<dist_t>( dist );
+			++m_size;
+			return { result, true };
+		}
+
+		/// Remove the element at index and shift the rest of its run back
+		constexpr void erase_index( std::size_t index ) {
+			std::size_t following = next( index );
+			while( m_tags[following] != empty_tag and m_dist[following] != 0 ) {
+				m_slots[index] = std::move( m_slots[following] );
+				set_tag( index, m_tags[following] );
+				m_dist[index] = static_cast<dist_t>( m_dist[following] - 1U );
+				index = following;
+				following = next( following );
+			}
+			m_slots[index] = Slot{ };
+			set_tag( index, empty_tag );
+			m_dist[index] = 0;
+			--m_size;
+		}
+
+		template<typename K>
+		constexpr bool erase( K const &key ) {
+			auto const index = find_index( key );
+			if( index == npos ) {
+				return false;
+			}
+			erase_index( index );
+			return true;
+		}
+
+		constexpr Slot &slot( std::size_t index ) noexcept {
+			return m_slots[index];
+		}
+
+		constexpr Slot const &slot( std::size_t index ) const noexcept {
+			return m_slots[index];
+		}
+
+		constexpr std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		/// The longest distance any element has been placed from its home
+		constexpr std::size_t max_probe_length( ) const noexcept {
+			return m_max_probe;
+		}
+
+		constexpr iterator make_iterator( std::size_t index ) noexcept {
+			return { m_tags.data( ), m_slots.data( ), index, slot_count };
+		}
+
+		constexpr const_iterator make_iterator( std::size_t index ) const noexcept {
+			return { m_tags.data( ), m_slots.data( ), index, slot_count };
+		}
+	};
+} // namespace daw::flat_hash_details
@@ -14,15 +14,19 @@
 
 #include <atomic>
 #include <ciso646>
+#include <cstddef>
 #include <cstdint>
-#include <mutex>
+#include <thread>
+#include <type_traits>
 
 namespace daw {
 	template<typename T>
 	class observable_ptr;
 
 	namespace impl {
-		template<typename T, typename Lockable>
+		/// Holds a borrow of Lockable and releases it with unlock_shared when
+		/// Shared, otherwise with unlock
+		template<typename T, typename Lockable, bool Shared = false>
 		class locked_ptr {
 			T *m_ptr = nullptr;
 			Lockable *m_lockable = nullptr;
@@ -45,7 +49,7 @@ namespace daw {
 				if( this != &rhs ) {
 					reset( );
 					m_ptr = daw::exchange( rhs.m_ptr, nullptr );
-					m_lockable = daw::exchange( rhs.m_ptr, nullptr );
+					m_lockable = daw::exchange( rhs.m_lockable, nullptr );
 				}
 				return *this;
 			}
@@ -53,7 +57,11 @@ namespace daw {
 			constexpr void reset( ) noexcept {
 				m_ptr = nullptr;
 				if( auto tmp = daw::exchange( m_lockable, nullptr ); tmp ) {
-					tmp->unlock( );
+					if constexpr( Shared ) {
+						tmp->unlock_shared( );
+					} else {
+						tmp->unlock( );
+					}
 				}
 			}
 
@@ -84,39 +92,110 @@ namespace daw {
 
 		template<typename T>
 		class control_block_t {
-			using observer_count_t = int16_t;
+			using state_t = std::uint64_t;
+			using ref_count_t = std::size_t;
+
+			// m_state holds the number of active borrows in the low bits and three
+			// flags above them.  A shared borrow is a single fetch_add, so readers
+			// never wait on each other.  An exclusive borrow sets the exclusive flag,
+			// counts as one borrow and waits for the shared borrows to drain
+			static constexpr state_t destruct_pending = state_t{ 1 } << 63U;
+			static constexpr state_t destroyed = state_t{ 1 } << 62U;
+			static constexpr state_t exclusive = state_t{ 1 } << 61U;
+			static constexpr state_t borrow_mask = exclusive - 1U;
 
 			// Pointer we are guarding
-			T *m_ptr;
+			mutable std::atomic<T *> m_ptr;
 
-			// The owner has gone out of scope, as soon as there are no borrows, run
-			// values destructor
-			std::atomic_bool m_ptr_destruct = false;
+			mutable std::atomic<state_t> m_state = 0;
 
-			// This controls access to deleting the control block
-			std::once_flag m_cb_destruct{ };
+			// The owner and each observer hold one reference, the control block is
+			// deleted when the last is released
+			std::atomic<ref_count_t> m_ref_count = 1;
 
-			// Pointer has been borrowed
-			mutable std::mutex m_is_borrowed{ };
+			explicit control_block_t( T *ptr )
+			  : m_ptr( ptr ) {}
 
-			// Number of observers alive, cannot delete control block unless this is 0
-			std::atomic<observer_count_t> m_observer_count = 0;
+			friend class observable_ptr<T>;
 
-			void destruct_if_should( std::lock_guard<std::mutex> const & ) {
-				if( m_ptr_destruct.load( ) ) {
-					delete daw::exchange( m_ptr, nullptr );
+			// Run once the owner is gone and the borrow count has reached zero.  The
+			// CAS ensures only one thread destroys the value, even when a failed
+			// borrow races with the last release
+			void destroy_if_released( ) const {
+				state_t expected = destruct_pending;
+				if( m_state.compare_exchange_strong( expected,
+				                                     destruct_pending | destroyed,
+				                                     std::memory_order_acq_rel ) ) {
+					delete m_ptr.exchange( nullptr, std::memory_order_acq_rel );
 				}
 			}
 
-			void destruct_if_should( ) {
-				std::lock_guard<std::mutex> lck( m_is_borrowed );
-				destruct_if_should( lck );
+			static void release_ref( control_block_t *cb ) {
+				if( cb->m_ref_count.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+					delete cb;
+				}
 			}
 
-			constexpr control_block_t( T *ptr )
-			  : m_ptr( ptr ) {}
+			// A shared borrow that finds an exclusive one backs off and, when Wait,
+			// retries once it is released
+			template<bool Wait>
+			bool try_add_borrow( ) const {
+				while( true ) {
+					state_t const prev =
+					  m_state.fetch_add( 1, std::memory_order_acquire );
+					if( prev & destruct_pending ) {
+						unlock_shared( );
+						return false;
+					}
+					if( not( prev & exclusive ) ) {
+						return true;
+					}
+					unlock_shared( );
+					if constexpr( not Wait ) {
+						return false;
+					}
+					while( ( m_state.load( std::memory_order_relaxed ) &
+					         ( exclusive | destruct_pending ) ) == exclusive ) {
+						std::this_thread::yield( );
+					}
+				}
+			}
 
-			friend class observable_ptr<T>;
+			// Set the exclusive flag and take a borrow in one step, then wait for
+			// the shared borrows still held to be released.  Without Wait this fails
+			// rather than waiting for any other borrow
+			template<bool Wait>
+			bool try_add_exclusive( ) const {
+				state_t current = m_state.load( std::memory_order_relaxed );
+				while( true ) {
+					if( current & destruct_pending ) {
+						return false;
+					}
+					if( current & exclusive ) {
+						if constexpr( not Wait ) {
+							return false;
+						}
+						std::this_thread::yield( );
+						current = m_state.load( std::memory_order_relaxed );
+						continue;
+					}
+					if constexpr( not Wait ) {
+						if( ( current & borrow_mask ) != 0 ) {
+							return false;
+						}
+					}
+					if( m_state.compare_exchange_weak(
+					      current, ( current + 1U ) | exclusive,
+					      std::memory_order_acquire, std::memory_order_relaxed ) ) {
+						break;
+					}
+				}
+				while( ( m_state.load( std::memory_order_acquire ) & borrow_mask ) !=
+				       1U ) {
+					std::this_thread::yield( );
+				}
+				return true;
+			}
 
 		public:
 			control_block_t( control_block_t const & ) = delete;
@@ -124,93 +203,108 @@ namespace daw {
 			control_block_t &operator=( control_block_t const & ) = delete;
 			control_block_t &operator=( control_block_t && ) noexcept = delete;
 
-			// Should never get to this point without point without owner/observer
-			// cleaning up ptr
-			//~control_block_t( ) noexcept = default;
-
 			bool expired( ) const noexcept {
-				return m_ptr_destruct;
+				return ( m_state.load( std::memory_order_acquire ) &
+				         destruct_pending ) != 0;
 			}
 
-			locked_ptr<T, std::mutex> try_borrow( ) const {
-				if( not m_is_borrowed.try_lock( ) ) {
-					return locked_ptr<T, std::mutex>( );
-				}
-				return locked_ptr<T, std::mutex>( m_ptr, m_is_borrowed );
+			/// Number of borrows currently held
+			std::size_t borrow_count( ) const noexcept {
+				return static_cast<std::size_t>(
+				  m_state.load( std::memory_order_relaxed ) & borrow_mask );
 			}
 
-			locked_ptr<T, std::mutex> borrow( ) const {
-				m_is_borrowed.lock( );
-				return locked_ptr<T, std::mutex>( m_ptr, m_is_borrowed );
+			/// Release a shared borrow, the last one out after the owner destroys
+			/// the value
+			void unlock_shared( ) const {
+				if( m_state.fetch_sub( 1, std::memory_order_acq_rel ) ==
+				    ( destruct_pending | 1U ) ) {
+					destroy_if_released( );
+				}
 			}
 
-			locked_ptr<T, std::mutex> borrow( ) {
-				m_is_borrowed.lock( );
-				return locked_ptr<T, std::mutex>( m_ptr, m_is_borrowed );
+			/// Release an exclusive borrow
+			void unlock( ) const {
+				if( m_state.fetch_sub( exclusive | 1U, std::memory_order_acq_rel ) ==
+				    ( destruct_pending | exclusive | 1U ) ) {
+					destroy_if_released( );
+				}
 			}
 
-			constexpr T *get( ) const noexcept {
-				return m_ptr;
+			/// Shared borrows are lock free and only give const access, they keep
+			/// the value alive and wait for an exclusive borrow.  Empty once the
+			/// owner has gone, or for try_borrow while exclusively borrowed
+			locked_ptr<T const, control_block_t const, true> try_borrow( ) const {
+				return make_borrow<T const, true>( try_add_borrow<false>( ) );
 			}
 
-			bool add_observer( ) {
-				if( m_ptr_destruct.load( ) ) {
-					return false;
-				}
-				++m_observer_count;
-				return true;
+			locked_ptr<T const, control_block_t const, true> borrow( ) const {
+				return make_borrow<T const, true>( try_add_borrow<true>( ) );
 			}
 
-		private:
-			bool remove_observer( std::lock_guard<std::mutex> &lck ) {
-				--m_observer_count;
-				destruct_if_should( lck );
-				return m_observer_count <= 0;
+			/// An exclusive borrow gives mutable access, no other borrow is held
+			/// at the same time.  Empty once the owner has gone, or for
+			/// try_borrow_exclusive while any other borrow is held
+			locked_ptr<T, control_block_t const> try_borrow_exclusive( ) const {
+				return make_borrow<T, false>( try_add_exclusive<false>( ) );
 			}
 
-			bool remove_observer( std::lock_guard<std::mutex> &&lck ) {
-				return remove_observer( lck );
+			locked_ptr<T, control_block_t const> borrow_exclusive( ) const {
+				return make_borrow<T, false>( try_add_exclusive<true>( ) );
 			}
 
-			bool remove_owner( std::lock_guard<std::mutex> &lck ) {
-				m_ptr_destruct = true;
-				destruct_if_should( lck );
-				return m_observer_count <= 0;
+			T *get( ) const noexcept {
+				return m_ptr.load( std::memory_order_acquire );
 			}
 
-			bool remove_owner( std::lock_guard<std::mutex> &&lck ) {
-				return remove_owner( lck );
-			}
-
-			static void destruct_cb( control_block_t *cb ) {
-				if( not cb ) {
-					return;
-				}
-				bool do_destruct = false;
-				std::call_once( cb->m_cb_destruct,
-				                [&do_destruct]( ) { do_destruct = true; } );
-				if( do_destruct ) {
-					delete cb;
+		private:
+			template<typename U, bool Shared>
+			locked_ptr<U, control_block_t const, Shared>
+			make_borrow( bool borrowed ) const {
+				if( not borrowed ) {
+					return locked_ptr<U, control_block_t const, Shared>( );
 				}
+				return locked_ptr<U, control_block_t const, Shared>(
+				  m_ptr.load( std::memory_order_acquire ), *this );
 			}
 
 		public:
-			static void remove_observer( control_block_t *cb ) {
-				if( cb and cb->remove_observer(
-				             std::lock_guard<std::mutex>( cb->m_is_borrowed ) ) ) {
+			bool add_observer( ) {
+				m_ref_count.fetch_add( 1, std::memory_order_relaxed );
+				return not expired( );
+			}
 
-					destruct_cb( cb );
+			static void remove_observer( control_block_t *cb ) {
+				if( cb ) {
+					release_ref( cb );
 				}
 			}
 
 			static void remove_owner( control_block_t *cb ) {
-				if( cb and cb->remove_owner(
-				             std::lock_guard<std::mutex>( cb->m_is_borrowed ) ) ) {
-
-					destruct_cb( cb );
+				if( not cb ) {
+					return;
 				}
+				state_t const prev =
+				  cb->m_state.fetch_or( destruct_pending, std::memory_order_acq_rel );
+				if( ( prev & borrow_mask ) == 0 ) {
+					cb->destroy_if_released( );
+				}
+				release_ref( cb );
 			}
 		};
+
+		template<typename T>
+		using borrowed_ptr_t = locked_ptr<T const, control_block_t<T> const, true>;
+
+		template<typename T>
+		using exclusive_ptr_t = locked_ptr<T, control_block_t<T> const>;
+
+		/// lock( c ) on a non-const pointer takes an exclusive borrow only when c
+		/// needs a mutable T
+		template<typename T, typename Callable>
+		inline constexpr bool needs_exclusive_v =
+		  std::is_invocable_v<Callable, T &> and
+		  not traits::is_callable_v<Callable, T const &>;
 	} // namespace impl
 
 	template<typename T>
@@ -228,31 +322,31 @@ namespace daw {
 		/// @param cb Control block for observable pointer.  Must never be null,
 		/// will abort if so
 		observer_ptr( impl::control_block_t<T> *cb )
-		  : m_control_block( cb ) {}
+		  : m_control_block( cb ) {
+			if( m_control_block ) {
+				m_control_block->add_observer( );
+			}
+		}
 
 		void reset( ) {
-			auto tmp = daw::exchange( m_control_block, nullptr );
-			if( tmp ) {
-				try {
-					impl::control_block_t<T>::remove_observer( tmp );
-				} catch( ... ) {}
-			}
+			impl::control_block_t<T>::remove_observer(
+			  daw::exchange( m_control_block, nullptr ) );
 		}
 
 		~observer_ptr( ) {
 			reset( );
 		}
 
-		constexpr observer_ptr( observer_ptr const &other )
-		  : m_control_block( other.m_control_block ) {
-
-			m_control_block->add_observer( );
-		}
+		observer_ptr( observer_ptr const &other )
+		  : observer_ptr( other.m_control_block ) {}
 
 		observer_ptr &operator=( observer_ptr const &rhs ) {
 			if( this != &rhs ) {
+				reset( );
 				m_control_block = rhs.m_control_block;
-				m_control_block->add_observer( );
+				if( m_control_block ) {
+					m_control_block->add_observer( );
+				}
 			}
 			return *this;
 		}
@@ -260,34 +354,50 @@ namespace daw {
 		constexpr observer_ptr( observer_ptr &&other ) noexcept
 		  : m_control_block( daw::exchange( other.m_control_block, nullptr ) ) {}
 
-		constexpr observer_ptr &operator=( observer_ptr &&rhs ) noexcept {
+		observer_ptr &operator=( observer_ptr &&rhs ) noexcept {
 			if( this != &rhs ) {
+				reset( );
 				m_control_block = daw::exchange( rhs.m_control_block, nullptr );
 			}
 			return *this;
 		}
 
-		constexpr T *get( ) const noexcept {
+		T *get( ) const noexcept {
 			if( not m_control_block ) {
 				return nullptr;
 			}
 			return m_control_block->get( );
 		}
 
-		impl::locked_ptr<T, std::mutex> try_borrow( ) const {
+		impl::borrowed_ptr_t<T> try_borrow( ) const {
 			if( not m_control_block ) {
-				return impl::locked_ptr<T, std::mutex>( );
+				return impl::borrowed_ptr_t<T>( );
 			}
 			return m_control_block->try_borrow( );
 		}
 
-		impl::locked_ptr<T, std::mutex> borrow( ) const {
+		impl::borrowed_ptr_t<T> borrow( ) const {
 			if( not m_control_block ) {
-				return impl::locked_ptr<T, std::mutex>( );
+				return impl::borrowed_ptr_t<T>( );
 			}
 			return m_control_block->borrow( );
 		}
 
+		impl::exclusive_ptr_t<T> try_borrow_exclusive( ) {
+			if( not m_control_block ) {
+				return impl::exclusive_ptr_t<T>( );
+			}
+			return m_control_block->try_borrow_exclusive( );
+		}
+
+		impl::exclusive_ptr_t<T> borrow_exclusive( ) {
+			if( not m_control_block ) {
+				return impl::exclusive_ptr_t<T>( );
+			}
+			return m_control_block->borrow_exclusive( );
+		}
+
+		/// Call c with a shared borrow of the value
 		template<typename Callable,
 		         std::enable_if_t<traits::is_callable_v<Callable, T const &>,
 		                          std::nullptr_t> = nullptr>
@@ -304,13 +414,14 @@ namespace daw {
 			                                             *lck_ptr );
 		}
 
+		/// Call c with an exclusive borrow when it needs a mutable value
 		template<typename Callable,
-		         std::enable_if_t<std::is_invocable_v<Callable, T &>,
+		         std::enable_if_t<impl::needs_exclusive_v<T, Callable>,
 		                          std::nullptr_t> = nullptr>
 		auto
 		lock( Callable &&c ) noexcept( noexcept( c( std::declval<T &>( ) ) ) ) {
 
-			auto lck_ptr = borrow( );
+			auto lck_ptr = borrow_exclusive( );
 			using result_t = daw::remove_cvref_t<decltype( c( *lck_ptr ) )>;
 
 			if( not lck_ptr ) {
@@ -329,11 +440,6 @@ namespace daw {
 			return r;
 		}
 
-		T &operator*( ) {
-			T &r = *borrow( );
-			return r;
-		}
-
 		explicit operator bool( ) const {
 			return m_control_block != nullptr and not m_control_block->expired( );
 		}
@@ -344,7 +450,9 @@ namespace daw {
 	};
 
 	/// @brief A pointer wrapper that allows others to temporarily postpone
-	/// destruction while in a locked scope
+	/// destruction while in a locked scope.  Shared borrows are counted
+	/// atomically, so any number of threads can read at once without taking a
+	/// lock.  Mutable access goes through an exclusive borrow
 	/// @tparam T Type to construct/hold
 	template<typename T>
 	class observable_ptr {
@@ -359,18 +467,21 @@ namespace daw {
 
 		observable_ptr &operator=( observable_ptr &&rhs ) noexcept {
 			if( this != &rhs ) {
+				reset( );
 				m_control_block = daw::exchange( rhs.m_control_block, nullptr );
 			}
 			return *this;
 		}
 
+		/// @brief Give up ownership.  The value is destroyed now, or by the last
+		/// outstanding borrow when it is released
+		void reset( ) noexcept {
+			impl::control_block_t<T>::remove_owner(
+			  daw::exchange( m_control_block, nullptr ) );
+		}
+
 		~observable_ptr( ) noexcept {
-			auto tmp = daw::exchange( m_control_block, nullptr );
-			try {
-				if( tmp ) {
-					impl::control_block_t<T>::remove_owner( tmp );
-				}
-			} catch( ... ) {}
+			reset( );
 		}
 
 		/// @brief Take ownership of pointer and construct shared_ptr with it
@@ -388,7 +499,7 @@ namespace daw {
 			return observer_ptr<T>( m_control_block );
 		}
 
-		constexpr T *get( ) const noexcept {
+		T *get( ) const noexcept {
 			if( not m_control_block ) {
 				return nullptr;
 			}
@@ -399,21 +510,38 @@ namespace daw {
 			return borrow( );
 		}
 
-		impl::locked_ptr<T, std::mutex> try_borrow( ) const {
+		impl::borrowed_ptr_t<T> try_borrow( ) const {
 			if( not m_control_block ) {
-				return impl::locked_ptr<T, std::mutex>( );
+				return impl::borrowed_ptr_t<T>( );
 			}
 			return m_control_block->try_borrow( );
 		}
 
-		impl::locked_ptr<T, std::mutex> borrow( ) const {
+		impl::borrowed_ptr_t<T> borrow( ) const {
 			if( not m_control_block ) {
-				return impl::locked_ptr<T, std::mutex>( );
+				return impl::borrowed_ptr_t<T>( );
 			}
 			return m_control_block->borrow( );
 		}
 
-		template<typename Callable>
+		impl::exclusive_ptr_t<T> try_borrow_exclusive( ) {
+			if( not m_control_block ) {
+				return impl::exclusive_ptr_t<T>( );
+			}
+			return m_control_block->try_borrow_exclusive( );
+		}
+
+		impl::exclusive_ptr_t<T> borrow_exclusive( ) {
+			if( not m_control_block ) {
+				return impl::exclusive_ptr_t<T>( );
+			}
+			return m_control_block->borrow_exclusive( );
+		}
+
+		/// Call c with a shared borrow of the value
+		template<typename Callable,
+		         std::enable_if_t<traits::is_callable_v<Callable, T const &>,
+		                          std::nullptr_t> = nullptr>
 		decltype( auto ) lock( Callable &&c ) const {
 			using result_t =
 			  daw::remove_cvref_t<decltype( c( std::declval<T const &>( ) ) )>;
@@ -426,11 +554,14 @@ namespace daw {
 			                                             r );
 		}
 
-		template<typename Callable>
+		/// Call c with an exclusive borrow when it needs a mutable value
+		template<typename Callable,
+		         std::enable_if_t<impl::needs_exclusive_v<T, Callable>,
+		                          std::nullptr_t> = nullptr>
 		decltype( auto ) lock( Callable &&c ) {
 			using result_t = daw::remove_cvref_t<decltype(
 			  std::declval<Callable>( )( std::declval<T &>( ) ) )>;
-			auto lck_ptr = borrow( );
+			auto lck_ptr = borrow_exclusive( );
 			if( not lck_ptr ) {
 				return daw::expected_t<result_t>{ };
 			}
@@ -444,11 +575,6 @@ namespace daw {
 			return r;
 		}
 
-		T &operator*( ) {
-			T &r = *borrow( );
-			return r;
-		}
-
 		explicit operator bool( ) const {
 			return m_control_block != nullptr and not m_control_block->expired( );
 		}
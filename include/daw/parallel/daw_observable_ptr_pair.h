@@ -78,7 +78,7 @@ namespace daw {
 		template<typename Visitor>
 		decltype( auto ) visit( Visitor vis ) {
 			return daw::visit_nt( m_ptrs, [&]( auto &p ) -> decltype( auto ) {
-				return vis( *p.borrow( ) );
+				return vis( *p.borrow_exclusive( ) );
 			} );
 		}
 
@@ -125,6 +125,16 @@ namespace daw {
 			  []( auto const &obs_ptr ) { return obs_ptr.try_borrow( ); } );
 		}
 
+		decltype( auto ) borrow_exclusive( ) {
+			return apply_visitor(
+			  []( auto &obs_ptr ) { return obs_ptr.borrow_exclusive( ); } );
+		}
+
+		decltype( auto ) try_borrow_exclusive( ) {
+			return apply_visitor(
+			  []( auto &obs_ptr ) { return obs_ptr.try_borrow_exclusive( ); } );
+		}
+
 		decltype( auto ) get( ) const {
 			return apply_visitor(
 			  []( auto const &obs_ptr ) { return obs_ptr.get( ); } );
@@ -136,6 +146,12 @@ namespace daw {
 				return obs_ptr.lock( daw::move( c ) );
 			} );
 		}
+
+		template<typename Callable>
+		decltype( auto ) lock( Callable c ) {
+			return apply_visitor(
+			  [&c]( auto &obs_ptr ) { return obs_ptr.lock( daw::move( c ) ); } );
+		}
 	};
 
 	template<typename T, typename... Args>
@@ -0,0 +1,504 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "../cpp_17.h"
+#include "../daw_algorithm.h"
+#include "../daw_move.h"
+#include "../daw_sort_n.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ciso646>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace daw::algorithm::parallel {
+	/// Ranges at or below this size are selected on the calling thread
+	inline constexpr std::ptrdiff_t parallel_select_limit = 1 << 16;
+
+	/// Ranges at or below this size are sorted on the calling thread
+	inline constexpr std::ptrdiff_t parallel_sort_limit = 1 << 16;
+
+	/// Indices of an index space handed to a thread at a time
+	inline constexpr std::size_t parallel_index_grain = 1 << 12;
+
+	/// @brief A stop flag shared by the caller and the worker threads of an
+	/// enumeration.  Workers check it between chunks
+	class cancellation_token {
+		std::atomic<bool> m_stop = false;
+
+	public:
+		cancellation_token( ) = default;
+
+		void request_stop( ) noexcept {
+			m_stop.store( true, std::memory_order_relaxed );
+		}
+
+		[[nodiscard]] bool stop_requested( ) const noexcept {
+			return m_stop.load( std::memory_order_relaxed );
+		}
+	};
+
+	namespace parallel_impl {
+		inline std::size_t thread_count( ) noexcept {
+			auto const result = std::thread::hardware_concurrency( );
+			return result == 0 ? 1U : static_cast<std::size_t>( result );
+		}
+
+		/// Split [0, size) into chunk_count contiguous chunks.  The split only
+		/// depends on size and chunk_count
+		constexpr std::ptrdiff_t chunk_start( std::ptrdiff_t size,
+		                                      std::size_t chunk_count,
+		                                      std::size_t chunk ) noexcept {
+			return static_cast<std::ptrdiff_t>(
+			  ( static_cast<std::size_t>( size ) * chunk ) / chunk_count );
+		}
+
+		/// Call func( chunk, chunk_first, chunk_last ) for every chunk, one
+		/// thread per chunk with chunk 0 run on the calling thread.  The first
+		/// exception thrown, by chunk order, is rethrown after all have joined
+		template<typename Func>
+		void for_each_chunk( std::ptrdiff_t size, std::size_t chunk_count,
+		                     Func &func ) {
+			std::vector<std::exception_ptr> errors( chunk_count );
+			auto const run = [&]( std::size_t chunk ) {
+				try {
+					func( chunk, chunk_start( size, chunk_count, chunk ),
+					      chunk_start( size, chunk_count, chunk + 1 ) );
+				} catch( ... ) { errors[chunk] = std::current_exception( ); }
+			};
+			std::vector<std::thread> threads{ };
+			threads.reserve( chunk_count - 1 );
+			for( std::size_t chunk = 1; chunk < chunk_count; ++chunk ) {
+				threads.emplace_back( run, chunk );
+			}
+			run( 0 );
+			for( auto &th : threads ) {
+				th.join( );
+			}
+			for( auto const &err : errors ) {
+				if( err ) {
+					std::rethrow_exception( err );
+				}
+			}
+		}
+
+		/// Run blocks over the hardware threads, each thread takes a
+		/// contiguous run of blocks
+		struct threaded_block_executor {
+			template<typename Func>
+			static void run( std::size_t block_count, Func &func ) {
+				run_chunked( block_count, func, thread_count( ) );
+			}
+
+			template<typename Func>
+			static void run_chunked( std::size_t block_count, Func &func,
+			                         std::size_t chunk_count ) {
+				chunk_count = std::min( chunk_count, block_count );
+				if( chunk_count <= 1 ) {
+					for( std::size_t block = 0; block < block_count; ++block ) {
+						func( block );
+					}
+					return;
+				}
+				auto run_chunk = [&]( std::size_t, std::ptrdiff_t cf,
+				                      std::ptrdiff_t cl ) {
+					for( ; cf < cl; ++cf ) {
+						func( static_cast<std::size_t>( cf ) );
+					}
+				};
+				for_each_chunk( static_cast<std::ptrdiff_t>( block_count ),
+				                chunk_count, run_chunk );
+			}
+		};
+
+		template<typename T>
+		inline constexpr bool is_parallel_selectable_v =
+		  std::is_default_constructible_v<T> and
+		  std::is_copy_constructible_v<T> and std::is_move_assignable_v<T>;
+
+		template<typename RandomIterator, typename Compare>
+		void select_chunked( RandomIterator first, RandomIterator nth,
+		                     RandomIterator last, Compare &comp,
+		                     std::size_t chunk_count ) {
+			using value_type =
+			  typename std::iterator_traits<RandomIterator>::value_type;
+			std::ptrdiff_t const size = last - first;
+			std::ptrdiff_t const k = nth - first;
+
+			// Evenly strided sample, sorted, with the splitters placed about four
+			// standard deviations of sample rank either side of nth
+			std::ptrdiff_t const sample_size = std::min(
+			  size,
+			  static_cast<std::ptrdiff_t>(
+			    4 * algorithm_details::select_isqrt(
+			          static_cast<std::uint64_t>( size ) ) ) );
+			std::vector<value_type> sample{ };
+			sample.reserve( static_cast<std::size_t>( sample_size ) );
+			for( std::ptrdiff_t n = 0; n < sample_size; ++n ) {
+				sample.push_back( first[n * size / sample_size] );
+			}
+			std::sort( sample.begin( ), sample.end( ), comp );
+			std::ptrdiff_t const rank = k * sample_size / size;
+			auto const margin = static_cast<std::ptrdiff_t>(
+			  2 * algorithm_details::select_isqrt(
+			        static_cast<std::uint64_t>( sample_size ) ) );
+			value_type const &lo = sample[static_cast<std::size_t>(
+			  rank > margin ? rank - margin : 0 )];
+			value_type const &hi = sample[static_cast<std::size_t>(
+			  std::min( rank + margin, sample_size - 1 ) )];
+
+			// Three way partition of each chunk: below lo, between, above hi
+			std::vector<std::ptrdiff_t> counts( chunk_count * 3 );
+			auto partition_chunk = [&]( std::size_t chunk, std::ptrdiff_t cf,
+			                            std::ptrdiff_t cl ) {
+				auto const b = first + cf;
+				auto const e = first + cl;
+				auto const m1 = std::partition(
+				  b, e, [&]( auto const &v ) { return comp( v, lo ); } );
+				auto const m2 = std::partition(
+				  m1, e, [&]( auto const &v ) { return not comp( hi, v ); } );
+				counts[chunk * 3] = m1 - b;
+				counts[chunk * 3 + 1] = m2 - m1;
+				counts[chunk * 3 + 2] = e - m2;
+			};
+			parallel_impl::for_each_chunk( size, chunk_count, partition_chunk );
+
+			// Output offset of each chunk's band in the gathered range
+			std::vector<std::ptrdiff_t> offsets( chunk_count * 3 );
+			std::ptrdiff_t pos = 0;
+			std::ptrdiff_t band_start[3] = { };
+			for( std::size_t band = 0; band < 3; ++band ) {
+				band_start[band] = pos;
+				for( std::size_t chunk = 0; chunk < chunk_count; ++chunk ) {
+					offsets[chunk * 3 + band] = pos;
+					pos += counts[chunk * 3 + band];
+				}
+			}
+
+			auto buffer = std::unique_ptr<value_type[]>(
+			  new value_type[static_cast<std::size_t>( size )] );
+			auto gather_chunk = [&]( std::size_t chunk, std::ptrdiff_t cf,
+			                         std::ptrdiff_t ) {
+				auto src = first + cf;
+				for( std::size_t band = 0; band < 3; ++band ) {
+					auto const len = counts[chunk * 3 + band];
+					std::move( src, src + len,
+					           buffer.get( ) + offsets[chunk * 3 + band] );
+					src += len;
+				}
+			};
+			parallel_impl::for_each_chunk( size, chunk_count, gather_chunk );
+			auto scatter_chunk = [&]( std::size_t, std::ptrdiff_t cf,
+			                          std::ptrdiff_t cl ) {
+				std::move( buffer.get( ) + cf, buffer.get( ) + cl, first + cf );
+			};
+			parallel_impl::for_each_chunk( size, chunk_count, scatter_chunk );
+
+			if( k >= band_start[1] and k < band_start[2] ) {
+				daw::algorithm::nth_element( first + band_start[1], nth,
+				                             first + band_start[2], comp );
+			} else {
+				daw::algorithm::nth_element( first, nth, last, comp );
+			}
+		}
+
+		/// Samples taken per bucket when choosing the sample sort splitters
+		inline constexpr std::ptrdiff_t sample_sort_oversample = 32;
+
+		/// Sort one bucket on the calling thread, radix sorting arithmetic values
+		/// under std::less
+		template<typename RandomIterator, typename Compare>
+		void serial_sort( RandomIterator first, RandomIterator last,
+		                  Compare &comp ) {
+			using value_type =
+			  typename std::iterator_traits<RandomIterator>::value_type;
+			if constexpr( sort_n_details::is_numeric_radix_key_v<value_type> and
+			              ( std::is_same_v<Compare, std::less<>> or
+			                std::is_same_v<Compare, std::less<value_type>> ) ) {
+				daw::radix_sort( first, last );
+			} else {
+				daw::sort( first, last, comp );
+			}
+		}
+
+		/// Sample sort over bucket_count buckets.  A sorted oversample picks the
+		/// splitters, every chunk tags its elements with their bucket and counts
+		/// them, the chunks scatter into a buffer in bucket order and each
+		/// bucket is then sorted by its own thread and moved back
+		template<typename RandomIterator, typename Compare>
+		void sample_sort( RandomIterator first, RandomIterator last,
+		                  Compare &comp, std::size_t bucket_count ) {
+			using value_type =
+			  typename std::iterator_traits<RandomIterator>::value_type;
+			std::ptrdiff_t const size = last - first;
+
+			std::ptrdiff_t const sample_size = std::min(
+			  size, static_cast<std::ptrdiff_t>( bucket_count ) *
+			          sample_sort_oversample );
+			std::vector<value_type> sample{ };
+			sample.reserve( static_cast<std::size_t>( sample_size ) );
+			for( std::ptrdiff_t n = 0; n < sample_size; ++n ) {
+				sample.push_back( first[n * size / sample_size] );
+			}
+			daw::sort( sample.begin( ), sample.end( ), comp );
+			std::vector<value_type> splitters{ };
+			splitters.reserve( bucket_count - 1 );
+			for( std::size_t b = 1; b < bucket_count; ++b ) {
+				splitters.push_back( sample[static_cast<std::size_t>(
+				  static_cast<std::ptrdiff_t>( b ) * sample_size /
+				  static_cast<std::ptrdiff_t>( bucket_count ) )] );
+			}
+
+			std::size_t const chunk_count = bucket_count;
+			std::vector<std::uint16_t> bucket_of( static_cast<std::size_t>( size ) );
+			std::vector<std::ptrdiff_t> counts( chunk_count * bucket_count );
+			auto classify_chunk = [&]( std::size_t chunk, std::ptrdiff_t cf,
+			                           std::ptrdiff_t cl ) {
+				auto *chunk_counts = counts.data( ) + chunk * bucket_count;
+				for( ; cf < cl; ++cf ) {
+					auto const b = static_cast<std::size_t>(
+					  std::upper_bound( splitters.begin( ), splitters.end( ),
+					                    first[cf], comp ) -
+					  splitters.begin( ) );
+					bucket_of[static_cast<std::size_t>( cf )] =
+					  static_cast<std::uint16_t>( b );
+					++chunk_counts[b];
+				}
+			};
+			for_each_chunk( size, chunk_count, classify_chunk );
+
+			// Output offset of each chunk's part of each bucket
+			std::vector<std::ptrdiff_t> offsets( chunk_count * bucket_count );
+			std::vector<std::ptrdiff_t> bucket_start( bucket_count + 1 );
+			std::ptrdiff_t pos = 0;
+			for( std::size_t b = 0; b < bucket_count; ++b ) {
+				bucket_start[b] = pos;
+				for( std::size_t chunk = 0; chunk < chunk_count; ++chunk ) {
+					offsets[chunk * bucket_count + b] = pos;
+					pos += counts[chunk * bucket_count + b];
+				}
+			}
+			bucket_start[bucket_count] = pos;
+
+			auto buffer = std::unique_ptr<value_type[]>(
+			  new value_type[static_cast<std::size_t>( size )] );
+			auto scatter_chunk = [&]( std::size_t chunk, std::ptrdiff_t cf,
+			                          std::ptrdiff_t cl ) {
+				auto *chunk_offsets = offsets.data( ) + chunk * bucket_count;
+				for( ; cf < cl; ++cf ) {
+					auto const b = bucket_of[static_cast<std::size_t>( cf )];
+					buffer[static_cast<std::size_t>( chunk_offsets[b]++ )] =
+					  daw::move( first[cf] );
+				}
+			};
+			for_each_chunk( size, chunk_count, scatter_chunk );
+
+			auto sort_bucket = [&]( std::size_t bucket, std::ptrdiff_t,
+			                        std::ptrdiff_t ) {
+				auto *const bf = buffer.get( ) + bucket_start[bucket];
+				auto *const bl = buffer.get( ) + bucket_start[bucket + 1];
+				serial_sort( bf, bl, comp );
+				std::move( bf, bl, first + bucket_start[bucket] );
+			};
+			for_each_chunk( static_cast<std::ptrdiff_t>( bucket_count ),
+			                bucket_count, sort_bucket );
+		}
+
+		/// Threads take chunks of grain indices from a shared counter until the
+		/// space is exhausted or the token is stopped.  func( first, last )
+		/// returning false stops every thread
+		template<typename ChunkFunc>
+		bool for_each_index_chunk( std::size_t size, std::size_t grain,
+		                           std::size_t threads,
+		                           cancellation_token &token, ChunkFunc &func ) {
+			std::atomic<std::size_t> next = 0;
+			auto worker = [&]( std::size_t, std::ptrdiff_t, std::ptrdiff_t ) {
+				while( not token.stop_requested( ) ) {
+					std::size_t const first =
+					  next.fetch_add( grain, std::memory_order_relaxed );
+					if( first >= size ) {
+						return;
+					}
+					std::size_t const last =
+					  size - first > grain ? first + grain : size;
+					if( not func( first, last ) ) {
+						token.request_stop( );
+						return;
+					}
+				}
+			};
+			threads = std::max<std::size_t>(
+			  1, std::min( threads, ( size + grain - 1 ) / grain ) );
+			for_each_chunk( static_cast<std::ptrdiff_t>( threads ), threads,
+			                worker );
+			return not token.stop_requested( );
+		}
+
+		template<std::size_t N, typename Function>
+		bool for_each_product_index( product_index_space<N> const &space,
+		                             Function &func, cancellation_token &token,
+		                             std::size_t threads ) {
+			auto run_chunk = [&]( std::size_t first, std::size_t last ) {
+				return daw::algorithm::for_each_product_index(
+				  space, first, last, std::ref( func ) );
+			};
+			return for_each_index_chunk( space.size( ), parallel_index_grain,
+			                             threads, token, run_chunk );
+		}
+
+		template<typename Function>
+		bool for_each_combination_index( combination_index_space const &space,
+		                                 Function &func,
+		                                 cancellation_token &token,
+		                                 std::size_t threads ) {
+			auto run_chunk = [&]( std::size_t first, std::size_t last ) {
+				return daw::algorithm::for_each_combination_index(
+				  space, first, last, std::ref( func ) );
+			};
+			return for_each_index_chunk( space.size( ), parallel_index_grain,
+			                             threads, token, run_chunk );
+		}
+	} // namespace parallel_impl
+
+	/// @brief Call func( coordinates ) for every index of space over the
+	/// hardware threads.  The space is cut into chunks that each start by
+	/// decoding their first index, func is called concurrently and in no
+	/// particular order.  func may return false, or token be stopped, to end
+	/// the enumeration early
+	/// @return false if the enumeration was stopped
+	template<std::size_t N, typename Function>
+	bool for_each_product_index( product_index_space<N> const &space,
+	                             Function func, cancellation_token &token ) {
+		return parallel_impl::for_each_product_index(
+		  space, func, token, parallel_impl::thread_count( ) );
+	}
+
+	template<std::size_t N, typename Function>
+	bool for_each_product_index( product_index_space<N> const &space,
+	                             Function func ) {
+		cancellation_token token{ };
+		return parallel::for_each_product_index( space, daw::move( func ),
+		                                         token );
+	}
+
+	/// @brief Call func( indices ) for every combination of space over the
+	/// hardware threads, indices being a view of k size_t's.  func is called
+	/// concurrently and in no particular order.  func may return false, or
+	/// token be stopped, to end the enumeration early
+	/// @return false if the enumeration was stopped
+	template<typename Function>
+	bool for_each_combination_index( combination_index_space const &space,
+	                                 Function func, cancellation_token &token ) {
+		return parallel_impl::for_each_combination_index(
+		  space, func, token, parallel_impl::thread_count( ) );
+	}
+
+	template<typename Function>
+	bool for_each_combination_index( combination_index_space const &space,
+	                                 Function func ) {
+		cancellation_token token{ };
+		return parallel::for_each_combination_index( space, daw::move( func ),
+		                                             token );
+	}
+
+	/// @brief Parallel cartesian_product_for_each, func( c0[i0], c1[i1], ... )
+	/// is called concurrently and in no particular order
+	/// @return false if the enumeration was stopped
+	template<typename Function, typename... Containers>
+	bool cartesian_product_for_each( Function func, cancellation_token &token,
+	                                 Containers const &... cs ) {
+		auto const space = algorithm_details::make_product_space( cs... );
+		auto const refs = std::forward_as_tuple( cs... );
+		return parallel::for_each_product_index(
+		  space,
+		  [&]( auto const &at ) {
+			  return algorithm_details::invoke_product(
+			    func, refs, at, std::index_sequence_for<Containers...>{ } );
+		  },
+		  token );
+	}
+
+	/// @brief Parallel sort.  Large ranges are sample sorted with one bucket
+	/// per hardware thread, each bucket radix sorted when the values are
+	/// arithmetic and comp is std::less, or sorted with daw::sort otherwise.
+	/// Small ranges, a single hardware thread or values that are not default
+	/// constructible are sorted on the calling thread the same way.  Not
+	/// stable
+	/// @param first first item in range
+	/// @param last end of range
+	/// @param comp comparision function object
+	template<typename RandomIterator, typename Compare = std::less<>>
+	void sort( RandomIterator first, RandomIterator last,
+	           Compare comp = Compare{ } ) {
+		using value_type =
+		  typename std::iterator_traits<RandomIterator>::value_type;
+
+		std::ptrdiff_t const size = last - first;
+		std::size_t const bucket_count = std::min(
+		  { parallel_impl::thread_count( ), std::size_t{ 0xFFFFU },
+		    static_cast<std::size_t>( size / ( parallel_sort_limit / 4 ) + 1 ) } );
+		if constexpr( parallel_impl::is_parallel_selectable_v<value_type> ) {
+			if( size > parallel_sort_limit and bucket_count > 1 ) {
+				parallel_impl::sample_sort( first, last, comp, bucket_count );
+				return;
+			}
+		}
+		parallel_impl::serial_sort( first, last, comp );
+	}
+
+	/// @brief Parallel nth_element.  A sorted sample brackets the nth value
+	/// with two splitters, every thread partitions its chunk in three around
+	/// them, the chunks are gathered into place and the single thread
+	/// selection only runs over the narrow middle band.  Small ranges, a
+	/// single hardware thread or a sample that misses fall back to
+	/// daw::algorithm::nth_element
+	/// @param first first item in range
+	/// @param nth position to select for
+	/// @param last end of range
+	/// @param comp comparision function object
+	template<typename RandomIterator, typename Compare = std::less<>>
+	void nth_element( RandomIterator first, RandomIterator nth,
+	                  RandomIterator const last, Compare comp = Compare{ } ) {
+		using value_type =
+		  typename std::iterator_traits<RandomIterator>::value_type;
+
+		std::ptrdiff_t const size = last - first;
+		std::size_t const chunk_count = std::min(
+		  parallel_impl::thread_count( ),
+		  static_cast<std::size_t>( size / ( parallel_select_limit / 4 ) + 1 ) );
+		if constexpr( parallel_impl::is_parallel_selectable_v<value_type> ) {
+			if( size > parallel_select_limit and chunk_count > 1 and
+			    nth != last ) {
+				parallel_impl::select_chunked( first, nth, last, comp, chunk_count );
+				return;
+			}
+		}
+		daw::algorithm::nth_element( first, nth, last, comp );
+	}
+} // namespace daw::algorithm::parallel
+
+namespace daw::algorithm::algorithm_details {
+	template<>
+	struct block_executor<execution::parallel_policy>
+	  : parallel::parallel_impl::threaded_block_executor {};
+
+	template<>
+	struct block_executor<execution::parallel_unsequenced_policy>
+	  : parallel::parallel_impl::threaded_block_executor {};
+} // namespace daw::algorithm::algorithm_details
@@ -12,10 +12,14 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
 #include <unordered_map>
 #include <vector>
 
@@ -829,6 +833,672 @@ constexpr bool adjacent_find_test( ) {
 }
 static_assert( adjacent_find_test( ) );
 
+constexpr bool nth_element_test_001( ) {
+	std::array<int, 40> ary{ };
+	for( size_t n = 0; n < ary.size( ); ++n ) {
+		ary[n] = static_cast<int>( ( n * 17U ) % 40U );
+	}
+	auto const nth = ary.begin( ) + 13;
+	daw::algorithm::nth_element( ary.begin( ), nth, ary.end( ) );
+	daw::expecting( 13, *nth );
+	for( auto it = ary.begin( ); it != nth; ++it ) {
+		daw::expecting( *it < *nth );
+	}
+	for( auto it = nth; it != ary.end( ); ++it ) {
+		daw::expecting( !( *it < *nth ) );
+	}
+	return true;
+}
+static_assert( nth_element_test_001( ) );
+
+constexpr bool partial_sort_test_001( ) {
+	std::array<int, 30> ary{ };
+	for( size_t n = 0; n < ary.size( ); ++n ) {
+		ary[n] = static_cast<int>( ( n * 7U ) % 30U );
+	}
+	daw::algorithm::partial_sort( ary.begin( ), ary.begin( ) + 5, ary.end( ),
+	                              std::greater<>{ } );
+	daw::expecting( 29, ary[0] );
+	daw::expecting( 28, ary[1] );
+	daw::expecting( 27, ary[2] );
+	daw::expecting( 26, ary[3] );
+	daw::expecting( 25, ary[4] );
+	return true;
+}
+static_assert( partial_sort_test_001( ) );
+
+constexpr bool partial_sort_copy_test_001( ) {
+	std::array<int, 9> const src = { 5, 7, 4, 2, 8, 6, 1, 9, 0 };
+	std::array<int, 3> dst{ };
+	auto const last = daw::algorithm::partial_sort_copy(
+	  src.begin( ), src.end( ), dst.begin( ), dst.end( ) );
+	daw::expecting( last == dst.end( ) );
+	daw::expecting( 0, dst[0] );
+	daw::expecting( 1, dst[1] );
+	daw::expecting( 2, dst[2] );
+
+	std::array<int, 12> big{ };
+	auto const last2 = daw::algorithm::partial_sort_copy(
+	  src.begin( ), src.end( ), big.begin( ), big.end( ) );
+	daw::expecting( 9, last2 - big.begin( ) );
+	daw::expecting( daw::algorithm::is_sorted( big.begin( ), last2 ) );
+
+	// An empty output range is never read
+	auto const last3 = daw::algorithm::partial_sort_copy(
+	  src.begin( ), src.end( ), dst.begin( ), dst.begin( ) );
+	daw::expecting( last3 == dst.begin( ) );
+	return true;
+}
+static_assert( partial_sort_copy_test_001( ) );
+
+template<typename Vector>
+void check_nth( Vector values, size_t k ) {
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ) );
+	auto const nth = values.begin( ) + static_cast<std::ptrdiff_t>( k );
+	daw::algorithm::nth_element( values.begin( ), nth, values.end( ) );
+	daw::expecting( expected[k], *nth );
+	daw::expecting( std::all_of( values.begin( ), nth,
+	                             [&]( auto v ) { return !( *nth < v ); } ) );
+	daw::expecting( std::all_of( nth, values.end( ),
+	                             [&]( auto v ) { return !( v < *nth ); } ) );
+}
+
+void nth_element_test_002( ) {
+	std::mt19937_64 rng( 1234 );
+	for( size_t size : { 1U, 2U, 17U, 100U, 601U, 5'000U, 100'000U } ) {
+		std::vector<int> random_values( size );
+		for( auto &v : random_values ) {
+			v = static_cast<int>( rng( ) % 1000U );
+		}
+		std::vector<int> sorted_values( size );
+		std::iota( sorted_values.begin( ), sorted_values.end( ), 0 );
+		auto reversed_values = sorted_values;
+		std::reverse( reversed_values.begin( ), reversed_values.end( ) );
+		std::vector<int> equal_values( size, 42 );
+		auto organ_pipe = sorted_values;
+		std::reverse( organ_pipe.begin( ) + static_cast<std::ptrdiff_t>( size / 2 ),
+		              organ_pipe.end( ) );
+		for( size_t k : { size_t{ 0 }, size / 2, ( size * 99 ) / 100, size - 1 } ) {
+			check_nth( random_values, k );
+			check_nth( sorted_values, k );
+			check_nth( reversed_values, k );
+			check_nth( equal_values, k );
+			check_nth( organ_pipe, k );
+		}
+	}
+}
+
+void partial_sort_test_002( ) {
+	std::mt19937_64 rng( 4321 );
+	std::vector<double> values( 50'000 );
+	for( auto &v : values ) {
+		v = static_cast<double>( rng( ) % 100'000U ) / 7.0;
+	}
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ) );
+	auto v1 = values;
+	daw::algorithm::partial_sort( v1.begin( ), v1.begin( ) + 1000, v1.end( ) );
+	daw::expecting(
+	  std::equal( v1.begin( ), v1.begin( ) + 1000, expected.begin( ) ) );
+	std::vector<double> v2( 1000 );
+	daw::algorithm::partial_sort_copy( values.begin( ), values.end( ),
+	                                   v2.begin( ), v2.end( ) );
+	daw::expecting( std::equal( v2.begin( ), v2.end( ), expected.begin( ) ) );
+}
+
+void nth_element_bench_001( ) {
+	std::mt19937_64 rng( 42 );
+	std::vector<double> latencies( 4'000'000 );
+	for( auto &v : latencies ) {
+		v = static_cast<double>( rng( ) % 1'000'000U ) / 1000.0;
+	}
+	auto const p99 = static_cast<std::ptrdiff_t>( latencies.size( ) * 99 / 100 );
+	double r1 = 0.0;
+	daw::show_benchmark(
+	  latencies.size( ) * sizeof( double ), "daw::algorithm::nth_element(p99)",
+	  [&]( ) {
+		  auto v = latencies;
+		  daw::algorithm::nth_element( v.begin( ), v.begin( ) + p99, v.end( ) );
+		  r1 = v[static_cast<size_t>( p99 )];
+	  },
+	  2, 2, latencies.size( ) );
+	double r2 = 0.0;
+	daw::show_benchmark(
+	  latencies.size( ) * sizeof( double ), "std::nth_element(p99)",
+	  [&]( ) {
+		  auto v = latencies;
+		  std::nth_element( v.begin( ), v.begin( ) + p99, v.end( ) );
+		  r2 = v[static_cast<size_t>( p99 )];
+	  },
+	  2, 2, latencies.size( ) );
+	daw::expecting( r2, r1 );
+}
+
+constexpr bool set_kernels_test_001( ) {
+	int const a[] = { 1, 3, 5, 7, 9, 11 };
+	int const b[] = { 2, 3, 4, 9, 10, 11, 12 };
+	int out[13]{ };
+	auto last = daw::algorithm::set_union( std::begin( a ), std::end( a ),
+	                                       std::begin( b ), std::end( b ), out );
+	int const expected_union[] = { 1, 2, 3, 4, 5, 7, 9, 10, 11, 12 };
+	daw::expecting( last - out, 10 );
+	for( std::size_t n = 0; n < 10; ++n ) {
+		daw::expecting( out[n], expected_union[n] );
+	}
+	last = daw::algorithm::set_difference( std::begin( a ), std::end( a ),
+	                                       std::begin( b ), std::end( b ), out );
+	daw::expecting( last - out, 3 );
+	daw::expecting( out[0] == 1 and out[1] == 5 and out[2] == 7 );
+	last = daw::algorithm::set_intersection_galloping(
+	  std::begin( a ), std::end( a ), std::begin( b ), std::end( b ), out );
+	daw::expecting( last - out, 3 );
+	daw::expecting( out[0] == 3 and out[1] == 9 and out[2] == 11 );
+	daw::expecting( daw::algorithm::set_intersection_count(
+	                  std::begin( a ), std::end( a ), std::begin( b ),
+	                  std::end( b ) ),
+	                3U );
+	daw::expecting( daw::algorithm::set_union_count( std::begin( a ),
+	                                                 std::end( a ),
+	                                                 std::begin( b ),
+	                                                 std::end( b ) ),
+	                10U );
+	daw::expecting( daw::algorithm::set_difference_count( std::begin( b ),
+	                                                      std::end( b ),
+	                                                      std::begin( a ),
+	                                                      std::end( a ) ),
+	                4U );
+	return true;
+}
+static_assert( set_kernels_test_001( ) );
+
+std::vector<std::uint32_t> make_sorted_set( std::mt19937_64 &rng,
+                                            std::size_t count,
+                                            std::uint32_t max_value ) {
+	std::vector<std::uint32_t> result( count );
+	for( auto &v : result ) {
+		v = static_cast<std::uint32_t>( rng( ) % max_value );
+	}
+	std::sort( result.begin( ), result.end( ) );
+	result.erase( std::unique( result.begin( ), result.end( ) ), result.end( ) );
+	return result;
+}
+
+void set_kernels_test_002( ) {
+	std::mt19937_64 rng( 1234 );
+	for( std::size_t small_size : { 0U, 1U, 7U, 100U, 5'000U } ) {
+		for( std::size_t large_size : { 0U, 9U, 5'000U, 200'000U } ) {
+			auto const a = make_sorted_set( rng, small_size, 400'000U );
+			auto const b = make_sorted_set( rng, large_size, 400'000U );
+			std::vector<std::uint32_t> expected{ };
+			std::set_intersection( a.begin( ), a.end( ), b.begin( ), b.end( ),
+			                       std::back_inserter( expected ) );
+			std::vector<std::uint32_t> result{ };
+			daw::algorithm::set_intersection_galloping(
+			  a.begin( ), a.end( ), b.begin( ), b.end( ),
+			  std::back_inserter( result ) );
+			daw::expecting( result == expected );
+			result.clear( );
+			daw::algorithm::set_intersection_adaptive(
+			  a.data( ), a.data( ) + a.size( ), b.data( ), b.data( ) + b.size( ),
+			  std::back_inserter( result ) );
+			daw::expecting( result == expected );
+			result.clear( );
+			daw::algorithm::set_intersection_adaptive(
+			  b.data( ), b.data( ) + b.size( ), a.data( ), a.data( ) + a.size( ),
+			  std::back_inserter( result ) );
+			daw::expecting( result == expected );
+			daw::expecting( expected.size( ),
+			                daw::algorithm::set_intersection_count(
+			                  a.begin( ), a.end( ), b.begin( ), b.end( ) ) );
+
+			expected.clear( );
+			std::set_union( a.begin( ), a.end( ), b.begin( ), b.end( ),
+			                std::back_inserter( expected ) );
+			result.clear( );
+			daw::algorithm::set_union( a.begin( ), a.end( ), b.begin( ), b.end( ),
+			                           std::back_inserter( result ) );
+			daw::expecting( result == expected );
+
+			expected.clear( );
+			std::set_difference( b.begin( ), b.end( ), a.begin( ), a.end( ),
+			                     std::back_inserter( expected ) );
+			daw::expecting( expected.size( ),
+			                daw::algorithm::set_difference_count(
+			                  b.begin( ), b.end( ), a.begin( ), a.end( ) ) );
+		}
+	}
+	// Dense lists so the block kernel sees many matches per block
+	for( std::uint32_t max_value : { 64U, 1'000U, 100'000U } ) {
+		auto const a = make_sorted_set( rng, 20'000U, max_value );
+		auto const b = make_sorted_set( rng, 20'000U, max_value );
+		std::vector<std::uint32_t> expected{ };
+		std::set_intersection( a.begin( ), a.end( ), b.begin( ), b.end( ),
+		                       std::back_inserter( expected ) );
+		std::vector<std::uint32_t> result{ };
+		daw::algorithm::set_intersection_adaptive(
+		  a.data( ), a.data( ) + a.size( ), b.data( ), b.data( ) + b.size( ),
+		  std::back_inserter( result ) );
+		daw::expecting( result == expected );
+
+		// 64 bit values whose low words often match when the values do not
+		auto const widen = []( std::vector<std::uint32_t> const &v ) {
+			auto wide = std::vector<std::uint64_t>( );
+			for( auto x : v ) {
+				wide.push_back( ( std::uint64_t{ x } << 32U ) | ( x & 3U ) );
+			}
+			return wide;
+		};
+		auto const a64 = widen( a );
+		auto const b64 = widen( b );
+		std::vector<std::uint64_t> expected64{ };
+		std::set_intersection( a64.begin( ), a64.end( ), b64.begin( ),
+		                       b64.end( ), std::back_inserter( expected64 ) );
+		std::vector<std::uint64_t> result64{ };
+		daw::algorithm::set_intersection_adaptive(
+		  a64.data( ), a64.data( ) + a64.size( ), b64.data( ),
+		  b64.data( ) + b64.size( ), std::back_inserter( result64 ) );
+		daw::expecting( result64 == expected64 );
+	}
+}
+
+void set_kernels_test_003( ) {
+	std::mt19937_64 rng( 99 );
+	std::vector<std::vector<std::uint32_t>> lists{ };
+	lists.push_back( make_sorted_set( rng, 50'000U, 100'000U ) );
+	lists.push_back( make_sorted_set( rng, 500U, 100'000U ) );
+	lists.push_back( make_sorted_set( rng, 80'000U, 100'000U ) );
+	lists.push_back( make_sorted_set( rng, 30'000U, 100'000U ) );
+
+	auto expected = lists[0];
+	for( std::size_t n = 1; n < lists.size( ); ++n ) {
+		std::vector<std::uint32_t> tmp{ };
+		std::set_intersection( expected.begin( ), expected.end( ),
+		                       lists[n].begin( ), lists[n].end( ),
+		                       std::back_inserter( tmp ) );
+		expected = std::move( tmp );
+	}
+	std::vector<std::uint32_t> result{ };
+	daw::algorithm::set_intersection_k( lists, std::back_inserter( result ) );
+	daw::expecting( result == expected );
+	daw::expecting( expected.size( ),
+	                daw::algorithm::set_intersection_k_count( lists ) );
+
+	expected = lists[0];
+	for( std::size_t n = 1; n < lists.size( ); ++n ) {
+		std::vector<std::uint32_t> tmp{ };
+		std::set_union( expected.begin( ), expected.end( ), lists[n].begin( ),
+		                lists[n].end( ), std::back_inserter( tmp ) );
+		expected = std::move( tmp );
+	}
+	result.clear( );
+	daw::algorithm::set_union_k( lists, std::back_inserter( result ) );
+	daw::expecting( result == expected );
+	daw::expecting( expected.size( ),
+	                daw::algorithm::set_union_k_count( lists ) );
+
+	lists.emplace_back( );
+	daw::expecting( daw::algorithm::set_intersection_k_count( lists ), 0U );
+}
+
+std::vector<std::uint32_t> make_sorted_multiset( std::mt19937_64 &rng,
+                                                 std::size_t count,
+                                                 std::uint32_t max_value ) {
+	std::vector<std::uint32_t> result( count );
+	for( auto &v : result ) {
+		v = static_cast<std::uint32_t>( rng( ) % max_value );
+	}
+	std::sort( result.begin( ), result.end( ) );
+	return result;
+}
+
+template<typename T>
+void check_intersection_paths( std::vector<T> const &a,
+                               std::vector<T> const &b ) {
+	std::vector<T> expected{ };
+	std::set_intersection( a.begin( ), a.end( ), b.begin( ), b.end( ),
+	                       std::back_inserter( expected ) );
+	// Pointers take the block kernel when the sizes are close, iterators the
+	// merge, and a 32x size difference the gallop
+	std::vector<T> result{ };
+	daw::algorithm::set_intersection_adaptive(
+	  a.data( ), a.data( ) + a.size( ), b.data( ), b.data( ) + b.size( ),
+	  std::back_inserter( result ) );
+	daw::expecting( result == expected );
+	result.clear( );
+	daw::algorithm::set_intersection_adaptive( a.begin( ), a.end( ), b.begin( ),
+	                                           b.end( ),
+	                                           std::back_inserter( result ) );
+	daw::expecting( result == expected );
+	result.clear( );
+	daw::algorithm::set_intersection_galloping( a.begin( ), a.end( ),
+	                                            b.begin( ), b.end( ),
+	                                            std::back_inserter( result ) );
+	daw::expecting( result == expected );
+	daw::expecting( expected.size( ),
+	                daw::algorithm::set_intersection_count(
+	                  a.data( ), a.data( ) + a.size( ), b.data( ),
+	                  b.data( ) + b.size( ) ) );
+	daw::expecting( expected.size( ),
+	                daw::algorithm::set_intersection_count(
+	                  a.begin( ), a.end( ), b.begin( ), b.end( ) ) );
+	auto const lists = std::vector<std::vector<T>>{ a, b };
+	daw::expecting( expected.size( ),
+	                daw::algorithm::set_intersection_k_count( lists ) );
+}
+
+void set_kernels_test_004( ) {
+	// Duplicates give min( count1, count2 ) copies on every path
+	std::vector<std::uint32_t> const ones( 16, 1U );
+	std::vector<std::uint32_t> nines( 9, 1U );
+	nines.insert( nines.end( ), 7, 2U );
+	daw::expecting( 9U, daw::algorithm::set_intersection_count(
+	                      ones.data( ), ones.data( ) + ones.size( ),
+	                      nines.data( ), nines.data( ) + nines.size( ) ) );
+	check_intersection_paths( ones, nines );
+
+	std::mt19937_64 rng( 4321 );
+	for( std::uint32_t max_value : { 4U, 50U, 1'000U } ) {
+		for( std::size_t size1 : { 1U, 9U, 40U, 3'000U } ) {
+			for( std::size_t size2 : { 1U, 17U, 3'000U, 100'000U } ) {
+				auto const a = make_sorted_multiset( rng, size1, max_value );
+				auto const b = make_sorted_multiset( rng, size2, max_value );
+				check_intersection_paths( a, b );
+				check_intersection_paths( b, a );
+				auto const a64 = std::vector<std::uint64_t>( a.begin( ), a.end( ) );
+				auto const b64 = std::vector<std::uint64_t>( b.begin( ), b.end( ) );
+				check_intersection_paths( a64, b64 );
+			}
+		}
+	}
+
+	// k lists with duplicates
+	std::vector<std::vector<std::uint32_t>> lists{ };
+	for( std::size_t n = 0; n < 4; ++n ) {
+		lists.push_back( make_sorted_multiset( rng, 2'000U + n * 500U, 300U ) );
+	}
+	auto expected = lists[0];
+	for( std::size_t n = 1; n < lists.size( ); ++n ) {
+		std::vector<std::uint32_t> tmp{ };
+		std::set_intersection( expected.begin( ), expected.end( ),
+		                       lists[n].begin( ), lists[n].end( ),
+		                       std::back_inserter( tmp ) );
+		expected = std::move( tmp );
+	}
+	std::vector<std::uint32_t> result{ };
+	daw::algorithm::set_intersection_k( lists, std::back_inserter( result ) );
+	daw::expecting( result == expected );
+}
+
+void set_kernels_bench_001( ) {
+	// Posting list style: a rare term against a common one
+	std::mt19937_64 rng( 7 );
+	auto const rare = make_sorted_set( rng, 2'000U, 100'000'000U );
+	auto const common = make_sorted_set( rng, 2'000'000U, 100'000'000U );
+	std::size_t r1 = 0;
+	daw::show_benchmark(
+	  common.size( ) * sizeof( std::uint32_t ),
+	  "daw::algorithm::set_intersection_count(skewed)",
+	  [&]( ) {
+		  r1 = daw::algorithm::set_intersection_count(
+		    rare.begin( ), rare.end( ), common.begin( ), common.end( ) );
+	  },
+	  2, 2, common.size( ) );
+	std::size_t r2 = 0;
+	daw::show_benchmark(
+	  common.size( ) * sizeof( std::uint32_t ), "std::set_intersection(skewed)",
+	  [&]( ) {
+		  std::vector<std::uint32_t> out{ };
+		  std::set_intersection( rare.begin( ), rare.end( ), common.begin( ),
+		                         common.end( ), std::back_inserter( out ) );
+		  r2 = out.size( );
+	  },
+	  2, 2, common.size( ) );
+	daw::expecting( r2, r1 );
+
+	auto const other = make_sorted_set( rng, 2'000'000U, 100'000'000U );
+	daw::show_benchmark(
+	  common.size( ) * sizeof( std::uint32_t ),
+	  "daw::algorithm::set_intersection_count(even)",
+	  [&]( ) {
+		  r1 = daw::algorithm::set_intersection_count(
+		    common.data( ), common.data( ) + common.size( ), other.data( ),
+		    other.data( ) + other.size( ) );
+	  },
+	  2, 2, common.size( ) );
+	daw::show_benchmark(
+	  common.size( ) * sizeof( std::uint32_t ), "std::set_intersection(even)",
+	  [&]( ) {
+		  std::vector<std::uint32_t> out{ };
+		  std::set_intersection( common.begin( ), common.end( ), other.begin( ),
+		                         other.end( ), std::back_inserter( out ) );
+		  r2 = out.size( );
+	  },
+	  2, 2, common.size( ) );
+	daw::expecting( r2, r1 );
+}
+
+constexpr bool simd_kernels_test_001( ) {
+	int const a[] = { 4, -2, 9, 9, -2, 5, 0 };
+	daw::expecting( daw::algorithm::min_element( std::begin( a ),
+	                                             std::end( a ) ) == a + 1 );
+	daw::expecting( daw::algorithm::max_element( std::begin( a ),
+	                                             std::end( a ) ) == a + 2 );
+	auto const mm =
+	  daw::algorithm::minmax_element( std::begin( a ), std::end( a ) );
+	daw::expecting( mm.min_element == a + 1 and mm.max_element == a + 3 );
+	daw::expecting( daw::algorithm::count_if(
+	                  std::begin( a ), std::end( a ),
+	                  daw::algorithm::in_range( -2, 4 ) ) == 4U );
+	daw::expecting( daw::algorithm::find( std::begin( a ), std::end( a ), 5 ) ==
+	                a + 5 );
+	return true;
+}
+static_assert( simd_kernels_test_001( ) );
+
+template<typename T>
+void simd_kernels_check( std::vector<T> const &values ) {
+	auto const first = values.begin( );
+	auto const last = values.end( );
+	daw::expecting( std::min_element( first, last ) ==
+	                daw::algorithm::min_element( first, last ) );
+	daw::expecting( std::max_element( first, last ) ==
+	                daw::algorithm::max_element( first, last ) );
+	auto const mm = daw::algorithm::minmax_element( first, last );
+	auto const expected_mm = std::minmax_element( first, last );
+	daw::expecting( expected_mm.first == mm.min_element );
+	daw::expecting( expected_mm.second == mm.max_element );
+	if( values.empty( ) ) {
+		return;
+	}
+	T const needle = values[values.size( ) / 2];
+	daw::expecting( std::find( first, last, needle ) ==
+	                daw::algorithm::find( first, last, needle ) );
+	daw::expecting(
+	  static_cast<std::size_t>( std::count( first, last, needle ) ),
+	  daw::algorithm::count_if( first, last,
+	                            daw::algorithm::equal_to( needle ) ) );
+	daw::expecting(
+	  static_cast<std::size_t>( std::count_if(
+	    first, last, [&]( T v ) { return v < needle; } ) ),
+	  daw::algorithm::count_if( first, last,
+	                            daw::algorithm::less_than( needle ) ) );
+	T const lo = values.front( ) < needle ? values.front( ) : needle;
+	T const hi = values.front( ) < needle ? needle : values.front( );
+	daw::expecting(
+	  static_cast<std::size_t>( std::count_if(
+	    first, last, [&]( T v ) { return lo <= v and v <= hi; } ) ),
+	  daw::algorithm::count_if( first, last,
+	                            daw::algorithm::in_range( lo, hi ) ) );
+}
+
+void simd_kernels_test_002( ) {
+	std::mt19937_64 rng( 2024 );
+	for( std::size_t size : { 0U, 1U, 2U, 255U, 256U, 257U, 1000U, 4099U } ) {
+		std::vector<int> ints( size );
+		for( auto &v : ints ) {
+			v = static_cast<int>( rng( ) % 50U ) - 25;
+		}
+		simd_kernels_check( ints );
+		std::vector<std::uint8_t> bytes( size );
+		for( auto &v : bytes ) {
+			v = static_cast<std::uint8_t>( rng( ) );
+		}
+		simd_kernels_check( bytes );
+		// Each lane width, signed and unsigned, takes its own SSE2 compare
+		std::vector<std::int8_t> signed_bytes( size );
+		std::vector<std::uint16_t> shorts( size );
+		std::vector<std::uint32_t> words( size );
+		std::vector<std::int64_t> longs( size );
+		std::vector<float> floats( size );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto const r = rng( );
+			signed_bytes[n] = static_cast<std::int8_t>( r );
+			shorts[n] = static_cast<std::uint16_t>( r >> 8U );
+			words[n] = static_cast<std::uint32_t>( r >> 24U );
+			longs[n] = static_cast<std::int64_t>( r % 100U ) - 50;
+			floats[n] = static_cast<float>( r % 1000U ) / 4.0f - 100.0f;
+		}
+		simd_kernels_check( signed_bytes );
+		simd_kernels_check( shorts );
+		simd_kernels_check( words );
+		simd_kernels_check( longs );
+		simd_kernels_check( floats );
+		std::vector<double> doubles( size );
+		for( auto &v : doubles ) {
+			v = static_cast<double>( rng( ) % 1000U ) / 8.0;
+		}
+		simd_kernels_check( doubles );
+		if( size > 10 ) {
+			// NaN gives order dependent results, the generic loops decide
+			doubles[3] = std::numeric_limits<double>::quiet_NaN( );
+			simd_kernels_check( doubles );
+		}
+	}
+}
+
+void simd_kernels_bench_001( ) {
+	std::mt19937_64 rng( 11 );
+	std::vector<int> values( 20'000'000 );
+	for( auto &v : values ) {
+		v = static_cast<int>( rng( ) % 1'000'000U );
+	}
+	values[values.size( ) - 7] = 5'000'000;
+	auto const bytes = values.size( ) * sizeof( int );
+	std::ptrdiff_t r1 = 0;
+	daw::show_benchmark(
+	  bytes, "daw::algorithm::max_element",
+	  [&]( ) {
+		  r1 = daw::algorithm::max_element( values.begin( ), values.end( ) ) -
+		       values.begin( );
+	  },
+	  2, 2, values.size( ) );
+	std::ptrdiff_t r2 = 0;
+	daw::show_benchmark(
+	  bytes, "std::max_element",
+	  [&]( ) {
+		  r2 = std::max_element( values.begin( ), values.end( ) ) - values.begin( );
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( r2, r1 );
+	std::size_t c1 = 0;
+	daw::show_benchmark(
+	  bytes, "daw::algorithm::count_if(less_than)",
+	  [&]( ) {
+		  c1 = daw::algorithm::count_if( values.begin( ), values.end( ),
+		                                 daw::algorithm::less_than( 500'000 ) );
+	  },
+	  2, 2, values.size( ) );
+	std::size_t c2 = 0;
+	daw::show_benchmark(
+	  bytes, "std::count_if(less_than)",
+	  [&]( ) {
+		  c2 = static_cast<std::size_t>(
+		    std::count_if( values.begin( ), values.end( ),
+		                   []( int v ) { return v < 500'000; } ) );
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( c2, c1 );
+	daw::show_benchmark(
+	  bytes, "daw::algorithm::find",
+	  [&]( ) {
+		  r1 = daw::algorithm::find( values.begin( ), values.end( ), 5'000'000 ) -
+		       values.begin( );
+	  },
+	  2, 2, values.size( ) );
+	daw::show_benchmark(
+	  bytes, "std::find",
+	  [&]( ) {
+		  r2 = std::find( values.begin( ), values.end( ), 5'000'000 ) -
+		       values.begin( );
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( r2, r1 );
+}
+
+constexpr bool index_space_test_001( ) {
+	daw::expecting( daw::algorithm::binomial( 5, 2 ), 10U );
+	daw::expecting( daw::algorithm::binomial( 60, 30 ), 118264581564861424ULL );
+	daw::expecting( daw::algorithm::binomial( 3, 5 ), 0U );
+
+	auto const space = daw::algorithm::product_index_space<3>( { 2, 3, 4 } );
+	daw::expecting( space.size( ), 24U );
+	auto const at = space.decode( 17 );
+	daw::expecting( at[0] == 1 and at[1] == 1 and at[2] == 1 );
+	daw::expecting( space.encode( at ), 17U );
+
+	std::array<int, 2> const a = { 1, 2 };
+	std::array<int, 3> const b = { 10, 20, 30 };
+	int sum = 0;
+	daw::algorithm::cartesian_product_for_each(
+	  [&]( int x, int y ) { sum += x * y; }, a, b );
+	daw::expecting( sum, 180 );
+
+	// Combination 6 of 5 choose 3 in lexicographic order is { 1, 2, 3 }
+	auto const combos = daw::algorithm::combination_index_space( 5, 3 );
+	std::size_t idx[3]{ };
+	combos.decode( 6, idx );
+	daw::expecting( idx[0] == 1 and idx[1] == 2 and idx[2] == 3 );
+	daw::expecting( combos.next( idx ) );
+	daw::expecting( idx[0] == 1 and idx[1] == 2 and idx[2] == 4 );
+	return true;
+}
+static_assert( index_space_test_001( ) );
+
+void index_space_test_002( ) {
+	// Decoding any index matches stepping to it
+	auto const combos = daw::algorithm::combination_index_space( 12, 5 );
+	std::vector<std::size_t> stepped( 5 );
+	combos.decode( 0, stepped.data( ) );
+	std::vector<std::size_t> decoded( 5 );
+	for( std::size_t n = 0; n < combos.size( ); ++n ) {
+		combos.decode( n, decoded.data( ) );
+		daw::expecting( decoded == stepped );
+		daw::expecting( combos.next( stepped.data( ) ) ==
+		                ( n + 1 < combos.size( ) ) );
+	}
+	std::size_t count = 0;
+	bool const finished = daw::algorithm::for_each_combination_index(
+	  combos, 100, 200, [&]( auto const &indices ) {
+		  daw::expecting( indices.size( ), 5U );
+		  return ++count < 50;
+	  } );
+	daw::expecting( not finished );
+	daw::expecting( count, 50U );
+	daw::expecting_exception<std::overflow_error>(
+	  [] { (void)daw::algorithm::binomial( 200, 100 ); } );
+}
+
 int main( ) {
 	daw_extract_to_001( );
+	nth_element_test_002( );
+	partial_sort_test_002( );
+	nth_element_bench_001( );
+	set_kernels_test_002( );
+	set_kernels_test_003( );
+	set_kernels_test_004( );
+	set_kernels_bench_001( );
+	simd_kernels_test_002( );
+	simd_kernels_bench_001( );
+	index_space_test_002( );
 }
@@ -0,0 +1,176 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_bit_stream.h"
+#include "daw/daw_random.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+constexpr bool daw_bit_reader_test_001( ) {
+	uint8_t const data[] = { 0b1010'0000, 0xFF, 0x12, 0x34 };
+	auto reader = daw::bit_reader( data, std::size( data ) );
+	daw::expecting( 1U, reader.peek_bits( 1 ) );
+	daw::expecting( 0b101U, reader.pop_bits( 3 ) );
+	daw::expecting( 0U, reader.pop_bits( 5 ) );
+	daw::expecting( 0xFFU, reader.pop_bits( 8 ) );
+	daw::expecting( 0x12U, reader.pop_value<uint8_t>( ) );
+	daw::expecting( 0U, reader.pop_bits( 0 ) );
+	daw::expecting( 8U, reader.bits_remaining( ) );
+	daw::expecting( 0x34U, reader.pop_bits( 8 ) );
+	daw::expecting( !reader.valid( ) );
+	daw::expecting( !reader.overrun( ) );
+	daw::expecting( 0U, reader.pop_bits( 4 ) );
+	daw::expecting( reader.overrun( ) );
+	return true;
+}
+static_assert( daw_bit_reader_test_001( ) );
+
+constexpr bool daw_bit_writer_test_001( ) {
+	uint8_t data[16] = { };
+	auto writer = daw::bit_writer( data, std::size( data ) );
+	writer.push_bits( 0b101U, 3 );
+	writer.push_value( 0xDEAD'BEEF'CAFE'F00DULL );
+	writer.push_value( 0x1'FFFF'FFFF'FFFFULL, 57 );
+	writer.push_bits( 0b11U, 2 );
+	auto const bytes = writer.finish( );
+	daw::expecting( 16U, bytes );
+
+	auto reader = daw::bit_reader<uint8_t>( data, bytes );
+	daw::expecting( 0b101U, reader.pop_bits( 3 ) );
+	daw::expecting( 0xDEAD'BEEF'CAFE'F00DULL, reader.pop_value( ) );
+	daw::expecting( 0x1'FFFF'FFFF'FFFFULL, reader.pop_value( 57 ) );
+	daw::expecting( 0b11U, reader.pop_bits( 2 ) );
+	return true;
+}
+static_assert( daw_bit_writer_test_001( ) );
+
+constexpr bool daw_bit_reader_test_002( ) {
+	// Reading well past the end gives zero bits and stays in bounds
+	uint8_t const data[3] = { 0xFF, 0xFF, 0xFF };
+	auto reader = daw::bit_reader<uint8_t>( data, std::size( data ) );
+	reader.skip_bits( 20 );
+	daw::expecting( 0xFU, reader.pop_bits( 4 ) );
+	reader.skip_bits( 100 );
+	daw::expecting( 0U, reader.pop_bits( 57 ) );
+	daw::expecting( 0U, reader.pop_bits( 8 ) );
+	daw::expecting( reader.overrun( ) );
+	daw::expecting( 24U + 100U + 57U + 8U, reader.bits_consumed( ) );
+	return true;
+}
+static_assert( daw_bit_reader_test_002( ) );
+
+void daw_bit_writer_test_002( ) {
+	// Round trip random widths, including the tail where the buffer has less
+	// than 8 bytes left
+	auto rng = daw::xoshiro256pp( 42U );
+	std::vector<std::pair<uint64_t, size_t>> values{ };
+	size_t total_bits = 0;
+	for( size_t n = 0; n < 10'000; ++n ) {
+		auto const width = daw::randint<size_t>( rng, 0, 64 );
+		auto const mask = width == 64 ? ~0ULL : ( 1ULL << width ) - 1U;
+		values.emplace_back( rng( ) & mask, width );
+		total_bits += width;
+	}
+	std::vector<unsigned char> buff( ( total_bits + 7U ) / 8U );
+	auto writer = daw::bit_writer( buff.data( ), buff.size( ) );
+	for( auto const &v : values ) {
+		writer.push_value( v.first, v.second );
+	}
+	daw::expecting( buff.size( ), writer.finish( ) );
+
+	auto reader = daw::bit_reader<unsigned char>( buff.data( ), buff.size( ) );
+	for( auto const &v : values ) {
+		daw::expecting( v.first, reader.pop_value( v.second ) );
+	}
+	daw::expecting( !reader.overrun( ) );
+	daw::expecting( reader.bits_remaining( ) < 8U );
+}
+
+void daw_bit_writer_test_003( ) {
+	unsigned char buff[2] = { };
+	auto writer = daw::bit_writer( buff, 2 );
+	writer.push_bits( 0xFFFFU, 16 );
+	daw::expecting_exception<std::out_of_range>(
+	  [&]( ) { writer.push_bits( 0xFFU, 8 ); } );
+
+	unsigned char big[16] = { };
+	auto writer2 = daw::bit_writer( big, 16 );
+	constexpr auto too_wide = decltype( writer2 )::max_push_bits + 1U;
+	daw::expecting_exception<std::invalid_argument>(
+	  [&]( ) { writer2.push_bits( 0U, too_wide ); } );
+}
+
+void daw_bit_reader_bench_001( ) {
+	constexpr size_t count = 1'000'000;
+	constexpr size_t pops = ( count * 8U ) / 5U;
+	auto data = daw::make_random_data<uint8_t>( count );
+	// bit_stream takes the low bits of each byte first and bit_reader the
+	// high bits, so bit_reader reads the same values written in its order
+	std::vector<uint8_t> msb_data( count );
+	{
+		auto bs = daw::make_bit_stream( data.begin( ), data.end( ) );
+		auto writer = daw::bit_writer( msb_data.data( ), msb_data.size( ) );
+		for( size_t n = 0; n < pops; ++n ) {
+			writer.push_bits( bs.pop_bits( 5 ), 5 );
+		}
+		daw::expecting( count, writer.finish( ) );
+	}
+	uint64_t sum1 = 0;
+	daw::show_benchmark(
+	  count, "bit_stream::pop_bits(5)",
+	  [&]( ) {
+		  auto bs = daw::make_bit_stream( data.begin( ), data.end( ) );
+		  sum1 = 0;
+		  for( size_t n = 0; n < pops; ++n ) {
+			  sum1 += bs.pop_bits( 5 );
+		  }
+	  },
+	  2, 2, pops );
+	uint64_t sum2 = 0;
+	daw::show_benchmark(
+	  count, "bit_reader::pop_bits(5)",
+	  [&]( ) {
+		  auto br = daw::bit_reader<uint8_t>( msb_data.data( ), msb_data.size( ) );
+		  sum2 = 0;
+		  for( size_t n = 0; n < pops; ++n ) {
+			  sum2 += br.pop_bits( 5 );
+		  }
+	  },
+	  2, 2, pops );
+	daw::expecting( sum1, sum2 );
+	uint64_t sum3 = 0;
+	daw::show_benchmark(
+	  count, "bit_reader::refill/peek_bits(5)",
+	  [&]( ) {
+		  auto br = daw::bit_reader<uint8_t>( msb_data.data( ), msb_data.size( ) );
+		  sum3 = 0;
+		  // One refill covers 11 pops of 5 bits
+		  size_t n = 0;
+		  for( ; n + 11U <= pops; n += 11U ) {
+			  br.refill( );
+			  for( size_t m = 0; m < 11U; ++m ) {
+				  sum3 += br.peek_bits( 5 );
+				  br.consume_bits( 5 );
+			  }
+		  }
+		  for( ; n < pops; ++n ) {
+			  sum3 += br.pop_bits( 5 );
+		  }
+	  },
+	  2, 2, pops );
+	daw::expecting( sum1, sum3 );
+}
+
+int main( ) {
+	daw_bit_writer_test_002( );
+	daw_bit_writer_test_003( );
+	daw_bit_reader_bench_001( );
+}
@@ -21,5 +21,15 @@ static_assert( 0b0001'0001 == daw::set_bits( 0u, 0u, 4u ) );
 static_assert( 0b1110'1111 == daw::unset_bits( 0b1111'1111, 4u ) );
 static_assert( 0b1110'1110 == daw::unset_bits( 0b1111'1111, 0u, 4u ) );
 static_assert( 0b0001'0101 == daw::get_bits( 0b1111'1111, 0u, 2u, 4u ) );
+static_assert( daw::is_power_of_two( 64U ) );
+static_assert( !daw::is_power_of_two( 0U ) );
+static_assert( !daw::is_power_of_two( 65U ) );
+static_assert( daw::bit_ceil( 0U ) == 1U );
+static_assert( daw::bit_ceil( 5U ) == 8U );
+static_assert( daw::bit_ceil( 64ULL ) == 64ULL );
+static_assert( daw::bit_ceil( 0x8000'0000U ) == 0x8000'0000U );
+static_assert( daw::bit_ceil( std::uint8_t{ 128 } ) == 128U );
+static_assert( daw::bit_log2( 1U ) == 0 );
+static_assert( daw::bit_log2( 64U ) == 6 );
 
 int main( ) {}
@@ -6,13 +6,19 @@
 // Official repository: https://github.com/beached/header_libraries
 //
 
+#include "daw/daw_benchmark.h"
 #include "daw/daw_bounded_hash_map.h"
 #include "daw/daw_fnv1a_hash.h"
+#include "daw/daw_random.h"
 #include "daw/daw_string_view.h"
 #include "daw/daw_utility.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace {
 	constexpr daw::bounded_hash_map<uint16_t, daw::string_view, 13,
@@ -69,4 +75,158 @@ test_const_002( daw::bounded_hash_map<daw::string_view, int, 100> &m,
 	return m[k];
 }
 
-int main( ) {}
+namespace {
+	constexpr auto const flat_status_codes =
+	  daw::make_bounded_flat_hash_map<uint16_t, daw::string_view,
+	                                  daw::fnv1a_hash_t>(
+	    { { 100, "Continue" },
+	      { 101, "Switching Protocols" },
+	      { 102, "Processing" },
+	      { 200, "OK" },
+	      { 201, "Created" },
+	      { 202, "Accepted" },
+	      { 203, "Non-Authoritative Information" },
+	      { 204, "No Content" },
+	      { 205, "Reset Content" },
+	      { 206, "Partial Content" },
+	      { 207, "Multi-Status" },
+	      { 208, "Already Reported" },
+	      { 226, "IM Used" } } );
+} // namespace
+
+constexpr bool flat_test_const_001( ) {
+	auto const &hm = flat_status_codes;
+	daw::expecting( hm.size( ), 13U );
+	daw::expecting( hm[204] == "No Content" );
+	daw::expecting( hm.find( 226 )->value == "IM Used" );
+	daw::expecting( not hm.exists( 300 ) );
+	daw::expecting( hm.find( 300 ) == hm.end( ) );
+	daw::expecting( not hm.try_get( 103 ) );
+	std::size_t count = 0;
+	for( auto const &kv : hm ) {
+		daw::expecting( not kv.value.empty( ) );
+		++count;
+	}
+	daw::expecting( count, 13U );
+	return true;
+}
+static_assert( flat_test_const_001( ) );
+
+constexpr bool flat_test_const_002( ) {
+	// Every key has the same hash, so each probe is as long as possible
+	struct bad_hash {
+		constexpr std::size_t operator( )( int ) const {
+			return 5;
+		}
+	};
+	daw::bounded_flat_hash_map<int, int, 40, bad_hash> m{ };
+	for( int n = 0; n < 40; ++n ) {
+		m[n] = n * 2;
+	}
+	daw::expecting( m.max_probe_length( ), 39U );
+	for( int n = 0; n < 40; n += 3 ) {
+		m.erase( n );
+	}
+	for( int n = 0; n < 40; ++n ) {
+		daw::expecting( m.exists( n ), n % 3 != 0 );
+		if( n % 3 != 0 ) {
+			daw::expecting( m[n], n * 2 );
+		}
+	}
+	return true;
+}
+static_assert( flat_test_const_002( ) );
+
+void flat_test_001( ) {
+	// Random inserts and erases against std::unordered_map
+	constexpr std::size_t capacity = 1000;
+	daw::bounded_flat_hash_map<std::uint32_t, std::uint32_t, capacity> m{ };
+	std::unordered_map<std::uint32_t, std::uint32_t> expected{ };
+	auto const keys = daw::make_random_data<std::uint32_t>( 20'000, 0, 1500 );
+	for( std::size_t n = 0; n < keys.size( ); ++n ) {
+		auto const key = keys[n];
+		if( n % 3 == 2 or expected.size( ) == capacity ) {
+			m.erase( key );
+			expected.erase( key );
+		} else {
+			m.insert( key, static_cast<std::uint32_t>( n ) );
+			expected[key] = static_cast<std::uint32_t>( n );
+		}
+		daw::expecting( m.size( ), expected.size( ) );
+	}
+	for( std::uint32_t key = 0; key <= 1500; ++key ) {
+		auto const pos = expected.find( key );
+		daw::expecting( m.exists( key ), pos != expected.end( ) );
+		if( pos != expected.end( ) ) {
+			daw::expecting( *m.try_get( key ), pos->second );
+		}
+	}
+	std::size_t visited = 0;
+	for( auto const &kv : m ) {
+		daw::expecting( expected.at( kv.key ), kv.value );
+		++visited;
+	}
+	daw::expecting( visited, expected.size( ) );
+	daw::expecting( m.max_probe_length( ) < 32U );
+}
+
+void flat_bench_001( ) {
+	std::cout << "bounded hash map field name lookup\n";
+	static constexpr std::size_t field_count = 64;
+	std::vector<std::string> names{ };
+	for( std::size_t n = 0; n < field_count; ++n ) {
+		names.push_back( "Header-Field-" + std::to_string( n * 7919 ) );
+	}
+	// Both tables have 128 slots
+	daw::bounded_hash_map<daw::string_view, std::size_t, field_count * 2,
+	                      daw::fnv1a_hash_t>
+	  linear{ };
+	daw::bounded_flat_hash_map<daw::string_view, std::size_t, field_count,
+	                           daw::fnv1a_hash_t>
+	  flat{ };
+	for( std::size_t n = 0; n < field_count; ++n ) {
+		linear.insert( daw::string_view( names[n] ), std::size_t{ n } );
+		flat.insert( daw::string_view( names[n] ), std::size_t{ n } );
+	}
+	// Half of the lookups miss
+	std::vector<std::string> queries{ };
+	auto const picks =
+	  daw::make_random_data<std::size_t>( 1'000'000, 0, field_count * 2 - 1 );
+	for( auto p : picks ) {
+		queries.push_back( p < field_count ? names[p]
+		                                   : "X-Unknown-" + std::to_string( p ) );
+	}
+	auto const bytes = queries.size( ) * sizeof( daw::string_view );
+	std::size_t sum_linear = 0;
+	daw::show_benchmark(
+	  bytes, "bounded_hash_map",
+	  [&]( ) {
+		  std::size_t sum = 0;
+		  for( auto const &q : queries ) {
+			  if( auto v = linear.try_get( daw::string_view( q ) ) ) {
+				  sum += *v;
+			  }
+		  }
+		  sum_linear = sum;
+	  },
+	  2, 2, queries.size( ) );
+	std::size_t sum_flat = 0;
+	daw::show_benchmark(
+	  bytes, "bounded_flat_hash_map",
+	  [&]( ) {
+		  std::size_t sum = 0;
+		  for( auto const &q : queries ) {
+			  if( auto v = flat.try_get( daw::string_view( q ) ) ) {
+				  sum += *v;
+			  }
+		  }
+		  sum_flat = sum;
+	  },
+	  2, 2, queries.size( ) );
+	daw::expecting( sum_flat, sum_linear );
+}
+
+int main( ) {
+	flat_test_001( );
+	flat_bench_001( );
+}
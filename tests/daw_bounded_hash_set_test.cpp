@@ -59,4 +59,39 @@ constexpr bool make_hash_set_001( ) {
 }
 static_assert( make_hash_set_001( ) );
 
+constexpr bool flat_test_001( ) {
+	daw::bounded_flat_hash_set<size_t, 1024ULL, daw::fnv1a_hash_t> adapt{ };
+	for( size_t n = 0; n < 1024ULL; n += 2 ) {
+		adapt.insert( n );
+	}
+	adapt.insert( 0 );
+	daw::expecting( adapt.size( ), 512U );
+	for( size_t n = 0; n < 1024ULL; ++n ) {
+		daw::expecting( adapt.exists( n ), n % 2 == 0 );
+	}
+	for( size_t n = 0; n < 1024ULL; n += 4 ) {
+		daw::expecting( adapt.erase( n ), 1U );
+	}
+	daw::expecting( adapt.erase( 1 ), 0U );
+	daw::expecting( adapt.size( ), 256U );
+	size_t count = 0;
+	for( auto key : adapt ) {
+		daw::expecting( key % 4, 2U );
+		++count;
+	}
+	daw::expecting( count, 256U );
+	return true;
+}
+static_assert( flat_test_001( ) );
+
+constexpr bool make_flat_hash_set_001( ) {
+	using namespace daw::string_view_literals;
+	auto hs = daw::make_bounded_flat_hash_set<daw::string_view,
+	                                          daw::fnv1a_hash_t>(
+	  { "hello"_sv, "there"_sv } );
+	return hs.count( "hello" ) == 1 and hs.count( "world" ) == 0 and
+	       *hs.find( "there" ) == "there";
+}
+static_assert( make_flat_hash_set_001( ) );
+
 int main( ) {}
@@ -6,11 +6,17 @@
 // Official repository: https://github.com/beached/header_libraries
 //
 
+#define DAW_CHECK_COUNTERS
+
 #include "daw/daw_benchmark.h"
 #include "daw/daw_exception.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 void test_01( ) {
 	daw::expecting( []( ) {
@@ -25,6 +31,84 @@ void test_01( ) {
 	  []( ) { daw::exception::precondition_check<std::exception>( false ); } );
 }
 
+static_assert( daw::exception::contract_checks_v );
+
+constexpr bool test_constexpr_001( ) {
+	daw::exception::precondition_check( true );
+	daw::exception::dbg_precondition_check( 1 == 1 );
+	daw::exception::precondition_check<std::out_of_range>( true, "never" );
+	return true;
+}
+static_assert( test_constexpr_001( ) );
+
+[[gnu::noinline]] int checked_digit( char c ) {
+	daw::exception::precondition_check<std::invalid_argument>(
+	  c >= '0' and c <= '9', "Expected a digit" );
+	return c - '0';
+}
+
+[[gnu::noinline]] int checked_letter( char c ) {
+	daw::exception::daw_throw_on_false<std::invalid_argument>(
+	  c >= 'a' and c <= 'z', "Expected a letter" );
+	return c - 'a';
+}
+
+void test_02( ) {
+	// Messages of any length and type still reach the exception
+	daw::expecting_exception<std::out_of_range>( [] {
+		daw::exception::daw_throw_on_false<std::out_of_range>( false,
+		                                                       "short" );
+	} );
+	daw::expecting_exception<std::out_of_range>( [] {
+		daw::exception::daw_throw_on_true<std::out_of_range>(
+		  true, std::string( "a message that is a std::string" ) );
+	} );
+
+	auto const before = daw::exception::check_failure_count( );
+	std::string const input = "12a4b";
+	int sum = 0;
+	std::size_t failures = 0;
+	for( int n = 0; n < 10; ++n ) {
+		for( char c : input ) {
+			try {
+				sum += checked_digit( c );
+			} catch( std::invalid_argument const &ex ) {
+				daw::expecting( std::string( ex.what( ) ), "Expected a digit" );
+				++failures;
+			}
+		}
+	}
+	daw::expecting( sum, 70 );
+	daw::expecting( failures, 20U );
+	daw::expecting( daw::exception::check_failure_count( ) - before, 20U );
+
+	for( char c : input ) {
+		try {
+			sum += checked_letter( c );
+		} catch( std::invalid_argument const & ) { ++failures; }
+	}
+	daw::expecting( failures, 23U );
+
+	// The failures in checked_digit and checked_letter are two sites, each
+	// recorded where the check is written and not where it fails
+	std::uint_least32_t digit_line = 0;
+	std::uint_least32_t letter_line = 0;
+	daw::exception::for_each_check_failure(
+	  [&]( daw::exception::check_site_count const &site ) {
+		  daw::expecting( site.site.file != nullptr );
+		  daw::expecting( std::string( site.site.file ).find(
+		                    "daw_exception_test.cpp" ) != std::string::npos );
+		  if( site.count == 20U ) {
+			  digit_line = site.site.line;
+		  } else if( site.count == 3U ) {
+			  letter_line = site.site.line;
+		  }
+	  } );
+	daw::expecting( digit_line != 0 );
+	daw::expecting( letter_line > digit_line );
+}
+
 int main( ) {
 	test_01( );
+	test_02( );
 }
@@ -13,9 +13,12 @@
 #include <cstddef>
 #include <exception>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 daw::expected_t<int> divide( int v ) {
 	try {
@@ -200,6 +203,211 @@ void daw_expected_test_move_construction_002( ) {
 	daw::expecting_exception( [&]( ) { tmp2.get( ); } );
 }
 
+enum class parse_errc { empty, bad_digit, overflow };
+
+static_assert( std::is_trivially_copyable_v<daw::expected<int, parse_errc>> );
+static_assert( std::is_trivially_copyable_v<daw::expected<void, parse_errc>> );
+static_assert( sizeof( daw::expected<int, parse_errc> ) == 2 * sizeof( int ) );
+static_assert(
+  not std::is_trivially_copyable_v<daw::expected<std::string, int>> );
+static_assert(
+  not std::is_copy_constructible_v<daw::expected<std::unique_ptr<int>, int>> );
+static_assert( std::is_nothrow_move_constructible_v<
+               daw::expected<std::unique_ptr<int>, int>> );
+
+constexpr daw::expected<int, parse_errc> parse_digit( char c ) {
+	if( c < '0' or c > '9' ) {
+		return daw::unexpected( parse_errc::bad_digit );
+	}
+	return c - '0';
+}
+
+constexpr bool daw_expected_std_test_001( ) {
+	constexpr auto a = parse_digit( '7' );
+	static_assert( a.has_value( ) and *a == 7 );
+	auto const b = parse_digit( 'x' );
+	daw::expecting( not b );
+	daw::expecting( b.error( ) == parse_errc::bad_digit );
+	daw::expecting( b.value_or( -1 ), -1 );
+
+	auto const c = a.and_then( []( int v ) -> daw::expected<int, parse_errc> {
+		                return v * 2;
+	                } )
+	                 .transform( []( int v ) { return v + 1; } );
+	daw::expecting( c.value( ), 15 );
+	auto const d = b.transform( []( int v ) { return v + 1; } );
+	daw::expecting( d == daw::unexpected( parse_errc::bad_digit ) );
+	auto const e = b.or_else( []( parse_errc ) {
+		return daw::expected<int, parse_errc>( 0 );
+	} );
+	daw::expecting( e == 0 );
+	auto const f =
+	  b.transform_error( []( parse_errc ec ) { return static_cast<int>( ec ); } );
+	daw::expecting( f.error( ), 1 );
+	daw::expecting( a != b );
+	return true;
+}
+static_assert( daw_expected_std_test_001( ) );
+
+void daw_expected_std_test_002( ) {
+	using result_t = daw::expected<std::string, std::string>;
+	result_t a = std::string( "hello" );
+	result_t b = daw::unexpected( std::string( "bad" ) );
+	result_t c = a;
+	daw::expecting( *c, "hello" );
+	c = b;
+	daw::expecting( c.error( ), "bad" );
+	c = std::move( a );
+	daw::expecting( c->size( ), 5U );
+	c.emplace( 3, 'x' );
+	daw::expecting( *c, "xxx" );
+	daw::expecting_exception<daw::bad_expected_access<std::string>>(
+	  [&] { (void)b.value( ); } );
+	auto const len = std::move( c ).transform(
+	  []( std::string &&s ) { return s.size( ); } );
+	daw::expecting( *len, 3U );
+
+	daw::expected<void, std::string> v{ };
+	daw::expecting( v.has_value( ) );
+	v.value( );
+	auto const v2 =
+	  v.and_then( [] { return daw::expected<int, std::string>( 42 ); } );
+	daw::expecting( *v2, 42 );
+	daw::expected<void, std::string> v3( daw::unexpect, "fail" );
+	daw::expecting( v3.transform( [] { return 1; } ).error( ), "fail" );
+	daw::expecting_exception<daw::bad_expected_access<std::string>>(
+	  [&] { v3.value( ); } );
+
+	daw::expected<std::unique_ptr<int>, int> p( std::make_unique<int>( 5 ) );
+	auto p2 = std::move( p );
+	daw::expecting( **p2, 5 );
+}
+
+namespace {
+	// Construction from an int throws when asked to
+	struct throws_on_int {
+		std::string value{ };
+
+		explicit throws_on_int( std::string v )
+		  : value( std::move( v ) ) {}
+
+		explicit throws_on_int( int fail ) {
+			if( fail != 0 ) {
+				throw std::runtime_error( "construction failed" );
+			}
+		}
+	};
+} // namespace
+
+void daw_expected_std_test_003( ) {
+	// emplace keeps the old value or error when the new value throws
+	using result_t = daw::expected<throws_on_int, std::string>;
+	result_t a( std::in_place, std::string( "kept" ) );
+	daw::expecting_exception<std::runtime_error>( [&] { a.emplace( 1 ); } );
+	daw::expecting( a.has_value( ) );
+	daw::expecting( a->value, "kept" );
+	a.emplace( std::string( "new" ) );
+	daw::expecting( a->value, "new" );
+
+	result_t b( daw::unexpect, "error" );
+	daw::expecting_exception<std::runtime_error>( [&] { b.emplace( 1 ); } );
+	daw::expecting( not b.has_value( ) );
+	daw::expecting( b.error( ), "error" );
+	b.emplace( 0 );
+	daw::expecting( b.has_value( ) );
+}
+
+namespace {
+	// The same four level parse chain using the exception_ptr based expected_t
+	// and the error code based expected
+	daw::expected<unsigned, parse_errc> parse_std( std::string_view sv ) {
+		if( sv.empty( ) ) {
+			return daw::unexpected( parse_errc::empty );
+		}
+		unsigned result = 0;
+		for( char c : sv ) {
+			if( c < '0' or c > '9' ) {
+				return daw::unexpected( parse_errc::bad_digit );
+			}
+			result = result * 10U + static_cast<unsigned>( c - '0' );
+		}
+		return result;
+	}
+
+	daw::expected_t<unsigned> parse_eptr( std::string_view sv ) {
+		if( sv.empty( ) ) {
+			return std::make_exception_ptr( std::invalid_argument( "empty" ) );
+		}
+		unsigned result = 0;
+		for( char c : sv ) {
+			if( c < '0' or c > '9' ) {
+				return std::make_exception_ptr( std::invalid_argument( "digit" ) );
+			}
+			result = result * 10U + static_cast<unsigned>( c - '0' );
+		}
+		return daw::expected_t<unsigned>( result );
+	}
+
+	template<int Depth>
+	[[gnu::noinline]] daw::expected<unsigned, parse_errc>
+	deep_std( std::string_view sv ) {
+		if constexpr( Depth == 0 ) {
+			return parse_std( sv );
+		} else {
+			return deep_std<Depth - 1>( sv ).transform(
+			  []( unsigned v ) { return v + 1U; } );
+		}
+	}
+
+	template<int Depth>
+	[[gnu::noinline]] daw::expected_t<unsigned> deep_eptr( std::string_view sv ) {
+		if constexpr( Depth == 0 ) {
+			return parse_eptr( sv );
+		} else {
+			auto result = deep_eptr<Depth - 1>( sv );
+			if( not result.has_value( ) ) {
+				return result;
+			}
+			return daw::expected_t<unsigned>( *result + 1U );
+		}
+	}
+} // namespace
+
+void daw_expected_bench_001( ) {
+	std::cout << "expected through a 4 deep call chain, 1 in 8 fail\n";
+	std::vector<std::string> inputs{ };
+	for( unsigned n = 0; n < 100'000; ++n ) {
+		inputs.push_back( n % 8U == 0 ? "12x4" : std::to_string( n ) );
+	}
+	std::size_t const bytes = inputs.size( ) * sizeof( unsigned );
+	unsigned sum_eptr = 0;
+	daw::show_benchmark(
+	  bytes, "daw::expected_t<unsigned>",
+	  [&]( ) {
+		  unsigned sum = 0;
+		  for( auto const &s : inputs ) {
+			  auto r = deep_eptr<4>( s );
+			  if( r.has_value( ) ) {
+				  sum += *r;
+			  }
+		  }
+		  sum_eptr = sum;
+	  },
+	  2, 2, inputs.size( ) );
+	unsigned sum_std = 0;
+	daw::show_benchmark(
+	  bytes, "daw::expected<unsigned, parse_errc>",
+	  [&]( ) {
+		  unsigned sum = 0;
+		  for( auto const &s : inputs ) {
+			  sum += deep_std<4>( s ).value_or( 0U );
+		  }
+		  sum_std = sum;
+	  },
+	  2, 2, inputs.size( ) );
+	daw::expecting( sum_std, sum_eptr );
+}
+
 int main( ) {
 	daw_expected_test_01( );
 	daw_expected_test_02( );
@@ -209,4 +417,7 @@ int main( ) {
 	daw_expected_test_move_construction_001( );
 	daw_expected_test_move_assignment_002( );
 	daw_expected_test_move_construction_002( );
+	daw_expected_std_test_002( );
+	daw_expected_std_test_003( );
+	daw_expected_bench_001( );
 }
@@ -66,12 +66,64 @@ constexpr bool daw_make_fixed_lookup_001( ) {
 static_assert( daw_make_fixed_lookup_001( ) );
 #endif
 
+constexpr bool daw_bucketed_fixed_lookup_001( ) {
+	daw::bucketed_fixed_lookup<int, 10> blah{ };
+	blah['a'] = 1;
+	blah['2'] = 3;
+	blah[4] = 4;
+	blah.insert( "hello", 5 );
+	daw::expecting( blah['a'], 1 );
+	daw::expecting( blah['2'], 3 );
+	daw::expecting( blah[4], 4 );
+	daw::expecting( blah["hello"], 5 );
+	daw::expecting( 4U, blah.size( ) );
+	daw::expecting( !blah.exists( 5 ) );
+	return true;
+}
+static_assert( daw_bucketed_fixed_lookup_001( ) );
+
+constexpr bool daw_bucketed_fixed_lookup_002( ) {
+	// Fill to capacity so that probing has to cross bucket boundaries
+	using lookup_t = daw::bucketed_fixed_lookup<uint32_t, 40, 4>;
+	static_assert( daw::is_power_of_two( lookup_t::bucket_count ) );
+	static_assert( lookup_t::capacity( ) >= 40U );
+	lookup_t blah{ };
+	for( uint32_t n = 0; n < lookup_t::capacity( ); ++n ) {
+		blah[n] = n * 2U;
+	}
+	daw::expecting( blah.capacity( ), blah.size( ) );
+	for( uint32_t n = 0; n < lookup_t::capacity( ); ++n ) {
+		daw::expecting( n * 2U, blah[n] );
+	}
+	return true;
+}
+static_assert( daw_bucketed_fixed_lookup_002( ) );
+
+constexpr bool daw_make_bucketed_fixed_lookup_001( ) {
+	auto values =
+	  daw::make_bucketed_fixed_lookup<int>( "hello", 3, 5, 6, "why oh why" );
+	daw::expecting( 5U, values.size( ) );
+	daw::expecting( values.exists( "why oh why" ) );
+	return true;
+}
+static_assert( daw_make_bucketed_fixed_lookup_001( ) );
+
+void daw_bucketed_fixed_lookup_003( ) {
+	daw::bucketed_fixed_lookup<int, 2> blah{ };
+	auto const cap = static_cast<int>( blah.capacity( ) );
+	for( int n = 0; n < cap; ++n ) {
+		blah[n] = n;
+	}
+	daw::expecting_exception<std::exception>( [&]( ) { blah[cap] = cap; } );
+}
+
 template<typename ValueType, ValueType SZ, size_t HashSize>
 void do_test( ) {
 	std::cout << "Testing with SZ = " << SZ << " and hash_size = " << HashSize
 	          << '\n';
 	using value_t = ValueType;
 	daw::fixed_lookup<value_t, SZ * 2> lookup{ };
+	daw::bucketed_fixed_lookup<value_t, SZ * 2> bucketed_lookup{ };
 	std::unordered_map<value_t, value_t> hash_map{ };
 	std::vector<value_t> ary{ };
 	ary.resize( SZ );
@@ -84,6 +136,14 @@ void do_test( ) {
 		  }
 	  },
 	  2, 2, SZ );
+	daw::show_benchmark(
+	  SZ * sizeof( value_t ), "bucketed_fixed_lookup(fill)",
+	  [&]( ) {
+		  for( value_t n = 0; n < SZ; ++n ) {
+			  bucketed_lookup[n] = n;
+		  }
+	  },
+	  2, 2, SZ );
 	daw::show_benchmark(
 	  SZ * sizeof( value_t ), "unordered_map(fill)",
 	  [&]( ) {
@@ -110,6 +170,15 @@ void do_test( ) {
 		  }
 	  },
 	  2, 2, SZ );
+	intmax_t sum4 = 0;
+	daw::show_benchmark(
+	  SZ * sizeof( value_t ), "bucketed_fixed_lookup(summation)",
+	  [&]( ) {
+		  for( value_t n = 0; n < SZ; ++n ) {
+			  sum4 += bucketed_lookup[n];
+		  }
+	  },
+	  2, 2, SZ );
 	intmax_t sum2 = 0;
 	daw::show_benchmark(
 	  SZ * sizeof( value_t ), "unordered_map(summation)",
@@ -130,6 +199,7 @@ void do_test( ) {
 	  2, 2, SZ );
 	daw::expecting( sum1, sum2 );
 	daw::expecting( sum1, sum3 );
+	daw::expecting( sum1, sum4 );
 	std::cout << "sum1: " << sum1 << " sum2: " << sum2 << " sum3: " << sum3
 	          << '\n';
 }
@@ -142,5 +212,6 @@ void daw_fixed_lookup_bench_001( ) {
 int main( ) {
 	daw_make_fixed_lookup_001( );
 	daw_fixed_lookup_001( );
+	daw_bucketed_fixed_lookup_003( );
 	daw_fixed_lookup_bench_001( );
 }
@@ -9,7 +9,13 @@
 #include "daw/daw_benchmark.h"
 #include "daw/daw_keep_n.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <random>
+#include <vector>
 
 constexpr bool keep_n_test_001( ) {
 	daw::keep_n<int, 3> top3( std::numeric_limits<int>::max( ) );
@@ -26,4 +32,126 @@ constexpr bool keep_n_test_001( ) {
 }
 static_assert( keep_n_test_001( ) );
 
-int main( ) {}
+constexpr bool keep_n_heap_test_001( ) {
+	daw::keep_n_heap<int, 3> top3{ };
+	daw::expecting( top3.empty( ) );
+	top3.insert( 5 );
+	top3.insert( 0 );
+	daw::expecting( 2U, top3.size( ) );
+	top3.insert( 1 );
+	top3.insert( 50 );
+	top3.insert( -50 );
+	daw::expecting( top3.full( ) );
+	daw::expecting( 1, top3.threshold( ) );
+
+	std::array<int, 3> result{ };
+	top3.copy_sorted( result.begin( ) );
+	daw::expecting( -50, result[0] );
+	daw::expecting( 0, result[1] );
+	daw::expecting( 1, result[2] );
+	return true;
+}
+static_assert( keep_n_heap_test_001( ) );
+
+constexpr bool keep_n_heap_test_002( ) {
+	std::array<int, 40> values{ };
+	for( size_t n = 0; n < values.size( ); ++n ) {
+		values[n] = static_cast<int>( ( n * 13U ) % 40U );
+	}
+	daw::keep_n_heap<int, 4, daw::keep_n_order::descending> top4{ };
+	top4.insert( values.begin( ), values.end( ) );
+	std::array<int, 4> result{ };
+	top4.copy_sorted( result.begin( ) );
+	daw::expecting( 39, result[0] );
+	daw::expecting( 38, result[1] );
+	daw::expecting( 37, result[2] );
+	daw::expecting( 36, result[3] );
+	return true;
+}
+static_assert( keep_n_heap_test_002( ) );
+
+void keep_n_heap_test_003( ) {
+	std::mt19937_64 rng( 1234 );
+	std::vector<unsigned> values( 100'000 );
+	for( auto &v : values ) {
+		v = static_cast<unsigned>( rng( ) );
+	}
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ), std::greater<>{ } );
+	expected.resize( 1000 );
+
+	auto top = std::make_unique<
+	  daw::keep_n_heap<unsigned, 1000, daw::keep_n_order::descending>>( );
+	top->insert( values.begin( ), values.end( ) );
+	daw::expecting( expected, top->sorted( ) );
+
+	// Per thread style partial results merged together
+	auto lhs = std::make_unique<
+	  daw::keep_n_heap<unsigned, 1000, daw::keep_n_order::descending>>( );
+	auto rhs = std::make_unique<
+	  daw::keep_n_heap<unsigned, 1000, daw::keep_n_order::descending>>( );
+	auto const mid = values.begin( ) + 37'123;
+	lhs->insert( values.begin( ), mid );
+	rhs->insert( mid, values.end( ) );
+	lhs->merge( *rhs );
+	daw::expecting( expected, lhs->sorted( ) );
+
+	// Merging with itself is the same as merging a copy
+	for( std::size_t count : { 0U, 1U, 7U, 499U, 500U, 501U, 2'000U } ) {
+		auto self = std::make_unique<
+		  daw::keep_n_heap<unsigned, 1000, daw::keep_n_order::descending>>( );
+		self->insert( values.begin( ), values.begin( ) + count );
+		auto copy = std::make_unique<
+		  daw::keep_n_heap<unsigned, 1000, daw::keep_n_order::descending>>( *self );
+		copy->merge( *self );
+		self->merge( *self );
+		daw::expecting( copy->sorted( ), self->sorted( ) );
+		daw::expecting( std::min<std::size_t>( 2 * count, 1000 ), self->size( ) );
+		// Still a valid heap
+		self->insert( values.begin( ), values.end( ) );
+		copy->insert( values.begin( ), values.end( ) );
+		daw::expecting( copy->sorted( ), self->sorted( ) );
+	}
+}
+
+void keep_n_heap_bench_001( ) {
+	std::mt19937_64 rng( 42 );
+	std::vector<int> values( 50'000 );
+	for( auto &v : values ) {
+		v = static_cast<int>( rng( ) % 100'000'000U );
+	}
+	using keep_n_t = daw::keep_n<int, 1000, daw::keep_n_order::descending>;
+	auto top_n = std::make_unique<keep_n_t>( std::numeric_limits<int>::min( ) );
+	daw::show_benchmark(
+	  values.size( ) * sizeof( int ), "keep_n<1000>",
+	  [&]( ) {
+		  for( auto v : values ) {
+			  top_n->insert( v );
+		  }
+	  },
+	  2, 2, values.size( ) );
+	using keep_n_heap_t =
+	  daw::keep_n_heap<int, 1000, daw::keep_n_order::descending>;
+	auto top_h = std::make_unique<keep_n_heap_t>( );
+	daw::show_benchmark(
+	  values.size( ) * sizeof( int ), "keep_n_heap<1000>(insert)",
+	  [&]( ) {
+		  for( auto v : values ) {
+			  top_h->insert( v );
+		  }
+	  },
+	  2, 2, values.size( ) );
+	auto top_r = std::make_unique<keep_n_heap_t>( );
+	daw::show_benchmark(
+	  values.size( ) * sizeof( int ), "keep_n_heap<1000>(range insert)",
+	  [&]( ) { top_r->insert( values.begin( ), values.end( ) ); }, 2, 2,
+	  values.size( ) );
+	auto const h = top_h->sorted( );
+	daw::expecting( h, top_r->sorted( ) );
+	daw::expecting( std::equal( h.begin( ), h.end( ), top_n->begin( ) ) );
+}
+
+int main( ) {
+	keep_n_heap_test_003( );
+	keep_n_heap_bench_001( );
+}
@@ -0,0 +1,182 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_heap_array.h"
+#include "daw/daw_md_view.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+constexpr bool md_view_test_001( ) {
+	std::array<int, 6> values{ 0, 1, 2, 3, 4, 5 };
+	daw::md_view<int, 2> row( values, { 2, 3 } );
+	daw::expecting( row( 1, 0 ), 3 );
+	daw::expecting( row( 0, 2 ), 2 );
+	daw::expecting( row.size( ), 6U );
+
+	daw::md_view<int, 2, daw::layout_column_major> col( values, { 2, 3 } );
+	daw::expecting( col( 1, 0 ), 1 );
+	daw::expecting( col( 0, 2 ), 4 );
+
+	// Every second column of the row major view
+	daw::md_view<int, 2, daw::layout_stride> strided(
+	  values.data( ), { { 2, 2 }, { 3, 2 } } );
+	daw::expecting( strided( 1, 1 ), 5 );
+	daw::expecting( strided.required_span_size( ), 6U );
+
+	int sum = 0;
+	daw::md_for_each( col, [&]( int v ) { sum += v; } );
+	daw::expecting( sum, 15 );
+	return true;
+}
+static_assert( md_view_test_001( ) );
+
+constexpr bool md_view_test_002( ) {
+	using tiled_t = daw::layout_tiled<2>;
+	daw::md_view<int const, 2, tiled_t> tiled( nullptr, { 3, 3 } );
+	daw::expecting( tiled.required_span_size( ), 16U );
+	daw::expecting( tiled.mapping( )( { 0, 1 } ), 1U );
+	daw::expecting( tiled.mapping( )( { 1, 0 } ), 2U );
+	daw::expecting( tiled.mapping( )( { 0, 2 } ), 4U );
+	daw::expecting( tiled.mapping( )( { 2, 0 } ), 8U );
+
+	daw::md_view<int const, 2, daw::layout_morton> morton( nullptr, { 4, 4 } );
+	daw::expecting( morton.required_span_size( ), 16U );
+	daw::expecting( morton.mapping( )( { 0, 1 } ), 1U );
+	daw::expecting( morton.mapping( )( { 1, 0 } ), 2U );
+	daw::expecting( morton.mapping( )( { 1, 1 } ), 3U );
+	daw::expecting( morton.mapping( )( { 0, 2 } ), 4U );
+	daw::expecting( morton.mapping( )( { 3, 3 } ), 15U );
+
+	// 2 x 8, the extra column bits go above the interleaved ones
+	daw::md_view<int const, 2, daw::layout_morton> wide( nullptr, { 2, 8 } );
+	daw::expecting( wide.required_span_size( ), 16U );
+	daw::expecting( wide.mapping( )( { 1, 1 } ), 3U );
+	daw::expecting( wide.mapping( )( { 0, 2 } ), 4U );
+	daw::expecting( wide.mapping( )( { 1, 7 } ), 15U );
+	return true;
+}
+static_assert( md_view_test_002( ) );
+
+// Every layout must be a bijection from the index space into its storage
+template<typename Layout>
+void md_view_layout_check( std::size_t rows, std::size_t cols ) {
+	typename Layout::template mapping<2> map( { rows, cols } );
+	std::vector<int> seen( map.required_span_size( ), 0 );
+	for( std::size_t i = 0; i < rows; ++i ) {
+		for( std::size_t j = 0; j < cols; ++j ) {
+			auto const off = map( { i, j } );
+			daw::expecting( off < seen.size( ) );
+			daw::expecting( seen[off]++, 0 );
+		}
+	}
+}
+
+void md_view_test_003( ) {
+	for( std::size_t rows : { 1U, 5U, 16U, 33U } ) {
+		for( std::size_t cols : { 1U, 7U, 16U, 40U } ) {
+			md_view_layout_check<daw::layout_right>( rows, cols );
+			md_view_layout_check<daw::layout_left>( rows, cols );
+			md_view_layout_check<daw::layout_tiled<4, 8>>( rows, cols );
+			md_view_layout_check<daw::layout_morton>( rows, cols );
+		}
+	}
+
+	daw::heap_array<double> values( 12 );
+	std::iota( values.begin( ), values.end( ), 0.0 );
+	daw::md_view<double, 3> cube( values, { 2, 3, 2 } );
+	daw::expecting( cube( 1, 2, 1 ), 11.0 );
+	daw::expecting( cube.at( 1, 0, 1 ), 7.0 );
+	daw::expecting_exception<std::out_of_range>(
+	  [&]( ) { (void)cube.at( 2, 0, 0 ); } );
+	daw::expecting_exception<std::out_of_range>( [&]( ) {
+		(void)daw::md_view<double, 2>( values, { 4, 4 } );
+	} );
+
+	std::vector<double> visited{ };
+	daw::md_for_each( daw::md_view<double, 3, daw::layout_left>(
+	                    values, { 2, 3, 2 } ),
+	                  [&]( double v ) { visited.push_back( v ); } );
+	daw::expecting( std::equal( visited.begin( ), visited.end( ),
+	                            values.begin( ), values.end( ) ) );
+}
+
+template<typename DstLayout>
+void md_transpose_check( std::size_t rows, std::size_t cols ) {
+	std::vector<int> src_data( rows * cols );
+	std::iota( src_data.begin( ), src_data.end( ), 0 );
+	daw::md_view<int const, 2> src( src_data, { rows, cols } );
+	typename DstLayout::template mapping<2> map( { cols, rows } );
+	std::vector<int> dst_data( map.required_span_size( ) );
+	daw::md_view<int, 2, DstLayout> dst( dst_data, { cols, rows } );
+	daw::md_transpose( src, dst, 8 );
+	for( std::size_t i = 0; i < rows; ++i ) {
+		for( std::size_t j = 0; j < cols; ++j ) {
+			daw::expecting( dst( j, i ), src( i, j ) );
+		}
+	}
+}
+
+void md_view_test_004( ) {
+	md_transpose_check<daw::layout_right>( 1, 1 );
+	md_transpose_check<daw::layout_right>( 17, 45 );
+	md_transpose_check<daw::layout_left>( 33, 9 );
+	md_transpose_check<daw::layout_tiled<8>>( 20, 30 );
+	md_transpose_check<daw::layout_morton>( 13, 64 );
+
+	std::size_t count = 0;
+	daw::md_for_each_tiled(
+	  10, 7, [&]( std::size_t, std::size_t ) { ++count; }, 4, 3 );
+	daw::expecting( count, 70U );
+	daw::expecting_exception<std::invalid_argument>( [] {
+		daw::md_for_each_tiled( 1, 1, []( std::size_t, std::size_t ) {}, 0 );
+	} );
+}
+
+void md_view_bench_001( ) {
+	std::cout << "md_view transpose\n";
+	constexpr std::size_t n = 2048;
+	std::vector<double> src_data( n * n );
+	std::iota( src_data.begin( ), src_data.end( ), 0.0 );
+	std::vector<double> dst_data( n * n );
+	daw::md_view<double const, 2> src( src_data, { n, n } );
+	daw::md_view<double, 2> dst( dst_data, { n, n } );
+	auto const bytes = n * n * sizeof( double );
+
+	daw::show_benchmark(
+	  bytes, "naive transpose",
+	  [&]( ) {
+		  for( std::size_t i = 0; i < n; ++i ) {
+			  for( std::size_t j = 0; j < n; ++j ) {
+				  dst( j, i ) = src( i, j );
+			  }
+		  }
+		  daw::do_not_optimize( dst_data );
+	  },
+	  2, 2, n * n );
+	daw::show_benchmark(
+	  bytes, "daw::md_transpose",
+	  [&]( ) {
+		  daw::md_transpose( src, dst );
+		  daw::do_not_optimize( dst_data );
+	  },
+	  2, 2, n * n );
+	daw::expecting( dst( 3, 5 ), src( 5, 3 ) );
+}
+
+int main( ) {
+	md_view_test_003( );
+	md_view_test_004( );
+	md_view_bench_001( );
+}
@@ -0,0 +1,207 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_multi_pattern_search.h"
+#include "daw/daw_random.h"
+#include "daw/daw_string_view.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Every match of every pattern, one pattern at a time
+	std::vector<daw::pattern_match>
+	naive_find_all( std::vector<std::string> const &patterns,
+	                daw::string_view haystack ) {
+		auto result = std::vector<daw::pattern_match>( );
+		for( std::size_t p = 0; p < patterns.size( ); ++p ) {
+			auto const pattern = daw::string_view( patterns[p] );
+			for( auto pos = haystack.find( pattern ); pos != daw::string_view::npos;
+			     pos = haystack.find( pattern, pos + 1 ) ) {
+				result.push_back( daw::pattern_match{ p, pos, pattern.size( ) } );
+			}
+		}
+		std::sort( result.begin( ), result.end( ) );
+		return result;
+	}
+
+	// Text over a small alphabet so that patterns taken from it match often
+	std::string make_text( std::size_t size, char last_letter ) {
+		auto const letters = daw::make_random_data<std::size_t>(
+		  size, 0, static_cast<std::size_t>( last_letter - 'a' ) );
+		auto result = std::string( );
+		for( auto l : letters ) {
+			result.push_back( static_cast<char>( 'a' + l ) );
+		}
+		return result;
+	}
+
+	std::vector<std::string> make_patterns( std::string const &text,
+	                                        std::size_t count,
+	                                        std::size_t max_size ) {
+		auto const picks =
+		  daw::make_random_data<std::size_t>( count * 2, 0, text.size( ) - 1 );
+		auto result = std::vector<std::string>( );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto const pos = picks[2 * n] % ( text.size( ) - max_size );
+			result.push_back( text.substr( pos, 1 + picks[2 * n + 1] % max_size ) );
+		}
+		return result;
+	}
+
+	void check_searcher( std::vector<std::string> const &patterns,
+	                     std::string const &haystack ) {
+		auto const searcher =
+		  daw::multi_pattern_searcher( patterns.begin( ), patterns.end( ) );
+		auto const expected = naive_find_all( patterns, haystack );
+		auto const found = searcher.find_all( haystack );
+		daw::expecting( found.size( ), expected.size( ) );
+		daw::expecting( found == expected );
+		auto const first = searcher.find_first( haystack );
+		daw::expecting( first.has_value( ), not expected.empty( ) );
+		if( first ) {
+			daw::expecting( *first == expected.front( ) );
+		}
+		daw::expecting( searcher.contains_any( haystack ), not expected.empty( ) );
+	}
+} // namespace
+
+void multi_pattern_search_test_001( ) {
+	auto const searcher =
+	  daw::multi_pattern_searcher{ "he", "she", "his", "hers", "she" };
+	daw::expecting( searcher.size( ), 5U );
+	daw::expecting( searcher.pattern( 2 ) == "his" );
+	auto const found = searcher.find_all( "ushers" );
+	auto const expected = std::vector<daw::pattern_match>{
+	  { 1, 1, 3 }, { 4, 1, 3 }, { 0, 2, 2 }, { 3, 2, 4 } };
+	daw::expecting( found == expected );
+
+	auto const first = searcher.find_first( "a hishers" );
+	daw::expecting( first.has_value( ) );
+	daw::expecting( first->pattern, 2U );
+	daw::expecting( first->position, 2U );
+	daw::expecting( not searcher.contains_any( "no match at all" ) );
+
+	// The patterns are owned, so copies and moves stay valid
+	auto copy = searcher;
+	auto moved = std::move( copy );
+	daw::expecting( moved.find_all( "ushers" ) == expected );
+	daw::expecting( moved.pattern( 3 ) == "hers" );
+
+	auto const empty = daw::multi_pattern_searcher( );
+	daw::expecting( empty.find_all( "anything" ).empty( ) );
+	daw::expecting( not empty.find_first( "anything" ) );
+	auto const single = daw::multi_pattern_searcher{ "abc" };
+	daw::expecting( single.find_all( "" ).empty( ) );
+}
+
+void multi_pattern_search_test_002( ) {
+	// Small sets take the SIMD prefilter when it is available, large ones the
+	// automaton alone.  Both against every haystack length near a block
+	for( std::size_t count : { 1U, 2U, 8U, 33U, 64U, 65U, 500U } ) {
+		for( std::size_t max_size : { 1U, 2U, 5U, 12U } ) {
+			auto const source = make_text( 200, 'f' );
+			auto const patterns = make_patterns( source, count, max_size );
+			for( std::size_t size : { 0U, 1U, 15U, 16U, 17U, 18U, 47U, 300U } ) {
+				check_searcher( patterns, make_text( size, 'f' ) );
+			}
+		}
+	}
+	// Patterns that are suffixes and prefixes of each other
+	check_searcher( { "a", "aa", "aaa", "aaaa", "ba", "aab" },
+	                std::string( 70, 'a' ) + "b" + std::string( 20, 'a' ) );
+	// Matches that start at the end of a block and run past it
+	auto tail_text = std::string( 40, 'x' );
+	tail_text.replace( 14, 5, "needl" );
+	tail_text.replace( 31, 6, "needle" );
+	check_searcher( { "needle", "needl", "eedle", "dle" }, tail_text );
+	// Every byte value
+	auto bytes = std::string( );
+	for( int b = 0; b < 256; ++b ) {
+		bytes.push_back( static_cast<char>( b ) );
+	}
+	check_searcher( { std::string( "\x00\x01", 2 ), "\xFE\xFF", "\x7F\x80", "A" },
+	                bytes + bytes );
+}
+
+void multi_pattern_search_test_003( ) {
+	// find_first stops early but must still report the leftmost match when a
+	// later start was seen first, like a long pattern that ends after a short
+	// one that starts later
+	auto const searcher = daw::multi_pattern_searcher{ "bcd", "abcdefgh" };
+	auto const haystack = std::string( 50, '.' ) + "abcdefgh";
+	auto const first = searcher.find_first( haystack );
+	daw::expecting( first.has_value( ) );
+	daw::expecting( first->pattern, 1U );
+	daw::expecting( first->position, 50U );
+
+	for( std::size_t n = 0; n < 200; ++n ) {
+		auto const source = make_text( 100, 'z' );
+		auto const patterns = make_patterns( source, 1 + n % 80, 1 + n % 9 );
+		check_searcher( patterns, make_text( 20 + n * 3, 'z' ) );
+	}
+}
+
+void multi_pattern_search_bench_001( ) {
+	std::cout << "scrubbing log lines for tokens\n";
+	auto const log_line = std::string(
+	  "2024-05-01T12:00:00Z INFO request id=7f3a9c path=/api/v1/items "
+	  "user=someone@example.com key=secret_7919 status=200 took=12ms\n" );
+	auto log = std::string( );
+	while( log.size( ) < 1'000'000 ) {
+		log += log_line;
+	}
+	auto tokens = std::vector<std::string>( );
+	for( std::size_t n = 0; n < 2'000; ++n ) {
+		tokens.push_back( "secret_" + std::to_string( n * 7919 ) );
+	}
+	for( std::size_t count : { 32U, 2'000U } ) {
+		auto const patterns =
+		  std::vector<std::string>( tokens.begin( ), tokens.begin( ) + count );
+		auto const searcher =
+		  daw::multi_pattern_searcher( patterns.begin( ), patterns.end( ) );
+		auto const label = std::to_string( count ) + " tokens: ";
+		std::size_t naive_count = 0;
+		daw::show_benchmark(
+		  log.size( ), label + "find per pattern",
+		  [&]( ) {
+			  naive_count = 0;
+			  for( auto const &p : patterns ) {
+				  for( auto pos = log.find( p ); pos != std::string::npos;
+				       pos = log.find( p, pos + 1 ) ) {
+					  ++naive_count;
+				  }
+			  }
+			  daw::do_not_optimize( naive_count );
+		  },
+		  2, 2 );
+		std::size_t searcher_count = 0;
+		daw::show_benchmark(
+		  log.size( ), label + "multi_pattern_searcher",
+		  [&]( ) {
+			  searcher_count = 0;
+			  searcher.for_each_match(
+			    log, [&]( daw::pattern_match const & ) { ++searcher_count; } );
+			  daw::do_not_optimize( searcher_count );
+		  },
+		  2, 2 );
+		daw::expecting( searcher_count, naive_count );
+	}
+}
+
+int main( ) {
+	multi_pattern_search_test_001( );
+	multi_pattern_search_test_002( );
+	multi_pattern_search_test_003( );
+	multi_pattern_search_bench_001( );
+}
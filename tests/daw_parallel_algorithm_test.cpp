@@ -0,0 +1,312 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/parallel/daw_parallel_algorithm.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+void parallel_nth_element_test_001( ) {
+	std::mt19937_64 rng( 1234 );
+	std::vector<int> values( 1'000'000 );
+	for( auto &v : values ) {
+		v = static_cast<int>( rng( ) % 100'000U );
+	}
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ) );
+	for( size_t k : { size_t{ 0 }, values.size( ) / 2,
+	                  ( values.size( ) * 99 ) / 100, values.size( ) - 1 } ) {
+		auto v = values;
+		auto const nth = v.begin( ) + static_cast<std::ptrdiff_t>( k );
+		daw::algorithm::parallel::nth_element( v.begin( ), nth, v.end( ) );
+		daw::expecting( expected[k], *nth );
+		daw::expecting( std::all_of( v.begin( ), nth,
+		                             [&]( int x ) { return x <= *nth; } ) );
+		daw::expecting(
+		  std::all_of( nth, v.end( ), [&]( int x ) { return x >= *nth; } ) );
+
+		// Force the chunked path regardless of the hardware thread count
+		v = values;
+		auto comp = std::less<>{ };
+		daw::algorithm::parallel::parallel_impl::select_chunked(
+		  v.begin( ), nth, v.end( ), comp, 5 );
+		daw::expecting( expected[k], *nth );
+		daw::expecting( std::all_of( v.begin( ), nth,
+		                             [&]( int x ) { return x <= *nth; } ) );
+		daw::expecting(
+		  std::all_of( nth, v.end( ), [&]( int x ) { return x >= *nth; } ) );
+	}
+}
+
+void parallel_nth_element_test_002( ) {
+	// Many duplicates and a custom comparison
+	std::vector<long> values( 300'000 );
+	for( size_t n = 0; n < values.size( ); ++n ) {
+		values[n] = static_cast<long>( n % 7U );
+	}
+	auto const nth = values.begin( ) + 150'000;
+	auto comp = std::greater<>{ };
+	daw::algorithm::parallel::parallel_impl::select_chunked(
+	  values.begin( ), nth, values.end( ), comp, 3 );
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ), std::greater<>{ } );
+	daw::expecting( expected[150'000], *nth );
+}
+
+void parallel_nth_element_bench_001( ) {
+	std::mt19937_64 rng( 42 );
+	std::vector<double> latencies( 8'000'000 );
+	for( auto &v : latencies ) {
+		v = static_cast<double>( rng( ) % 1'000'000U ) / 1000.0;
+	}
+	auto const p50 = static_cast<std::ptrdiff_t>( latencies.size( ) / 2 );
+	double r1 = 0.0;
+	daw::show_benchmark(
+	  latencies.size( ) * sizeof( double ), "parallel::nth_element(p50)",
+	  [&]( ) {
+		  auto v = latencies;
+		  daw::algorithm::parallel::nth_element( v.begin( ), v.begin( ) + p50,
+		                                         v.end( ) );
+		  r1 = v[static_cast<size_t>( p50 )];
+	  },
+	  2, 2, latencies.size( ) );
+	double r2 = 0.0;
+	daw::show_benchmark(
+	  latencies.size( ) * sizeof( double ), "algorithm::nth_element(p50)",
+	  [&]( ) {
+		  auto v = latencies;
+		  daw::algorithm::nth_element( v.begin( ), v.begin( ) + p50, v.end( ) );
+		  r2 = v[static_cast<size_t>( p50 )];
+	  },
+	  2, 2, latencies.size( ) );
+	daw::expecting( r2, r1 );
+}
+
+void execution_policy_test_001( ) {
+	std::mt19937_64 rng( 77 );
+	std::vector<double> values( 300'000 );
+	for( auto &v : values ) {
+		v = static_cast<double>( rng( ) % 1'000'000U ) / 997.0;
+	}
+	namespace exec = daw::algorithm::execution;
+	auto const seq_sum = daw::algorithm::reduce( exec::seq, values.begin( ),
+	                                             values.end( ), 0.0 );
+	auto const par_sum = daw::algorithm::reduce( exec::par, values.begin( ),
+	                                             values.end( ), 0.0 );
+	auto const unseq_sum = daw::algorithm::reduce(
+	  exec::unseq, values.begin( ), values.end( ), 0.0 );
+	auto const par_unseq_sum = daw::algorithm::reduce(
+	  exec::par_unseq, values.begin( ), values.end( ), 0.0 );
+	// Same grouping for seq/par and for unseq/par_unseq, so bit identical
+	daw::expecting( seq_sum == par_sum );
+	daw::expecting( unseq_sum == par_unseq_sum );
+	auto const serial_sum =
+	  std::accumulate( values.begin( ), values.end( ), 0.0 );
+	daw::expecting( std::abs( serial_sum - seq_sum ) < 1e-6 * serial_sum );
+	daw::expecting( std::abs( serial_sum - unseq_sum ) < 1e-6 * serial_sum );
+	daw::expecting( par_sum ==
+	                daw::algorithm::accumulate( exec::par, values.begin( ),
+	                                            values.end( ), 0.0 ) );
+
+	auto const dot = daw::algorithm::map_reduce(
+	  exec::par_unseq, values.begin( ), values.end( ), values.begin( ), 0.0,
+	  std::plus<>{ }, std::multiplies<>{ } );
+	auto const dot_seq = std::inner_product( values.begin( ), values.end( ),
+	                                         values.begin( ), 0.0 );
+	daw::expecting( std::abs( dot - dot_seq ) < 1e-6 * dot_seq );
+
+	std::vector<double> out( values.size( ) );
+	auto const last = daw::algorithm::transform(
+	  exec::par, values.begin( ), values.end( ), out.begin( ),
+	  []( double v ) { return v * 2.0; } );
+	daw::expecting( last == out.end( ) );
+	for( std::size_t n = 0; n < values.size( ); ++n ) {
+		daw::expecting( out[n] == values[n] * 2.0 );
+	}
+
+	std::vector<int> empty{ };
+	daw::expecting( 5, daw::algorithm::reduce( exec::par, empty.begin( ),
+	                                           empty.end( ), 5 ) );
+}
+
+void execution_policy_test_002( ) {
+	// Force several threads over the blocks, every block must run once
+	std::vector<int> hits( 37 );
+	auto func = [&]( std::size_t block ) { ++hits[block]; };
+	daw::algorithm::parallel::parallel_impl::threaded_block_executor::
+	  run_chunked( hits.size( ), func, 5 );
+	for( auto h : hits ) {
+		daw::expecting( 1, h );
+	}
+}
+
+void execution_policy_test_003( ) {
+	// Associative but not commutative, keep the right operand.  Every policy
+	// must give the last element for sizes around the lane and block sizes
+	namespace exec = daw::algorithm::execution;
+	auto right = []( long, long r ) { return r; };
+	for( std::size_t size : { 1U, 7U, 15U, 16U, 17U, 63U, 1000U, 4099U,
+	                          100'003U } ) {
+		std::vector<long> values( size );
+		std::iota( values.begin( ), values.end( ), 1L );
+		auto const last = static_cast<long>( size );
+		daw::expecting( last, daw::algorithm::reduce( exec::seq, values.begin( ),
+		                                              values.end( ), 0L, right ) );
+		daw::expecting( last, daw::algorithm::reduce( exec::unseq, values.begin( ),
+		                                              values.end( ), 0L, right ) );
+		daw::expecting( last,
+		                daw::algorithm::reduce( exec::par_unseq, values.begin( ),
+		                                        values.end( ), 0L, right ) );
+	}
+}
+
+void execution_policy_bench_001( ) {
+	std::mt19937_64 rng( 5 );
+	std::vector<double> values( 8'000'000 );
+	for( auto &v : values ) {
+		v = static_cast<double>( rng( ) % 1'000'000U ) / 1000.0;
+	}
+	namespace exec = daw::algorithm::execution;
+	double r1 = 0.0;
+	daw::show_benchmark(
+	  values.size( ) * sizeof( double ), "algorithm::accumulate",
+	  [&]( ) {
+		  r1 = daw::algorithm::accumulate( values.begin( ), values.end( ), 0.0 );
+	  },
+	  2, 2, values.size( ) );
+	double r2 = 0.0;
+	daw::show_benchmark(
+	  values.size( ) * sizeof( double ), "algorithm::reduce(unseq)",
+	  [&]( ) {
+		  r2 = daw::algorithm::reduce( exec::unseq, values.begin( ),
+		                               values.end( ), 0.0 );
+	  },
+	  2, 2, values.size( ) );
+	double r3 = 0.0;
+	daw::show_benchmark(
+	  values.size( ) * sizeof( double ), "algorithm::reduce(par_unseq)",
+	  [&]( ) {
+		  r3 = daw::algorithm::reduce( exec::par_unseq, values.begin( ),
+		                               values.end( ), 0.0 );
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( r2 == r3 );
+	daw::expecting( std::abs( r1 - r2 ) < 1e-6 * r1 );
+}
+
+void parallel_sort_test_001( ) {
+	std::mt19937_64 rng( 101 );
+	std::vector<std::uint64_t> keys( 200'000 );
+	for( auto &k : keys ) {
+		k = rng( ) % 1'000'000U;
+	}
+	auto expected = keys;
+	std::sort( expected.begin( ), expected.end( ) );
+	auto v1 = keys;
+	daw::algorithm::parallel::sort( v1.begin( ), v1.end( ) );
+	daw::expecting( v1 == expected );
+
+	// Force the sample sort buckets, radix sorted and comparison sorted
+	auto v2 = keys;
+	auto less = std::less<>{ };
+	daw::algorithm::parallel::parallel_impl::sample_sort( v2.begin( ), v2.end( ),
+	                                                      less, 7 );
+	daw::expecting( v2 == expected );
+	auto v3 = keys;
+	auto greater = std::greater<>{ };
+	daw::algorithm::parallel::parallel_impl::sample_sort( v3.begin( ), v3.end( ),
+	                                                      greater, 5 );
+	daw::expecting( std::equal( v3.begin( ), v3.end( ), expected.rbegin( ) ) );
+
+	// Few distinct values put many equal keys around the splitters
+	std::vector<int> dups( 100'000 );
+	for( auto &d : dups ) {
+		d = static_cast<int>( rng( ) % 3U );
+	}
+	auto expected_dups = dups;
+	std::sort( expected_dups.begin( ), expected_dups.end( ) );
+	daw::algorithm::parallel::parallel_impl::sample_sort(
+	  dups.begin( ), dups.end( ), less, 4 );
+	daw::expecting( dups == expected_dups );
+}
+
+void parallel_index_space_test_001( ) {
+	namespace par = daw::algorithm::parallel;
+	// Forced thread counts so the chunks really are shared out
+	auto const space =
+	  daw::algorithm::product_index_space<3>( { 40, 50, 60 } );
+	std::atomic<std::size_t> sum = 0;
+	std::atomic<std::size_t> count = 0;
+	auto visit = [&]( std::array<std::size_t, 3> const &at ) {
+		sum += space.encode( at );
+		++count;
+	};
+	par::cancellation_token token{ };
+	daw::expecting(
+	  par::parallel_impl::for_each_product_index( space, visit, token, 4 ) );
+	daw::expecting( count.load( ), space.size( ) );
+	daw::expecting( sum.load( ), space.size( ) * ( space.size( ) - 1 ) / 2 );
+
+	auto const combos = daw::algorithm::combination_index_space( 30, 4 );
+	count = 0;
+	auto visit_combo = [&]( auto const &indices ) {
+		for( std::size_t n = 1; n < indices.size( ); ++n ) {
+			daw::expecting( indices[n - 1] < indices[n] );
+		}
+		++count;
+	};
+	par::cancellation_token combo_token{ };
+	daw::expecting( par::parallel_impl::for_each_combination_index(
+	  combos, visit_combo, combo_token, 3 ) );
+	daw::expecting( count.load( ), combos.size( ) );
+
+	// Returning false stops every thread at its next chunk
+	count = 0;
+	auto stop_early = [&]( auto const & ) { return ++count < 10'000; };
+	par::cancellation_token stop_token{ };
+	daw::expecting( not par::parallel_impl::for_each_product_index(
+	  space, stop_early, stop_token, 4 ) );
+	daw::expecting( stop_token.stop_requested( ) );
+	daw::expecting( count.load( ) < space.size( ) );
+
+	// A token stopped up front runs nothing
+	par::cancellation_token stopped{ };
+	stopped.request_stop( );
+	daw::expecting( not par::cartesian_product_for_each(
+	  [&]( int, int ) { daw::expecting( false ); }, stopped,
+	  std::vector<int>( 10 ), std::vector<int>( 10 ) ) );
+
+	std::atomic<long> product_sum = 0;
+	std::vector<int> const xs = { 1, 2, 3 };
+	std::vector<int> const ys = { 10, 20 };
+	par::cancellation_token sum_token{ };
+	daw::expecting( par::cartesian_product_for_each(
+	  [&]( int x, int y ) { product_sum += x * y; }, sum_token, xs, ys ) );
+	daw::expecting( product_sum.load( ), 180L );
+}
+
+int main( ) {
+	parallel_index_space_test_001( );
+	parallel_sort_test_001( );
+	execution_policy_test_001( );
+	execution_policy_test_002( );
+	execution_policy_test_003( );
+	execution_policy_bench_001( );
+	parallel_nth_element_test_001( );
+	parallel_nth_element_test_002( );
+	parallel_nth_element_bench_001( );
+}
@@ -30,7 +30,7 @@ void test_002( ) {
 
 	auto obs = t.get_observer( );
 	{
-		auto lck = obs.try_borrow( );
+		auto lck = obs.try_borrow_exclusive( );
 		if( lck ) {
 			*lck = 5;
 		}
@@ -10,7 +10,11 @@
 #include "daw/parallel/daw_observable_ptr.h"
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
 
 void test_001( ) {
 	int *p = new int{ 4 };
@@ -29,12 +33,20 @@ void test_002( ) {
 
 	auto obs = t.get_observer( );
 	{
-		auto lck = obs.try_borrow( );
-		if( lck ) {
-			*lck = 5;
-		}
+		auto lck = obs.try_borrow_exclusive( );
+		daw::expecting( lck );
+		*lck = 5;
+		// Every other borrow fails while the exclusive one is held
+		daw::expecting( not obs.try_borrow( ) );
+		daw::expecting( not t.try_borrow_exclusive( ) );
 	}
 	daw::expecting( 5, *p );
+	{
+		auto shared = obs.borrow( );
+		daw::expecting( obs.try_borrow( ) );
+		daw::expecting( not t.try_borrow_exclusive( ) );
+	}
+	daw::expecting( t.try_borrow_exclusive( ) );
 }
 
 void test_003( ) {
@@ -72,10 +84,146 @@ void test_005( ) {
 	daw::expecting( 0, v );
 }
 
+namespace {
+	struct destruct_counter {
+		std::atomic_int *count;
+		int value = 42;
+
+		explicit destruct_counter( std::atomic_int &c )
+		  : count( &c ) {}
+
+		~destruct_counter( ) {
+			++*count;
+		}
+	};
+} // namespace
+
+// The value outlives its owner while borrowed, and observers are not limited
+// to a 16 bit count
+void test_006( ) {
+	std::atomic_int destructed = 0;
+	auto t = daw::make_observable_ptr<destruct_counter>( destructed );
+	std::vector<daw::observer_ptr<destruct_counter>> observers{ };
+	observers.reserve( 100'000 );
+	for( std::size_t n = 0; n < 100'000; ++n ) {
+		observers.push_back( t.get_observer( ) );
+	}
+	{
+		auto b1 = observers.front( ).borrow( );
+		auto b2 = observers.back( ).try_borrow( );
+		daw::expecting( b1 and b2 );
+		t = daw::observable_ptr<destruct_counter>( );
+		daw::expecting( not observers.front( ) );
+		daw::expecting( 0, destructed.load( ) );
+		daw::expecting( 42, b1->value );
+		daw::expecting( not observers[5].borrow( ) );
+	}
+	daw::expecting( 1, destructed.load( ) );
+	daw::expecting( observers.back( ).get( ) == nullptr );
+	observers.clear( );
+	daw::expecting( 1, destructed.load( ) );
+}
+
+// Many threads borrowing while the owner goes away, the value must be
+// destroyed exactly once and never while borrowed
+void test_007( ) {
+	for( int run = 0; run < 20; ++run ) {
+		std::atomic_int destructed = 0;
+		auto t = daw::make_observable_ptr<destruct_counter>( destructed );
+		std::atomic_bool go = false;
+		std::vector<std::thread> threads{ };
+		for( int n = 0; n < 4; ++n ) {
+			threads.emplace_back( [&, obs = t.get_observer( )] {
+				while( not go ) {}
+				for( int i = 0; i < 10'000; ++i ) {
+					auto b = obs.borrow( );
+					if( not b ) {
+						break;
+					}
+					daw::expecting( 0, destructed.load( ) );
+					daw::expecting( 42, b->value );
+				}
+			} );
+		}
+		go = true;
+		t.reset( );
+		for( auto &th : threads ) {
+			th.join( );
+		}
+		daw::expecting( 1, destructed.load( ) );
+	}
+}
+
+namespace {
+	struct pair_t {
+		long first = 0;
+		long second = 0;
+	};
+} // namespace
+
+// Writers go through exclusive borrows, readers through shared ones.  Readers
+// must never see a half written value and no increment may be lost
+void test_008( ) {
+	auto t = daw::make_observable_ptr<pair_t>( );
+	constexpr long writes = 20'000;
+	std::atomic_bool done = false;
+	std::vector<std::thread> threads{ };
+	for( int n = 0; n < 2; ++n ) {
+		threads.emplace_back( [obs = t.get_observer( )]( ) mutable {
+			for( long i = 0; i < writes; ++i ) {
+				obs.lock( []( pair_t &value ) {
+					++value.first;
+					++value.second;
+				} );
+			}
+		} );
+	}
+	std::vector<std::thread> readers{ };
+	for( int n = 0; n < 2; ++n ) {
+		readers.emplace_back( [&, obs = t.get_observer( )] {
+			while( not done ) {
+				obs.lock( []( pair_t const &value ) {
+					daw::expecting( value.first, value.second );
+				} );
+			}
+		} );
+	}
+	for( auto &th : threads ) {
+		th.join( );
+	}
+	done = true;
+	for( auto &th : readers ) {
+		th.join( );
+	}
+	daw::expecting( 2 * writes, t->first );
+	daw::expecting( 2 * writes, t->second );
+}
+
+void observable_ptr_bench_001( ) {
+	std::cout << "observer_ptr borrow\n";
+	auto t = daw::make_observable_ptr<int>( 5 );
+	auto obs = t.get_observer( );
+	constexpr std::size_t count = 10'000'000;
+	daw::show_benchmark(
+	  count * sizeof( int ), "observer_ptr::borrow",
+	  [&]( ) {
+		  long long sum = 0;
+		  for( std::size_t n = 0; n < count; ++n ) {
+			  sum += *obs.borrow( );
+		  }
+		  daw::do_not_optimize( sum );
+	  },
+	  2, 2, count );
+}
+
 int main( ) {
 	test_001( );
 	test_002( );
 	test_003( );
 	test_004( );
 	test_005( );
+	test_006( );
+	test_007( );
+	test_008( );
+	observable_ptr_bench_001( );
 }
@@ -8,6 +8,14 @@
 
 #include "daw/daw_benchmark.h"
 #include "daw/daw_parser_helper_sv.h"
+#include "daw/daw_random.h"
+#include "daw/daw_string_view.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 constexpr bool test_in_t_test_001( ) {
 	daw::parser::char_in_t<' ', '1'> tst{ };
@@ -18,4 +26,197 @@ constexpr bool test_in_t_test_001( ) {
 }
 static_assert( test_in_t_test_001( ) );
 
-int main( ) {}
+constexpr bool ascii_class_test_001( ) {
+	using namespace daw::parser;
+	daw::expecting( ascii_whitespace_t{ }( '\v' ) );
+	daw::expecting( not ascii_whitespace_t{ }( 'x' ) );
+	daw::expecting( ascii_hex_t{ }( 'F' ) );
+	daw::expecting( not ascii_hex_t{ }( 'g' ) );
+	daw::expecting( not ascii_alpha_t{ }( '@' ) );
+	daw::expecting( not ascii_alpha_t{ }( '[' ) );
+	daw::expecting( ascii_all_of( "12345", ascii_digit_t{ } ) );
+	daw::expecting( not ascii_all_of( "123a5", ascii_digit_t{ } ) );
+	daw::expecting( ascii_trim( " \t hello world \r\n" ) == "hello world" );
+	daw::expecting( ascii_trim_left( "  a " ) == "a " );
+	daw::expecting( ascii_trim_right( "  a " ) == "  a" );
+	daw::expecting( ascii_trim( " \t " ).empty( ) );
+
+	constexpr auto token = ascii_set::from_predicate( ascii_alnum_t{ } ) |
+	                       ascii_set( "!#$%&'*+-.^_`|~" );
+	daw::expecting( token( '-' ) );
+	daw::expecting( not token( ':' ) );
+	daw::expecting( not token( static_cast<char>( 0xC3 ) ) );
+	daw::expecting( ( ~token )( ':' ) );
+	daw::expecting( ascii_set( ).insert_range( '\x80', '\xFF' )(
+	  static_cast<char>( 0xFF ) ) );
+
+	daw::expecting( ascii_iequal( "Content-Length", "content-LENGTH" ) );
+	daw::expecting( not ascii_iequal( "@", "`" ) );
+	daw::expecting( not ascii_iequal( "Host", "Hosts" ) );
+	daw::expecting( ascii_ihash( "Content-Length" ) ==
+	                ascii_ihash( "CONTENT-length" ) );
+	char buff[] = "Mixed Case 123";
+	ascii_to_upper( buff, buff + sizeof( buff ) - 1 );
+	daw::expecting( daw::string_view( buff ) == "MIXED CASE 123" );
+	return true;
+}
+static_assert( ascii_class_test_001( ) );
+
+// Compare the block scanners with the scalar predicates on every length and
+// alignment that covers whole blocks, tails and matches at each position
+template<typename Class>
+void ascii_scan_check( std::string const &text, Class const &cls ) {
+	for( std::size_t first = 0; first < 17; ++first ) {
+		for( std::size_t last = first; last <= text.size( ); ++last ) {
+			char const *f = text.data( ) + first;
+			char const *l = text.data( ) + last;
+			char const *expected = f;
+			while( expected != l and not cls( *expected ) ) {
+				++expected;
+			}
+			daw::expecting( daw::parser::ascii_find_if( f, l, cls ) == expected );
+			expected = f;
+			while( expected != l and cls( *expected ) ) {
+				++expected;
+			}
+			daw::expecting( daw::parser::ascii_find_if_not( f, l, cls ) ==
+			                expected );
+			expected = l;
+			while( expected != f and cls( *( expected - 1 ) ) ) {
+				--expected;
+			}
+			daw::expecting( daw::parser::ascii_rfind_if_not( f, l, cls ) ==
+			                expected );
+		}
+	}
+}
+
+void ascii_class_test_002( ) {
+	auto const bytes = daw::make_random_data<int>( 80, 0, 255 );
+	std::string text{ };
+	for( auto b : bytes ) {
+		text.push_back( static_cast<char>( b ) );
+	}
+	std::string const sparse = "                         \t\r\n  x    " +
+	                           std::string( 40, ' ' ) + "\xA0  ";
+	for( auto const &str : { text, sparse } ) {
+		ascii_scan_check( str, daw::parser::ascii_whitespace_t{ } );
+		ascii_scan_check( str, daw::parser::ascii_digit_t{ } );
+		ascii_scan_check( str, daw::parser::ascii_alpha_t{ } );
+		ascii_scan_check( str, daw::parser::ascii_alnum_t{ } );
+		ascii_scan_check( str, daw::parser::ascii_hex_t{ } );
+		ascii_scan_check( str, daw::parser::ascii_set( " x\xA0\xFF" ) );
+	}
+
+	// Every byte value through the block and scalar paths
+	std::string all( 256, '\0' );
+	for( std::size_t n = 0; n < all.size( ); ++n ) {
+		all[n] = static_cast<char>( n );
+	}
+	std::string lower( all.size( ), '\0' );
+	std::string upper( all.size( ), '\0' );
+	daw::parser::ascii_to_lower( all, lower.data( ) );
+	daw::parser::ascii_to_upper( all, upper.data( ) );
+	for( std::size_t n = 0; n < all.size( ); ++n ) {
+		daw::expecting( lower[n] == daw::parser::ascii_to_lower( all[n] ) );
+		daw::expecting( upper[n] == daw::parser::ascii_to_upper( all[n] ) );
+	}
+	daw::expecting( daw::parser::ascii_iequal( lower, upper ) );
+	daw::expecting( daw::parser::ascii_ihash( lower ) ==
+	                daw::parser::ascii_ihash( upper ) );
+	for( std::size_t n = 0; n < all.size( ); ++n ) {
+		auto changed = lower;
+		changed[n] ^= 0x20;
+		bool const is_letter = daw::parser::ascii_alpha_t{ }( lower[n] );
+		daw::expecting( daw::parser::ascii_iequal( lower, changed ) == is_letter );
+	}
+}
+
+void ascii_class_test_003( ) {
+	// Case-insensitive keys, as for HTTP header names
+	std::unordered_map<std::string, int, daw::parser::ascii_case_insensitive_hash,
+	                   daw::parser::ascii_case_insensitive_equal>
+	  headers{ };
+	headers["Content-Type"] = 1;
+	headers["content-type"] = 2;
+	headers["Accept-Encoding"] = 3;
+	daw::expecting( headers.size( ), 2U );
+	daw::expecting( headers.at( "CONTENT-TYPE" ), 2 );
+	daw::expecting( headers.at( "accept-encoding" ), 3 );
+}
+
+void ascii_class_bench_001( ) {
+	std::cout << "trimming and checking HTTP header values\n";
+	std::vector<std::string> values{ };
+	for( std::size_t n = 0; n < 10'000; ++n ) {
+		values.push_back( std::string( n % 40, ' ' ) + "\t" +
+		                  std::to_string( n * 7919U ) +
+		                  std::string( n % 23, ' ' ) + "\r\n" );
+	}
+	std::size_t bytes = 0;
+	for( auto const &v : values ) {
+		bytes += v.size( );
+	}
+	std::size_t scalar_numbers = 0;
+	daw::show_benchmark(
+	  bytes, "trim + is_number",
+	  [&]( ) {
+		  std::size_t count = 0;
+		  for( auto const &v : values ) {
+			  auto const t = daw::parser::trim( daw::string_view( v ) );
+			  bool all_digits = true;
+			  for( char c : t ) {
+				  all_digits = all_digits and daw::parser::is_number( c );
+			  }
+			  count += all_digits ? 1U : 0U;
+		  }
+		  daw::do_not_optimize( count );
+		  scalar_numbers = count;
+	  },
+	  2, 2, values.size( ) );
+	std::size_t ascii_numbers = 0;
+	daw::show_benchmark(
+	  bytes, "ascii_trim + ascii_all_of",
+	  [&]( ) {
+		  std::size_t count = 0;
+		  for( auto const &v : values ) {
+			  auto const t = daw::parser::ascii_trim( v );
+			  count += daw::parser::ascii_all_of( t, daw::parser::ascii_digit_t{ } )
+			             ? 1U
+			             : 0U;
+		  }
+		  daw::do_not_optimize( count );
+		  ascii_numbers = count;
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( ascii_numbers, scalar_numbers );
+
+	std::string text{ };
+	for( auto const &v : values ) {
+		text += "X-Forwarded-For: " + v;
+	}
+	std::string out( text.size( ), '\0' );
+	daw::show_benchmark(
+	  text.size( ), "to_lower per char",
+	  [&]( ) {
+		  for( std::size_t n = 0; n < text.size( ); ++n ) {
+			  auto const c = text[n];
+			  out[n] = c >= 'A' and c <= 'Z' ? static_cast<char>( c | 0x20 ) : c;
+		  }
+		  daw::do_not_optimize( out );
+	  },
+	  2, 2 );
+	daw::show_benchmark(
+	  text.size( ), "ascii_to_lower",
+	  [&]( ) {
+		  daw::parser::ascii_to_lower( text, out.data( ) );
+		  daw::do_not_optimize( out );
+	  },
+	  2, 2 );
+}
+
+int main( ) {
+	ascii_class_test_002( );
+	ascii_class_test_003( );
+	ascii_class_bench_001( );
+}
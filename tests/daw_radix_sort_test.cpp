@@ -0,0 +1,122 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_sort_n.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template<typename T>
+void radix_sort_check( std::vector<T> values ) {
+	auto expected = values;
+	std::sort( expected.begin( ), expected.end( ) );
+	daw::radix_sort( values.begin( ), values.end( ) );
+	daw::expecting( values == expected );
+}
+
+void radix_sort_test_001( ) {
+	std::mt19937_64 rng( 31 );
+	for( std::size_t size : { 0U, 1U, 100U, 256U, 5'000U, 70'000U } ) {
+		std::vector<std::uint64_t> u64( size );
+		std::vector<std::int32_t> i32( size );
+		std::vector<std::int8_t> i8( size );
+		std::vector<double> f64( size );
+		std::vector<float> f32( size );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto const r = rng( );
+			u64[n] = r;
+			i32[n] = static_cast<std::int32_t>( r );
+			i8[n] = static_cast<std::int8_t>( r );
+			f64[n] = static_cast<double>( static_cast<std::int64_t>( r ) ) / 1e9;
+			f32[n] = static_cast<float>( static_cast<std::int32_t>( r >> 20U ) ) *
+			         0.125f;
+		}
+		radix_sort_check( u64 );
+		radix_sort_check( i32 );
+		radix_sort_check( i8 );
+		radix_sort_check( f64 );
+		radix_sort_check( f32 );
+	}
+	// Only the low byte differs, every other pass is skipped
+	std::vector<std::uint32_t> narrow( 1'000 );
+	for( auto &v : narrow ) {
+		v = 0xAB'CD'00'00U | static_cast<std::uint32_t>( rng( ) % 256U );
+	}
+	radix_sort_check( narrow );
+}
+
+struct radix_record_t {
+	std::int64_t key;
+	std::size_t position;
+};
+
+void radix_sort_test_002( ) {
+	// Key extractor, and stability between equal keys
+	std::mt19937_64 rng( 32 );
+	std::vector<radix_record_t> records( 10'000 );
+	for( std::size_t n = 0; n < records.size( ); ++n ) {
+		records[n] = { static_cast<std::int64_t>( rng( ) % 200U ) - 100, n };
+	}
+	daw::radix_sort( records.begin( ), records.end( ),
+	                 []( radix_record_t const &r ) { return r.key; } );
+	for( std::size_t n = 1; n < records.size( ); ++n ) {
+		daw::expecting( records[n - 1].key < records[n].key or
+		                ( records[n - 1].key == records[n].key and
+		                  records[n - 1].position < records[n].position ) );
+	}
+
+	// Fixed width string keys
+	using name_t = std::array<char, 6>;
+	std::vector<name_t> names( 3'000 );
+	for( auto &name : names ) {
+		for( auto &c : name ) {
+			c = static_cast<char>( 'a' + rng( ) % 4U );
+		}
+	}
+	auto expected = names;
+	std::sort( expected.begin( ), expected.end( ) );
+	daw::radix_sort( names.begin( ), names.end( ) );
+	daw::expecting( names == expected );
+}
+
+void radix_sort_bench_001( ) {
+	std::mt19937_64 rng( 33 );
+	std::vector<std::uint64_t> keys( 4'000'000 );
+	for( auto &k : keys ) {
+		k = rng( );
+	}
+	auto const bytes = keys.size( ) * sizeof( std::uint64_t );
+	std::vector<std::uint64_t> v1{ };
+	daw::show_benchmark(
+	  bytes, "daw::radix_sort(uint64_t)",
+	  [&]( ) {
+		  v1 = keys;
+		  daw::radix_sort( v1.begin( ), v1.end( ) );
+	  },
+	  2, 2, keys.size( ) );
+	std::vector<std::uint64_t> v2{ };
+	daw::show_benchmark(
+	  bytes, "std::sort(uint64_t)",
+	  [&]( ) {
+		  v2 = keys;
+		  std::sort( v2.begin( ), v2.end( ) );
+	  },
+	  2, 2, keys.size( ) );
+	daw::expecting( v1 == v2 );
+}
+
+int main( ) {
+	radix_sort_test_001( );
+	radix_sort_test_002( );
+	radix_sort_bench_001( );
+}
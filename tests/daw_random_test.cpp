@@ -89,6 +89,193 @@ void cxrand_test_002( ) {
 	std::cout << '\n';
 }
 
+constexpr bool xoshiro256pp_test_001( ) {
+	// Reference output of xoshiro256++ for the state { 1, 2, 3, 4 }
+	auto rng = daw::xoshiro256pp( 1, 2, 3, 4 );
+	daw::expecting( 41943041ULL, rng( ) );
+	daw::expecting( 58720359ULL, rng( ) );
+	return true;
+}
+static_assert( xoshiro256pp_test_001( ) );
+
+constexpr bool pcg32_test_001( ) {
+	// Reference output of the pcg32 demo seeded with 42 on stream 54
+	auto rng = daw::pcg32( 42U, 54U );
+	daw::expecting( 0xa15c02b7U, rng( ) );
+	daw::expecting( 0x7b47f409U, rng( ) );
+	daw::expecting( 0xba1d3330U, rng( ) );
+	return true;
+}
+static_assert( pcg32_test_001( ) );
+
+template<typename Engine>
+constexpr bool discard_test( ) {
+	auto rng1 = Engine( 1234U );
+	auto rng2 = rng1;
+	for( int n = 0; n < 1000; ++n ) {
+		(void)rng1( );
+	}
+	rng2.discard( 1000U );
+	daw::expecting( rng1 == rng2 );
+	return true;
+}
+static_assert( discard_test<daw::pcg32>( ) );
+static_assert( discard_test<daw::wyrand>( ) );
+
+constexpr bool split_test_001( ) {
+	auto rng = daw::xoshiro256pp( 1234U );
+	auto worker0 = rng.split( );
+	auto worker1 = rng.split( );
+	auto expected1 = daw::xoshiro256pp( 1234U );
+	expected1.jump( );
+	daw::expecting( worker1 == expected1 );
+	daw::expecting( worker0 != worker1 );
+	return true;
+}
+static_assert( split_test_001( ) );
+
+constexpr bool split_test_002( ) {
+	// Reference outputs for seed 42, stream 54, and a split stream whose seed
+	// and stream each take the first of two draws as the high word
+	auto rng = daw::pcg32( 42U, 54U );
+	auto ref = rng;
+	daw::expecting( ref( ), 0xA15C'02B7U );
+	daw::expecting( ref( ), 0x7B47'F409U );
+	auto worker = rng.split( );
+	daw::expecting( worker( ), 0x71BC'7250U );
+	daw::expecting( worker( ), 0xAFA3'3DE8U );
+	daw::expecting( worker( ), 0xC158'C2A5U );
+	daw::expecting( worker( ), 0x4DE8'B2CFU );
+	daw::expecting( rng( ), 0xBFA4'784BU );
+	daw::expecting( rng( ), 0xCBED'606EU );
+	return true;
+}
+static_assert( split_test_002( ) );
+
+constexpr bool bounded_rand_test_001( ) {
+	auto rng = daw::wyrand( 42U );
+	for( int n = 0; n < 1000; ++n ) {
+		auto const v = daw::randint( rng, -5, 5 );
+		daw::expecting( -5 <= v and v <= 5 );
+	}
+	auto prng = daw::pcg32( 42U );
+	for( int n = 0; n < 1000; ++n ) {
+		auto const v = daw::bounded_rand<uint64_t>( prng, 3'000'000'000'000ULL );
+		daw::expecting( v < 3'000'000'000'000ULL );
+	}
+	return true;
+}
+static_assert( bounded_rand_test_001( ) );
+
+void bounded_rand_test_002( ) {
+	// Every value of a small range must be reachable and roughly uniform
+	auto rng = daw::xoshiro256pp( 42U );
+	size_t counts[7] = { };
+	for( size_t n = 0; n < 70'000; ++n ) {
+		++counts[daw::bounded_rand<uint32_t>( rng, 7U )];
+	}
+	for( auto c : counts ) {
+		daw::expecting( 9'000U < c and c < 11'000U );
+	}
+	auto const full =
+	  daw::randint( rng, std::numeric_limits<int64_t>::min( ),
+	                std::numeric_limits<int64_t>::max( ) );
+	(void)full;
+}
+
+void batch_random_fill_test_001( ) {
+	std::vector<int32_t> a( 1001 );
+	auto rng = daw::xoshiro256pp( 42U );
+	daw::batch_random_fill( a.data( ), a.data( ) + a.size( ), -10, 10, rng );
+	for( auto v : a ) {
+		daw::expecting( -10 <= v and v <= 10 );
+	}
+	std::vector<int32_t> b( a.size( ) );
+	auto rng2 = daw::xoshiro256pp( 42U );
+	daw::batch_random_fill( b.data( ), b.data( ) + b.size( ), -10, 10, rng2 );
+	daw::expecting( a == b );
+
+	std::vector<double> d( 1001 );
+	daw::batch_random_fill( d.data( ), d.data( ) + d.size( ), 1.0, 2.0, rng );
+	for( auto v : d ) {
+		daw::expecting( 1.0 <= v and v < 2.0 );
+	}
+	std::vector<float> f( 17 );
+	daw::batch_random_fill( f.data( ), f.data( ) + f.size( ), 0.0f, 1.0f, rng );
+	for( auto v : f ) {
+		daw::expecting( 0.0f <= v and v < 1.0f );
+	}
+}
+
+namespace {
+	// Always the largest value, the worst case for rounding up to b
+	struct max_engine {
+		using result_type = uint64_t;
+
+		static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		static constexpr result_type max( ) noexcept {
+			return std::numeric_limits<result_type>::max( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			return max( );
+		}
+	};
+} // namespace
+
+void randreal_test_001( ) {
+	// 1 + ( 1 - 2^-24 ) rounds to 2.0f
+	auto rng = max_engine{ };
+	auto const f = daw::randreal( rng, 1.0f, 2.0f );
+	daw::expecting( 1.0f <= f and f < 2.0f );
+	auto const d = daw::randreal( rng, 1.0, 2.0 );
+	daw::expecting( 1.0 <= d and d < 2.0 );
+}
+
+void batch_random_fill_test_002( ) {
+	// A range where about a third of the values are redrawn.  The redraws
+	// come from the lanes, so engine only provides the lane seeds
+	std::vector<uint32_t> a( 10'000 );
+	auto rng = daw::xoshiro256pp( 7U );
+	daw::batch_random_fill( a.data( ), a.data( ) + a.size( ), 0U,
+	                        2'999'999'999U, rng );
+	auto expected_rng = daw::xoshiro256pp( 7U );
+	expected_rng.discard( 8 );
+	daw::expecting( rng == expected_rng );
+	for( auto v : a ) {
+		daw::expecting( v <= 2'999'999'999U );
+	}
+	std::vector<uint32_t> b( a.size( ) );
+	auto rng2 = daw::xoshiro256pp( 7U );
+	daw::batch_random_fill( b.data( ), b.data( ) + b.size( ), 0U,
+	                        2'999'999'999U, rng2 );
+	daw::expecting( a == b );
+}
+
+void engine_bench_001( ) {
+	constexpr size_t count = 1'000'000;
+	std::vector<uint32_t> data( count );
+	daw::show_benchmark(
+	  count * sizeof( uint32_t ), "random_fill(mt19937_64)",
+	  [&]( ) { daw::random_fill( data.begin( ), data.end( ), 0U, 1000U ); }, 2,
+	  2, count );
+	auto rng = daw::xoshiro256pp( );
+	daw::show_benchmark(
+	  count * sizeof( uint32_t ), "random_fill(xoshiro256pp)",
+	  [&]( ) { daw::random_fill( data.begin( ), data.end( ), 0U, 1000U, rng ); },
+	  2, 2, count );
+	daw::show_benchmark(
+	  count * sizeof( uint32_t ), "batch_random_fill(xoshiro256pp)",
+	  [&]( ) {
+		  daw::batch_random_fill( data.data( ), data.data( ) + data.size( ), 0U,
+		                          1000U, rng );
+	  },
+	  2, 2, count );
+}
+
 int main( ) {
 	daw_random_01( );
 	daw_random_02( );
@@ -96,4 +283,9 @@ int main( ) {
 	daw_fill_01( );
 	daw_make_random_01( );
 	cxrand_test_002( );
+	bounded_rand_test_002( );
+	batch_random_fill_test_001( );
+	randreal_test_001( );
+	batch_random_fill_test_002( );
+	engine_bench_001( );
 }
@@ -0,0 +1,194 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_range_lazy.h"
+#include "daw/daw_range_operators.h"
+
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+void lazy_range_test_001( ) {
+	std::vector<int> const values = { 5, 1, 8, 3, 9, 2, 7, 4, 6, 0 };
+	using daw::range::lazy;
+
+	auto const result = lazy( values )
+	                      .where( []( int v ) { return v % 2 == 0; } )
+	                      .map( []( int v ) { return v * 10; } )
+	                      .to_vector( );
+	daw::expecting( ( std::vector<int>{ 80, 20, 40, 60, 0 } ), result );
+
+	auto const taken = lazy( values ).drop( 2 ).take( 3 ).to_vector( );
+	daw::expecting( ( std::vector<int>{ 8, 3, 9 } ), taken );
+
+	auto const sum =
+	  lazy( values ).map( []( int v ) { return v * v; } ).reduce( 0 );
+	daw::expecting( 285, sum );
+
+	auto const count =
+	  lazy( values ).filter( []( int v ) { return v > 4; } ).count( );
+	daw::expecting( 5U, count );
+
+	auto const sorted = lazy( values ).take( 4 ).sort( );
+	daw::expecting( ( std::vector<int>{ 1, 3, 5, 8 } ), sorted.as_vector( ) );
+}
+
+void lazy_range_test_002( ) {
+	// Stages only see elements that survive earlier ones, and take stops the
+	// pass instead of reading the whole source
+	std::vector<int> values( 100 );
+	std::iota( values.begin( ), values.end( ), 0 );
+	std::size_t calls = 0;
+	auto pipeline = daw::range::lazy( values )
+	                  .map( [&calls]( int v ) {
+		                  ++calls;
+		                  return v;
+	                  } )
+	                  .take( 5 );
+	daw::expecting( 0U, calls );
+	auto const first = pipeline.to_vector( );
+	daw::expecting( 5U, first.size( ) );
+	daw::expecting( 5U, calls );
+	// Pipelines are reusable and take restarts
+	daw::expecting( first, pipeline.to_vector( ) );
+
+	// Rvalue sources are owned by the pipeline
+	auto owned = daw::range::lazy( std::vector<std::string>{ "a", "bb", "ccc" } )
+	               .map( []( std::string const &s ) { return s.size( ); } );
+	daw::expecting( 6U, owned.reduce( std::size_t{ 0 } ) );
+}
+
+void lazy_range_operators_test_001( ) {
+	using namespace daw::range::operators;
+	std::vector<int> const values = { 5, 1, 8, 3, 9, 2, 7, 4, 6, 0 };
+
+	auto const result = values << filter( []( int v ) { return v > 2; } )
+	                           << map( []( int v ) { return v + 1; } )
+	                           << take( 4 ) << to_vector( );
+	daw::expecting( ( std::vector<int>{ 6, 9, 4, 10 } ), result );
+
+	auto const sorted = values << where( []( int v ) { return v < 5; } )
+	                           << sort( );
+	daw::expecting( ( std::vector<int>{ 0, 1, 2, 3, 4 } ), sorted.as_vector( ) );
+
+	auto const total =
+	  daw::range::lazy( values ) << map( []( int v ) { return v * 2; } )
+	                             << reduce( 0 );
+	daw::expecting( 90, total );
+
+	// A temporary on the left is moved into the pipeline, so it outlives the
+	// full expression
+	auto const make_values = [] {
+		return std::vector<int>{ 5, 1, 8, 3, 9, 2, 7, 4, 6, 0 };
+	};
+	auto const evens =
+	  make_values( ) << filter( []( int v ) { return v % 2 == 0; } );
+	daw::expecting( ( std::vector<int>{ 8, 2, 4, 6, 0 } ), evens.to_vector( ) );
+	auto const tens = make_values( )
+	                  << map( []( int v ) { return v * 10; } ) << take( 2 );
+	daw::expecting( ( std::vector<int>{ 50, 10 } ), tens.to_vector( ) );
+	auto const sorted_tmp = make_values( ) << sort( );
+	daw::expecting( 0, sorted_tmp.as_vector( ).front( ) );
+}
+
+void lazy_range_operators_test_002( ) {
+	// where and transform on a plain container still give a CollectionRange,
+	// so the eager clauses and iteration keep working
+	using namespace daw::range::operators;
+	std::vector<int> const values = { 5, 1, 8, 3, 9, 2, 7, 4, 6, 0 };
+
+	auto const small = values << where( []( int v ) { return v < 5; } );
+	daw::expecting( 5U, small.size( ) );
+	daw::expecting( 3, small[1] );
+	daw::expecting( small.contains( 3 ) );
+	daw::expecting( 4, *small.find( 4 ) );
+	int sum = 0;
+	for( auto v : small ) {
+		sum += v;
+	}
+	daw::expecting( 10, sum );
+
+	auto const odd_small = values << where( []( int v ) { return v < 5; } )
+	                              << erase( []( int v ) { return v % 2 == 0; } );
+	daw::expecting( ( std::vector<int>{ 1, 3 } ), odd_small.as_vector( ) );
+	auto const no_threes = values << where( []( int v ) { return v < 5; } )
+	                              << erase_where_equal_to( 3 );
+	daw::expecting( ( std::vector<int>{ 1, 2, 4, 0 } ), no_threes.as_vector( ) );
+	auto const found = small << find_if( []( int v ) { return v % 3 == 0; } );
+	daw::expecting( 3, *found );
+
+	auto const tens = values << transform( []( int v ) { return v * 10; } );
+	daw::expecting( 10U, tens.size( ) );
+	daw::expecting( 80, tens[2] );
+	auto const big_tens = values << transform( []( int v ) { return v * 10; } )
+	                             << where( []( int v ) { return v > 60; } )
+	                             << sort( );
+	daw::expecting( ( std::vector<int>{ 70, 80, 90 } ), big_tens.as_vector( ) );
+
+	// The same clauses on a lazy pipeline materialize once
+	auto const lazy_small = values << filter( []( int v ) { return v < 5; } );
+	daw::expecting( lazy_small.contains( 3 ) );
+	daw::expecting( not lazy_small.contains( 7 ) );
+	daw::expecting( ( std::vector<int>{ 1, 3 } ),
+	                ( lazy_small << erase( []( int v ) { return v % 2 == 0; } ) )
+	                  .as_vector( ) );
+	daw::expecting( ( std::vector<int>{ 1, 2, 4, 0 } ),
+	                ( lazy_small << erase_where_equal_to( 3 ) ).as_vector( ) );
+	daw::expecting( 1U, lazy_small.where_equal_to( 2 ).count( ) );
+}
+
+void lazy_range_bench_001( ) {
+	std::vector<long> values( 1'000'000 );
+	std::iota( values.begin( ), values.end( ), 0L );
+	auto const is_odd = []( long v ) { return v % 2 == 1; };
+	auto const times3 = []( long v ) { return v * 3; };
+	auto const small = []( long v ) { return v < 2'000'000; };
+	auto const plus1 = []( long v ) { return v + 1; };
+
+	long r1 = 0;
+	daw::show_benchmark(
+	  values.size( ) * sizeof( long ), "CollectionRange(where/transform)",
+	  [&]( ) {
+		  auto c = daw::range::from_mutable( values );
+		  c.where( is_odd );
+		  std::vector<long> mapped{ };
+		  for( auto v : c ) {
+			  mapped.push_back( times3( v ) );
+		  }
+		  auto c2 = daw::range::from_mutable( mapped );
+		  c2.where( small );
+		  r1 = 0;
+		  for( auto v : c2 ) {
+			  r1 += plus1( v );
+		  }
+	  },
+	  2, 2, values.size( ) );
+	long r2 = 0;
+	daw::show_benchmark(
+	  values.size( ) * sizeof( long ), "LazyRange(fused)",
+	  [&]( ) {
+		  r2 = daw::range::lazy( values )
+		         .where( is_odd )
+		         .map( times3 )
+		         .where( small )
+		         .map( plus1 )
+		         .reduce( 0L );
+	  },
+	  2, 2, values.size( ) );
+	daw::expecting( r1, r2 );
+}
+
+int main( ) {
+	lazy_range_test_001( );
+	lazy_range_test_002( );
+	lazy_range_operators_test_001( );
+	lazy_range_operators_test_002( );
+	lazy_range_bench_001( );
+}
@@ -0,0 +1,266 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
+#include "daw/daw_soa_vector.h"
+#include "daw/daw_sort_n.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	struct particle {
+		float x = 0.0f;
+		float vx = 0.0f;
+		float mass = 0.0f;
+		std::uint32_t id = 0;
+	};
+
+	using particle_soa = daw::soa_vector<particle, &particle::x, &particle::vx,
+	                                     &particle::mass, &particle::id>;
+
+	struct order {
+		std::string symbol{ };
+		std::int64_t price = 0;
+		std::int64_t quantity = 0;
+	};
+
+	using order_soa = daw::soa_vector<order, &order::symbol, &order::price,
+	                                  &order::quantity>;
+
+	/// Counts live instances and throws from the copy after copies_left copies
+	struct copy_counter {
+		static inline int live = 0;
+		static inline int copies_left = -1;
+		int value = 0;
+
+		copy_counter( ) {
+			++live;
+		}
+
+		copy_counter( copy_counter const &other )
+		  : value( other.value ) {
+			if( copies_left == 0 ) {
+				throw std::runtime_error( "copy failed" );
+			}
+			--copies_left;
+			++live;
+		}
+
+		copy_counter( copy_counter &&other ) noexcept
+		  : value( other.value ) {
+			++live;
+		}
+
+		copy_counter &operator=( copy_counter const & ) = default;
+		copy_counter &operator=( copy_counter && ) = default;
+
+		~copy_counter( ) {
+			--live;
+		}
+	};
+
+	struct counted_row {
+		copy_counter first{ };
+		copy_counter second{ };
+	};
+
+	using counted_soa =
+	  daw::soa_vector<counted_row, &counted_row::first, &counted_row::second>;
+
+	std::vector<particle> make_particles( std::size_t count ) {
+		std::vector<particle> result( count );
+		auto ids = daw::make_random_data<std::uint32_t>( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			result[n] = particle{ static_cast<float>( n ), 1.0f, 2.0f, ids[n] };
+		}
+		return result;
+	}
+} // namespace
+
+void soa_vector_test_001( ) {
+	particle_soa soa{ };
+	daw::expecting( soa.empty( ) );
+	for( std::uint32_t n = 0; n < 100; ++n ) {
+		soa.push_back( particle{ static_cast<float>( n ), 0.5f, 1.0f, n } );
+	}
+	daw::expecting( soa.size( ), 100U );
+	daw::expecting( soa.capacity( ) >= 100U );
+	daw::expecting( soa[42].get<&particle::id>( ), 42U );
+	daw::expecting( soa[42].get<1>( ), 0.5f );
+
+	// Columns are contiguous and cache line aligned
+	auto xs = soa.column<&particle::x>( );
+	daw::expecting( xs.size( ), 100U );
+	daw::expecting(
+	  reinterpret_cast<std::uintptr_t>( soa.column<&particle::id>( ).data( ) ) %
+	    64U,
+	  0U );
+	daw::expecting( xs[7], 7.0f );
+
+	for( auto row : soa ) {
+		row.get<&particle::x>( ) += row.get<&particle::vx>( );
+	}
+	daw::expecting( xs[7], 7.5f );
+
+	particle const p = soa[3];
+	daw::expecting( p.id, 3U );
+	soa[3] = particle{ 1.0f, 2.0f, 3.0f, 99U };
+	daw::expecting( soa.column<3>( )[3], 99U );
+
+	auto copy = soa;
+	copy[0].get<&particle::id>( ) = 1000U;
+	daw::expecting( soa[0].get<&particle::id>( ), 0U );
+	soa.pop_back( );
+	daw::expecting( soa.size( ), 99U );
+	soa.resize( 120 );
+	daw::expecting( soa[119].get<&particle::id>( ), 0U );
+	daw::expecting_exception<std::out_of_range>( [&] { (void)soa.at( 120 ); } );
+	soa.clear( );
+	daw::expecting( soa.empty( ) );
+	daw::expecting( copy.size( ), 100U );
+}
+
+void soa_vector_test_002( ) {
+	// Rows sort as a unit through the proxy references
+	auto const values = make_particles( 2000 );
+	auto expected = values;
+	auto const by_id = []( particle const &lhs, particle const &rhs ) {
+		return lhs.id < rhs.id;
+	};
+	std::stable_sort( expected.begin( ), expected.end( ), by_id );
+	auto const check = [&]( particle_soa const &soa ) {
+		daw::expecting( soa.size( ), expected.size( ) );
+		for( std::size_t n = 0; n < expected.size( ); ++n ) {
+			particle const p = soa[n];
+			daw::expecting( p.id, expected[n].id );
+			daw::expecting( p.x, expected[n].x );
+		}
+	};
+
+	particle_soa a{ };
+	particle_soa b{ };
+	particle_soa c{ };
+	particle_soa d{ };
+	for( auto const &p : values ) {
+		a.push_back( p );
+		b.push_back( p );
+		c.push_back( p );
+		d.push_back( p );
+	}
+	std::sort( a.begin( ), a.end( ), by_id );
+	daw::expecting( std::is_sorted( a.begin( ), a.end( ), by_id ) );
+	daw::sort( b.begin( ), b.end( ), by_id );
+	daw::expecting( std::is_sorted( b.begin( ), b.end( ), by_id ) );
+	daw::soa_sort_by<&particle::id>( c );
+	check( c );
+	daw::soa_sort( d, by_id );
+	check( d );
+
+	order_soa orders{ };
+	orders.emplace_back( "MSFT", 300, 10 );
+	orders.emplace_back( "AAPL", 150, 5 );
+	orders.emplace_back( "GOOG", 100, 7 );
+	orders.emplace_back( "AAPL", 140, 1 );
+	daw::soa_sort_by<&order::symbol>( orders );
+	daw::expecting( orders[0].get<&order::price>( ), 150 );
+	daw::expecting( orders[1].get<&order::price>( ), 140 );
+	daw::expecting( orders[3].get<&order::symbol>( ), "MSFT" );
+	daw::soa_sort_by<&order::price>( orders, std::greater<>{ } );
+	daw::expecting( orders[0].get<&order::symbol>( ), "MSFT" );
+	daw::expecting( orders[3].get<&order::quantity>( ), 7 );
+
+	swap( orders[0], orders[3] );
+	daw::expecting( orders[0].get<&order::symbol>( ), "GOOG" );
+	daw::expecting( orders[3].get<&order::symbol>( ), "MSFT" );
+}
+
+void soa_vector_test_003( ) {
+	// A copy that throws part way through a later column must not leak the
+	// rows already copied
+	{
+		counted_soa soa( 10 );
+		daw::expecting( copy_counter::live, 20 );
+		for( int failing_copy : { 0, 5, 10, 15 } ) {
+			copy_counter::copies_left = failing_copy;
+			daw::expecting_exception<std::runtime_error>(
+			  [&] { (void)counted_soa( soa ); } );
+			daw::expecting( copy_counter::live, 20 );
+		}
+		copy_counter::copies_left = -1;
+		auto const copy = soa;
+		daw::expecting( copy.size( ), 10U );
+		daw::expecting( copy_counter::live, 40 );
+	}
+	daw::expecting( copy_counter::live, 0 );
+}
+
+void soa_vector_bench_001( ) {
+	std::cout << "soa_vector field update and sort\n";
+	constexpr std::size_t count = 4'000'000;
+	auto aos = make_particles( count );
+	particle_soa soa{ };
+	soa.reserve( count );
+	for( auto const &p : aos ) {
+		soa.push_back( p );
+	}
+
+	daw::show_benchmark(
+	  count * sizeof( float ) * 2U, "AoS x += vx",
+	  [&]( ) {
+		  for( auto &p : aos ) {
+			  p.x += p.vx;
+		  }
+		  daw::do_not_optimize( aos );
+	  },
+	  2, 2, count );
+	daw::show_benchmark(
+	  count * sizeof( float ) * 2U, "SoA x += vx",
+	  [&]( ) {
+		  auto xs = soa.column<&particle::x>( );
+		  auto vxs = soa.column<&particle::vx>( );
+		  for( std::size_t n = 0; n < xs.size( ); ++n ) {
+			  xs[n] += vxs[n];
+		  }
+		  daw::do_not_optimize( soa );
+	  },
+	  2, 2, count );
+
+	auto const by_id = []( particle const &lhs, particle const &rhs ) {
+		return lhs.id < rhs.id;
+	};
+	auto aos_copy = aos;
+	daw::show_benchmark(
+	  count * sizeof( particle ), "AoS std::sort by id",
+	  [&]( ) { std::sort( aos_copy.begin( ), aos_copy.end( ), by_id ); }, 2, 1,
+	  count );
+	particle_soa soa_copy = soa;
+	daw::show_benchmark(
+	  count * sizeof( particle ), "SoA std::sort by id",
+	  [&]( ) { std::sort( soa_copy.begin( ), soa_copy.end( ), by_id ); }, 2, 1,
+	  count );
+	daw::show_benchmark(
+	  count * sizeof( particle ), "daw::soa_sort_by<id>",
+	  [&]( ) { daw::soa_sort_by<&particle::id>( soa ); }, 2, 1, count );
+	for( std::size_t n = 0; n < count; n += 997 ) {
+		daw::expecting( soa[n].get<&particle::id>( ), aos_copy[n].id );
+	}
+}
+
+int main( ) {
+	soa_vector_test_001( );
+	soa_vector_test_002( );
+	soa_vector_test_003( );
+	soa_vector_bench_001( );
+}
@@ -10,8 +10,12 @@
 #include "daw/daw_stack_function.h"
 #include "daw/daw_utility.h"
 
+#include <array>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 std::string strfunc( ) {
 	return "Goodbye";
@@ -82,7 +86,130 @@ void stack_function_test_002( ) {
 	fcvf1( );
 }
 
+void unique_function_test_001( ) {
+	using func_t = daw::unique_function<32, int( int )>;
+	func_t f{ };
+	daw::expecting( f.empty( ) );
+	daw::expecting_exception<std::bad_function_call>( [&]( ) { f( 1 ); } );
+	f = []( int x ) { return x * x; };
+	daw::expecting( !f.empty( ) );
+	daw::expecting( 16, f( 4 ) );
+
+	// Move only callable
+	auto p = std::make_unique<int>( 5 );
+	func_t f2 = [p = daw::move( p )]( int x ) { return *p + x; };
+	daw::expecting( 7, f2( 2 ) );
+	func_t f3 = daw::move( f2 );
+	daw::expecting( f2.empty( ) );
+	daw::expecting( 8, f3( 3 ) );
+
+	int ( *fp )( int ) = nullptr;
+	f3 = fp;
+	daw::expecting( f3.empty( ) );
+	std::function<int( int )> sf{ };
+	f3 = sf;
+	daw::expecting( f3.empty( ) );
+}
+
+void unique_function_test_002( ) {
+	// Oversized callables go to the heap instead of failing to compile
+	using func_t = daw::unique_function<16, size_t( )>;
+	std::array<size_t, 64> big{ };
+	big[63] = 42;
+	auto big_lambda = [big]( ) { return big[63]; };
+	static_assert( not func_t::stores_inline<decltype( big_lambda )>( ) );
+	func_t f = big_lambda;
+	daw::expecting( 42U, f( ) );
+
+	std::vector<func_t> queue{ };
+	for( size_t n = 0; n < 100; ++n ) {
+		if( n % 2 == 0 ) {
+			queue.emplace_back( [n]( ) { return n; } );
+		} else {
+			queue.emplace_back( [big, n]( ) { return big[63] + n; } );
+		}
+	}
+	size_t sum = 0;
+	for( auto &task : queue ) {
+		sum += task( );
+	}
+	daw::expecting( 4950U + 42U * 50U, sum );
+
+	// Non-trivial inline callable relocates through its move constructor
+	using sfunc_t = daw::unique_function<64, std::string( )>;
+	static_assert( sfunc_t::stores_inline<std::string>( ) or
+	               sizeof( std::string ) > 64 );
+	sfunc_t sf = [s = std::string( "hello" )]( ) { return s; };
+	sfunc_t sf2 = daw::move( sf );
+	daw::expecting( sf2( ) == "hello" );
+}
+
+int call_twice( daw::function_ref<int( int )> f, int x ) {
+	return f( f( x ) );
+}
+
+int add_one( int x ) {
+	return x + 1;
+}
+
+void function_ref_test_001( ) {
+	int offset = 3;
+	auto add_offset = [&offset]( int x ) { return x + offset; };
+	daw::expecting( 7, call_twice( add_offset, 1 ) );
+	daw::expecting( 3, call_twice( add_one, 1 ) );
+	daw::expecting( 3, call_twice( &add_one, 1 ) );
+	static_assert( std::is_trivially_copyable_v<daw::function_ref<int( int )>> );
+}
+
+void unique_function_bench_001( ) {
+	constexpr size_t count = 1'000'000;
+	std::vector<daw::function<32, size_t( size_t )>> vfuncs{ };
+	std::vector<daw::unique_function<32, size_t( size_t )>> ufuncs{ };
+	std::vector<std::function<size_t( size_t )>> sfuncs{ };
+	vfuncs.reserve( count );
+	ufuncs.reserve( count );
+	sfuncs.reserve( count );
+	for( size_t n = 0; n < count; ++n ) {
+		vfuncs.emplace_back( [n]( size_t x ) { return x + n; } );
+		ufuncs.emplace_back( [n]( size_t x ) { return x + n; } );
+		sfuncs.emplace_back( [n]( size_t x ) { return x + n; } );
+	}
+	size_t sum1 = 0;
+	daw::show_benchmark(
+	  count * sizeof( vfuncs[0] ), "daw::function(call)",
+	  [&]( ) {
+		  for( auto &f : vfuncs ) {
+			  sum1 += f( 1 );
+		  }
+	  },
+	  2, 2, count );
+	size_t sum2 = 0;
+	daw::show_benchmark(
+	  count * sizeof( ufuncs[0] ), "daw::unique_function(call)",
+	  [&]( ) {
+		  for( auto &f : ufuncs ) {
+			  sum2 += f( 1 );
+		  }
+	  },
+	  2, 2, count );
+	size_t sum3 = 0;
+	daw::show_benchmark(
+	  count * sizeof( sfuncs[0] ), "std::function(call)",
+	  [&]( ) {
+		  for( auto &f : sfuncs ) {
+			  sum3 += f( 1 );
+		  }
+	  },
+	  2, 2, count );
+	daw::expecting( sum1, sum2 );
+	daw::expecting( sum1, sum3 );
+}
+
 int main( ) {
 	stack_function_test_001( );
 	stack_function_test_002( );
+	unique_function_test_001( );
+	unique_function_test_002( );
+	function_ref_test_001( );
+	unique_function_bench_001( );
 }
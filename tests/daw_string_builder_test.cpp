@@ -0,0 +1,150 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_string_builder.h"
+#include "daw/daw_string_view.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void string_builder_test_001( ) {
+	daw::string_builder sb{ };
+	daw::expecting( sb.empty( ) );
+	sb.append( "Hello" ).append( ',' ).append( 1, ' ' );
+	sb += "World";
+	daw::expecting( sb.size( ), 12U );
+	daw::expecting( sb.chunk_count( ), 1U );
+	daw::expecting( sb.to_string( ), "Hello, World" );
+
+	// Spill out of the small buffer and across several chunks
+	std::string expected = "Hello, World";
+	std::string const line = "0123456789abcdef";
+	for( std::size_t n = 0; n < 2000; ++n ) {
+		sb += line;
+		expected += line;
+	}
+	sb.append( 10'000, 'x' );
+	expected.append( 10'000, 'x' );
+	daw::expecting( sb.size( ), expected.size( ) );
+	daw::expecting( sb.chunk_count( ) > 2U );
+	daw::expecting( sb.to_string( ), expected );
+
+	std::string copied( sb.size( ), '\0' );
+	daw::expecting( sb.copy_to( copied.data( ) ) == copied.data( ) + sb.size( ) );
+	daw::expecting( copied, expected );
+
+	std::size_t total = 0;
+	for( auto sv : sb.chunks( ) ) {
+		daw::expecting( not sv.empty( ) );
+		total += sv.size( );
+	}
+	daw::expecting( total, expected.size( ) );
+
+	sb.clear( );
+	daw::expecting( sb.empty( ) );
+	sb += "again";
+	daw::expecting( sb.to_string( ), "again" );
+}
+
+void string_builder_test_002( ) {
+	// Large views are referenced in place, in order with the copied text
+	std::string const body( 4096, 'b' );
+	daw::string_builder sb{ };
+	sb += "HTTP/1.1 200 OK\r\n\r\n";
+	sb.append_view( body );
+	sb += "\r\n";
+	sb.append_view( "tiny" );
+	auto const pieces = sb.chunks( );
+	daw::expecting( pieces.size( ), 3U );
+	daw::expecting( pieces[1].data( ) == body.data( ) );
+	daw::expecting( sb.to_string( ),
+	                "HTTP/1.1 200 OK\r\n\r\n" + body + "\r\ntiny" );
+
+	// reserve keeps the next append in one chunk
+	daw::string_builder r( 100'000 );
+	r.append( 100'000, 'r' );
+	daw::expecting( r.chunk_count( ), 1U );
+	auto moved = std::move( r );
+	daw::expecting( moved.size( ), 100'000U );
+
+	// A reserved chunk that only a view follows stays empty and is skipped
+	daw::string_builder v{ };
+	v.reserve( 10'000 );
+	v.append_view( body );
+	daw::expecting( v.chunk_count( ), 1U );
+	daw::expecting( v.chunk_count( ), v.chunks( ).size( ) );
+	daw::expecting( v.to_string( ), body );
+}
+
+void string_builder_bench_001( ) {
+	std::cout << "assembling an 8MB response from short pieces\n";
+	std::vector<std::string> rows{ };
+	for( std::size_t n = 0; n < 1000; ++n ) {
+		rows.push_back( "<tr><td>" + std::to_string( n * 7919U ) +
+		                "</td><td>value</td></tr>\n" );
+	}
+	constexpr std::size_t repeat = 250;
+	std::size_t bytes = 0;
+	for( auto const &r : rows ) {
+		bytes += r.size( ) * repeat;
+	}
+
+	std::size_t string_size = 0;
+	daw::show_benchmark(
+	  bytes, "std::string +=",
+	  [&]( ) {
+		  std::string out{ };
+		  for( std::size_t n = 0; n < repeat; ++n ) {
+			  for( auto const &r : rows ) {
+				  out += r;
+			  }
+		  }
+		  daw::do_not_optimize( out );
+		  string_size = out.size( );
+	  },
+	  2, 2 );
+	std::size_t builder_size = 0;
+	daw::show_benchmark(
+	  bytes, "string_builder chunks",
+	  [&]( ) {
+		  daw::string_builder out{ };
+		  for( std::size_t n = 0; n < repeat; ++n ) {
+			  for( auto const &r : rows ) {
+				  out += r;
+			  }
+		  }
+		  // What a writev would be given
+		  auto pieces = out.chunks( );
+		  daw::do_not_optimize( pieces );
+		  builder_size = out.size( );
+	  },
+	  2, 2 );
+	daw::show_benchmark(
+	  bytes, "string_builder to_string",
+	  [&]( ) {
+		  daw::string_builder out{ };
+		  for( std::size_t n = 0; n < repeat; ++n ) {
+			  for( auto const &r : rows ) {
+				  out += r;
+			  }
+		  }
+		  auto str = out.to_string( );
+		  daw::do_not_optimize( str );
+	  },
+	  2, 2 );
+	daw::expecting( builder_size, string_size );
+}
+
+int main( ) {
+	string_builder_test_001( );
+	string_builder_test_002( );
+	string_builder_bench_001( );
+}
@@ -0,0 +1,184 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
+#include "daw/daw_string_interner.h"
+#include "daw/daw_string_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	std::vector<std::string> make_tags( std::size_t count ) {
+		std::vector<std::string> result{ };
+		for( std::size_t n = 0; n < count; ++n ) {
+			result.push_back( "service.tag." + std::to_string( n * 31U ) );
+		}
+		return result;
+	}
+} // namespace
+
+void string_interner_test_001( ) {
+	daw::string_interner interner{ };
+	auto const a = interner.intern( "hello" );
+	std::string const hello = std::string( "hel" ) + "lo";
+	auto const b = interner.intern( hello );
+	auto const c = interner.intern( "world" );
+	auto const empty = interner.intern( "" );
+	daw::expecting( a.is_valid( ) );
+	daw::expecting( a == b );
+	daw::expecting( a != c );
+	daw::expecting( interner.view( a ) == "hello" );
+	daw::expecting( interner[c] == "world" );
+	daw::expecting( interner[empty].empty( ) );
+	daw::expecting( interner.size( ), 3U );
+	daw::expecting( interner.find( "world" ) == c );
+	daw::expecting( not interner.find( "missing" ) );
+
+	// Enough strings to grow every shard's index and entry blocks
+	auto const tags = make_tags( 20'000 );
+	std::vector<daw::interned_string> handles{ };
+	for( auto const &t : tags ) {
+		handles.push_back( interner.intern( t ) );
+	}
+	std::unordered_set<daw::interned_string> distinct( handles.begin( ),
+	                                                   handles.end( ) );
+	daw::expecting( distinct.size( ), tags.size( ) );
+	for( std::size_t n = 0; n < tags.size( ); ++n ) {
+		daw::expecting( interner[handles[n]] == tags[n] );
+		daw::expecting( interner.intern( tags[n] ) == handles[n] );
+	}
+	daw::expecting( interner.size( ), tags.size( ) + 3U );
+
+	// An empty string before any characters are stored, found again through
+	// a string_view with no data
+	daw::string_interner fresh{ };
+	auto const first_empty = fresh.intern( "" );
+	daw::expecting( fresh.intern( daw::string_view( ) ) == first_empty );
+	daw::expecting( fresh.find( daw::string_view( ) ) == first_empty );
+	daw::expecting( fresh.view( first_empty ).data( ) != nullptr );
+	daw::expecting( fresh.view( first_empty ).empty( ) );
+	daw::expecting( fresh.size( ), 1U );
+}
+
+void string_interner_test_002( ) {
+	// Bulk intern returns handles in input order, repeats included
+	daw::string_interner interner{ };
+	auto const first = interner.intern( "service.tag.0" );
+	auto tags = make_tags( 500 );
+	tags.push_back( "service.tag.0" );
+	tags.push_back( "service.tag.31" );
+	auto const handles = interner.intern( tags.begin( ), tags.end( ) );
+	daw::expecting( handles.size( ), tags.size( ) );
+	daw::expecting( handles[0] == first );
+	daw::expecting( handles[500] == first );
+	daw::expecting( handles[501] == handles[1] );
+	for( std::size_t n = 0; n < tags.size( ); ++n ) {
+		daw::expecting( interner[handles[n]] == tags[n] );
+	}
+	daw::expecting( interner.size( ), 500U );
+
+	// A frozen interner finds what it has and adds nothing
+	interner.freeze( );
+	daw::expecting( interner.is_frozen( ) );
+	daw::expecting( interner.intern( "service.tag.62" ) == handles[2] );
+	daw::expecting( not interner.intern( "new.tag" ) );
+	std::vector<std::string> const more{ "service.tag.93", "other" };
+	auto const more_handles = interner.intern( more.begin( ), more.end( ) );
+	daw::expecting( more_handles[0] == handles[3] );
+	daw::expecting( not more_handles[1] );
+	daw::expecting( interner.size( ), 500U );
+}
+
+void string_interner_test_003( ) {
+	// Threads interning overlapping strings agree on every handle
+	daw::string_interner interner{ };
+	auto const tags = make_tags( 4000 );
+	constexpr std::size_t thread_count = 4;
+	std::vector<std::vector<daw::interned_string>> results( thread_count );
+	std::vector<std::thread> threads{ };
+	for( std::size_t t = 0; t < thread_count; ++t ) {
+		threads.emplace_back( [&, t] {
+			auto &out = results[t];
+			out.resize( tags.size( ) );
+			for( std::size_t n = 0; n < tags.size( ); ++n ) {
+				auto const idx = ( n + t * 997U ) % tags.size( );
+				out[idx] = interner.intern( tags[idx] );
+			}
+		} );
+	}
+	for( auto &th : threads ) {
+		th.join( );
+	}
+	daw::expecting( interner.size( ), tags.size( ) );
+	for( std::size_t n = 0; n < tags.size( ); ++n ) {
+		for( std::size_t t = 1; t < thread_count; ++t ) {
+			daw::expecting( results[t][n] == results[0][n] );
+		}
+		daw::expecting( interner[results[0][n]] == tags[n] );
+	}
+}
+
+void string_interner_bench_001( ) {
+	std::cout << "counting repeated event tags\n";
+	auto const tags = make_tags( 2000 );
+	auto const picks =
+	  daw::make_random_data<std::size_t>( 1'000'000, 0, tags.size( ) - 1 );
+	std::vector<daw::string_view> events{ };
+	for( auto p : picks ) {
+		events.emplace_back( tags[p] );
+	}
+	auto const bytes = events.size( ) * sizeof( daw::string_view );
+
+	std::size_t string_distinct = 0;
+	daw::show_benchmark(
+	  bytes, "unordered_map<std::string, count>",
+	  [&]( ) {
+		  std::unordered_map<std::string, std::size_t> counts{ };
+		  for( auto ev : events ) {
+			  ++counts[static_cast<std::string>( ev )];
+		  }
+		  string_distinct = counts.size( );
+	  },
+	  2, 2, events.size( ) );
+
+	// Intern once at ingest, then every later pass works on 32 bit handles
+	daw::string_interner interner{ };
+	std::vector<daw::interned_string> handles{ };
+	daw::show_benchmark(
+	  bytes, "bulk intern",
+	  [&]( ) { handles = interner.intern( events.begin( ), events.end( ) ); },
+	  2, 2, events.size( ) );
+	std::size_t handle_distinct = 0;
+	daw::show_benchmark(
+	  events.size( ) * sizeof( daw::interned_string ),
+	  "unordered_map<interned_string, count>",
+	  [&]( ) {
+		  std::unordered_map<daw::interned_string, std::size_t> counts{ };
+		  for( auto h : handles ) {
+			  ++counts[h];
+		  }
+		  handle_distinct = counts.size( );
+	  },
+	  2, 2, events.size( ) );
+	daw::expecting( handle_distinct, string_distinct );
+}
+
+int main( ) {
+	string_interner_test_001( );
+	string_interner_test_002( );
+	string_interner_test_003( );
+	string_interner_bench_001( );
+}
@@ -7,10 +7,12 @@
 //
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
 #include "daw/daw_string_split_range.h"
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -77,8 +79,110 @@ void string_split_range_003( ) {
 	daw::expecting( ans );
 }
 
+// The indexed split gives the same tokens as the lazy one, whole or in
+// blocks, for delimiters of any length at any position
+void indexed_string_split_001( ) {
+	auto const picks = daw::make_random_data<std::size_t>( 200'000, 0, 3 );
+	std::string text{ };
+	for( auto p : picks ) {
+		text.push_back( "ab,;"[p] );
+	}
+	for( std::string const delimiter : { ",", "ab", "a,b", ",;,;", "ab,;ab" } ) {
+		for( std::size_t size : { 0, 1, 5, 17, 40, 100, 3000 } ) {
+			auto const str = daw::string_view( text.data( ), size );
+			auto const delim =
+			  daw::string_view( delimiter.data( ), delimiter.size( ) );
+			std::vector<daw::string_view> expected{ };
+			for( auto tok : daw::split_string( str, delim ) ) {
+				expected.push_back( tok );
+			}
+
+			auto const index = daw::indexed_string_split( str, delim );
+			daw::expecting( index.size( ), expected.size( ) );
+			daw::expecting( std::equal( index.begin( ), index.end( ),
+			                            expected.begin( ), expected.end( ) ) );
+			for( std::size_t n = 0; n < index.size( ); ++n ) {
+				daw::expecting( index[n] == expected[n] );
+				daw::expecting( index.begin( )[static_cast<std::ptrdiff_t>( n )] ==
+				                expected[n] );
+			}
+
+			std::vector<daw::string_view> blocked{ };
+			daw::for_each_split_block(
+			  str, delim, 3, [&]( daw::indexed_string_split<char> const &block ) {
+				  daw::expecting( block.size( ) <= 3U );
+				  blocked.insert( blocked.end( ), block.begin( ), block.end( ) );
+			  } );
+			daw::expecting( std::equal( blocked.begin( ), blocked.end( ),
+			                            expected.begin( ), expected.end( ) ) );
+		}
+	}
+
+	auto const csv = daw::indexed_string_split( daw::string_view( "a,,b," ),
+	                                            daw::string_view( "," ) );
+	daw::expecting( csv.size( ), 4U );
+	daw::expecting( csv[1].empty( ) and csv[3].empty( ) );
+	daw::expecting( csv.end( ) - csv.begin( ), 4 );
+	daw::expecting( *( csv.end( ) - 2 ) == "b" );
+}
+
+void indexed_string_split_bench_001( ) {
+	std::cout << "tokenizing 16MB of space separated words\n";
+	auto const lengths = daw::make_random_data<std::size_t>( 2'000'000, 1, 12 );
+	std::string text{ };
+	for( auto len : lengths ) {
+		text.append( len, 'w' );
+		text.push_back( ' ' );
+	}
+	auto const str = daw::string_view( text.data( ), text.size( ) );
+	auto const delim = daw::string_view( " " );
+	std::size_t lazy_count = 0;
+	daw::show_benchmark(
+	  text.size( ), "string_split_range",
+	  [&]( ) {
+		  std::size_t count = 0;
+		  for( auto tok : daw::split_string( str, delim ) ) {
+			  count += tok.size( );
+		  }
+		  daw::do_not_optimize( count );
+		  lazy_count = count;
+	  },
+	  2, 2 );
+	std::size_t indexed_count = 0;
+	daw::show_benchmark(
+	  text.size( ), "indexed_string_split",
+	  [&]( ) {
+		  std::size_t count = 0;
+		  for( auto tok : daw::indexed_string_split( str, delim ) ) {
+			  count += tok.size( );
+		  }
+		  daw::do_not_optimize( count );
+		  indexed_count = count;
+	  },
+	  2, 2 );
+	std::size_t block_count = 0;
+	daw::show_benchmark(
+	  text.size( ), "for_each_split_block",
+	  [&]( ) {
+		  std::size_t count = 0;
+		  daw::for_each_split_block(
+		    str, delim, 4096, [&]( daw::indexed_string_split<char> const &b ) {
+			    for( auto tok : b ) {
+				    count += tok.size( );
+			    }
+		    } );
+		  daw::do_not_optimize( count );
+		  block_count = count;
+	  },
+	  2, 2 );
+	daw::expecting( indexed_count, lazy_count );
+	daw::expecting( block_count, lazy_count );
+}
+
 int main( ) {
 	string_split_range_001( );
 	string_split_range_002( );
 	string_split_range_003( );
+	indexed_string_split_001( );
+	indexed_string_split_bench_001( );
 }
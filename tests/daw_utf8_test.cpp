@@ -0,0 +1,224 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_random.h"
+#include "daw/daw_string_view.h"
+#include "daw/daw_utf8.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+	// Each is not well formed from its first byte
+	std::vector<std::string> const invalid_sequences = {
+	  "\x80",             // lone continuation
+	  "\xC0\xAF",         // overlong '/'
+	  "\xC1\xBF",         // overlong two byte
+	  "\xC3",             // truncated
+	  "\xC3(",            // missing continuation
+	  "\xE0\x9F\x80",     // overlong three byte
+	  "\xE2\x82",         // truncated
+	  "\xED\xA0\x80",     // surrogate
+	  "\xF0\x8F\xBF\xBF", // overlong four byte
+	  "\xF4\x90\x80\x80", // past U+10FFFF
+	  "\xF5\x80\x80\x80", // bad lead
+	  "\xF0\x9F\x98",     // truncated
+	  "\xFF" };
+
+	// ASCII with some two, three and four byte sequences
+	std::string make_mixed_text( std::size_t size ) {
+		std::string const pieces[] = {
+		  "{\"name\": \"value\", ", "caf\xC3\xA9 ", "\xE2\x82\xAC 12, ",
+		  "\xF0\x9F\x98\x80 ", "plain ascii text " };
+		std::string result{ };
+		auto const picks = daw::make_random_data<std::size_t>( size / 8, 0, 4 );
+		for( auto p : picks ) {
+			if( result.size( ) >= size ) {
+				break;
+			}
+			result += pieces[p];
+		}
+		return result;
+	}
+} // namespace
+
+constexpr bool utf8_test_001( ) {
+	daw::expecting( daw::utf8::is_valid( "h\xC3\xA9llo \xF0\x9F\x98\x80" ) );
+	daw::expecting( daw::utf8::count_code_points( "h\xC3\xA9llo" ), 5U );
+	daw::expecting( daw::utf8::utf16_length( "\xF0\x9F\x98\x80" ), 2U );
+	daw::expecting( daw::utf8::find_invalid( "ab\xE2\x82" ), 2U );
+	daw::expecting( daw::utf8::find_invalid( "a\xED\xA0\x80" ), 1U );
+	daw::expecting( daw::utf8::find_invalid( "\xF4\x8F\xBF\xBF" ) ==
+	                daw::string_view::npos );
+
+	char32_t u32[4]{ };
+	auto const r = daw::utf8::to_utf32( "\xC3\xA9\xE2\x82\xAC!", u32 );
+	daw::expecting( static_cast<bool>( r ) );
+	daw::expecting( r.out - u32, 3 );
+	daw::expecting( u32[0] == 0xE9 and u32[1] == 0x20AC and u32[2] == '!' );
+
+	char16_t const pair[] = { 0xD83D, 0xDE00 };
+	char u8[4]{ };
+	auto const r2 =
+	  daw::utf8::from_utf16( daw::basic_string_view<char16_t>( pair, 2 ), u8 );
+	daw::expecting( static_cast<bool>( r2 ) );
+	daw::expecting( daw::string_view( u8, 4 ) == "\xF0\x9F\x98\x80" );
+	return true;
+}
+static_assert( utf8_test_001( ) );
+
+void utf8_test_002( ) {
+	// Each invalid sequence at each offset of an ASCII and a mixed background
+	for( auto const &background :
+	     { std::string( 80, 'x' ), make_mixed_text( 80 ) } ) {
+		for( auto const &bad : invalid_sequences ) {
+			for( std::size_t pos = 0; pos <= 64; ++pos ) {
+				// Insert on a sequence boundary of the background
+				auto at = pos;
+				while( at < background.size( ) and
+				       ( static_cast<unsigned char>( background[at] ) & 0xC0U ) ==
+				         0x80U ) {
+					++at;
+				}
+				// What follows starts a sequence, so a truncated one stays bad
+				auto const str =
+				  background.substr( 0, at ) + bad + background.substr( at );
+				daw::expecting( daw::utf8::find_invalid( str ), at );
+				daw::expecting( not daw::utf8::is_valid( str ) );
+			}
+		}
+	}
+
+	// Random damage, checked against the byte at a time decoder
+	auto const text = make_mixed_text( 300 );
+	auto const edits = daw::make_random_data<std::size_t>( 40'000, 0, 1023 );
+	for( std::size_t n = 0; n + 4 < edits.size( ); n += 4 ) {
+		auto str = text.substr( 0, 100 + edits[n] % 200 );
+		str[edits[n + 1] % str.size( )] = static_cast<char>( edits[n + 2] );
+		if( edits[n + 3] % 2 == 0 ) {
+			str[edits[n + 3] % str.size( )] =
+			  static_cast<char>( edits[n + 2] ^ 0x40U );
+		}
+		char const *const first = str.data( );
+		char const *const last = str.data( ) + str.size( );
+		auto const bad =
+		  daw::utf8::utf8_details::find_invalid_scalar( first, last );
+		auto const expected = bad == last ? daw::string_view::npos
+		                                  : static_cast<std::size_t>( bad - first );
+		daw::expecting( daw::utf8::find_invalid( str ), expected );
+	}
+}
+
+void utf8_test_003( ) {
+	// Round trip every scalar value
+	std::u32string all{ };
+	for( char32_t cp = 1; cp <= 0x10'FFFF; ++cp ) {
+		if( cp < 0xD800 or cp > 0xDFFF ) {
+			all.push_back( cp );
+		}
+	}
+	auto const all_view =
+	  daw::basic_string_view<char32_t>( all.data( ), all.size( ) );
+	std::string u8( daw::utf8::utf8_length( all_view ), '\0' );
+	auto const r8 = daw::utf8::from_utf32( all_view, u8.data( ) );
+	daw::expecting( static_cast<bool>( r8 ) );
+	daw::expecting( r8.out == u8.data( ) + u8.size( ) );
+	daw::expecting( daw::utf8::is_valid( u8 ) );
+	daw::expecting( daw::utf8::count_code_points( u8 ), all.size( ) );
+
+	std::u32string u32( all.size( ), U'\0' );
+	auto const r32 = daw::utf8::to_utf32( u8, u32.data( ) );
+	daw::expecting( static_cast<bool>( r32 ) );
+	daw::expecting( u32 == all );
+
+	std::u16string u16( daw::utf8::utf16_length( u8 ), u'\0' );
+	auto const r16 = daw::utf8::to_utf16( u8, u16.data( ) );
+	daw::expecting( static_cast<bool>( r16 ) );
+	daw::expecting( r16.out == u16.data( ) + u16.size( ) );
+	auto const u16_view =
+	  daw::basic_string_view<char16_t>( u16.data( ), u16.size( ) );
+	daw::expecting( daw::utf8::utf8_length( u16_view ), u8.size( ) );
+	std::string back( u8.size( ), '\0' );
+	auto const rb = daw::utf8::from_utf16( u16_view, back.data( ) );
+	daw::expecting( static_cast<bool>( rb ) );
+	daw::expecting( back == u8 );
+
+	// Conversion stops at the bad unit
+	std::u16string lone = u"0123456789abcdef";
+	lone[9] = 0xDC00;
+	std::string out( lone.size( ) * 3, '\0' );
+	auto const rl = daw::utf8::from_utf16(
+	  daw::basic_string_view<char16_t>( lone.data( ), lone.size( ) ),
+	  out.data( ) );
+	daw::expecting( not rl );
+	daw::expecting( rl.in - lone.data( ), 9 );
+	daw::expecting( rl.out - out.data( ), 9 );
+
+	std::u32string big = U"0123456789";
+	big[5] = 0x11'0000;
+	auto const rbig = daw::utf8::from_utf32(
+	  daw::basic_string_view<char32_t>( big.data( ), big.size( ) ), out.data( ) );
+	daw::expecting( not rbig );
+	daw::expecting( rbig.in - big.data( ), 5 );
+
+	std::string const bad_u8 = std::string( 40, 'a' ) + "\xE2\x82";
+	auto const rbad = daw::utf8::to_utf32( bad_u8, u32.data( ) );
+	daw::expecting( not rbad );
+	daw::expecting( rbad.in - bad_u8.data( ), 40 );
+}
+
+void utf8_bench_payload( std::string const &label,
+                        std::string const &payload ) {
+	char const *const first = payload.data( );
+	char const *const last = payload.data( ) + payload.size( );
+	bool scalar_ok = false;
+	daw::show_benchmark(
+	  payload.size( ), label + ": byte at a time",
+	  [&]( ) {
+		  scalar_ok =
+		    daw::utf8::utf8_details::find_invalid_scalar( first, last ) == last;
+		  daw::do_not_optimize( scalar_ok );
+	  },
+	  2, 2 );
+	bool block_ok = false;
+	daw::show_benchmark(
+	  payload.size( ), label + ": is_valid",
+	  [&]( ) {
+		  block_ok = daw::utf8::is_valid( payload );
+		  daw::do_not_optimize( block_ok );
+	  },
+	  2, 2 );
+	daw::expecting( scalar_ok and block_ok );
+	std::u16string u16( payload.size( ), u'\0' );
+	daw::show_benchmark(
+	  payload.size( ), label + ": to_utf16",
+	  [&]( ) {
+		  auto r = daw::utf8::to_utf16( payload, u16.data( ) );
+		  daw::do_not_optimize( r );
+	  },
+	  2, 2 );
+}
+
+void utf8_bench_001( ) {
+	std::cout << "validating request payloads\n";
+	std::string ascii{ };
+	while( ascii.size( ) < 1'000'000 ) {
+		ascii += "{\"id\": 12345, \"name\": \"some value\", \"ok\": true}, ";
+	}
+	utf8_bench_payload( "ascii", ascii );
+	utf8_bench_payload( "mixed", make_mixed_text( 1'000'000 ) );
+}
+
+int main( ) {
+	utf8_test_002( );
+	utf8_test_003( );
+	utf8_bench_001( );
+}
@@ -6,8 +6,11 @@
 // Official repository: https://github.com/beached/header_libraries
 //
 
+#include <cstddef>
 #include <optional>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "daw/daw_benchmark.h"
 #include "daw/daw_visit.h"
@@ -76,7 +79,127 @@ static_assert( ::daw::is_visitable_v<int, A> );
 struct B {};
 static_assert( !::daw::is_visitable_v<int, B> );
 
+template<std::size_t N>
+struct msg_t {
+	int value = static_cast<int>( N );
+};
+
+template<typename>
+struct make_big_variant;
+
+template<std::size_t... Is>
+struct make_big_variant<std::index_sequence<Is...>> {
+	using type = std::variant<msg_t<Is>...>;
+};
+
+using big_variant_t =
+  typename make_big_variant<std::make_index_sequence<24>>::type;
+
+struct big_visitor_t {
+	template<std::size_t N>
+	constexpr int operator( )( msg_t<N> const &m ) const {
+		return m.value * 2;
+	}
+};
+
+// More alternatives than the switch threshold, dispatched through the table
+constexpr bool visit_nt_006( ) {
+	big_variant_t const a = msg_t<17>{ };
+	daw::expecting( 34, ::daw::visit_nt( a, big_visitor_t{ } ) );
+	big_variant_t const b = msg_t<0>{ };
+	daw::expecting( 0, ::daw::visit_nt( b, big_visitor_t{ } ) );
+	big_variant_t const c = msg_t<23>{ };
+	daw::expecting( 46L, ::daw::visit_nt<long>( c, big_visitor_t{ } ) );
+	return true;
+}
+static_assert( visit_nt_006( ) );
+
+constexpr bool visit_nt_multi_001( ) {
+	std::variant<int, double> a = 5.5;
+	std::variant<char, int, bool> b = true;
+	auto result = ::daw::visit_nt_multi(
+	  []( auto x, auto y ) {
+		  return static_cast<int>( x ) * 10 + static_cast<int>( y );
+	  },
+	  a, b );
+	daw::expecting( 51, result );
+	std::variant<int, double> const c = 2;
+	std::variant<char, int, bool> const d = 'A';
+	result = ::daw::visit_nt_multi(
+	  []( auto x, auto y ) {
+		  return static_cast<int>( x ) * 1000 + static_cast<int>( y );
+	  },
+	  c, d );
+	daw::expecting( 2065, result );
+	return true;
+}
+static_assert( visit_nt_multi_001( ) );
+
+constexpr bool visit_nt_multi_002( ) {
+	big_variant_t a = msg_t<3>{ };
+	big_variant_t b = msg_t<20>{ };
+	std::variant<int, double> c = 1;
+	auto result = ::daw::visit_nt_multi<long>(
+	  []( auto const &x, auto const &y, auto z ) {
+		  return x.value * 100 + y.value + static_cast<int>( z );
+	  },
+	  a, b, c );
+	daw::expecting( 321L, result );
+	return true;
+}
+static_assert( visit_nt_multi_002( ) );
+
+template<std::size_t... Is>
+std::vector<big_variant_t> make_big_variants( std::size_t count,
+                                              std::index_sequence<Is...> ) {
+	big_variant_t const alternatives[] = {
+	  big_variant_t( std::in_place_index<Is> )... };
+	std::vector<big_variant_t> result{ };
+	result.reserve( count );
+	for( std::size_t n = 0; n < count; ++n ) {
+		// Scatter the indices so the branch predictor cannot learn them
+		result.push_back( alternatives[( n * 7919U + n / 3U ) % sizeof...( Is )] );
+	}
+	return result;
+}
+
+void visit_nt_bench_001( ) {
+	constexpr std::size_t count = 1'000'000;
+	auto const values =
+	  make_big_variants( count, std::make_index_sequence<24>{ } );
+	long sum1 = 0;
+	daw::show_benchmark(
+	  count * sizeof( big_variant_t ), "daw::visit_nt(24 alternatives)",
+	  [&]( ) {
+		  for( auto const &v : values ) {
+			  sum1 += ::daw::visit_nt( v, big_visitor_t{ } );
+		  }
+	  },
+	  2, 2, count );
+	long sum2 = 0;
+	daw::show_benchmark(
+	  count * sizeof( big_variant_t ), "switch chain(24 alternatives)",
+	  [&]( ) {
+		  for( auto const &v : values ) {
+			  sum2 += ::daw::visit_details::visit_nt<0, int>( v, big_visitor_t{ } );
+		  }
+	  },
+	  2, 2, count );
+	long sum3 = 0;
+	daw::show_benchmark(
+	  count * sizeof( big_variant_t ), "std::visit(24 alternatives)",
+	  [&]( ) {
+		  for( auto const &v : values ) {
+			  sum3 += std::visit( big_visitor_t{ }, v );
+		  }
+	  },
+	  2, 2, count );
+	daw::expecting( sum1, sum2 );
+	daw::expecting( sum1, sum3 );
+}
+
 int main( ) {
 	visit_nt_004( );
 	visit_nt_005( );
+	visit_nt_bench_001( );
 }